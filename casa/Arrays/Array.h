@@ -248,6 +248,15 @@ public:
     // non-conforming array.
     virtual Array<T> &operator=(const Array<T> &other);
 
+#ifdef AIPS_CXX11
+    // Move assignment. It has the same semantics as the copy assignment
+    // above, so values are copied if this array is not empty.
+    // However, if this array is empty and <src>other</src> is the only
+    // user of its contiguous storage, that storage is taken over instead
+    // of copied. <src>other</src> is then left as an empty array.
+    Array<T> &operator=(Array<T> &&other);
+#endif
+
     // Set every element of this array to "value". In other words, a scalar
     // behaves as if it were a constant conformant array.
     Array<T> &operator=(const T &value);
@@ -763,6 +772,14 @@ protected:
     virtual void doNonDegenerate(const Array<T> &other,
                                  const IPosition &ignoreAxes);
 
+    // Take over the storage of <src>other</src> if this array is empty
+    // and <src>other</src> is the only user of its storage, which must be
+    // contiguous and fully used. The result is then the same as assigning
+    // <src>other</src>, but without copying the values. <src>other</src> is
+    // resized to an empty array.
+    // It returns False (and does nothing) if the storage cannot be taken over.
+    Bool moveUnique (Array<T> &other);
+
 
     // Reference counted block that contains the storage.
     CountedPtr<Block<T> > data_p;
@@ -243,6 +243,35 @@ template<class T> Array<T> &Array<T>::operator=(const Array<T> &other)
     return *this;
 }
 
+#ifdef AIPS_CXX11
+template<class T> Array<T> &Array<T>::operator=(Array<T> &&other)
+{
+    DebugAssert(ok(), ArrayError);
+    if (this != &other  &&  !moveUnique (other)) {
+        operator= (static_cast<const Array<T>&>(other));
+    }
+    return *this;
+}
+#endif
+
+template<class T> Bool Array<T>::moveUnique (Array<T> &other)
+{
+    // Only do it if the result is indistinguishable from a copy,
+    // i.e. if nobody else can see the storage being taken over.
+    // The dimensionality check avoids that a derived class
+    // (e.g. Vector) refuses the reference where a copy would be fine.
+    if (nelements() != 0  ||  other.nelements() == 0
+    ||  (ndim() != 0  &&  ndim() != other.ndim())
+    ||  !other.contiguousStorage()  ||  other.data_p.nrefs() != 1
+    ||  other.begin_p != other.data_p->storage()
+    ||  other.nelements() != other.data_p->nelements()) {
+        return False;
+    }
+    reference (other);
+    other.resize();
+    return True;
+}
+
 template<class T> Array<T> &Array<T>::operator=(const T &val)
 {
     DebugAssert(ok(), ArrayError);
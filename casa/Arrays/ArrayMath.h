@@ -603,6 +603,25 @@ template<class T> inline Vector<T> indgen(uInt length, T start, T inc)
 }
 
 
+// Accumulate the <src>n</src> contiguous values starting at <src>data</src>
+// using the accumulation functor <src>op</src> (e.g. std::plus or
+// casa::SumSqr). Partial results are combined using operator+.
+// <br>The values are accumulated in blocks using several interleaved
+// partial sums which are combined pairwise. It makes it possible for the
+// compiler to vectorize the inner loop, while the round-off error grows
+// with log(n) instead of n. The blocking is independent of the number of
+// threads, so the result is always the same.
+// If compiled with OpenMP, the blocks of a large array are accumulated
+// in parallel.
+template<typename T, typename AccumOp>
+T accumulateContiguous (const T* data, size_t n, AccumOp op);
+
+// Determine the minimum and maximum of the <src>n</src> contiguous values
+// starting at <src>data</src> (which must be > 0).
+// If compiled with OpenMP, a large array is handled in parallel.
+template<typename T>
+void minMaxContiguous (T& minVal, T& maxVal, const T* data, size_t n);
+
 // Sum of every element of the array.
 template<class T> T sum(const Array<T> &a);
 // 
@@ -658,7 +677,9 @@ template<class T> T rms(const Array<T> &a);
 // <br>If "sorted"==True we assume the data is already sorted and we
 // compute the median directly. Otherwise the function GenSort::kthLargest
 // is used to find the median (kthLargest is about 6 times faster
-// than a full quicksort).
+// than a full quicksort). If the mean of the two middle elements has to
+// be taken, the second one is the minimum of the upper part left by
+// kthLargest, so no second selection is needed.
 // <br>Finding the median means that the array has to be (partially)
 // sorted. By default a copy will be made, but if "inPlace" is in effect,
 // the data themselves will be sorted. That should only be used if the
@@ -753,27 +753,19 @@ template<class T> void minMax(T &minVal, T &maxVal, const Array<T> &array)
     throw(ArrayError("void minMax(T &min, T &max, const Array<T> &array) - "
                      "Array has no elements"));	
   }
+  if (array.contiguousStorage()) {
+    minMaxContiguous (minVal, maxVal, array.data(), array.nelements());
+    return;
+  }
   T minv = array.data()[0];
   T maxv = minv;
-  if (array.contiguousStorage()) {
-    typename Array<T>::const_contiter iterEnd = array.cend();
-    for (typename Array<T>::const_contiter iter = array.cbegin();
-         iter!=iterEnd; ++iter) {
-      if (*iter < minv) {
-        minv = *iter;
-      } else if (*iter > maxv) {
-        maxv = *iter;
-      }
-    }
-  } else {
-    typename Array<T>::const_iterator iterEnd = array.end();
-    for (typename Array<T>::const_iterator iter = array.begin();
-         iter!=iterEnd; ++iter) {
-      if (*iter < minv) {
-        minv = *iter;
-      } else if (*iter > maxv) {
-        maxv = *iter;
-      }
+  typename Array<T>::const_iterator iterEnd = array.end();
+  for (typename Array<T>::const_iterator iter = array.begin();
+       iter!=iterEnd; ++iter) {
+    if (*iter < minv) {
+      minv = *iter;
+    } else if (*iter > maxv) {
+      maxv = *iter;
     }
   }
   maxVal = maxv;
@@ -1033,13 +1025,107 @@ template<class T> Array<T> fmod(const Array<T> &a, const T &b)
 }
 
 
+// Accumulate a part of the data pairwise. The leaves are accumulated
+// using 4 interleaved partial sums, so the compiler can vectorize the loop.
+template<typename T, typename AccumOp>
+T pairwiseAccumulate (const T* data, size_t n, AccumOp op)
+{
+  if (n <= 256) {
+    T s0 = T();
+    T s1 = T();
+    T s2 = T();
+    T s3 = T();
+    size_t i = 0;
+    for (; i+4<=n; i+=4) {
+      s0 = op(s0, data[i]);
+      s1 = op(s1, data[i+1]);
+      s2 = op(s2, data[i+2]);
+      s3 = op(s3, data[i+3]);
+    }
+    for (; i<n; ++i) {
+      s0 = op(s0, data[i]);
+    }
+    return (s0 + s1) + (s2 + s3);
+  }
+  size_t nh = n/2;
+  return pairwiseAccumulate (data, nh, op) +
+         pairwiseAccumulate (data+nh, n-nh, op);
+}
+
+template<typename T, typename AccumOp>
+T accumulateContiguous (const T* data, size_t n, AccumOp op)
+{
+  // Use fixed size blocks, so the result does not depend on #threads.
+  const size_t blockSize = 65536;
+  if (n <= blockSize) {
+    return pairwiseAccumulate (data, n, op);
+  }
+  Int64 nblock = (n + blockSize - 1) / blockSize;
+  Block<T> partial(nblock);
+#ifdef _OPENMP
+#pragma omp parallel for if (nblock > 4)
+#endif
+  for (Int64 i=0; i<nblock; ++i) {
+    size_t st = i*blockSize;
+    partial[i] = pairwiseAccumulate (data + st, std::min(blockSize, n-st),
+                                     op);
+  }
+  return pairwiseAccumulate (partial.storage(), nblock, std::plus<T>());
+}
+
+// Determine min and max of a part of the data.
+// Comparisons are written as selections, so the compiler can vectorize.
+// Note that minv and maxv have to be initialized by the caller.
+template<typename T>
+void minMaxPart (T& minVal, T& maxVal, const T* data, size_t n)
+{
+  T minv = minVal;
+  T maxv = maxVal;
+  for (size_t i=0; i<n; ++i) {
+    minv = (data[i] < minv  ?  data[i] : minv);
+    maxv = (data[i] > maxv  ?  data[i] : maxv);
+  }
+  minVal = minv;
+  maxVal = maxv;
+}
+
+template<typename T>
+void minMaxContiguous (T& minVal, T& maxVal, const T* data, size_t n)
+{
+  // Each part is initialized with the first value, so the result for NaNs
+  // is the same as for a sequential loop.
+  T minv = data[0];
+  T maxv = minv;
+  const size_t blockSize = 65536;
+  if (n <= blockSize) {
+    minMaxPart (minv, maxv, data, n);
+  } else {
+    Int64 nblock = (n + blockSize - 1) / blockSize;
+    Block<T> mins(nblock, minv);
+    Block<T> maxs(nblock, maxv);
+#ifdef _OPENMP
+#pragma omp parallel for if (nblock > 4)
+#endif
+    for (Int64 i=0; i<nblock; ++i) {
+      size_t st = i*blockSize;
+      minMaxPart (mins[i], maxs[i], data + st, std::min(blockSize, n-st));
+    }
+    for (Int64 i=0; i<nblock; ++i) {
+      if (mins[i] < minv) minv = mins[i];
+      if (maxs[i] > maxv) maxv = maxs[i];
+    }
+  }
+  minVal = minv;
+  maxVal = maxv;
+}
+
 // <thrown>
 //    </item> ArrayError
 // </thrown>
 template<class T> T sum(const Array<T> &a)
 {
   return a.contiguousStorage() ?
-    std::accumulate(a.cbegin(), a.cend(), T(), std::plus<T>()) :
+    accumulateContiguous (a.data(), a.nelements(), std::plus<T>()) :
     std::accumulate(a.begin(),  a.end(),  T(), std::plus<T>());
 }
 
@@ -1085,7 +1171,8 @@ template<class T> T variance(const Array<T> &a, T mean)
 			 "elements"));
     }
     T sum = a.contiguousStorage() ?
-      std::accumulate(a.cbegin(), a.cend(), T(), casa::SumSqrDiff<T>(mean)) :
+      accumulateContiguous (a.data(), a.nelements(),
+                            casa::SumSqrDiff<T>(mean)) :
       std::accumulate(a.begin(),  a.end(),  T(), casa::SumSqrDiff<T>(mean));
     return T(sum/(1.0*a.nelements() - 1));
 }
@@ -1148,7 +1235,8 @@ template<class T> T avdev(const Array<T> &a, T mean)
 			 "element"));
     }
     T sum = a.contiguousStorage() ?
-      std::accumulate(a.cbegin(), a.cend(), T(), casa::SumAbsDiff<T>(mean)) :
+      accumulateContiguous (a.data(), a.nelements(),
+                            casa::SumAbsDiff<T>(mean)) :
       std::accumulate(a.begin(),  a.end(),  T(), casa::SumAbsDiff<T>(mean));
     return T(sum/(1.0*a.nelements()));
 }
@@ -1163,7 +1251,7 @@ template<class T> T rms(const Array<T> &a)
 			 "element"));
     }
     T sum = a.contiguousStorage() ?
-      std::accumulate(a.cbegin(), a.cend(), T(), casa::SumSqr<T>()) :
+      accumulateContiguous (a.data(), a.nelements(), casa::SumSqr<T>()) :
       std::accumulate(a.begin(),  a.end(),  T(), casa::SumSqr<T>());
     return T(sqrt(sum/(1.0*a.nelements())));
 }
@@ -1204,8 +1292,15 @@ template<class T> T median(const Array<T> &a, Block<T> &tmp, Bool sorted,
 	if (nelem > 20) {
 	    medval = GenSort<T>::kthLargest (data, nelem, n2);
 	    if (takeEvenMean) {
-		medval = T(0.5 * (medval +
-				  GenSort<T>::kthLargest (data, nelem, n2+1)));
+		// kthLargest has partitioned the data, so the next element
+		// is the minimum of the upper part.
+		T nextval = data[n2+1];
+		for (size_t i=n2+2; i<nelem; ++i) {
+		    if (data[i] < nextval) {
+			nextval = data[i];
+		    }
+		}
+		medval = T(0.5 * (medval + nextval));
 	    }
 	} else {
 	    GenSort<T>::sort (data, nelem);
@@ -1264,13 +1359,13 @@ template<class T> T fractile(const Array<T> &a, Block<T>& tmp, Float fraction,
     const T* storage = a.data();
     if (!(a.contiguousStorage() && inPlace)) {
       tmp.resize (a.size(), False, False);
+      storage = tmp.storage();
       if (a.contiguousStorage()) {
 	objcopy (tmp.storage(), a.data(), a.size());
       } else {
       // A non-contiguous array, so do the assignment through an array.
 	Array<T> tmpa(a.shape(), tmp.storage(), SHARE);
 	tmpa = a;
-	storage = tmp.storage();
       }
     }
     T* data = const_cast<T*>(storage);
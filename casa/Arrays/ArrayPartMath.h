@@ -232,7 +232,7 @@ private:
     Bool     itsSorted;
     Bool     itsTakeEvenMean;
     Bool     itsInPlace;
-    mutable Block<Float> itsTmp;
+    mutable Block<T> itsTmp;
 };
 template<typename T> class FractileFunc {
 public:
@@ -259,7 +259,7 @@ private:
   float    itsFraction;
   Bool     itsSorted;
   Bool     itsInPlace;
-  mutable Block<Float> itsTmp;
+  mutable Block<T> itsTmp;
 };
 template<typename T> class InterHexileRangeFunc: public InterFractileRangeFunc<T> {
 public:
@@ -274,6 +274,30 @@ public:
     {}
 };
 
+// Apply the given ArrayMath reduction function object to each part of
+// the array formed by the collapse axes. The result is an array with a shape
+// formed by the remaining axes (as in partialMedians).
+// <br>The data are reordered such that the collapse axes come first,
+// whereafter the function object is applied to each contiguous part.
+// The function object is called with a contiguous array it is allowed to
+// change (thus it can work in place). If compiled with OpenMP, the parts
+// are processed in parallel, each thread using a copy of the function object.
+// <br>The input array is only used in place if <src>inPlace=True</src> and
+// the collapse axes are the first axes.
+// <example>
+// Determine the median of each X line of a cube.
+// <srcblock>
+//    Array<Float> meds = partialArrayMath (cube, IPosition(1,0), False,
+//                                          MedianFunc<Float>(False, False,
+//                                                            True));
+// </srcblock>
+// </example>
+template <typename T, typename FuncType>
+Array<T> partialArrayMath (const Array<T>& array,
+                           const IPosition& collapseAxes,
+                           Bool inPlace,
+                           const FuncType& funcObj);
+
 // Apply the given ArrayMath reduction function objects
 // to each box in the array.
 // <example>
@@ -29,6 +29,7 @@
 
 #include <casa/Arrays/ArrayPartMath.h>
 #include <casa/Arrays/ArrayError.h>
+#include <casa/Arrays/ArrayUtil.h>
 #include <casa/BasicMath/Math.h>
 #include <casa/Utilities/Assert.h>
 
@@ -74,11 +75,8 @@ template<class T> Array<T> partialSums (const Array<T>& array,
   IPosition pos(ndim, 0);
   while (True) {
     if (cont) {
-      T tmp = *res;
-      for (uInt i=0; i<n0; i++) {
-	tmp += *data++;
-      }
-      *res = tmp;
+      *res += accumulateContiguous (data, n0, std::plus<T>());
+      data += n0;
     } else {
       for (uInt i=0; i<n0; i++) {
 	*res += *data++;
@@ -399,13 +397,8 @@ template<class T> Array<T> partialVariances (const Array<T>& array,
   IPosition pos(ndim, 0);
   while (True) {
     if (cont) {
-      T tmp = *res;
-      T tmpm = *mean;
-      for (uInt i=0; i<n0; i++) {
-	T var = *data++ - tmpm;
-	tmp += var*var;
-      }
-      *res = tmp;
+      *res += accumulateContiguous (data, n0, casa::SumSqrDiff<T>(*mean));
+      data += n0;
     } else {
       for (uInt i=0; i<n0; i++) {
 	T var = *data++ - *mean;
@@ -559,12 +552,8 @@ template<class T> Array<T> partialRmss (const Array<T>& array,
   IPosition pos(ndim, 0);
   while (True) {
     if (cont) {
-      T tmp = *res;
-      for (uInt i=0; i<n0; i++) {
-	tmp += *data * *data;
-	data++;
-      }
-      *res = tmp;
+      *res += accumulateContiguous (data, n0, casa::SumSqr<T>());
+      data += n0;
     } else {
       for (uInt i=0; i<n0; i++) {
 	*res += *data * *data;
@@ -598,60 +587,8 @@ template<class T> Array<T> partialMedians (const Array<T>& array,
 					   Bool takeEvenMean,
 					   Bool inPlace)
 {
-  // Need to make shallow copy because operator() is non-const.
-  Array<T> arr = array;
-  // Is there anything to collapse?
-  if (collapseAxes.nelements() == 0) {
-    return (inPlace  ?  array : array.copy());
-  }
-  const IPosition& shape = array.shape();
-  uInt ndim = shape.nelements();
-  if (ndim == 0) {
-    return Array<T>();
-  }
-  // Get the remaining axes.
-  // It also checks if axes are specified correctly.
-  IPosition resAxes = IPosition::otherAxes (ndim, collapseAxes);
-  uInt ndimRes = resAxes.nelements();
-  // Create the result shape.
-  // Create blc and trc to step through the input array.
-  IPosition resShape(ndimRes);
-  IPosition blc(ndim, 0);
-  IPosition trc(shape-1);
-  for (uInt i=0; i<ndimRes; ++i) {
-    resShape[i] = shape[resAxes[i]];
-    trc[resAxes[i]] = 0;
-  }
-  if (ndimRes == 0) {
-    resShape.resize(1);
-    resShape[0] = 1;
-  }
-  Array<T> result (resShape);
-  Bool deleteRes;
-  T* resData = result.getStorage (deleteRes);
-  T* res = resData;
-  Block<T> tmp;
-  // Loop through all data and assemble as needed.
-  IPosition pos(ndimRes, 0);
-  while (True) {
-    *res++ = median(arr(blc,trc), tmp, False, takeEvenMean, inPlace);
-    uInt ax;
-    for (ax=0; ax<ndimRes; ax++) {
-      if (++pos(ax) < resShape(ax)) {
-	blc[resAxes[ax]]++;
-	trc[resAxes[ax]]++;
-	break;
-      }
-      pos(ax) = 0;
-      blc[resAxes[ax]] = 0;
-      trc[resAxes[ax]] = 0;
-    }
-    if (ax == ndimRes) {
-      break;
-    }
-  }
-  result.putStorage (resData, deleteRes);
-  return result;
+  return partialArrayMath (array, collapseAxes, inPlace,
+                           MedianFunc<T> (False, takeEvenMean, True));
 }
 
 template<class T> Array<T> partialMadfms (const Array<T>& array,
@@ -659,60 +596,8 @@ template<class T> Array<T> partialMadfms (const Array<T>& array,
                                          Bool takeEvenMean,
                                          Bool inPlace)
 {
-  // Need to make shallow copy because operator() is non-const.
-  Array<T> arr = array;
-  // Is there anything to collapse?
-  if (collapseAxes.nelements() == 0) {
-    return (inPlace  ?  array : array.copy());
-  }
-  const IPosition& shape = array.shape();
-  uInt ndim = shape.nelements();
-  if (ndim == 0) {
-    return Array<T>();
-  }
-  // Get the remaining axes.
-  // It also checks if axes are specified correctly.
-  IPosition resAxes = IPosition::otherAxes (ndim, collapseAxes);
-  uInt ndimRes = resAxes.nelements();
-  // Create the result shape.
-  // Create blc and trc to step through the input array.
-  IPosition resShape(ndimRes);
-  IPosition blc(ndim, 0);
-  IPosition trc(shape-1);
-  for (uInt i=0; i<ndimRes; ++i) {
-    resShape[i] = shape[resAxes[i]];
-    trc[resAxes[i]] = 0;
-  }
-  if (ndimRes == 0) {
-    resShape.resize(1);
-    resShape[0] = 1;
-  }
-  Array<T> result (resShape);
-  Bool deleteRes;
-  T* resData = result.getStorage (deleteRes);
-  T* res = resData;
-  Block<T> tmp;
-  // Loop through all data and assemble as needed.
-  IPosition pos(ndimRes, 0);
-  while (True) {
-    *res++ = madfm(arr(blc,trc), tmp, False, takeEvenMean, inPlace);
-    uInt ax;
-    for (ax=0; ax<ndimRes; ax++) {
-      if (++pos(ax) < resShape(ax)) {
-       blc[resAxes[ax]]++;
-       trc[resAxes[ax]]++;
-       break;
-      }
-      pos(ax) = 0;
-      blc[resAxes[ax]] = 0;
-      trc[resAxes[ax]] = 0;
-    }
-    if (ax == ndimRes) {
-      break;
-    }
-  }
-  result.putStorage (resData, deleteRes);
-  return result;
+  return partialArrayMath (array, collapseAxes, inPlace,
+                           MadfmFunc<T> (False, takeEvenMean, True));
 }
 
 template<class T> Array<T> partialFractiles (const Array<T>& array,
@@ -723,60 +608,8 @@ template<class T> Array<T> partialFractiles (const Array<T>& array,
   if (fraction < 0  ||  fraction > 1) {
     throw(ArrayError("::fractile(const Array<T>&) - fraction <0 or >1 "));
   }    
-  // Need to make shallow copy because operator() is non-const.
-  Array<T> arr = array;
-  // Is there anything to collapse?
-  if (collapseAxes.nelements() == 0) {
-    return (inPlace  ?  array : array.copy());
-  }
-  const IPosition& shape = array.shape();
-  uInt ndim = shape.nelements();
-  if (ndim == 0) {
-    return Array<T>();
-  }
-  // Get the remaining axes.
-  // It also checks if axes are specified correctly.
-  IPosition resAxes = IPosition::otherAxes (ndim, collapseAxes);
-  uInt ndimRes = resAxes.nelements();
-  // Create the result shape.
-  // Create blc and trc to step through the input array.
-  IPosition resShape(ndimRes);
-  IPosition blc(ndim, 0);
-  IPosition trc(shape-1);
-  for (uInt i=0; i<ndimRes; ++i) {
-    resShape[i] = shape[resAxes[i]];
-    trc[resAxes[i]] = 0;
-  }
-  if (ndimRes == 0) {
-    resShape.resize(1);
-    resShape[0] = 1;
-  }
-  Array<T> result (resShape);
-  Bool deleteRes;
-  T* resData = result.getStorage (deleteRes);
-  T* res = resData;
-  Block<T> tmp;
-  // Loop through all data and assemble as needed.
-  IPosition pos(ndimRes, 0);
-  while (True) {
-    *res++ = fractile(arr(blc,trc), tmp, fraction, False, inPlace);
-    uInt ax;
-    for (ax=0; ax<ndimRes; ax++) {
-      if (++pos(ax) < resShape(ax)) {
-	blc[resAxes[ax]]++;
-	trc[resAxes[ax]]++;
-	break;
-      }
-      pos(ax) = 0;
-      blc[resAxes[ax]] = 0;
-      trc[resAxes[ax]] = 0;
-    }
-    if (ax == ndimRes) {
-      break;
-    }
-  }
-  result.putStorage (resData, deleteRes);
-  return result;
+  return partialArrayMath (array, collapseAxes, inPlace,
+                           FractileFunc<T> (fraction, False, True));
 }
 
 template<class T> Array<T> partialInterFractileRanges (const Array<T>& array,
@@ -784,8 +617,17 @@ template<class T> Array<T> partialInterFractileRanges (const Array<T>& array,
                                                        Float fraction,
                                                        Bool inPlace)
 {
-  // Need to make shallow copy because operator() is non-const.
-  Array<T> arr = array;
+  return partialArrayMath (array, collapseAxes, inPlace,
+                           InterFractileRangeFunc<T> (fraction, False, True));
+}
+
+
+template <typename T, typename FuncType>
+Array<T> partialArrayMath (const Array<T>& array,
+                           const IPosition& collapseAxes,
+                           Bool inPlace,
+                           const FuncType& funcObj)
+{
   // Is there anything to collapse?
   if (collapseAxes.nelements() == 0) {
     return (inPlace  ?  array : array.copy());
@@ -800,43 +642,45 @@ template<class T> Array<T> partialInterFractileRanges (const Array<T>& array,
   IPosition resAxes = IPosition::otherAxes (ndim, collapseAxes);
   uInt ndimRes = resAxes.nelements();
   // Create the result shape.
-  // Create blc and trc to step through the input array.
   IPosition resShape(ndimRes);
-  IPosition blc(ndim, 0);
-  IPosition trc(shape-1);
   for (uInt i=0; i<ndimRes; ++i) {
     resShape[i] = shape[resAxes[i]];
-    trc[resAxes[i]] = 0;
   }
   if (ndimRes == 0) {
     resShape.resize(1);
     resShape[0] = 1;
   }
+  // Reorder the data such that the collapse axes come first, so the data of
+  // each result element are contiguous. The reordering is done in a single
+  // pass over the data, which is much faster than gathering the data for
+  // each result element. No copy is made if in place and already ordered.
+  Array<T> data = reorderArray (array, collapseAxes, !inPlace);
+  if (! data.contiguousStorage()) {
+    data.reference (data.copy());
+  }
   Array<T> result (resShape);
-  Bool deleteRes;
-  T* resData = result.getStorage (deleteRes);
-  T* res = resData;
-  Block<T> tmp;
-  // Loop through all data and assemble as needed.
-  IPosition pos(ndimRes, 0);
-  while (True) {
-    *res++ = interFractileRange(arr(blc,trc), tmp, fraction, False, inPlace);
-    uInt ax;
-    for (ax=0; ax<ndimRes; ax++) {
-      if (++pos(ax) < resShape(ax)) {
-       blc[resAxes[ax]]++;
-       trc[resAxes[ax]]++;
-       break;
-      }
-      pos(ax) = 0;
-      blc[resAxes[ax]] = 0;
-      trc[resAxes[ax]] = 0;
-    }
-    if (ax == ndimRes) {
-      break;
+  DebugAssert (result.contiguousStorage(), AipsError);
+  T* res = result.data();
+  T* dataPtr = data.data();
+  Int64 nres = result.size();
+  Int64 npart = (nres == 0  ?  0 : data.size() / nres);
+  IPosition partShape(1, npart);
+  // The parts are independent, so they can be done in parallel.
+  // Each thread uses its own copy of the function object, because it can
+  // contain a buffer. Do not use threads for empty parts, because the
+  // function objects throw an exception in that case.
+#ifdef _OPENMP
+#pragma omp parallel if (npart > 0  &&  nres > 1)
+#endif
+  {
+    FuncType func(funcObj);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+    for (Int64 i=0; i<nres; ++i) {
+      res[i] = func (Array<T>(partShape, dataPtr + i*npart, SHARE));
     }
   }
-  result.putStorage (resData, deleteRes);
   return result;
 }
 
@@ -137,6 +137,11 @@ public:
     // non-conforming cube.
     // <group>
     Cube<T> &operator=(const Cube<T> &other);
+#ifdef AIPS_CXX11
+    // Move assignment. The storage of other is taken over if possible
+    // (see the move assignment of class Array).
+    Cube<T> &operator=(Cube<T> &&other);
+#endif
     virtual Array<T> &operator=(const Array<T> &other);
     // </group>
 
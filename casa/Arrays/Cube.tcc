@@ -157,6 +157,17 @@ template<class T> Cube<T> &Cube<T>::operator=(const Cube<T> &other)
     return *this;
 }
 
+#ifdef AIPS_CXX11
+template<class T> Cube<T> &Cube<T>::operator=(Cube<T> &&other)
+{
+    DebugAssert(ok(), ArrayError);
+    if (this != &other  &&  !this->moveUnique (other)) {
+        operator= (static_cast<const Cube<T>&>(other));
+    }
+    return *this;
+}
+#endif
+
 template<class T> Array<T> &Cube<T>::operator=(const Array<T> &a)
 {
     DebugAssert(ok(), ArrayError);
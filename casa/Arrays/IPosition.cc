@@ -35,22 +35,6 @@
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
-IPosition::IPosition (uInt length)
-: size_p (length),
-  data_p (buffer_p)
-{
-    if (length > BufferLength) {
-	allocateBuffer();
-    }
-}
-
-IPosition::~IPosition()
-{
-    if (data_p != &buffer_p[0]) {
-        delete [] data_p;
-    }
-}
-
 void IPosition::allocateBuffer()
 {
     if (size_p <= BufferLength) {
@@ -114,18 +98,47 @@ IPosition::IPosition (uInt length, ssize_t val0, ssize_t val1, ssize_t val2,
     DebugAssert(ok(), AipsError);
 }
 
-IPosition::IPosition (const IPosition& other)
+#ifdef AIPS_CXX11
+IPosition::IPosition (IPosition&& other)
 : size_p (other.size_p),
   data_p (buffer_p)
 {
-    if (size_p > BufferLength) {
-	allocateBuffer();
+    if (other.data_p != &other.buffer_p[0]) {
+	// Take over the heap buffer.
+	data_p = other.data_p;
+	other.data_p = other.buffer_p;
+    } else {
+	for (uInt i=0; i<size_p; i++) {
+	    data_p[i] = other.data_p[i];
+	}
     }
-    for (uInt i=0; i<size_p; i++) {
-	data_p[i] = other.data_p[i];
+    other.size_p = 0;
+}
+
+IPosition& IPosition::operator= (IPosition&& other)
+{
+    if (&other == this) {
+	return *this;
     }
-    DebugAssert(ok(), AipsError);
+    if (size_p != 0  &&  ! conform(other)) {
+	throw(ArrayConformanceError("IPosition::operator=(IPosition&&) - "
+				    "this and other differ in length"));
+    }
+    if (other.data_p != &other.buffer_p[0]) {
+	// Take over the heap buffer.
+	if (data_p != &buffer_p[0]) {
+	    delete [] data_p;
+	}
+	size_p = other.size_p;
+	data_p = other.data_p;
+	other.data_p = other.buffer_p;
+	other.size_p = 0;
+    } else {
+	*this = other;
+    }
+    return *this;
 }
+#endif
 
 IPosition IPosition::nonDegenerate (uInt startingAxis) const
 {
@@ -202,12 +215,9 @@ void IPosition::resize (uInt newSize, Bool copy)
 // <thrown>
 //    <item> ArrayConformanceError
 // </thrown>
-IPosition& IPosition::operator= (const IPosition& other)
+void IPosition::copyOther (const IPosition& other)
 {
     DebugAssert(ok(), AipsError);
-    if (&other == this) {
-	return *this;
-    }
     if (size_p == 0) {
 	this->resize (other.nelements(), False);
     } else if (! conform(other)) {
@@ -218,7 +228,6 @@ IPosition& IPosition::operator= (const IPosition& other)
 	data_p[i] = other.data_p[i];
     }
     DebugAssert(ok(), AipsError);
-    return *this;
 }
 
 IPosition& IPosition::operator= (ssize_t value)
@@ -139,8 +139,15 @@ public:
 	       ssize_t val9=MIN_INT);
 
     // Makes a copy (copy, NOT reference, semantics) of other.
+    // It is inlined and does not allocate for up to 4 elements.
     IPosition(const IPosition& other);
-    
+
+#ifdef AIPS_CXX11
+    // Move constructor. A heap buffer of other is taken over; other
+    // becomes a 0-length IPosition.
+    IPosition(IPosition&& other);
+#endif
+
     ~IPosition();
 
     // Makes this a copy of other. "this" and "other" must either be conformant
@@ -148,6 +155,12 @@ public:
     // resize itself to be the same length as other.
     IPosition& operator=(const IPosition& other);
 
+#ifdef AIPS_CXX11
+    // Move assignment with the same conformance rules as copy assignment.
+    // A heap buffer of other is taken over if possible.
+    IPosition& operator=(IPosition&& other);
+#endif
+
     // Copy "value" into every position of this IPosition.
     IPosition& operator=(ssize_t value);
 
@@ -407,6 +420,10 @@ private:
     // Throw an index error exception.
     void throwIndexError() const;
 
+    // Assign from an IPosition with a different length, which is only
+    // possible if this IPosition has length 0.
+    void copyOther (const IPosition& other);
+
     enum { BufferLength = 4 };
     uInt size_p;
     ssize_t buffer_p[BufferLength];
@@ -524,6 +541,48 @@ inline IPosition::IPosition()
   data_p (buffer_p)
 {}
 
+inline IPosition::IPosition (uInt length)
+: size_p (length),
+  data_p (buffer_p)
+{
+    if (length > BufferLength) {
+	allocateBuffer();
+    }
+}
+
+inline IPosition::IPosition (const IPosition& other)
+: size_p (other.size_p),
+  data_p (buffer_p)
+{
+    if (size_p > BufferLength) {
+	allocateBuffer();
+    }
+    for (uInt i=0; i<size_p; i++) {
+	data_p[i] = other.data_p[i];
+    }
+}
+
+inline IPosition::~IPosition()
+{
+    if (data_p != &buffer_p[0]) {
+        delete [] data_p;
+    }
+}
+
+inline IPosition& IPosition::operator= (const IPosition& other)
+{
+    if (&other != this) {
+	if (size_p != other.size_p) {
+	    copyOther (other);
+	} else {
+	    for (uInt i=0; i<size_p; i++) {
+		data_p[i] = other.data_p[i];
+	    }
+	}
+    }
+    return *this;
+}
+
 inline IPosition IPosition::makeAxisPath (uInt nrdim)
 {
     return makeAxisPath (nrdim, IPosition());
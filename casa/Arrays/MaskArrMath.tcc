@@ -28,6 +28,7 @@
 #include <casa/Arrays/ArrayLogical.h>
 #include <casa/Arrays/MaskArrMath.h>
 #include <casa/BasicMath/Math.h>
+#include <casa/BasicMath/Functors.h>
 #include <casa/Arrays/Array.h>
 #include <casa/Arrays/ArrayError.h>
 #include <casa/Arrays/ArrayIter.h>
@@ -39,7 +40,12 @@
 namespace casa { //# NAMESPACE CASA - BEGIN
 
 
-#define MARRM_IOP_MA(IOP,STRIOP) \
+// The masked in-place operators select the result instead of branching on
+// the mask, so the loops can be vectorized. Masked-off elements use a
+// neutral right operand (0 or 1), so they never trap (e.g. an integer
+// division by zero) and keep their value.
+
+#define MARRM_IOP_MA(IOP,STRIOP,NEUTRAL) \
 template<class T> \
 const MaskedArray<T> & operator IOP (const MaskedArray<T> &left, \
                                     const Array<T> &right) \
@@ -63,14 +69,11 @@ const MaskedArray<T> & operator IOP (const MaskedArray<T> &left, \
     const T *rightStorage = right.getStorage(rightDelete); \
     const T *rightS = rightStorage; \
 \
-    uInt ntotal = left.nelements(); \
-    while (ntotal--) { \
-        if (*leftmaskS) { \
-	    *leftarrS IOP *rightS; \
-        } \
-        leftarrS++; \
-        leftmaskS++; \
-        rightS++; \
+    size_t ntotal = left.nelements(); \
+    for (size_t i=0; i<ntotal; ++i) { \
+        T tmp = leftarrS[i]; \
+        tmp IOP (leftmaskS[i]  ?  rightS[i] : NEUTRAL); \
+        leftarrS[i] = (leftmaskS[i]  ?  tmp : leftarrS[i]); \
     } \
 \
     left.putArrayStorage(leftarrStorage, leftarrDelete); \
@@ -81,7 +84,7 @@ const MaskedArray<T> & operator IOP (const MaskedArray<T> &left, \
 }
 
 
-#define MARRM_IOP_AM(IOP,STRIOP) \
+#define MARRM_IOP_AM(IOP,STRIOP,NEUTRAL) \
 template<class T> \
 Array<T> & operator IOP (Array<T> &left, const MaskedArray<T> &right) \
 { \
@@ -104,14 +107,11 @@ Array<T> & operator IOP (Array<T> &left, const MaskedArray<T> &right) \
         right.getMaskStorage(rightmaskDelete); \
     const LogicalArrayElem *rightmaskS = rightmaskStorage; \
 \
-    uInt ntotal = left.nelements(); \
-    while (ntotal--) { \
-        if (*rightmaskS) { \
-	    *leftS IOP *rightarrS; \
-        } \
-        leftS++; \
-        rightarrS++; \
-        rightmaskS++; \
+    size_t ntotal = left.nelements(); \
+    for (size_t i=0; i<ntotal; ++i) { \
+        T tmp = leftS[i]; \
+        tmp IOP (rightmaskS[i]  ?  rightarrS[i] : NEUTRAL); \
+        leftS[i] = (rightmaskS[i]  ?  tmp : leftS[i]); \
     } \
 \
     left.putStorage(leftStorage, leftDelete); \
@@ -122,7 +122,7 @@ Array<T> & operator IOP (Array<T> &left, const MaskedArray<T> &right) \
 }
 
 
-#define MARRM_IOP_MM(IOP,STRIOP) \
+#define MARRM_IOP_MM(IOP,STRIOP,NEUTRAL) \
 template<class T> \
 const MaskedArray<T> & operator IOP (const MaskedArray<T> &left, \
                                      const MaskedArray<T> &right) \
@@ -151,15 +151,12 @@ const MaskedArray<T> & operator IOP (const MaskedArray<T> &left, \
         = right.getMaskStorage(rightmaskDelete); \
     const LogicalArrayElem *rightmaskS = rightmaskStorage; \
 \
-    uInt ntotal = left.nelements(); \
-    while (ntotal--) { \
-        if (*leftmaskS && *rightmaskS) { \
-	    *leftarrS IOP *rightarrS; \
-        } \
-        leftarrS++; \
-        leftmaskS++; \
-        rightarrS++; \
-        rightmaskS++; \
+    size_t ntotal = left.nelements(); \
+    for (size_t i=0; i<ntotal; ++i) { \
+        Bool valid = leftmaskS[i]  &&  rightmaskS[i]; \
+        T tmp = leftarrS[i]; \
+        tmp IOP (valid  ?  rightarrS[i] : NEUTRAL); \
+        leftarrS[i] = (valid  ?  tmp : leftarrS[i]); \
     } \
 \
     left.putArrayStorage(leftarrStorage, leftarrDelete); \
@@ -170,7 +167,7 @@ const MaskedArray<T> & operator IOP (const MaskedArray<T> &left, \
     return left; \
 }
 
-#define MARRM_IOP_MM2(IOP,STRIOP) \
+#define MARRM_IOP_MM2(IOP,STRIOP,NEUTRAL) \
 template<class T,class S> \
 const MaskedArray<T> & operator IOP (const MaskedArray<T> &left, \
                                      const MaskedArray<S> &right) \
@@ -199,15 +196,12 @@ const MaskedArray<T> & operator IOP (const MaskedArray<T> &left, \
         = right.getMaskStorage(rightmaskDelete); \
     const LogicalArrayElem *rightmaskS = rightmaskStorage; \
 \
-    uInt ntotal = left.nelements(); \
-    while (ntotal--) { \
-        if (*leftmaskS && *rightmaskS) { \
-	    *leftarrS IOP *rightarrS; \
-        } \
-        leftarrS++; \
-        leftmaskS++; \
-        rightarrS++; \
-        rightmaskS++; \
+    size_t ntotal = left.nelements(); \
+    for (size_t i=0; i<ntotal; ++i) { \
+        Bool valid = leftmaskS[i]  &&  rightmaskS[i]; \
+        T tmp = leftarrS[i]; \
+        tmp IOP (valid  ?  rightarrS[i] : NEUTRAL); \
+        leftarrS[i] = (valid  ?  tmp : leftarrS[i]); \
     } \
 \
     left.putArrayStorage(leftarrStorage, leftarrDelete); \
@@ -219,7 +213,7 @@ const MaskedArray<T> & operator IOP (const MaskedArray<T> &left, \
 }
 
 
-#define MARRM_IOP_MS(IOP) \
+#define MARRM_IOP_MS(IOP,NEUTRAL) \
 template<class T> \
 const MaskedArray<T> & operator IOP (const MaskedArray<T> &left, \
                                      const T &right) \
@@ -233,13 +227,11 @@ const MaskedArray<T> & operator IOP (const MaskedArray<T> &left, \
         = left.getMaskStorage(leftmaskDelete); \
     const LogicalArrayElem *leftmaskS = leftmaskStorage; \
 \
-    uInt ntotal = left.nelements(); \
-    while (ntotal--) { \
-        if (*leftmaskS) { \
-	    *leftarrS IOP right; \
-        } \
-        leftarrS++; \
-        leftmaskS++; \
+    size_t ntotal = left.nelements(); \
+    for (size_t i=0; i<ntotal; ++i) { \
+        T tmp = leftarrS[i]; \
+        tmp IOP (leftmaskS[i]  ?  right : NEUTRAL); \
+        leftarrS[i] = (leftmaskS[i]  ?  tmp : leftarrS[i]); \
     } \
 \
     left.putArrayStorage(leftarrStorage, leftarrDelete); \
@@ -249,26 +241,26 @@ const MaskedArray<T> & operator IOP (const MaskedArray<T> &left, \
 }
 
 
-MARRM_IOP_MA ( += , "+=" )
-MARRM_IOP_MA ( -= , "-=" )
-MARRM_IOP_MA ( *= , "*=" )
-MARRM_IOP_MA ( /= , "/=" )
+MARRM_IOP_MA ( += , "+=" , T() )
+MARRM_IOP_MA ( -= , "-=" , T() )
+MARRM_IOP_MA ( *= , "*=" , T(1) )
+MARRM_IOP_MA ( /= , "/=" , T(1) )
 
-MARRM_IOP_AM ( += , "+=" )
-MARRM_IOP_AM ( -= , "-=" )
-MARRM_IOP_AM ( *= , "*=" )
-MARRM_IOP_AM ( /= , "/=" )
+MARRM_IOP_AM ( += , "+=" , T() )
+MARRM_IOP_AM ( -= , "-=" , T() )
+MARRM_IOP_AM ( *= , "*=" , T(1) )
+MARRM_IOP_AM ( /= , "/=" , T(1) )
 
-MARRM_IOP_MM ( += , "+=" )
-MARRM_IOP_MM ( -= , "-=" )
-MARRM_IOP_MM ( *= , "*=" )
-MARRM_IOP_MM ( /= , "/=" )
-MARRM_IOP_MM2 ( /= , "/=" )
+MARRM_IOP_MM ( += , "+=" , T() )
+MARRM_IOP_MM ( -= , "-=" , T() )
+MARRM_IOP_MM ( *= , "*=" , T(1) )
+MARRM_IOP_MM ( /= , "/=" , T(1) )
+MARRM_IOP_MM2 ( /= , "/=" , S(1) )
 
-MARRM_IOP_MS ( += )
-MARRM_IOP_MS ( -= )
-MARRM_IOP_MS ( *= )
-MARRM_IOP_MS ( /= )
+MARRM_IOP_MS ( += , T() )
+MARRM_IOP_MS ( -= , T() )
+MARRM_IOP_MS ( *= , T(1) )
+MARRM_IOP_MS ( /= , T(1) )
 
 
 template<class T> MaskedArray<T> operator+ (const MaskedArray<T> &left)
@@ -290,13 +282,9 @@ template<class T> MaskedArray<T> operator- (const MaskedArray<T> &left)
         = result.getMaskStorage(resultmaskDelete);
     const LogicalArrayElem *resultmaskS = resultmaskStorage;
 
-    uInt ntotal = result.nelements();
-    while (ntotal--) {
-        if (*resultmaskS) {
-	    *resultarrS = -(*resultarrS);
-        }
-        resultarrS++;
-        resultmaskS++;
+    size_t ntotal = result.nelements();
+    for (size_t i=0; i<ntotal; ++i) {
+        resultarrS[i] = (resultmaskS[i]  ?  -resultarrS[i] : resultarrS[i]);
     }
 
     result.putArrayStorage(resultarrStorage, resultarrDelete);
@@ -911,30 +899,14 @@ void minMax(T &minVal, T &maxVal, IPosition &minPos, IPosition &maxPos,
         = marray.getMaskStorage(marraymaskDelete);
     const LogicalArrayElem *marraymaskS = marraymaskStorage;
 
-    uInt ntotal = marray.nelements();
-    Bool foundOne = False;
-    T minLocal = T();
-    T maxLocal = T();
-    uInt minNtotal=0;
-    uInt maxNtotal=0;
-
-    while (ntotal--) {
-        if (*marraymaskS) {
-            minLocal = *marrayarrS;
-            maxLocal = minLocal;
-            minNtotal = ntotal + 1;
-            maxNtotal = minNtotal;
-            marrayarrS++;
-            marraymaskS++;
-            foundOne = True;
-            break;
-        } else {
-            marrayarrS++;
-            marraymaskS++;
-        }
+    // Find the first valid element.
+    size_t ntotal = marray.nelements();
+    size_t first = 0;
+    while (first < ntotal  &&  !marraymaskS[first]) {
+        ++first;
     }
 
-    if (!foundOne) {
+    if (first == ntotal) {
         marray.freeArrayStorage(marrayarrStorage, marrayarrDelete);
         marray.freeMaskStorage(marraymaskStorage, marraymaskDelete);
 
@@ -945,19 +917,18 @@ void minMax(T &minVal, T &maxVal, IPosition &minPos, IPosition &maxPos,
                          " - MaskedArray must have at least 1 element"));
     }
 
-    while (ntotal--) {
-        if (*marraymaskS) {
-            if (*marrayarrS < minLocal) { \
-                minLocal = *marrayarrS;
-                minNtotal = ntotal + 1;
-            }
-            if (*marrayarrS > maxLocal) { \
-                maxLocal = *marrayarrS;
-                maxNtotal = ntotal + 1;
-            }
-        }
-        marrayarrS++;
-        marraymaskS++;
+    // Select the new extremes instead of branching on the mask.
+    T minLocal = marrayarrS[first];
+    T maxLocal = minLocal;
+    size_t minInx = first;
+    size_t maxInx = first;
+    for (size_t i=first+1; i<ntotal; ++i) {
+        Bool isMin = marraymaskS[i]  &&  marrayarrS[i] < minLocal;
+        Bool isMax = marraymaskS[i]  &&  marrayarrS[i] > maxLocal;
+        minLocal = (isMin  ?  marrayarrS[i] : minLocal);
+        minInx   = (isMin  ?  i : minInx);
+        maxLocal = (isMax  ?  marrayarrS[i] : maxLocal);
+        maxInx   = (isMax  ?  i : maxInx);
     }
 
     marray.freeArrayStorage(marrayarrStorage, marrayarrDelete);
@@ -966,10 +937,8 @@ void minMax(T &minVal, T &maxVal, IPosition &minPos, IPosition &maxPos,
     minVal = minLocal;
     maxVal = maxLocal;
 
-    minPos = toIPositionInArray (marray.nelements() - minNtotal,
-				 marray.shape());
-    maxPos = toIPositionInArray (marray.nelements() - maxNtotal,
-				 marray.shape());
+    minPos = toIPositionInArray (minInx, marray.shape());
+    maxPos = toIPositionInArray (maxInx, marray.shape());
 
     return;
 }
@@ -1000,24 +969,13 @@ template<class T> T FUNC (const MaskedArray<T> &left) \
         = left.getMaskStorage(leftmaskDelete); \
     const LogicalArrayElem *leftmaskS = leftmaskStorage; \
 \
-    T result = *leftarrS; \
-    uInt ntotal = left.nelements(); \
-    Bool foundOne = False; \
-\
-    while (ntotal--) { \
-        if (*leftmaskS) { \
-            result = *leftarrS; \
-            leftarrS++; \
-            leftmaskS++; \
-            foundOne = True; \
-            break; \
-        } else { \
-            leftarrS++; \
-            leftmaskS++; \
-        } \
+    size_t ntotal = left.nelements(); \
+    size_t first = 0; \
+    while (first < ntotal  &&  !leftmaskS[first]) { \
+        ++first; \
     } \
 \
-    if (!foundOne) { \
+    if (first == ntotal) { \
         left.freeArrayStorage(leftarrStorage, leftarrDelete); \
         left.freeMaskStorage(leftmaskStorage, leftmaskDelete); \
 \
@@ -1025,14 +983,10 @@ template<class T> T FUNC (const MaskedArray<T> &left) \
                          "MaskedArray must have at least 1 element")); \
     } \
 \
-    while (ntotal--) { \
-        if (*leftmaskS) { \
-            if (*leftarrS OP result) { \
-                result = *leftarrS; \
-            } \
-        } \
-        leftarrS++; \
-        leftmaskS++; \
+    T result = leftarrS[first]; \
+    for (size_t i=first+1; i<ntotal; ++i) { \
+        result = (leftmaskS[i]  &&  leftarrS[i] OP result) \
+                 ?  leftarrS[i] : result; \
     } \
 \
     left.freeArrayStorage(leftarrStorage, leftarrDelete); \
@@ -1068,16 +1022,10 @@ MaskedArray<T> FUNC (const MaskedArray<T> &left, const Array<T> &right) \
     const T *rightStorage = right.getStorage(rightDelete); \
     const T *rightS = rightStorage; \
 \
-    uInt ntotal = result.nelements(); \
-    while (ntotal--) { \
-        if (*resultmaskS) { \
-            if (*rightS OP *resultarrS) { \
-                *resultarrS = *rightS; \
-            } \
-        } \
-        resultarrS++; \
-        resultmaskS++; \
-        rightS++; \
+    size_t ntotal = result.nelements(); \
+    for (size_t i=0; i<ntotal; ++i) { \
+        resultarrS[i] = (resultmaskS[i]  &&  rightS[i] OP resultarrS[i]) \
+                        ?  rightS[i] : resultarrS[i]; \
     } \
 \
     result.putArrayStorage(resultarrStorage, resultarrDelete); \
@@ -1114,16 +1062,10 @@ MaskedArray<T> FUNC (const Array<T> &left, const MaskedArray<T> &right) \
     const T *rightarrStorage = right.getArrayStorage(rightarrDelete); \
     const T *rightarrS = rightarrStorage; \
 \
-    uInt ntotal = result.nelements(); \
-    while (ntotal--) { \
-        if (*resultmaskS) { \
-            if (*rightarrS OP *resultarrS) { \
-                *resultarrS = *rightarrS; \
-            } \
-        } \
-        resultarrS++; \
-        resultmaskS++; \
-        rightarrS++; \
+    size_t ntotal = result.nelements(); \
+    for (size_t i=0; i<ntotal; ++i) { \
+        resultarrS[i] = (resultmaskS[i]  &&  rightarrS[i] OP resultarrS[i]) \
+                        ?  rightarrS[i] : resultarrS[i]; \
     } \
 \
     result.putArrayStorage(resultarrStorage, resultarrDelete); \
@@ -1162,16 +1104,10 @@ MaskedArray<T> FUNC (const MaskedArray<T> &left, \
     const T *rightarrStorage = right.getArrayStorage(rightarrDelete); \
     const T *rightarrS = rightarrStorage; \
 \
-    uInt ntotal = result.nelements(); \
-    while (ntotal--) { \
-        if (*resultmaskS) { \
-            if (*rightarrS OP *resultarrS) { \
-                *resultarrS = *rightarrS; \
-            } \
-        } \
-        resultarrS++; \
-        resultmaskS++; \
-        rightarrS++; \
+    size_t ntotal = result.nelements(); \
+    for (size_t i=0; i<ntotal; ++i) { \
+        resultarrS[i] = (resultmaskS[i]  &&  rightarrS[i] OP resultarrS[i]) \
+                        ?  rightarrS[i] : resultarrS[i]; \
     } \
 \
     result.putArrayStorage(resultarrStorage, resultarrDelete); \
@@ -1197,15 +1133,10 @@ MaskedArray<T> FUNC (const MaskedArray<T> &left, const T &right) \
         = result.getMaskStorage(resultmaskDelete); \
     const LogicalArrayElem *resultmaskS = resultmaskStorage; \
 \
-    uInt ntotal = result.nelements(); \
-    while (ntotal--) { \
-        if (*resultmaskS) { \
-            if (right OP *resultarrS) { \
-                *resultarrS = right; \
-            } \
-        } \
-        resultarrS++; \
-        resultmaskS++; \
+    size_t ntotal = result.nelements(); \
+    for (size_t i=0; i<ntotal; ++i) { \
+        resultarrS[i] = (resultmaskS[i]  &&  right OP resultarrS[i]) \
+                        ?  right : resultarrS[i]; \
     } \
 \
     result.putArrayStorage(resultarrStorage, resultarrDelete); \
@@ -1237,16 +1168,10 @@ MaskedArray<T> FUNC (const T &left, const MaskedArray<T> &right) \
     const T *rightarrStorage = right.getArrayStorage(rightarrDelete); \
     const T *rightarrS = rightarrStorage; \
 \
-    uInt ntotal = result.nelements(); \
-    while (ntotal--) { \
-        if (*resultmaskS) { \
-            if (*rightarrS OP *resultarrS) { \
-                *resultarrS = *rightarrS; \
-            } \
-        } \
-        resultarrS++; \
-        resultmaskS++; \
-        rightarrS++; \
+    size_t ntotal = result.nelements(); \
+    for (size_t i=0; i<ntotal; ++i) { \
+        resultarrS[i] = (resultmaskS[i]  &&  rightarrS[i] OP resultarrS[i]) \
+                        ?  rightarrS[i] : resultarrS[i]; \
     } \
 \
     result.putArrayStorage(resultarrStorage, resultarrDelete); \
@@ -1286,15 +1211,10 @@ void FUNC (const MaskedArray<T> &result, \
     const T *rightarrStorage = right.getStorage(rightarrDelete); \
     const T *rightarrS = rightarrStorage; \
 \
-    uInt ntotal = result.nelements(); \
-    while (ntotal--) { \
-        if (*resultmaskS) { \
-            *resultarrS = (*leftarrS OP *rightarrS) ? *leftarrS : *rightarrS; \
-        } \
-        resultarrS++; \
-        resultmaskS++; \
-        leftarrS++; \
-        rightarrS++; \
+    size_t ntotal = result.nelements(); \
+    for (size_t i=0; i<ntotal; ++i) { \
+        T val = (leftarrS[i] OP rightarrS[i])  ?  leftarrS[i] : rightarrS[i]; \
+        resultarrS[i] = (resultmaskS[i]  ?  val : resultarrS[i]); \
     } \
 \
     result.putArrayStorage(resultarrStorage, resultarrDelete); \
@@ -1328,13 +1248,12 @@ MARRM_MINORMAX_AAM ( min, < , "min" )
 MARRM_MINORMAX_AAM ( max, > , "max" )
 
 
-template<class T> T sum(const MaskedArray<T> &left)
+// Accumulate the values with a True mask using the accumulation functor.
+// The mask is applied as a selection instead of a branch and four
+// interleaved partial results are used, so the compiler can vectorize.
+template<typename T, typename AccumOp>
+T maskedAccumulate (const MaskedArray<T> &left, AccumOp op)
 {
-    if (left.nelementsValid() < 1) {
-        throw (ArrayError("T ::sum(const MaskedArray<T> &left) - "
-                         "MaskedArray must have at least 1 element"));
-    }
-
     Bool leftarrDelete;
     const T *leftarrStorage = left.getArrayStorage(leftarrDelete);
     const T *leftarrS = leftarrStorage;
@@ -1344,52 +1263,44 @@ template<class T> T sum(const MaskedArray<T> &left)
         = left.getMaskStorage(leftmaskDelete);
     const LogicalArrayElem *leftmaskS = leftmaskStorage;
 
-    T sum = 0;
-    uInt ntotal = left.nelements();
-    while (ntotal--) {
-        if (*leftmaskS) {
-            sum += *leftarrS;
-        }
-        leftarrS++;
-        leftmaskS++;
+    T s0 = T();
+    T s1 = T();
+    T s2 = T();
+    T s3 = T();
+    size_t ntotal = left.nelements();
+    size_t i = 0;
+    for (; i+4<=ntotal; i+=4) {
+        s0 = (leftmaskS[i]   ?  op(s0, leftarrS[i])   : s0);
+        s1 = (leftmaskS[i+1] ?  op(s1, leftarrS[i+1]) : s1);
+        s2 = (leftmaskS[i+2] ?  op(s2, leftarrS[i+2]) : s2);
+        s3 = (leftmaskS[i+3] ?  op(s3, leftarrS[i+3]) : s3);
+    }
+    for (; i<ntotal; ++i) {
+        s0 = (leftmaskS[i]  ?  op(s0, leftarrS[i]) : s0);
     }
 
     left.freeArrayStorage(leftarrStorage, leftarrDelete);
     left.freeMaskStorage(leftmaskStorage, leftmaskDelete);
 
-    return sum;
+    return (s0 + s1) + (s2 + s3);
 }
 
-template<class T> T sumsquares(const MaskedArray<T> &left)
+template<class T> T sum(const MaskedArray<T> &left)
 {
     if (left.nelementsValid() < 1) {
-        throw (ArrayError("T ::sumsquares(const MaskedArray<T> &left) - "
+        throw (ArrayError("T ::sum(const MaskedArray<T> &left) - "
                          "MaskedArray must have at least 1 element"));
     }
+    return maskedAccumulate (left, std::plus<T>());
+}
 
-    Bool leftarrDelete;
-    const T *leftarrStorage = left.getArrayStorage(leftarrDelete);
-    const T *leftarrS = leftarrStorage;
-
-    Bool leftmaskDelete;
-    const LogicalArrayElem *leftmaskStorage
-        = left.getMaskStorage(leftmaskDelete);
-    const LogicalArrayElem *leftmaskS = leftmaskStorage;
-
-    T sumsquares = 0;
-    uInt ntotal = left.nelements();
-    while (ntotal--) {
-        if (*leftmaskS) {
-            sumsquares += (*leftarrS * *leftarrS);
-        }
-        leftarrS++;
-        leftmaskS++;
+template<class T> T sumsquares(const MaskedArray<T> &left)
+{
+    if (left.nelementsValid() < 1) {
+        throw (ArrayError("T ::sumsquares(const MaskedArray<T> &left) - "
+                         "MaskedArray must have at least 1 element"));
     }
-
-    left.freeArrayStorage(leftarrStorage, leftarrDelete);
-    left.freeMaskStorage(leftmaskStorage, leftmaskDelete);
-
-    return sumsquares;
+    return maskedAccumulate (left, casa::SumSqr<T>());
 }
 
 template<class T> T product(const MaskedArray<T> &left)
@@ -1426,11 +1337,12 @@ template<class T> T product(const MaskedArray<T> &left)
 
 template<class T> T mean(const MaskedArray<T> &left)
 {
-    if (left.nelementsValid() < 1) {
+    size_t nvalid = left.nelementsValid();
+    if (nvalid < 1) {
         throw (ArrayError("T ::mean(const MaskedArray<T> &left) - "
                           "MaskedArray must have at least 1 element"));
     }
-    return sum(left)/left.nelementsValid();
+    return maskedAccumulate (left, std::plus<T>()) / nvalid;
 }
 
 template<class T> T variance(const MaskedArray<T> &left, T mean)
@@ -1439,9 +1351,9 @@ template<class T> T variance(const MaskedArray<T> &left, T mean)
         throw (ArrayError("T ::variance(const MaskedArray<T> &, T) - "
                           "MaskedArray must have at least 2 elements"));
     }
-    MaskedArray<T> deviations (left - mean);
-    deviations *= deviations;
-    return sum(deviations)/(left.nelementsValid() - 1);
+    // Accumulate directly instead of creating temporary masked arrays.
+    return maskedAccumulate (left, casa::SumSqrDiff<T>(mean)) /
+           (left.nelementsValid() - 1);
 }
 
 template<class T> T variance(const MaskedArray<T> &left)
@@ -1470,8 +1382,8 @@ template<class T> T avdev(const MaskedArray<T> &left, T mean)
         throw (ArrayError("T ::avdev(const MaskedArray<T> &, T) - "
                           "MaskedArray must have at least 1 element"));
     }
-    MaskedArray<T> avdeviations (abs(left - mean));
-    return sum(avdeviations)/left.nelementsValid();
+    return maskedAccumulate (left, casa::SumAbsDiff<T>(mean)) /
+           left.nelementsValid();
 }
 
 template<class T> T rms(const MaskedArray<T> &left)
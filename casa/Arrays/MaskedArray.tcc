@@ -422,13 +422,11 @@ template<class T> uInt MaskedArray<T>::nelementsValid() const
         const LogicalArrayElem *maskStorage = getMaskStorage(maskDelete);
         const LogicalArrayElem *maskS = maskStorage;
 
+        // Count without branches, so the compiler can vectorize.
         uInt nelemValidTmp = 0;
         uInt ntotal = nelements();
-        while (ntotal--) {
-            if (*maskS) {
-                nelemValidTmp++;
-            }
-            maskS++;
+        for (uInt i=0; i<ntotal; ++i) {
+            nelemValidTmp += (maskS[i] ? 1 : 0);
         }
 
         freeMaskStorage(maskStorage, maskDelete);
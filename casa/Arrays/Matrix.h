@@ -153,6 +153,11 @@ public:
     // non-conforming matrix.
     // <group>
     Matrix<T> &operator=(const Matrix<T> &other);
+#ifdef AIPS_CXX11
+    // Move assignment. The storage of other is taken over if possible
+    // (see the move assignment of class Array).
+    Matrix<T> &operator=(Matrix<T> &&other);
+#endif
     virtual Array<T> &operator=(const Array<T> &other);
     // </group>
 
@@ -159,6 +159,17 @@ template<class T> Matrix<T> &Matrix<T>::operator=(const Matrix<T> &other)
     return *this;
 }
 
+#ifdef AIPS_CXX11
+template<class T> Matrix<T> &Matrix<T>::operator=(Matrix<T> &&other)
+{
+    DebugAssert(ok(), ArrayError);
+    if (this != &other  &&  !this->moveUnique (other)) {
+        operator= (static_cast<const Matrix<T>&>(other));
+    }
+    return *this;
+}
+#endif
+
 template<class T> Array<T> &Matrix<T>::operator=(const Array<T> &a)
 {
     DebugAssert(ok(), ArrayError);
@@ -221,8 +221,8 @@ IPosition Slicer::inferShapeFromSource (const IPosition& shp,
 					IPosition& end,
 					IPosition& stride) const
 {
-    IPosition origin(shp.nelements(), 0);
-    return inferShapeFromSource (shp, origin, start, end, stride);
+    //# No need to create an origin of all zeroes.
+    return doInferShape (shp, 0, start, end, stride);
 }
 
 IPosition Slicer::inferShapeFromSource (const IPosition& shp,
@@ -231,58 +231,72 @@ IPosition Slicer::inferShapeFromSource (const IPosition& shp,
 					IPosition& end,
 					IPosition& stride) const
 {
-    //# Check if length of shape and origin conform the Slicer.
-    if (shp.nelements() != start_p.nelements()
-    ||  ori.nelements() != start_p.nelements()) {
+    if (ori.nelements() != start_p.nelements()) {
 	throw (ArraySlicerError
 	               ("Shape/Origin IPosition-lengths differ from ndim()"));
     }
-    //# Resize the output IPositions.
-    //# Initialize them, so they will do for unspecified values.
-    start.resize (start_p.nelements());
-    end.resize (start_p.nelements());
-    stride.resize (start_p.nelements());
-    start  = 0;
-    end    = shp - 1;
-    stride = stride_p;
-    IPosition res(start_p.nelements(), 0);
-    for (uInt i=0; i<start_p.nelements(); i++) {
+    return doInferShape (shp, ori.storage(), start, end, stride);
+}
+
+IPosition Slicer::doInferShape (const IPosition& shp,
+                                const ssize_t* ori,
+                                IPosition& start,
+                                IPosition& end,
+                                IPosition& stride) const
+{
+    //# Check if length of shape conforms the Slicer.
+    uInt ndim = start_p.nelements();
+    if (shp.nelements() != ndim) {
+	throw (ArraySlicerError
+	               ("Shape/Origin IPosition-lengths differ from ndim()"));
+    }
+    //# Resize the output IPositions (a no-op if the size is unchanged).
+    //# They are filled per axis, so no temporary IPositions are needed.
+    start.resize (ndim, False);
+    end.resize (ndim, False);
+    stride.resize (ndim, False);
+    IPosition res(ndim, 0);
+    for (uInt i=0; i<ndim; i++) {
+	//# Initialize for unspecified values.
+	start[i]  = 0;
+	end[i]    = shp[i] - 1;
+	stride[i] = stride_p[i];
+	ssize_t orig = (ori == 0  ?  0 : ori[i]);
 	//# Fill and check start value; unspecified means 0.
-	if (start_p(i) != MimicSource) {
-	    start(i) = start_p(i) - ori(i);
+	if (start_p[i] != MimicSource) {
+	    start[i] = start_p[i] - orig;
 	}
-	if (start(i) < 0) {
+	if (start[i] < 0) {
 	    throw (ArraySlicerError ("infer: startResult<0"));
 	}
-	if (start(i) >= shp(i)) {
+	if (start[i] >= shp[i]) {
 	    throw (ArraySlicerError ("infer: startResult>=shape"));
 	}
 	//# Fill end value.
 	//# If given as end, unspecified is end of axis.
 	//# If given as length, unspecified is also end of axis.
 	if (asEnd_p == endIsLast) {
-	    if (end_p(i) != MimicSource) {
-		end(i) = end_p(i) - ori(i);
+	    if (end_p[i] != MimicSource) {
+		end[i] = end_p[i] - orig;
 	    }
 	}else{
-	    if (len_p(i) != MimicSource) {
-		end(i) = start(i) + len_p(i) * stride_p(i) - 1;
+	    if (len_p[i] != MimicSource) {
+		end[i] = start[i] + len_p[i] * stride_p[i] - 1;
 	    }
 	}
 	//# Get resulting shape and adjust and check end value.
 	//# Length 0 is handled correctly.
-	if (end(i) < start(i)) {
-	    if (end(i) < start(i) - 1) {
+	if (end[i] < start[i]) {
+	    if (end[i] < start[i] - 1) {
 		throw (ArraySlicerError ("infer: endResult<startResult-1"));
 	    }
 	}else{
-	    res(i) = 1 + (end(i) - start(i)) / stride(i);
-	    end(i) = start(i) + (res(i) - 1) * stride(i);
+	    res[i] = 1 + (end[i] - start[i]) / stride[i];
+	    end[i] = start[i] + (res[i] - 1) * stride[i];
 	}
-	if (end(i) >= shp(i)) {
+	if (end[i] >= shp[i]) {
 	    throw (ArraySlicerError ("infer: endResult>=shape"));
 	}
-
     }
     return res;
 }
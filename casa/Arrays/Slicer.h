@@ -419,6 +419,12 @@ private:
 
     // Fill the fixed flag.
     void fillFixed();
+
+    // Do the actual work for the inferShapeFromSource functions.
+    // The origin can be a null pointer, meaning all zeroes.
+    IPosition doInferShape (const IPosition& shape, const ssize_t* origin,
+                            IPosition& startResult, IPosition& endResult,
+                            IPosition& strideResult) const;
 };
 
 
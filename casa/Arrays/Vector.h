@@ -174,6 +174,11 @@ public:
     // non-conforming vector.
     // <group>
     Vector<T> &operator=(const Vector<T> &other);
+#ifdef AIPS_CXX11
+    // Move assignment. The storage of other is taken over if possible
+    // (see the move assignment of class Array).
+    Vector<T> &operator=(Vector<T> &&other);
+#endif
     // Other must be a 1-dimensional array.
     virtual Array<T> &operator=(const Array<T> &other);
     // </group>
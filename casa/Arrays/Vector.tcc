@@ -215,6 +215,17 @@ template<class T> void Vector<T>::toBlock(Block<T> & other) const
     objcopy(other.storage(), this->begin_p, this->nels_p, 1U, this->inc_p(0));
 }
 
+#ifdef AIPS_CXX11
+template<class T> Vector<T> &Vector<T>::operator=(Vector<T> &&other)
+{
+    DebugAssert(ok(), ArrayError);
+    if (this != &other  &&  !this->moveUnique (other)) {
+        operator= (static_cast<const Vector<T>&>(other));
+    }
+    return *this;
+}
+#endif
+
 template<class T> Array<T> &Vector<T>::operator=(const Array<T> &a)
 {
     DebugAssert(ok(), ArrayError);
@@ -828,6 +828,50 @@ void testRowColDiag()
   doRowColDiag (m(IPosition(2,1,2), IPosition(2,17,12), IPosition(2,3,2)));
 }
 
+void testMoveAssign()
+{
+#ifdef AIPS_CXX11
+  cout << "Testing move assignment" << endl;
+  // Storage of a temporary is taken over.
+  Array<Int> arr1;
+  Array<Int> tmp(IPosition(2,4,5));
+  indgen (tmp);
+  const Int* ptr = tmp.data();
+  arr1 = std::move(tmp);
+  AlwaysAssertExit (arr1.data() == ptr);
+  AlwaysAssertExit (arr1.shape() == IPosition(2,4,5));
+  AlwaysAssertExit (tmp.nelements() == 0);
+  // Shared storage must be copied.
+  Array<Int> arr2;
+  Array<Int> ref(arr1);
+  arr2 = std::move(ref);
+  AlwaysAssertExit (arr2.data() != arr1.data());
+  AlwaysAssertExit (allEQ (arr2, arr1));
+  // A slice must be copied.
+  Array<Int> arr3;
+  arr3 = arr1(IPosition(2,0,0), IPosition(2,3,0));
+  AlwaysAssertExit (arr3.data() != arr1.data());
+  // A non-empty array gets the values copied.
+  Array<Int> arr4(IPosition(2,4,5), 0);
+  ptr = arr4.data();
+  arr4 = arr1.copy();
+  AlwaysAssertExit (arr4.data() == ptr);
+  AlwaysAssertExit (allEQ (arr4, arr1));
+  // The derived classes keep their dimensionality.
+  Vector<Int> vec1;
+  vec1 = Vector<Int>(10, 3);
+  AlwaysAssertExit (vec1.nelements() == 10  &&  allEQ (vec1, 3));
+  Matrix<Int> mat1;
+  mat1 = Matrix<Int>(arr1.copy());
+  AlwaysAssertExit (mat1.nrow() == 4  &&  mat1.ncolumn() == 5);
+  AlwaysAssertExit (mat1(3,4) == arr1(IPosition(2,3,4)));
+  Vector<Int> vec2;
+  Array<Int>& vref = vec2;
+  vref = Array<Int>(IPosition(2,1,6), 2);
+  AlwaysAssertExit (vec2.ndim() == 1  &&  vec2.nelements() == 6);
+#endif
+}
+
 
 int main()
 {
@@ -1032,6 +1076,7 @@ int main()
 	testResizeCopy();
         // Test getting row, column, diagonal
         testRowColDiag();
+        testMoveAssign();
         {
         	// tovector tests
         	Vector<Int> x(3);
@@ -427,6 +427,39 @@ TestBinary(+, testPlusInt, Int, Int)
 TestBinary(-, testMinusInt, Int, Int)
 TestBinary(*, testTimesInt, Int, Int)
 TestBinary(/, testDivideInt, Int, Int)
+void testLargeReduce()
+{
+  // Use more elements than a block, so multiple blocks are combined.
+  Array<Int> a(IPosition(2,1000,301));
+  Array<Double> b(a.shape());
+  Int* ap = a.data();
+  Double* bp = b.data();
+  Int64 res = 0;
+  for (uInt i=0; i<a.size(); ++i) {
+    ap[i] = (i%1000) - 400;
+    bp[i] = 1 + 1e-9*i;
+    res += ap[i];
+  }
+  AlwaysAssertExit (sum(a) == res);
+  Double s = 0;
+  for (uInt i=0; i<b.size(); ++i) {
+    s += bp[i];
+  }
+  AlwaysAssertExit (near(sum(b), s, 1e-12));
+  ap[123456] = -500;
+  ap[234567] = 1000;
+  Int minval, maxval;
+  minMax (minval, maxval, a);
+  AlwaysAssertExit (minval == -500  &&  maxval == 1000);
+  // Median of an even number of elements taking the mean.
+  Vector<Double> v(100);
+  indgen (v, 100., -1.);
+  AlwaysAssertExit (median(v, False, True) == 50.5);
+  AlwaysAssertExit (median(v, False, False) == 50);
+  AlwaysAssertExit (fractile(v, 0.25) == 25.);
+  AlwaysAssertExit (v[0] == 100.);   // not changed by fractile
+}
+
 TestBinary(%, testModuloInt, Int, Int)
 TestBinary(|, testOrInt, Int, Int)
 TestBinary(&, testAndInt, Int, Int)
@@ -514,6 +547,7 @@ int main()
     testMinInt();
     testMaxInt();
     testMeanFloat();
+    testLargeReduce();
     testSinDouble();
     testSinhDouble();
     testCosFloat();
@@ -0,0 +1,104 @@
+//# tIPositionPerf.cc: Test performance of IPosition and Slicer handling
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//# 
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//# 
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//# 
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//# 
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casa/Arrays/IPosition.h>
+#include <casa/Arrays/Slicer.h>
+#include <casa/OS/Timer.h>
+#include <casa/Utilities/Assert.h>
+#include <casa/Exceptions/Error.h>
+#include <casa/iostream.h>
+
+#include <casa/namespace.h>
+
+// Test performance of creating, copying and using IPosition and Slicer
+// objects the way it is done when stepping through the tiles of a cube.
+
+void testTileLoop (const IPosition& shape, const IPosition& tileShape,
+                   uInt nloop)
+{
+  cout << "Tile loop over " << shape << " with tiles " << tileShape
+       << " (" << nloop << " times) ..." << endl;
+  IPosition start, end, stride;
+  Int64 nelem = 0;
+  Timer tim;
+  for (uInt i=0; i<nloop; ++i) {
+    IPosition blc(shape.size(), 0);
+    while (True) {
+      // Create the section the way an accessor does.
+      IPosition trc(blc + tileShape - 1);
+      Slicer section (blc, trc, Slicer::endIsLast);
+      IPosition len = section.inferShapeFromSource (shape, start,
+                                                    end, stride);
+      IPosition copy(len);
+      nelem += copy.product();
+      uInt ax;
+      for (ax=0; ax<shape.size(); ++ax) {
+        blc[ax] += tileShape[ax];
+        if (blc[ax] < shape[ax]) {
+          break;
+        }
+        blc[ax] = 0;
+      }
+      if (ax == shape.size()) {
+        break;
+      }
+    }
+  }
+  tim.show ("tile loop");
+  AlwaysAssertExit (nelem == nloop * shape.product());
+}
+
+void testCopy (uInt ndim, uInt nloop)
+{
+  cout << "Copy and assign " << ndim << "-dim IPosition ("
+       << nloop << " times) ..." << endl;
+  IPosition pos(ndim, 1);
+  IPosition res(ndim);
+  Timer tim;
+  for (uInt i=0; i<nloop; ++i) {
+    IPosition tmp(pos);
+    tmp[0] = i;
+    res = tmp;
+  }
+  tim.show ("copy  ");
+  AlwaysAssertExit (res[0] == Int(nloop-1));
+}
+
+int main()
+{
+  try {
+    testTileLoop (IPosition(3,512,512,64), IPosition(3,32,32,8), 1000);
+    testTileLoop (IPosition(4,512,512,4,64), IPosition(4,32,32,1,8), 250);
+    testCopy (3, 10000000);
+    testCopy (6, 10000000);
+  } catch (const AipsError& x) {
+    cout << "Caught an exception: " << x.getMesg() << endl;
+    return 1;
+  } 
+  cout << "OK" << endl;
+  return 0;               // successfully executed
+}
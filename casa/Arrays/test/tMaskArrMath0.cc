@@ -219,6 +219,28 @@ int main()
 
             }
 
+            {
+
+                // Masked-off elements are not used, so a zero divisor
+                // there must not trap and the value must be kept.
+                Vector<Int> num(10), den(10);
+                indgen (num, 10);
+                indgen (den);
+                MaskedArray<Int> m(num, (den>0));
+                m /= den;
+                AlwaysAssertExit (num(0) == 10);
+                for (Int i=1; i<10; i++) {
+                    AlwaysAssertExit (num(i) == (10+i)/i);
+                }
+                MaskedArray<Int> md(den, (den>2 && den<8));
+                AlwaysAssertExit (min(md) == 3  &&  max(md) == 7);
+                Int minVal, maxVal;
+                IPosition minPos(1), maxPos(1);
+                minMax (minVal, maxVal, minPos, maxPos, md);
+                AlwaysAssertExit (minPos(0) == 3  &&  maxPos(0) == 7);
+
+            }
+
 
             }
 
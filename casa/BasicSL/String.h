@@ -277,6 +277,15 @@ class String : public string {
   String(const SubString &str) : string(str.ref_p, str.pos_p, str.len_p) {}
   // Construct from a stream.
   String(ostringstream &os);
+#ifdef AIPS_CXX11
+  // Copy and move constructors.
+  // The move constructors take over the contents of the other string.
+  // <group>
+  String(const String& str) : string(str) {}
+  String(String&& str) : string(std::move(str)) {}
+  String(string&& str) : string(std::move(str)) {}
+  // </group>
+#endif
 
   //# Destructor
   // Destructor
@@ -293,6 +302,14 @@ class String : public string {
     return static_cast<String&>(string::operator=(s)); }
   String& operator=(Char c) {
     return static_cast<String&>(string::operator=(c)); }
+#ifdef AIPS_CXX11
+  String& operator=(const String& str) {
+    return static_cast<String&>(string::operator=(str)); }
+  String& operator=(String&& str) {
+    return static_cast<String&>(string::operator=(std::move(str))); }
+  String& operator=(string&& str) {
+    return static_cast<String&>(string::operator=(std::move(str))); }
+#endif
   // </group>
   // ** Casacore addition: synonym for at(pos, len)
   SubString operator()(size_type pos, size_type len);
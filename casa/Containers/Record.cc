@@ -112,6 +112,29 @@ Record& Record::operator= (const Record& other)
     return *this;
 }
 
+#ifdef AIPS_CXX11
+Record& Record::operator= (Record&& other)
+{
+    if (this != &other) {
+	if (! isFixed()  ||  nfields() == 0) {
+	    notify (RecordNotice (RecordNotice::DETACH, 0));
+	    // A subrecord is part of its parent, so it cannot give away
+	    // its representation.
+	    if (other.parent_p == 0) {
+		other.notify (RecordNotice (RecordNotice::DETACH, 0));
+		rep_p.swap (other.rep_p);
+	    } else {
+		rep_p = other.rep_p;
+	    }
+	}else{
+	    AlwaysAssert (conform (other), AipsError);
+	    rwRef().copyData (other.ref());
+	}
+    }
+    return *this;
+}
+#endif
+
 Record::~Record()
 {}
 
@@ -234,6 +234,15 @@ public:
     // be copied.
     // </note>
     Record& operator= (const Record& other);
+
+#ifdef AIPS_CXX11
+    // Move assignment with the same semantics as the copy assignment.
+    // For variable structured or empty records the representation of
+    // <src>other</src> is taken over by swapping it with the current one
+    // (unless <src>other</src> is a subrecord).
+    // RecordFieldPtr's using either record get invalidated.
+    Record& operator= (Record&& other);
+#endif
     
     // Release resources associated with this object.
     ~Record();
@@ -120,6 +120,13 @@ public:
     // Replace this description with other.
     RecordDesc& operator= (const RecordDesc& other);
 
+#ifdef AIPS_CXX11
+    // Replace this description with other by swapping them, so no
+    // reference counts need to be adjusted.
+    RecordDesc& operator= (RecordDesc&& other)
+      { desc_p.swap (other.desc_p); return *this; }
+#endif
+
     ~RecordDesc();
 
     // Add scalar, array, sub-record, or table field.
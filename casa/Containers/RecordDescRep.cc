@@ -45,7 +45,7 @@ RecordDescRep::RecordDescRep()
   is_array_p(0),
   tableDescNames_p(0),
   comments_p(0),
-  name_map_p(-1, 64)
+  hash_p(16, -1)
 {
     // Nothing
 }
@@ -59,7 +59,7 @@ RecordDescRep::RecordDescRep (const RecordDescRep& other)
   is_array_p(0),
   tableDescNames_p(0),
   comments_p(0),
-  name_map_p(-1, 64)
+  hash_p(16, -1)
 {
     copy_other (other);
 }
@@ -92,7 +92,11 @@ void RecordDescRep::addFieldName (const String& fieldName, DataType type)
     uInt n = n_p - 1;
     types_p[n] = type;
     names_p[n] = fieldName;
-    name_map_p.define (fieldName, n);
+    if (2*n_p > hash_p.nelements()) {
+	rehash();
+    } else {
+	addHash (n);
+    }
     sub_records_p[n] = 0;
     is_array_p[n] = False;
     shapes_p[n].resize(1);
@@ -325,15 +329,6 @@ uInt RecordDescRep::removeField (Int whichField)
 	sub_records_p[whichField] = 0;
     }
     n_p--;
-    // Remove the field from the name map.
-    // Decrement the field number of all fields following it.
-    name_map_p.remove (names_p[whichField]);
-    for (uInt i=0; i<n_p; i++) {
-	Int& inx = name_map_p.getVal (i);
-	if (inx > whichField) {
-	    inx--;
-	}
-    }
     types_p.remove (whichField);
     names_p.remove (whichField);
     sub_records_p.remove (whichField);
@@ -341,14 +336,17 @@ uInt RecordDescRep::removeField (Int whichField)
     is_array_p.remove (whichField);
     tableDescNames_p.remove (whichField);
     comments_p.remove (whichField);
+    // The field numbers of all fields following it have changed,
+    // so rebuild the name map.
+    rehash();
     return n_p;
 }
 
 void RecordDescRep::renameField (const String& newName, Int whichField)
 {
     AlwaysAssert (whichField>=0 && whichField < Int(n_p), AipsError);
-    name_map_p.rename (newName, names_p[whichField]);
     names_p[whichField] = newName;
+    rehash();
 }
 
 void RecordDescRep::setShape (const IPosition& shape, Int whichField)
@@ -360,8 +358,51 @@ void RecordDescRep::setShape (const IPosition& shape, Int whichField)
 
 Int RecordDescRep::fieldNumber (const String& fieldName) const
 {
-    const Int* inx = name_map_p.isDefined (fieldName);
-    return (inx == 0  ?  -1 : *inx);
+    // The table is never full, so the search ends at an empty slot.
+    uInt mask = hash_p.nelements() - 1;
+    uInt slot = hashName(fieldName) & mask;
+    while (True) {
+	Int inx = hash_p[slot];
+	if (inx < 0  ||  names_p[inx] == fieldName) {
+	    return inx;
+	}
+	slot = (slot + 1) & mask;
+    }
+}
+
+uInt RecordDescRep::hashName (const String& fieldName)
+{
+    // FNV-1a hash.
+    const char* ptr = fieldName.data();
+    uInt n = fieldName.size();
+    uInt hv = 2166136261u;
+    for (uInt i=0; i<n; i++) {
+	hv = (hv ^ uChar(ptr[i])) * 16777619u;
+    }
+    return hv;
+}
+
+void RecordDescRep::addHash (Int whichField)
+{
+    uInt mask = hash_p.nelements() - 1;
+    uInt slot = hashName(names_p[whichField]) & mask;
+    while (hash_p[slot] >= 0) {
+	slot = (slot + 1) & mask;
+    }
+    hash_p[slot] = whichField;
+}
+
+void RecordDescRep::rehash()
+{
+    uInt size = 16;
+    while (size < 2*n_p) {
+	size *= 2;
+    }
+    hash_p.resize (size, True, False);
+    hash_p = -1;
+    for (uInt i=0; i<n_p; i++) {
+	addHash (i);
+    }
 }
 
 String RecordDescRep::makeName (Int whichField) const
@@ -517,7 +558,7 @@ void RecordDescRep::copy_other (const RecordDescRep& other)
     n_p = other.n_p;
     types_p = other.types_p;
     names_p = other.names_p;
-    name_map_p = other.name_map_p;
+    hash_p = other.hash_p;
     shapes_p = other.shapes_p;
     is_array_p = other.is_array_p;
     tableDescNames_p = other.tableDescNames_p;
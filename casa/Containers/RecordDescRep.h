@@ -34,7 +34,6 @@
 #include <casa/aips.h>
 #include <casa/Utilities/DataType.h>
 #include <casa/Containers/Block.h>
-#include <casa/Containers/SimOrdMap.h>
 #include <casa/Arrays/IPosition.h>
 #include <casa/iosfwd.h>
 
@@ -290,8 +289,20 @@ private:
     Block<String> tableDescNames_p;
     // Comments for each field.
     Block<String> comments_p;
-    // Mapping of field name to field number.
-    SimpleOrderedMap<String,Int> name_map_p;
+    // Hash table mapping field name to field number (-1 is an empty slot).
+    // It uses open addressing with linear probing. Its size is a power of 2
+    // and at least twice the number of fields, so a lookup usually needs
+    // a single string comparison.
+    Block<Int> hash_p;
+
+    // Hash function for a field name.
+    static uInt hashName (const String& fieldName);
+
+    // Add the given field to the hash table, which must have room for it.
+    void addHash (Int whichField);
+
+    // (Re)build the hash table from the field names.
+    void rehash();
 };
 
 inline uInt RecordDescRep::nfields() const
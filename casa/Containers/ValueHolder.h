@@ -119,6 +119,19 @@ public:
   // Assignment (reference semantics).
   ValueHolder& operator= (const ValueHolder&);
 
+#ifdef AIPS_CXX11
+  // Move constructor and assignment. They take over the value without
+  // touching the reference count. After the move constructor
+  // <src>that</src> is a null object.
+  // <group>
+  ValueHolder (ValueHolder&& that)
+    : itsRep()
+    { itsRep.swap (that.itsRep); }
+  ValueHolder& operator= (ValueHolder&& that)
+    { itsRep.swap (that.itsRep); return *this; }
+  // </group>
+#endif
+
   // Is this a null object?
   Bool isNull() const
     { return itsRep.null(); }
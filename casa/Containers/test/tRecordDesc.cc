@@ -254,6 +254,31 @@ void doIt (Bool doExcp)
     g.renameField ("TpArrayString", gn);
     AlwaysAssertExit (g.fieldNumber("TpArrayString") == gn);
     AlwaysAssertExit (g.fieldNumber("newname") < 0);
+    {
+	// Many fields, so the name map has to grow several times.
+	RecordDesc many;
+	for (Int i=0; i<300; i++) {
+	    many.addField ("fld" + String::toString(i), TpInt);
+	}
+	for (Int i=0; i<300; i++) {
+	    AlwaysAssertExit (many.fieldNumber("fld" + String::toString(i))
+			      == i);
+	}
+	AlwaysAssertExit (many.fieldNumber("fld300") < 0);
+	// Removing fields renumbers the ones following.
+	many.removeField (10);
+	many.removeField (0);
+	AlwaysAssertExit (many.nfields() == 298);
+	AlwaysAssertExit (many.fieldNumber("fld0") < 0);
+	AlwaysAssertExit (many.fieldNumber("fld10") < 0);
+	AlwaysAssertExit (many.fieldNumber("fld1") == 0);
+	AlwaysAssertExit (many.fieldNumber("fld11") == 9);
+	AlwaysAssertExit (many.fieldNumber("fld299") == 297);
+	RecordDesc manyCopy(many);
+	manyCopy.addField ("fld0", TpFloat);
+	AlwaysAssertExit (manyCopy.fieldNumber("fld0") == 298);
+	AlwaysAssertExit (many.fieldNumber("fld0") < 0);
+    }
     {
 	// operator<<()
 	RecordDesc rd;
@@ -45,6 +45,26 @@ BitVector::BitVector (uInt length, Bool state)
     }
 }
 
+BitVector::BitVector (const Bool* values, uInt nvalues)
+: size_p (nvalues),
+  bits_p   ((nvalues + WORDSIZE - 1) / WORDSIZE, uInt(0))
+{
+    uInt nfull = nvalues / WORDSIZE;
+    for (uInt i=0; i<nfull; i++) {
+	const Bool* vals = values + i*WORDSIZE;
+	uInt word = 0;
+	for (uInt j=0; j<WORDSIZE; j++) {
+	    word |= uInt(vals[j] ? 1 : 0) << j;
+	}
+	bits_p[i] = word;
+    }
+    for (uInt j=nfull*WORDSIZE; j<nvalues; j++) {
+	if (values[j]) {
+	    setBit (j);
+	}
+    }
+}
+
 BitVector::BitVector (const BitVector& that)
 : size_p (that.size_p),
   bits_p   (that.bits_p)
@@ -93,6 +113,21 @@ Bool BitVector::getBit (uInt pos) const
     return result;
 }
 
+void BitVector::toBool (Bool* values) const
+{
+    uInt nfull = size_p / WORDSIZE;
+    for (uInt i=0; i<nfull; i++) {
+	const uInt word = bits_p[i];
+	Bool* vals = values + i*WORDSIZE;
+	for (uInt j=0; j<WORDSIZE; j++) {
+	    vals[j] = ((word >> j) & 1) != 0;
+	}
+    }
+    for (uInt j=nfull*WORDSIZE; j<size_p; j++) {
+	values[j] = getBit (j);
+    }
+}
+
 void BitVector::resize (uInt length, Bool state, Bool copy)
 {
     //# Do a true resize.
@@ -122,6 +122,11 @@ public:
     // and set all bits to to the specified state.
     BitVector (uInt length, Bool state);
 
+    // Create a bit vector from <src>nvalues</src> Bools (e.g. the storage
+    // of a mask or flag array). The bits are packed word by word without
+    // branches.
+    BitVector (const Bool* values, uInt nvalues);
+
     // Copy constructor (copy semantics).
     BitVector (const BitVector& that);
 
@@ -217,6 +222,10 @@ public:
     void copy (uInt thisStart, uInt length, const BitVector& that,
 	       uInt thatStart);
 
+    // Unpack the bits into the Bools pointed to by <src>values</src>,
+    // which must have room for nbits() values.
+    void toBool (Bool* values) const;
+
     // Write a representation of the bit vector (a list of
     // <em>zeros</em> and <em>ones</em> enclosed in square
     // parentheses) to ostream.
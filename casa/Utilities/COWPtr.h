@@ -210,6 +210,9 @@ public:
   // assignment operator with reference semantics
   inline COWPtr &operator=(const COWPtr<T> &other);
 
+  // swap the objects referenced by this and other (without copying them)
+  inline void swap(COWPtr<T> &other);
+
   // return a pointer to a const object.  This prevents "write" operations.
   inline const T *operator->() const;  
 
@@ -295,6 +298,14 @@ inline COWPtr<T> &COWPtr<T>::operator=(const COWPtr<T> &other)
   return *this;
 }
 
+template <class T> inline void COWPtr<T>::swap(COWPtr<T> &other)
+{
+  obj_p.swap (other.obj_p);
+  Bool tmp = const_p;
+  const_p = other.const_p;
+  other.const_p = tmp;
+}
+
 template <class T> inline void COWPtr<T>::setReadOnly (const T *obj)
 {
   set ((T*)obj, False, True);
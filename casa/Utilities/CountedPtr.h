@@ -158,6 +158,12 @@ public:
     void reset (t *val, Bool delit=True)
       { pointerRep_p = PointerRep (val, Deleter<t>(delit)); }
 
+    // Swap the pointers of this and that <src>CountedPtr</src>.
+    // It does not change the reference counts, so it is cheaper than
+    // a pair of assignments.
+    void swap (CountedPtr<t>& that)
+      { pointerRep_p.swap (that.pointerRep_p); }
+
     // The <src>CountedPtr</src> indirection operator simply
     // returns a reference to the value being protected. If the pointer
     // is un-initialized (null), an exception will be thrown. The member
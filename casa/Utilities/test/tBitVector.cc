@@ -137,6 +137,20 @@ void doIt()
     if (bv2 != (bv1^bv3)  ||  bv2[0] || !bv2[1] || !bv2[2] || bv2[3]) {
 	cout << "=^ is incorrect" << endl;
     }
+
+    // Conversion from and to Bools.
+    Bool flags[77];
+    for (uInt i=0; i<77; i++) {
+	flags[i] = (i%3 == 0  ||  i%7 == 0);
+    }
+    BitVector bv4 (flags, 77);
+    Bool flags2[77];
+    bv4.toBool (flags2);
+    for (uInt i=0; i<77; i++) {
+	if (bv4[i] != flags[i]  ||  flags2[i] != flags[i]) {
+	    cout << "Bool conversion is incorrect for bit " << i << endl;
+	}
+    }
 }
 
 
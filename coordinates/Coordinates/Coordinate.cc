@@ -38,27 +38,32 @@
 #include <casa/Exceptions/Error.h>
 #include <casa/Logging/LogIO.h>
 #include <casa/BasicMath/Math.h>
+#include <casa/BasicSL/Constants.h>
 #include <measures/Measures/MDirection.h>
 #include <casa/Quanta/Unit.h>
 #include <casa/Utilities/Assert.h>
 #include <casa/Utilities/Regex.h>
 
 #include <casa/OS/Timer.h>
+#include <casa/OS/Mutex.h>
 
-#include <casa/iomanip.h>  
+#include <casa/iomanip.h>
+#include <algorithm>  
 #include <casa/sstream.h>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
 Coordinate::Coordinate()
 : worldMin_p(0),
-  worldMax_p(0)
+  worldMax_p(0),
+  approxTol_p(0)
 {}
 
 Coordinate::Coordinate(const Coordinate& other)
 : worldMin_p(0),
   worldMax_p(0),
-  error_p(other.error_p)
+  error_p(other.error_p),
+  approxTol_p(other.approxTol_p)
 {
    worldMin_p = other.worldMin_p;
    worldMax_p = other.worldMax_p;
@@ -73,6 +78,7 @@ Coordinate& Coordinate::operator=(const Coordinate& other)
       worldMin_p = other.worldMin_p;
       worldMax_p = other.worldMax_p;
       error_p = other.error_p;
+      approxTol_p = other.approxTol_p;
    }
    return *this;
 }
@@ -169,6 +175,232 @@ Bool Coordinate::toPixelMany(Matrix<Double>& pixel,
 } 
 
 
+void Coordinate::setApproximate (Double tolerance)
+{
+    approxTol_p = (tolerance > 0  ?  tolerance : 0);
+}
+
+Bool Coordinate::useApprox (uInt nTransforms) const
+{
+// A cell needs 9 exact transformations, so it does not pay off for
+// only a few positions.
+
+    return approxTol_p > 0  &&  nTransforms >= 64  &&
+           nPixelAxes() == 2  &&  nWorldAxes() == 2;
+}
+
+
+// Functor to partition the position indices on an axis.
+struct CoordinateApproxLess
+{
+    CoordinateApproxLess (const Double* in, uInt axis, Double value)
+      : itsIn(in), itsAxis(axis), itsValue(value)
+    {}
+    Bool operator() (uInt index) const
+      { return itsIn[2*index + itsAxis] < itsValue; }
+    const Double* itsIn;
+    uInt   itsAxis;
+    Double itsValue;
+};
+
+Bool Coordinate::toManyApprox (Matrix<Double>& out, const Matrix<Double>& in,
+                               Vector<Bool>& failures, Bool toWorld) const
+{
+    AlwaysAssert(nPixelAxes()==2 && nWorldAxes()==2 && in.nrow()==2,
+                 AipsError);
+    const uInt nTransforms = in.ncolumn();
+    out.resize(2, nTransforms);
+    failures.resize(nTransforms);
+
+// The factors to convert differences in the output to pixels.
+
+    Double scale[2] = {1, 1};
+    if (toWorld) {
+       const Vector<Double> inc = increment();
+       for (uInt k=0; k<2; k++) {
+          scale[k] = (inc[k] == 0  ?  0 : 1/abs(inc[k]));
+       }
+    }
+//
+    Bool deleteIn, deleteOut, deleteFail;
+    const Double* pIn = in.getStorage(deleteIn);
+    Double* pOut = out.getStorage(deleteOut);
+    Bool* pFail = failures.getStorage(deleteFail);
+
+// Determine the bounding box of the input positions.
+// Undefined positions are transformed exactly (and fail).
+
+    std::vector<uInt> index;
+    std::vector<uInt> exact;
+    index.reserve(nTransforms);
+    Double blc[2] = {C::dbl_max, C::dbl_max};
+    Double trc[2] = {-C::dbl_max, -C::dbl_max};
+    for (uInt i=0; i<nTransforms; i++) {
+       const Double x = pIn[2*i];
+       const Double y = pIn[2*i+1];
+       if (isFinite(x) && isFinite(y)) {
+          index.push_back(i);
+          blc[0] = min(blc[0], x);
+          blc[1] = min(blc[1], y);
+          trc[0] = max(trc[0], x);
+          trc[1] = max(trc[1], y);
+       } else {
+          exact.push_back(i);
+       }
+    }
+    if (! index.empty()) {
+       approxCell(pIn, pOut, pFail, &(index[0]), index.size(),
+                  blc[0], blc[1], trc[0], trc[1], 0, scale, toWorld, exact);
+    }
+
+// Do the exact transformations.
+
+    String errorMsg;
+    uInt nError = 0;
+    Vector<Double> inTmp(2), outTmp(2);
+    for (uInt e=0; e<exact.size(); e++) {
+       const uInt i = exact[e];
+       inTmp[0] = pIn[2*i];
+       inTmp[1] = pIn[2*i+1];
+       pFail[i] = ! (toWorld  ?  this->toWorld(outTmp, inTmp) :
+                                 toPixel(outTmp, inTmp));
+       if (pFail[i]) {
+          nError++;
+          if (nError == 1) errorMsg = errorMessage();    // Save the first error message
+       } else {
+          pOut[2*i] = outTmp[0];
+          pOut[2*i+1] = outTmp[1];
+       }
+    }
+//
+    in.freeStorage(pIn, deleteIn);
+    out.putStorage(pOut, deleteOut);
+    failures.putStorage(pFail, deleteFail);
+    if (nError != 0) set_error(errorMsg); // put back the first error
+    return (nError==0);
+}
+
+void Coordinate::approxCell (const Double* in, Double* out, Bool* failures,
+                             uInt* index, uInt npos,
+                             Double x0, Double y0, Double x1, Double y1,
+                             uInt depth, const Double* scale, Bool toWorld,
+                             std::vector<uInt>& exact) const
+{
+// The first levels are always divided, so the estimated error is based
+// on a reasonable number of test points.
+
+    const uInt minDepth = 3;
+    const uInt maxDepth = 10;
+
+// Testing a cell takes 9 exact transformations, so transform a few
+// positions directly. Also do that if testing the 4 quadrants would
+// take more than half the transformations.
+
+    if (npos <= 16  ||  (depth >= minDepth  &&  npos < 72)) {
+       exact.insert(exact.end(), index, index+npos);
+       return;
+    }
+    const Bool splitX = x1 > x0;
+    const Bool splitY = y1 > y0;
+    const Bool canSplit = (splitX || splitY)  &&  depth < maxDepth;
+    const Double xm = 0.5*(x0 + x1);
+    const Double ym = 0.5*(y0 + y1);
+    if (depth >= minDepth  ||  !canSplit) {
+
+// Do the exact transformations at the corners, edge midpoints and centre.
+
+       Double val[3][3][2];
+       Vector<Double> inTmp(2), outTmp(2);
+       const Double xs[3] = {x0, xm, x1};
+       const Double ys[3] = {y0, ym, y1};
+       uInt nFail = 0;
+       for (uInt b=0; b<3; b++) {
+          for (uInt a=0; a<3; a++) {
+             inTmp[0] = xs[a];
+             inTmp[1] = ys[b];
+             if (toWorld  ?  this->toWorld(outTmp, inTmp) :
+                             toPixel(outTmp, inTmp)) {
+                val[b][a][0] = outTmp[0];
+                val[b][a][1] = outTmp[1];
+             } else {
+                nFail++;
+             }
+          }
+       }
+
+// If all failed, the cell is most likely outside the projection.
+
+       if (nFail == 9) {
+          exact.insert(exact.end(), index, index+npos);
+          return;
+       }
+
+// Compare them with the bi-linear interpolation of the corners.
+// A NaN fails the test.
+
+       Bool accept = (nFail == 0);
+       for (uInt b=0; b<3 && accept; b++) {
+          for (uInt a=0; a<3 && accept; a++) {
+             const Double t = 0.5*a;
+             const Double u = 0.5*b;
+             for (uInt k=0; k<2; k++) {
+                const Double pred = (1-t)*(1-u)*val[0][0][k] +
+                                    t*(1-u)*val[0][2][k] +
+                                    t*u*val[2][2][k] +
+                                    (1-t)*u*val[2][0][k];
+                accept = accept  &&
+                         abs(pred - val[b][a][k]) * scale[k] <= approxTol_p;
+             }
+          }
+       }
+       if (accept) {
+          const Double dx = x1 - x0;
+          const Double dy = y1 - y0;
+          for (uInt p=0; p<npos; p++) {
+             const uInt i = index[p];
+             const Double t = (splitX  ?  (in[2*i] - x0) / dx : 0);
+             const Double u = (splitY  ?  (in[2*i+1] - y0) / dy : 0);
+             for (uInt k=0; k<2; k++) {
+                out[2*i+k] = (1-t)*(1-u)*val[0][0][k] +
+                             t*(1-u)*val[0][2][k] +
+                             t*u*val[2][2][k] +
+                             (1-t)*u*val[2][0][k];
+             }
+             failures[i] = False;
+          }
+          return;
+       }
+    }
+    if (! canSplit) {
+       exact.insert(exact.end(), index, index+npos);
+       return;
+    }
+
+// Divide the cell in (at most) 4 quadrants.
+
+    uInt* end = index + npos;
+    uInt* midX = (splitX  ?
+                  std::partition(index, end, CoordinateApproxLess(in, 0, xm)) :
+                  end);
+    uInt* midY0 = (splitY  ?
+                   std::partition(index, midX, CoordinateApproxLess(in, 1, ym)) :
+                   midX);
+    uInt* midY1 = (splitY  ?
+                   std::partition(midX, end, CoordinateApproxLess(in, 1, ym)) :
+                   end);
+    const Double xl = (splitX  ?  xm : x1);
+    const Double yl = (splitY  ?  ym : y1);
+    approxCell(in, out, failures, index, midY0-index,
+               x0, y0, xl, yl, depth+1, scale, toWorld, exact);
+    approxCell(in, out, failures, midY0, midX-midY0,
+               x0, ym, xl, y1, depth+1, scale, toWorld, exact);
+    approxCell(in, out, failures, midX, midY1-midX,
+               xm, y0, x1, yl, depth+1, scale, toWorld, exact);
+    approxCell(in, out, failures, midY1, end-midY1,
+               xm, ym, x1, y1, depth+1, scale, toWorld, exact);
+}
+
+
 
 Bool Coordinate::toMix(Vector<Double>& worldOut,
                        Vector<Double>& pixelOut,
@@ -184,8 +416,8 @@ Bool Coordinate::toMix(Vector<Double>& worldOut,
 // need their own implementation
 //
 {
-    static Vector<Double> pixel_tmp;
-    static Vector<Double> world_tmp;
+    Vector<Double> pixel_tmp;
+    Vector<Double> world_tmp;
 
    const uInt nWorld = worldAxes.nelements();
    const uInt nPixel = pixelAxes.nelements();
@@ -358,7 +590,7 @@ String Coordinate::format(
 
 // Convert given world value to absolute or relative as needed
 
-   static Vector<Double> world;   
+   Vector<Double> world;   
    if (world.nelements()!=nWorldAxes()) world.resize(nWorldAxes());
 //
    if (showAsAbsolute) {
@@ -391,7 +623,7 @@ String Coordinate::format(
    if (currentUnitU != nativeUnitU) {
       throw(AipsError("Requested units are invalid for this Coordinate"));
    } else {
-      static Quantum<Double> q;
+      Quantum<Double> q;
       q.setValue(worldValue);
       q.setUnit(nativeUnitU);
       worldValue = q.getValue(currentUnitU);
@@ -403,7 +635,7 @@ String Coordinate::format(
 // ensure that there is enough precision... may need more tweaking...
    Vector<Double> inc(increment());
    if ( inc.nelements( ) > 0 && ((worldValue - trunc(worldValue)) != 0) ) {
-      static Quantum<Double> qdelta;
+      Quantum<Double> qdelta;
       qdelta.setValue(inc(0));
       qdelta.setUnit(nativeUnitU);
       Double worldIncr = qdelta.getValue(currentUnitU);
@@ -522,8 +754,13 @@ String Coordinate::typeToString (Coordinate::Type type)
    return String("");
 }
 
+// Serializes the setting of the error messages, because a transformation
+// can fail in several threads at the same time.
+static Mutex theirErrorMutex;
+
 void Coordinate::set_error(const String &errorMsg) const
 {
+    ScopedMutexLock lock(theirErrorMutex);
     error_p = errorMsg;
 }
 
@@ -34,6 +34,7 @@
 #include <casa/BasicSL/String.h>
 #include <casa/Arrays/Vector.h>
 #include <wcslib/wcs.h>
+#include <vector>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
@@ -281,6 +282,19 @@ public:
                              Vector<Bool>& failures) const;
     // </group>
 
+    // Set or get the tolerance (in pixels) of approximate batch
+    // transformations. A tolerance of 0 (the default) means that
+    // <src>toWorldMany</src> and <src>toPixelMany</src> do exact
+    // transformations. Otherwise a coordinate with 2 pixel and 2 world axes
+    // (e.g. a DirectionCoordinate) may approximate them by interpolating in
+    // a grid of exact transformations (see <src>toManyApprox</src>).
+    // The tolerance is not saved in a record.
+    // <group>
+    virtual void setApproximate (Double tolerance);
+    Double approximate() const
+      { return approxTol_p; }
+    // </group>
+
     // Make absolute coordinates relative and vice-versa (with
     // respect to the reference value).
     // Vectors must be length <src>nPixelAxes()</src> or
@@ -515,6 +529,29 @@ protected:
    Bool toPixelManyWCS (Matrix<Double>& pixel, const Matrix<Double>& world,
                         Vector<Bool>& failures, wcsprm& wcs) const;
 
+   // Should the batch transformations be approximated?
+   // It is True if a tolerance is set, the coordinate has 2 pixel and
+   // 2 world axes and enough transformations have to be done.
+   Bool useApprox (uInt nTransforms) const;
+
+   // Do many transformations (pixel to world if <src>toWorld</src> is True,
+   // otherwise world to pixel) approximately. The bounding box of the input
+   // positions is divided recursively into cells. For each cell the exact
+   // transformations are done at the corners, edge midpoints and centre.
+   // If bi-linear interpolation between the corners gives all of them
+   // within the tolerance (converted from pixels to world units using the
+   // increments), the transformations of the positions in the cell are
+   // interpolated. Otherwise the cell is divided further. Positions in cells
+   // that are still too inaccurate at the finest level, e.g. near a pole,
+   // a discontinuity in longitude or the edge of the projection, are
+   // transformed exactly. Note that the error is only estimated from the
+   // points tested in a cell.
+   // <br>Functions <src>toWorld</src> and <src>toPixel</src> are used for
+   // the exact transformations, so the derived class can call this
+   // function from its <src>toWorldMany</src> and <src>toPixelMany</src>.
+   Bool toManyApprox (Matrix<Double>& out, const Matrix<Double>& in,
+                      Vector<Bool>& failures, Bool toWorld) const;
+
    // Functions for handling conversion between the current units and
    // the wcs units. These are called explicitly by the appropriate 
    // derived class.
@@ -556,6 +593,8 @@ protected:
 
 private:
     mutable String error_p;
+    // Tolerance (in pixels) of approximate batch transformations.
+    Double approxTol_p;
 
     // Check format type
     void checkFormat(Coordinate::formatType& format,         
@@ -564,6 +603,15 @@ private:
     void makeWorldAbsRelMany (Matrix<Double>& value, Bool toAbs) const; 
     void makePixelAbsRelMany (Matrix<Double>& value, Bool toAbs) const; 
 
+    // Approximate the transformations of the positions with the given
+    // indices in a cell for <src>toManyApprox</src>. The indices of the
+    // positions to transform exactly are added to <src>exact</src>.
+    void approxCell (const Double* in, Double* out, Bool* failures,
+                     uInt* index, uInt npos,
+                     Double x0, Double y0, Double x1, Double y1, uInt depth,
+                     const Double* scale, Bool toWorld,
+                     std::vector<uInt>& exact) const;
+
 
 };
 
@@ -91,6 +91,7 @@ void CoordinateSystem::copy(const CoordinateSystem &other)
     clear();
 //
     obsinfo_p = other.obsinfo_p;
+    Coordinate::setApproximate (other.approximate());
     coordinates_p = other.coordinates_p;
     const uInt n = coordinates_p.nelements();
 //
@@ -1058,6 +1059,22 @@ Vector<Double> CoordinateSystem::toWorld(const IPosition& pixel) const {
 
 Bool CoordinateSystem::toWorld(Vector<Double> &world, 
 			       const Vector<Double> &pixel) const
+{
+    return doToWorld (world, pixel, pixel_tmps_p, world_tmps_p);
+}
+
+Bool CoordinateSystem::toWorld(Vector<Double> &world, 
+			       const Vector<Double> &pixel,
+			       TransformScratch& scratch) const
+{
+    initScratch (scratch);
+    return doToWorld (world, pixel, scratch.itsPixel, scratch.itsWorld);
+}
+
+Bool CoordinateSystem::doToWorld(Vector<Double> &world, 
+				 const Vector<Double> &pixel,
+				 const PtrBlock<Vector<Double>*>& pixelTmps,
+				 const PtrBlock<Vector<Double>*>& worldTmps) const
 {
     if(pixel.nelements() != nPixelAxes()){
 	ostringstream oss;
@@ -1085,15 +1102,15 @@ Bool CoordinateSystem::toWorld(Vector<Double> &world,
 
  //cerr << "i j where " << i << " " << j << " " << where <<endl;
 
-		pixel_tmps_p[i]->operator()(j) = pixel(where);
+		pixelTmps[i]->operator()(j) = pixel(where);
 	    } else {
-		pixel_tmps_p[i]->operator()(j) = 
+		pixelTmps[i]->operator()(j) = 
 		    pixel_replacement_values_p[i]->operator()(j);
 	    }
 	}
 	Bool oldok = ok;
 	ok = coordinates_p[i]->toWorld(
-		       *(world_tmps_p[i]), *(pixel_tmps_p[i]));
+		       *(worldTmps[i]), *(pixelTmps[i]));
 
 	if (!ok) {
 
@@ -1108,7 +1125,7 @@ Bool CoordinateSystem::toWorld(Vector<Double> &world,
 	for (j=0; j<nwa; j++) {
 	    Int where = world_maps_p[i]->operator[](j);
 	    if (where >= 0) {
-		world(where) = world_tmps_p[i]->operator()(j);
+		world(where) = worldTmps[i]->operator()(j);
 	    }
 	}
     }
@@ -1127,7 +1144,7 @@ Vector<Double> CoordinateSystem::toPixel(const Vector<Double> &world) const {
 Bool CoordinateSystem::toWorld(Vector<Double> &world, 
 			       const IPosition &pixel) const
 {
-    static Vector<Double> pixel_tmp;
+    Vector<Double> pixel_tmp;
     if (pixel_tmp.nelements()!=pixel.nelements()) pixel_tmp.resize(pixel.nelements());
 //
     const uInt& n = pixel.nelements();
@@ -1139,6 +1156,22 @@ Bool CoordinateSystem::toWorld(Vector<Double> &world,
 
 Bool CoordinateSystem::toPixel(Vector<Double> &pixel, 
 			       const Vector<Double> &world) const
+{
+    return doToPixel (pixel, world, pixel_tmps_p, world_tmps_p);
+}
+
+Bool CoordinateSystem::toPixel(Vector<Double> &pixel, 
+			       const Vector<Double> &world,
+			       TransformScratch& scratch) const
+{
+    initScratch (scratch);
+    return doToPixel (pixel, world, scratch.itsPixel, scratch.itsWorld);
+}
+
+Bool CoordinateSystem::doToPixel(Vector<Double> &pixel, 
+				 const Vector<Double> &world,
+				 const PtrBlock<Vector<Double>*>& pixelTmps,
+				 const PtrBlock<Vector<Double>*>& worldTmps) const
 {
     AlwaysAssert(world.nelements() == nWorldAxes(), AipsError);
     if (pixel.nelements()!=nPixelAxes()) pixel.resize(nPixelAxes());
@@ -1156,15 +1189,15 @@ Bool CoordinateSystem::toPixel(Vector<Double> &pixel,
 	for (j=0; j<nwra; j++) {
 	    where = world_maps_p[i]->operator[](j);
 	    if (where >= 0) {
-		world_tmps_p[i]->operator()(j) = world(where);
+		worldTmps[i]->operator()(j) = world(where);
 	    } else {
-		world_tmps_p[i]->operator()(j) = 
+		worldTmps[i]->operator()(j) = 
 		    world_replacement_values_p[i]->operator()(j);
 	    }
 	}
 	Bool oldok = ok;
 	ok = coordinates_p[i]->toPixel(
-			    *(pixel_tmps_p[i]), *(world_tmps_p[i]));
+			    *(pixelTmps[i]), *(worldTmps[i]));
 	if (!ok) {
 	    // Transfer the error message. Note that if there is more than
 	    // one error message this transfers the last one. I suppose this
@@ -1176,7 +1209,7 @@ Bool CoordinateSystem::toPixel(Vector<Double> &pixel,
 	for (j=0; j<npxa; j++) {
 	    where = pixel_maps_p[i]->operator[](j);
 	    if (where >= 0) {
-		pixel(where) = pixel_tmps_p[i]->operator()(j);
+		pixel(where) = pixelTmps[i]->operator()(j);
 	    }
 	}
     }
@@ -1184,6 +1217,35 @@ Bool CoordinateSystem::toPixel(Vector<Double> &pixel,
     return ok;
 }
 
+void CoordinateSystem::initScratch (TransformScratch& scratch) const
+{
+    const uInt nc = coordinates_p.nelements();
+    if (scratch.itsPixel.nelements() != nc) {
+        for (uInt i=0; i<scratch.itsPixel.nelements(); i++) {
+            delete scratch.itsPixel[i];
+            delete scratch.itsWorld[i];
+        }
+        scratch.itsPixel.resize (nc, True, False);
+        scratch.itsWorld.resize (nc, True, False);
+        for (uInt i=0; i<nc; i++) {
+            scratch.itsPixel[i] = new Vector<Double>;
+            scratch.itsWorld[i] = new Vector<Double>;
+        }
+    }
+    for (uInt i=0; i<nc; i++) {
+        scratch.itsPixel[i]->resize (pixel_tmps_p[i]->nelements());
+        scratch.itsWorld[i]->resize (world_tmps_p[i]->nelements());
+    }
+}
+
+CoordinateSystem::TransformScratch::~TransformScratch()
+{
+    for (uInt i=0; i<itsPixel.nelements(); i++) {
+        delete itsPixel[i];
+        delete itsWorld[i];
+    }
+}
+
 Quantity CoordinateSystem::toWorldLength(
     const Double nPixels,
    	const uInt pixelAxis
@@ -1341,6 +1403,14 @@ Bool CoordinateSystem::toPixelMany(Matrix<Double>& pixel,
    return ok;
 }
 
+void CoordinateSystem::setApproximate (Double tolerance)
+{
+    Coordinate::setApproximate (tolerance);
+    for (uInt i=0; i<coordinates_p.nelements(); i++) {
+       coordinates_p[i]->setApproximate (tolerance);
+    }
+}
+
 
 
 
@@ -185,6 +185,18 @@ class LogIO;
 // but for the DirectionCoordinate  you might request a mixed
 // pixel/world conversion. In this case, the extra conversion layer
 // is ill-defined and not active (for the DirectionCoordinate part of it).
+// <p>
+// The const pixel/world transformation functions of the coordinates can be
+// used by multiple threads at the same time. The wcslib structures are
+// fully set up when a coordinate is constructed or changed, so the wcslib
+// transformations do not modify them. The use of the reference frame
+// conversion machines is serialized. However, the plain <src>toWorld</src>
+// and <src>toPixel</src> functions of CoordinateSystem use scratch vectors
+// held in the object. Threads sharing a CoordinateSystem should use the
+// versions taking a <src>TransformScratch</src> object, of which each
+// thread has its own. Note that if transformations fail in several
+// threads, <src>errorMessage()</src> gives one of the messages.
+// Functions changing a coordinate must not be used at the same time.
 // </synopsis>
 
 // <note role=caution>
@@ -208,7 +220,6 @@ class LogIO;
 //   <li> Undelete individual removed axes.
 //   <li> Non-integral pixel shifts/decimations in subimage operations?
 //   <li> Copy-on-write for efficiency?
-//   <li> Check if the classes are thread safe in general
 // </todo>
 //
 
@@ -436,6 +447,37 @@ public:
     virtual Vector<Double> toPixel(const Vector<Double> &world) const;
     // </group>
 
+    // Scratch vectors for the transformations of the coordinates in the
+    // CoordinateSystem. They are resized when used by the
+    // <src>toWorld</src> and <src>toPixel</src> functions below.
+    class TransformScratch
+    {
+    public:
+      TransformScratch()
+      {}
+      ~TransformScratch();
+    private:
+      // Forbid copy constructor and assignment.
+      // <group>
+      TransformScratch (const TransformScratch&);
+      TransformScratch& operator= (const TransformScratch&);
+      // </group>
+      friend class CoordinateSystem;
+      PtrBlock<Vector<Double>*> itsWorld;
+      PtrBlock<Vector<Double>*> itsPixel;
+    };
+
+    // Convert a pixel position to a world position or vice versa using
+    // the given scratch vectors instead of the ones held in the object.
+    // Thus these functions can be used by multiple threads at the same time,
+    // provided that each thread uses its own TransformScratch object.
+    // <group>
+    Bool toWorld (Vector<Double>& world, const Vector<Double>& pixel,
+                  TransformScratch& scratch) const;
+    Bool toPixel (Vector<Double>& pixel, const Vector<Double>& world,
+                  TransformScratch& scratch) const;
+    // </group>
+
     // convert a pixel "length" to a world "length"
     virtual Quantity toWorldLength(
     	const Double nPixels,
@@ -462,6 +504,12 @@ public:
                              Vector<Bool>& failures) const;
     // </group>
 
+    // Set the tolerance (in pixels) of approximate batch transformations
+    // for all coordinates currently in the CoordinateSystem (see
+    // <linkto class=Coordinate>Coordinate::setApproximate</linkto>).
+    // Coordinates added later keep their own tolerance.
+    virtual void setApproximate (Double tolerance);
+
 
     // Mixed pixel/world coordinate conversion.
     // <src>worldIn</src> and <src>worldAxes</src> are of length n<src>worldAxes</src>.
@@ -894,6 +942,20 @@ private:
     PtrBlock<Vector<Double> *> worldMin_tmps_p;
     PtrBlock<Vector<Double> *> worldMax_tmps_p;
 
+    // Do the conversions of <src>toWorld</src> and <src>toPixel</src>
+    // using the given scratch vectors.
+    // <group>
+    Bool doToWorld (Vector<Double>& world, const Vector<Double>& pixel,
+                    const PtrBlock<Vector<Double>*>& pixelTmps,
+                    const PtrBlock<Vector<Double>*>& worldTmps) const;
+    Bool doToPixel (Vector<Double>& pixel, const Vector<Double>& world,
+                    const PtrBlock<Vector<Double>*>& pixelTmps,
+                    const PtrBlock<Vector<Double>*>& worldTmps) const;
+    // </group>
+
+    // Size the scratch vectors for the coordinates in the CoordinateSystem.
+    void initScratch (TransformScratch& scratch) const;
+
     // Miscellaneous information about the observation associated with this
     // Coordinate System.
     ObsInfo obsinfo_p;
@@ -47,7 +47,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 Bool DirectionCoordinate::toWorld(MDirection &world, 
 				  const Vector<Double> &pixel) const
 {
-    static MVDirection world_tmp;
+    MVDirection world_tmp;
     if (toWorld(world_tmp, pixel)) {
        world.set(world_tmp, MDirection::Ref(type_p));
        return True;
@@ -59,7 +59,7 @@ Bool DirectionCoordinate::toWorld(MDirection &world,
 Bool DirectionCoordinate::toWorld(MVDirection &world, 
 				  const Vector<Double> &pixel) const
 {
-    static Vector<Double> world_tmp(2);
+    Vector<Double> world_tmp(2);
     if (toWorld(world_tmp, pixel)) {
        world.setAngle(world_tmp(0)*to_radians_p[0],
                       world_tmp(1)*to_radians_p[1]);
@@ -99,7 +99,7 @@ Bool DirectionCoordinate::toPixel(
 Bool DirectionCoordinate::toPixel(Vector<Double> &pixel,
                                   const MVDirection &world) const
 {
-   static Vector<Double> world_tmp(2);
+   Vector<Double> world_tmp(2);
 
 // Convert to current units
 
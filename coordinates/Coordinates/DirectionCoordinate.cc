@@ -49,6 +49,7 @@
 #include <casa/Quanta/Euler.h>
 #include <casa/Utilities/Assert.h>
 #include <casa/Utilities/LinearSearch.h>
+#include <casa/OS/Mutex.h>
 #include <casa/BasicSL/String.h>
 
 #include <wcslib/wcsfix.h>
@@ -322,7 +323,7 @@ Bool DirectionCoordinate::toWorld(Vector<Double> &world,
 Bool DirectionCoordinate::toPixel(Vector<Double> &pixel,
 				  const Vector<Double> &world) const
 {
-    static Vector<Double> world_tmp;
+    Vector<Double> world_tmp;
     DebugAssert(world.nelements() == nWorldAxes(), AipsError);
        
 // Convert from specified conversion reference type
@@ -356,8 +357,8 @@ Bool DirectionCoordinate::toMix(Vector<Double>& worldOut,
          
 // Temporaries
        
-   static Vector<Double> in_tmp;
-   static Vector<Double> out_tmp;
+   Vector<Double> in_tmp;
+   Vector<Double> out_tmp;
 //
    const uInt nPixel = pixelAxes.nelements();
    DebugAssert(worldAxes.nelements()==nWorldAxes(), AipsError);
@@ -449,6 +450,10 @@ Bool DirectionCoordinate::toWorldMany (Matrix<Double>& world,
                                        const Matrix<Double>& pixel,
                                        Vector<Bool>& failures) const
 { 
+    if (useApprox (pixel.ncolumn())) {
+       return toManyApprox (world, pixel, failures, True);
+    }
+
 // To World with wcs
 
     if (toWorldManyWCS (world, pixel, failures, wcs_p)) {
@@ -473,6 +478,9 @@ Bool DirectionCoordinate::toPixelMany (Matrix<Double>& pixel,
                                        Vector<Bool>& failures) const
 {
     AlwaysAssert(world.nrow()==nWorldAxes(), AipsError);
+    if (useApprox (world.ncolumn())) {
+       return toManyApprox (pixel, world, failures, False);
+    }
 
 // Copy input as we have to convert it to all sorts of things
 
@@ -954,7 +962,7 @@ String DirectionCoordinate::format(String& units,
 
 // Convert given world value to absolute or relative as needed
    
-   static Vector<Double> world;
+   Vector<Double> world;
    world.resize(nWorldAxes());
 //
    if (showAsAbsolute) {
@@ -1818,7 +1826,7 @@ Quantity DirectionCoordinate::getPixelArea() const {
 
 void DirectionCoordinate::makeWorldRelative (Vector<Double>& world) const
 {
-    static MVDirection mv;
+    MVDirection mv;
     DebugAssert(world.nelements()==2, AipsError);
 //
     mv.setAngle(world[0]*to_radians_p[0], world[1]*to_radians_p[1]);
@@ -1830,7 +1838,7 @@ void DirectionCoordinate::makeWorldRelative (Vector<Double>& world) const
 
 void DirectionCoordinate::makeWorldRelative (MDirection& world) const
 {
-    static MVDirection mv;
+    MVDirection mv;
     mv = world.getValue() * rot_p;
     Double lon = mv.getLong();
     Double lat = mv.getLat();
@@ -1841,7 +1849,7 @@ void DirectionCoordinate::makeWorldRelative (MDirection& world) const
 
 void DirectionCoordinate::makeWorldAbsolute (Vector<Double>& world) const
 {
-    static MVDirection mv;
+    MVDirection mv;
     DebugAssert(world.nelements()==2, AipsError);
 //   
     Double lat = world[1]*to_radians_p[1];
@@ -1855,7 +1863,7 @@ void DirectionCoordinate::makeWorldAbsolute (Vector<Double>& world) const
 void DirectionCoordinate::makeWorldAbsoluteRef (Vector<Double>& world,
                                                 const Vector<Double>& refVal) const
 {
-    static MVDirection mv;
+    MVDirection mv;
     DebugAssert(world.nelements()==2, AipsError);
     DebugAssert(refVal.nelements()==2, AipsError);
 //   
@@ -1872,7 +1880,7 @@ void DirectionCoordinate::makeWorldAbsoluteRef (Vector<Double>& world,
 
 void DirectionCoordinate::makeWorldAbsolute (MDirection& world) const
 {
-    static MVDirection mv;
+    MVDirection mv;
 //
     Double lon = world.getValue().getLong();
     Double lat = world.getValue().getLat();
@@ -2045,14 +2053,19 @@ void DirectionCoordinate::initializeFactors ()
 
 
 
+// A conversion machine keeps state, so its use is serialized to make
+// the transformations thread-safe.
+static Mutex theirConversionMutex;
+
 void DirectionCoordinate::convertTo (Vector<Double>& world) const
 {
-   static MVDirection inMV;
+   MVDirection inMV;
 
 // I can't set the machine to operate in the native units because
 // the user can set them differently for lon and lat
 
    if (pConversionMachineTo_p) {
+      ScopedMutexLock lock(theirConversionMutex);
       inMV.setAngle(world[0]*to_radians_p[0], world[1]*to_radians_p[1]);
       world  = (*pConversionMachineTo_p)(inMV).getValue().get() / to_radians_p;
    }
@@ -2062,12 +2075,13 @@ void DirectionCoordinate::convertTo (Vector<Double>& world) const
 
 void DirectionCoordinate::convertFrom (Vector<Double>& world) const
 {
-   static MVDirection inMV;
+   MVDirection inMV;
 
 // I can't set the machine to operate in the native units because
 // the user can set them differently for lon and lat
 
    if (pConversionMachineFrom_p) {
+      ScopedMutexLock lock(theirConversionMutex);
       inMV.setAngle(world[0]*to_radians_p[0], world[1]*to_radians_p[1]);
       world = (*pConversionMachineFrom_p)(inMV).getValue().get() / to_radians_p;
    }
@@ -427,7 +427,10 @@ public:
     // of the matrices contain the coordinates. Returns False if any conversion
     // failed  and  <src>errorMessage()</src> will hold a message.
     // The <src>failures</src> array is the length of the number of conversions
-    // (True for failure, False for success)
+    // (True for failure, False for success).
+    // If a tolerance is set with <src>setApproximate</src>, the
+    // transformations are interpolated in a grid of exact ones, which is
+    // much faster for large numbers of positions, e.g. all pixels in a plane.
     // <group>
     virtual Bool toWorldMany(Matrix<Double> &world,
                              const Matrix<Double> &pixel,
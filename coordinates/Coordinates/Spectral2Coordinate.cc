@@ -44,6 +44,7 @@
 #include <casa/Quanta/MVFrequency.h>
 #include <casa/Quanta/Quantum.h>
 #include <casa/Quanta/Unit.h>
+#include <casa/OS/Mutex.h>
 #include <casa/BasicSL/String.h>
 
 
@@ -53,7 +54,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 Bool SpectralCoordinate::toWorld(MFrequency& world, 
 				 Double pixel) const
 {
-    static MVFrequency world_tmp;
+    MVFrequency world_tmp;
     if (toWorld(world_tmp, pixel)) {
        world.set(world_tmp, MFrequency::Ref(type_p));
        return True;
@@ -65,7 +66,7 @@ Bool SpectralCoordinate::toWorld(MVFrequency& world,
 				 Double pixel) const
 {
     Double world_tmp;
-    static Quantum<Double> q_tmp;
+    Quantum<Double> q_tmp;
 //
     if (toWorld(world_tmp, pixel)) {
        q_tmp.setValue(world_tmp);
@@ -133,7 +134,7 @@ Bool SpectralCoordinate::frequencyToVelocity (Quantum<Double>& velocity, Double
 
 Bool SpectralCoordinate::frequencyToVelocity (Double& velocity, Double frequency) const
 {
-   static Quantum<Double> t;
+   Quantum<Double> t;
    t = pVelocityMachine_p->makeVelocity(frequency);
    velocity = t.getValue();
    return True;
@@ -357,9 +358,14 @@ Int SpectralCoordinate::makeConversionMachines (MFrequency::Types type,
    return 1;
 }
 
+// A conversion machine keeps state, so its use is serialized to make
+// the transformations thread-safe.
+static Mutex theirConversionMutex;
+
 void SpectralCoordinate::convertTo (Vector<Double>& world) const
 {
   if (pConversionMachineTo_p) {
+    ScopedMutexLock lock(theirConversionMutex);
     for(uInt i=0; i<world.size(); i++){
       world[i]  = (*pConversionMachineTo_p)(world[i]).get(unit_p).getValue();
     }
@@ -370,6 +376,7 @@ void SpectralCoordinate::convertFrom (Vector<Double>& world) const
 {
 
   if (pConversionMachineFrom_p) {
+    ScopedMutexLock lock(theirConversionMutex);
     for(uInt i=0; i<world.size(); i++){
       world[i]  = (*pConversionMachineFrom_p)(world[i]).get(unit_p).getValue();
     }
@@ -469,8 +469,8 @@ Bool SpectralCoordinate::toWorld (Vector<Double> &world,
 
 Bool SpectralCoordinate::toWorld(Double& world, const Double& pixel) const
 {
-    static Vector<Double> pixel_tmp1(1);
-    static Vector<Double> world_tmp1(1);
+    Vector<Double> pixel_tmp1(1);
+    Vector<Double> world_tmp1(1);
 //
     pixel_tmp1[0] = pixel;
     if (toWorld(world_tmp1, pixel_tmp1)) {
@@ -486,7 +486,7 @@ Bool SpectralCoordinate::toWorld(Double& world, const Double& pixel) const
 Bool SpectralCoordinate::toPixel (Vector<Double> &pixel,
                                   const Vector<Double> &world) const
 {
-    static Vector<Double> world_tmp1(1);
+    Vector<Double> world_tmp1(1);
     DebugAssert(world.nelements()==1, AipsError);
     Bool ok = True;
 
@@ -515,8 +515,8 @@ Bool SpectralCoordinate::toPixel (Vector<Double> &pixel,
 
 Bool SpectralCoordinate::toPixel(Double& pixel, const Double& world) const
 {
-    static Vector<Double> pixel_tmp2(1);
-    static Vector<Double> world_tmp2(1);
+    Vector<Double> pixel_tmp2(1);
+    Vector<Double> world_tmp2(1);
 //
     world_tmp2[0] = world;
     if (toPixel(pixel_tmp2, world_tmp2)) {
@@ -2117,10 +2117,10 @@ String SpectralCoordinate::format (String& units,
    static const Unit unitsHZ(String("Hz"));      
    static const Unit unitsKMS_c(String("km/s"));      
    static const Unit unitsM_c(String("m"));      
-   static Quantum<Double> qVel;
+   Quantum<Double> qVel;
    //   static Quantum<Double> qFreq;
-   static Vector<Double> vWave;
-   static Vector<Double> world;
+   Vector<Double> vWave;
+   Vector<Double> world;
 
 // Use default format unit (which itself may be empty) if empty
 
@@ -2166,7 +2166,7 @@ String SpectralCoordinate::format (String& units,
 
 // Find relative coordinate in km/s consistent units
 
-   			static Vector<Double> vel(2), freq2(2);
+   			Vector<Double> vel(2), freq2(2);
    			freq2(0) = referenceValue()(worldAxis);
    			freq2(1) = worldValue;
    			if (!frequencyToVelocity(vel, freq2)) {
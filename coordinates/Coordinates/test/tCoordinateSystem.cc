@@ -101,6 +101,7 @@ void doit7 ();
 void verifyCAS3264 ();
 void spectralAxisNumber();
 void polarizationAxisNumber();
+void testScratch();
 
 
 
@@ -324,6 +325,7 @@ int main()
       {
     	  spectralAxisNumber();
     	  polarizationAxisNumber();
+    	  testScratch();
 
       }
       {
@@ -2576,3 +2578,58 @@ void doit6 ()
 
      }
 
+   void testScratch() {
+	   cout << "*** test toWorld/toPixel with TransformScratch" << endl;
+	   CoordinateSystem csys = CoordinateUtil::defaultCoords4D();
+	   // Use a conversion machine and a removed axis as well.
+	   Int dc = csys.findCoordinate(Coordinate::DIRECTION);
+	   DirectionCoordinate dir = csys.directionCoordinate(dc);
+	   dir.setReferenceConversion(MDirection::GALACTIC);
+	   csys.replaceCoordinate(dir, dc);
+	   csys.removePixelAxis(2, 1.0);
+	   const Int n = 200;
+	   Matrix<Double> pixel(csys.nPixelAxes(), n);
+	   for (Int i=0; i<n; i++) {
+		   pixel(0,i) = i%20 - 5.5;
+		   pixel(1,i) = i/10 + 0.25;
+		   pixel(2,i) = i%7;
+	   }
+	   Matrix<Double> world(csys.nWorldAxes(), n);
+	   Matrix<Double> pixel2(csys.nPixelAxes(), n);
+	   Bool ok = True;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+	   for (Int i=0; i<n; i++) {
+		   // Do not use Matrix::column, because it shares the storage.
+		   CoordinateSystem::TransformScratch scratch;
+		   Vector<Double> pin(pixel.nrow()), w, p;
+		   for (uInt k=0; k<pin.nelements(); k++) {
+			   pin[k] = pixel(k,i);
+		   }
+		   Bool ok1 = csys.toWorld(w, pin, scratch);
+		   ok1 = ok1 && csys.toPixel(p, w, scratch);
+		   if (ok1) {
+			   for (uInt k=0; k<w.nelements(); k++) {
+				   world(k,i) = w[k];
+			   }
+			   for (uInt k=0; k<p.nelements(); k++) {
+				   pixel2(k,i) = p[k];
+			   }
+		   } else {
+#ifdef _OPENMP
+#pragma omp critical(tCoordinateSystem_testScratch)
+#endif
+			   ok = False;
+		   }
+	   }
+	   AlwaysAssert(ok, AipsError);
+	   Vector<Double> w, p;
+	   for (Int i=0; i<n; i++) {
+		   AlwaysAssert(csys.toWorld(w, pixel.column(i)), AipsError);
+		   AlwaysAssert(allNear(w, world.column(i), 1e-12), AipsError);
+		   AlwaysAssert(csys.toPixel(p, w), AipsError);
+		   AlwaysAssert(allNear(p, pixel2.column(i), 1e-12), AipsError);
+		   AlwaysAssert(allNearAbs(p, pixel.column(i), 1e-6), AipsError);
+	   }
+   }
@@ -77,6 +77,7 @@ void doit7 ();
 void doit8 ();
 void doit9 ();
 void doit10 ();
+void doit11 ();
 
 
 
@@ -274,6 +275,9 @@ int main()
       {
          doit10();
       }
+      {
+         doit11();
+      }
       {
     	  // getPixelArea
     	  DirectionCoordinate dc  = makeCoordinate(
@@ -482,6 +486,60 @@ int main()
 }
 
 
+void doit11 ()
+{
+// Approximate batch transformations of an image straddling longitude 0
+
+   Matrix<Double> xform(2,2);
+   xform = 0.0;
+   xform.diagonal() = 1.0;
+   const Double inc = C::pi/180/60;             // 1 arcmin
+   DirectionCoordinate dc(MDirection::J2000, Projection::SIN, 0.0, 0.8,
+                          -inc, inc, xform, 128.0, 128.0);
+   AlwaysAssert(dc.approximate()==0, AipsError);
+   const uInt n = 256;
+   Matrix<Double> pixel(2, n*n);
+   for (uInt j=0; j<n; j++) {
+      for (uInt i=0; i<n; i++) {
+         pixel(0, j*n+i) = i;
+         pixel(1, j*n+i) = j + 0.5;
+      }
+   }
+   Matrix<Double> world, world2, pixel2;
+   Vector<Bool> failures, failures2;
+   AlwaysAssert(dc.toWorldMany(world, pixel, failures), AipsError);
+//
+   DirectionCoordinate dc2(dc);
+   dc2.setApproximate(0.01);
+   AlwaysAssert(dc2.approximate()==0.01, AipsError);
+   AlwaysAssert(dc2.toWorldMany(world2, pixel, failures2), AipsError);
+   AlwaysAssert(allEQ(failures2, False), AipsError);
+   Double maxErr = 0;
+   for (uInt k=0; k<n*n; k++) {
+      Double dLon = abs(world2(0,k) - world(0,k));
+      dLon = min(dLon, C::_2pi - dLon);
+      maxErr = max(maxErr, dLon/inc);
+      maxErr = max(maxErr, abs(world2(1,k) - world(1,k))/inc);
+   }
+   AlwaysAssert(maxErr <= 0.02, AipsError);
+   AlwaysAssert(dc2.toPixelMany(pixel2, world, failures2), AipsError);
+   AlwaysAssert(max(abs(pixel2-pixel)) <= 0.02, AipsError);
+
+// Copies keep the tolerance, also in a CoordinateSystem.
+
+   DirectionCoordinate dc3;
+   dc3 = dc2;
+   AlwaysAssert(dc3.approximate()==0.01, AipsError);
+   CoordinateSystem cSys;
+   cSys.addCoordinate(dc);
+   cSys.setApproximate(0.05);
+   AlwaysAssert(cSys.approximate()==0.05, AipsError);
+   AlwaysAssert(cSys.directionCoordinate(0).approximate()==0.05, AipsError);
+   CoordinateSystem cSys2(cSys);
+   AlwaysAssert(cSys2.approximate()==0.05, AipsError);
+   AlwaysAssert(cSys2.directionCoordinate(0).approximate()==0.05, AipsError);
+}
+
 DirectionCoordinate makeCoordinate(MDirection::Types type,
                                    Projection& proj,
                                    Vector<Double>& crval, 
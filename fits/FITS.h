@@ -32,6 +32,7 @@
 #include <fits/FITS/blockio.h>         
 #include <fits/FITS/CopyRecord.h>        
 #include <fits/FITS/FITS2.h>             
+#include <fits/FITS/FITSCompressedFile.h>
 #include <fits/FITS/FITSDateUtil.h>    
 #include <fits/FITS/FITSError.h>        
 #include <fits/FITS/FITSFieldCopier.h>
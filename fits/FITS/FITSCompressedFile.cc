@@ -0,0 +1,428 @@
+//# FITSCompressedFile.cc: Access to a tile-compressed FITS image
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <fits/FITS/FITSCompressedFile.h>
+#include <casa/Arrays/Array.h>
+#include <casa/Arrays/Slicer.h>
+#include <casa/BasicMath/Math.h>
+#include <casa/Exceptions/Error.h>
+#include <casa/iostream.h>
+#include <casa/stdlib.h>
+#include <casa/string.h>
+#include <stdio.h>
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+Mutex FITSCompressedFile::theirMutex;
+
+FITSCompressedFile::FITSCompressedFile (const String& fileName,
+                                        uInt whichHDU,
+                                        uInt maximumCacheSize)
+: itsFile         (0),
+  itsName         (fileName),
+  itsBitpix       (0),
+  itsMaxCacheSize (maximumCacheSize),
+  itsMaxNrTiles   (1),
+  itsClock        (0),
+  itsNrAccess     (0),
+  itsNrDecompress (0)
+{
+  int status = 0;
+  fits_open_file (&itsFile, fileName.chars(), READONLY, &status);
+  checkStatus (status, "FITSCompressedFile: cannot open " + fileName);
+  try {
+    int hdutype;
+    fits_movabs_hdu (itsFile, whichHDU+1, &hdutype, &status);
+    checkStatus (status, "FITSCompressedFile: cannot move to HDU " +
+                 String::toString(whichHDU) + " in " + fileName);
+    if (! fits_is_compressed_image (itsFile, &status)) {
+      throw AipsError ("FITSCompressedFile: HDU " + String::toString(whichHDU)
+                       + " in " + fileName
+                       + " is not a tile-compressed image");
+    }
+    int bitpix, naxis;
+    fits_get_img_type (itsFile, &bitpix, &status);
+    fits_get_img_dim (itsFile, &naxis, &status);
+    checkStatus (status, "FITSCompressedFile: cannot get image info of "
+                 + fileName);
+    if (naxis <= 0) {
+      throw AipsError ("FITSCompressedFile: image in " + fileName +
+                       " has no axes");
+    }
+    Block<long> naxes(naxis);
+    fits_get_img_size (itsFile, naxis, naxes.storage(), &status);
+    checkStatus (status, "FITSCompressedFile: cannot get image shape of "
+                 + fileName);
+    itsBitpix = bitpix;
+    itsShape.resize (naxis);
+    itsTileShape.resize (naxis);
+    itsNrTiles.resize (naxis);
+    for (int i=0; i<naxis; ++i) {
+      itsShape(i) = naxes[i];
+      // If ZTILEn is not given, each row is a tile.
+      char key[FLEN_KEYWORD];
+      sprintf (key, "ZTILE%d", i+1);
+      long tile;
+      int st = 0;
+      fits_read_key (itsFile, TLONG, key, &tile, 0, &st);
+      if (st != 0  ||  tile <= 0) {
+        tile = (i==0 ? naxes[0] : 1);
+      }
+      itsTileShape(i) = std::min (tile, naxes[i]);
+      itsNrTiles(i) = (itsShape(i) + itsTileShape(i) - 1) / itsTileShape(i);
+    }
+  } catch (AipsError&) {
+    status = 0;
+    fits_close_file (itsFile, &status);
+    itsFile = 0;
+    throw;
+  }
+  setMaximumCacheSize (maximumCacheSize);
+}
+
+FITSCompressedFile::~FITSCompressedFile()
+{
+  if (itsFile) {
+    int status = 0;
+    fits_close_file (itsFile, &status);
+  }
+}
+
+Bool FITSCompressedFile::isCompressed (const String& fileName,
+                                       uInt& whichHDU)
+{
+  fitsfile* file = 0;
+  int status = 0;
+  if (fits_open_file (&file, fileName.chars(), READONLY, &status)) {
+    return False;
+  }
+  int hdutype;
+  fits_movabs_hdu (file, whichHDU+1, &hdutype, &status);
+  Bool compressed = (status == 0  &&  fits_is_compressed_image (file, &status));
+  if (!compressed  &&  whichHDU == 0  &&  status == 0) {
+    // An fpack-ed file has an empty primary array.
+    int naxis;
+    fits_get_img_dim (file, &naxis, &status);
+    if (status == 0  &&  naxis == 0) {
+      fits_movabs_hdu (file, 2, &hdutype, &status);
+      if (status == 0  &&  fits_is_compressed_image (file, &status)) {
+        compressed = True;
+        whichHDU = 1;
+      }
+    }
+  }
+  status = 0;
+  fits_close_file (file, &status);
+  return compressed;
+}
+
+Vector<String> FITSCompressedFile::header()
+{
+  char* hdr = 0;
+  int nkeys = 0;
+  int status = 0;
+  fits_convert_hdr2str (itsFile, 0, 0, 0, &hdr, &nkeys, &status);
+  checkStatus (status, "FITSCompressedFile: cannot read header of "
+               + itsName);
+  uInt ncard = strlen(hdr) / 80;
+  Vector<String> cards(ncard+1);
+  uInt nr = 0;
+  while (nr < ncard) {
+    cards(nr) = String(hdr + 80*nr, 80);
+    if (cards(nr).before(8) == "END     ") {
+      break;
+    }
+    nr++;
+  }
+  free (hdr);
+  if (nr == ncard) {
+    cards(nr) = "END" + String(77, ' ');
+  }
+  cards.resize (nr+1, True);
+  return cards;
+}
+
+void FITSCompressedFile::setMaximumCacheSize (uInt nbytes)
+{
+  itsMaxCacheSize = nbytes;
+  uInt tileSize = itsTileShape.product() * sizeof(Float);
+  itsMaxNrTiles = std::max (1u, nbytes / tileSize);
+  while (itsCache.size() > itsMaxNrTiles) {
+    makeRoom();
+  }
+}
+
+void FITSCompressedFile::setCacheSize (uInt nrTiles)
+{
+  setMaximumCacheSize (std::max(1u, nrTiles) *
+                       itsTileShape.product() * sizeof(Float));
+}
+
+void FITSCompressedFile::setCacheSize (const IPosition& sliceShape,
+                                       const IPosition& windowStart,
+                                       const IPosition& windowLength,
+                                       const IPosition& axisPath)
+{
+  // A slice needs the tiles it overlaps. When stepping along the first
+  // axis of the path, the tiles along that axis have to be kept in order
+  // to reuse them for the next slices in the other axes.
+  const uInt ndim = itsShape.nelements();
+  const uInt pathAxis = (axisPath.nelements() > 0  ?  axisPath(0) : 0);
+  uInt nrTiles = 1;
+  for (uInt i=0; i<ndim; ++i) {
+    Int64 st = windowStart(i);
+    Int64 len = (i == pathAxis  ?  windowLength(i) : sliceShape(i));
+    nrTiles *= (st + len - 1) / itsTileShape(i) - st / itsTileShape(i) + 1;
+  }
+  setCacheSize (nrTiles);
+}
+
+void FITSCompressedFile::clearCache()
+{
+  itsCache.clear();
+}
+
+void FITSCompressedFile::showCacheStatistics (ostream& os) const
+{
+  os << "FITSCompressedFile cache statistics:" << endl;
+  os << "  maxNrTiles  " << itsMaxNrTiles << endl;
+  os << "  nrTiles     " << itsCache.size() << endl;
+  os << "  nrAccess    " << itsNrAccess << endl;
+  os << "  nrDecompress " << itsNrDecompress << endl;
+}
+
+void FITSCompressedFile::makeRoom()
+{
+  // Remove the least recently used tiles.
+  while (!itsCache.empty()  &&  itsCache.size() >= itsMaxNrTiles) {
+    std::map<Int64,CacheEntry>::iterator oldest = itsCache.begin();
+    for (std::map<Int64,CacheEntry>::iterator iter = itsCache.begin();
+         iter != itsCache.end(); ++iter) {
+      if (iter->second.lastUse < oldest->second.lastUse) {
+        oldest = iter;
+      }
+    }
+    itsCache.erase (oldest);
+  }
+}
+
+const Float* FITSCompressedFile::getTile (const IPosition& tileNr)
+{
+  const uInt ndim = itsShape.nelements();
+  Int64 key = 0;
+  for (Int i=ndim-1; i>=0; --i) {
+    key = key * itsNrTiles(i) + tileNr(i);
+  }
+  itsNrAccess++;
+  std::map<Int64,CacheEntry>::iterator iter = itsCache.find (key);
+  if (iter != itsCache.end()) {
+    iter->second.lastUse = ++itsClock;
+    return iter->second.data.storage();
+  }
+  // Decompress the tile; the cfitsio pixel numbers are 1-relative.
+  makeRoom();
+  Block<long> fpixel(ndim), lpixel(ndim), inc(ndim, 1L);
+  uInt64 npixel = 1;
+  for (uInt i=0; i<ndim; ++i) {
+    fpixel[i] = tileNr(i) * itsTileShape(i) + 1;
+    lpixel[i] = std::min (long(fpixel[i] + itsTileShape(i) - 1),
+                          long(itsShape(i)));
+    npixel *= lpixel[i] - fpixel[i] + 1;
+  }
+  CacheEntry& entry = itsCache[key];
+  entry.data.resize (npixel, False, False);
+  Float nulval;
+  setNaN (nulval);
+  int anynul = 0;
+  int status = 0;
+  {
+    ScopedMutexLock lock(theirMutex);
+    fits_read_subset (itsFile, TFLOAT, fpixel.storage(), lpixel.storage(),
+                      inc.storage(), &nulval, entry.data.storage(),
+                      &anynul, &status);
+  }
+  if (status != 0) {
+    itsCache.erase (key);
+    checkStatus (status, "FITSCompressedFile: cannot decompress tile of "
+                 + itsName);
+  }
+  itsNrDecompress++;
+  entry.lastUse = ++itsClock;
+  return entry.data.storage();
+}
+
+void FITSCompressedFile::get (Array<Float>& buffer, const Slicer& section)
+{
+  const uInt ndim = itsShape.nelements();
+  const IPosition& blc = section.start();
+  const IPosition& trc = section.end();
+  const IPosition& inc = section.stride();
+  const IPosition& len = section.length();
+  buffer.resize (len);
+  Bool deleteIt;
+  Float* out = buffer.getStorage (deleteIt);
+  IPosition outStride(ndim), tileStride(ndim);
+  IPosition tileBlc(ndim), tileTrc(ndim);
+  for (uInt i=0; i<ndim; ++i) {
+    outStride(i) = (i==0 ? 1 : outStride(i-1) * len(i-1));
+    tileBlc(i) = blc(i) / itsTileShape(i);
+    tileTrc(i) = trc(i) / itsTileShape(i);
+  }
+  // Loop over all tiles containing part of the section.
+  IPosition tileNr(tileBlc);
+  IPosition start(ndim), first(ndim), last(ndim), pos(ndim);
+  while (True) {
+    // Determine the part of the section in this tile (taking the
+    // strides into account).
+    Bool empty = False;
+    for (uInt i=0; i<ndim; ++i) {
+      start(i) = tileNr(i) * itsTileShape(i);
+      Int64 end = std::min (start(i) + itsTileShape(i), itsShape(i)) - 1;
+      tileStride(i) = (i==0 ? 1 :
+                       tileStride(i-1) * (std::min (start(i-1) + itsTileShape(i-1),
+                                                    itsShape(i-1)) - start(i-1)));
+      Int64 st = std::max (blc(i), start(i));
+      first(i) = blc(i) + (st - blc(i) + inc(i) - 1) / inc(i) * inc(i);
+      last(i) = std::min (Int64(trc(i)), end);
+      if (first(i) > last(i)) {
+        empty = True;
+      }
+    }
+    if (!empty) {
+      const Float* tile = getTile (tileNr);
+      // Copy the lines along the first axis.
+      pos = first;
+      while (True) {
+        Int64 inOff  = first(0) - start(0);
+        Int64 outOff = (first(0) - blc(0)) / inc(0);
+        for (uInt i=1; i<ndim; ++i) {
+          inOff  += (pos(i) - start(i)) * tileStride(i);
+          outOff += (pos(i) - blc(i)) / inc(i) * outStride(i);
+        }
+        const Float* in = tile + inOff;
+        Float* to = out + outOff;
+        for (Int64 j=first(0); j<=last(0); j+=inc(0)) {
+          *to++ = *in;
+          in += inc(0);
+        }
+        uInt ax;
+        for (ax=1; ax<ndim; ++ax) {
+          pos(ax) += inc(ax);
+          if (pos(ax) <= last(ax)) {
+            break;
+          }
+          pos(ax) = first(ax);
+        }
+        if (ax >= ndim) {
+          break;
+        }
+      }
+    }
+    // Go to the next tile.
+    uInt ax;
+    for (ax=0; ax<ndim; ++ax) {
+      tileNr(ax)++;
+      if (tileNr(ax) <= tileTrc(ax)) {
+        break;
+      }
+      tileNr(ax) = tileBlc(ax);
+    }
+    if (ax >= ndim) {
+      break;
+    }
+  }
+  buffer.putStorage (out, deleteIt);
+}
+
+void FITSCompressedFile::compress (const String& inName,
+                                   const String& outName,
+                                   const String& type,
+                                   const IPosition& tileShape,
+                                   Float quantizeLevel)
+{
+  int comptype;
+  String utype(type);
+  utype.upcase();
+  if (utype == "RICE_1") {
+    comptype = RICE_1;
+  } else if (utype == "GZIP_1") {
+    comptype = GZIP_1;
+  } else if (utype == "GZIP_2") {
+    comptype = GZIP_2;
+  } else if (utype == "HCOMPRESS_1") {
+    comptype = HCOMPRESS_1;
+  } else if (utype == "PLIO_1") {
+    comptype = PLIO_1;
+  } else {
+    throw AipsError ("FITSCompressedFile: unknown compression type " + type);
+  }
+  fitsfile* in = 0;
+  fitsfile* out = 0;
+  int status = 0;
+  fits_open_file (&in, inName.chars(), READONLY, &status);
+  checkStatus (status, "FITSCompressedFile: cannot open " + inName);
+  fits_create_file (&out, outName.chars(), &status);
+  if (status != 0) {
+    int st = 0;
+    fits_close_file (in, &st);
+    checkStatus (status, "FITSCompressedFile: cannot create " + outName);
+  }
+  fits_set_compression_type (out, comptype, &status);
+  if (tileShape.nelements() > 0) {
+    Block<long> tile(tileShape.nelements());
+    for (uInt i=0; i<tile.nelements(); ++i) {
+      tile[i] = tileShape(i);
+    }
+    fits_set_tile_dim (out, tile.nelements(), tile.storage(), &status);
+  }
+  fits_set_quantize_level (out, quantizeLevel, &status);
+  // Compress the image and copy the other HDUs.
+  int hdutype, nhdu;
+  fits_movabs_hdu (in, 1, &hdutype, &status);
+  fits_img_compress (in, out, &status);
+  fits_get_num_hdus (in, &nhdu, &status);
+  for (int i=2; i<=nhdu && status==0; ++i) {
+    fits_movabs_hdu (in, i, &hdutype, &status);
+    fits_copy_hdu (in, out, 0, &status);
+  }
+  int st = 0;
+  fits_close_file (out, &st);
+  fits_close_file (in, &st);
+  checkStatus (status, "FITSCompressedFile: cannot compress " + inName +
+               " into " + outName);
+}
+
+void FITSCompressedFile::checkStatus (int status, const String& msg)
+{
+  if (status != 0) {
+    char text[FLEN_STATUS];
+    fits_get_errstatus (status, text);
+    throw AipsError (msg + ": " + String(text));
+  }
+}
+
+} //# NAMESPACE CASA - END
@@ -0,0 +1,217 @@
+//# FITSCompressedFile.h: Access to a tile-compressed FITS image
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef FITS_FITSCOMPRESSEDFILE_H
+#define FITS_FITSCOMPRESSEDFILE_H
+
+//# Includes
+#include <casa/aips.h>
+#include <casa/Arrays/IPosition.h>
+#include <casa/Arrays/Vector.h>
+#include <casa/Containers/Block.h>
+#include <casa/BasicSL/String.h>
+#include <casa/OS/Mutex.h>
+#include <casa/iosfwd.h>
+#include <map>
+
+//# Make sure that cfitsio does not declare the wcs headers.
+extern "C"{
+#include <fitsio.h>  //# header file from cfitsio
+}
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+//# Forward Declarations
+template<class T> class Array;
+class Slicer;
+
+
+// <summary>
+// Access to a tile-compressed FITS image
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tFITSImage.cc">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class=TiledFileAccess>TiledFileAccess</linkto>
+// </prerequisite>
+
+// <synopsis>
+// A tile-compressed FITS image (as made by e.g. fpack) is stored in a
+// binary table. Each row of the table holds a compressed tile of the
+// image (RICE, GZIP, HCOMPRESS or PLIO). Floating point data are usually
+// quantised to integers before being compressed.
+// <p>
+// This class gives access to such an image using cfitsio. Tiles are only
+// decompressed when needed. The decompressed tiles are kept in a cache,
+// so the access is similar to <linkto class=TiledFileAccess>
+// TiledFileAccess</linkto>. The least recently used tiles are removed
+// from the cache when it gets full.
+// <p>
+// The data are always returned as Float. Scaling factors (BSCALE, BZERO)
+// are applied, and blanked pixels are returned as NaN.
+// <p>
+// The static function <src>compress</src> writes a tile-compressed copy
+// of the image in a FITS file. Other HDUs are copied unchanged.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   FITSCompressedFile file ("image.fits.fz", 1);
+//   Array<Float> plane;
+//   file.get (plane, Slicer(IPosition(3,0), IPosition(3,file.shape()(0),
+//                                                   file.shape()(1), 1)));
+// </srcblock>
+// </example>
+
+// <motivation>
+// Tile-compressed FITS files take a few times less space, and reading
+// and decompressing them can be faster than reading the uncompressed data.
+// </motivation>
+
+class FITSCompressedFile
+{
+public:
+  // Open the image in the given HDU (0-relative) of the file.
+  // An exception is thrown if it is not a tile-compressed image.
+  // The cache can hold <src>maximumCacheSize</src> bytes of
+  // decompressed data.
+  FITSCompressedFile (const String& fileName, uInt whichHDU,
+                      uInt maximumCacheSize = 32*1024*1024);
+
+  // The destructor closes the file.
+  ~FITSCompressedFile();
+
+  // Is the given HDU (0-relative) a tile-compressed image?
+  // If <src>whichHDU</src> is 0 and the primary array is empty, the first
+  // extension is tested. If that is a compressed image,
+  // <src>whichHDU</src> is set to 1.
+  static Bool isCompressed (const String& fileName, uInt& whichHDU);
+
+  // Get the shape of the image.
+  const IPosition& shape() const
+    { return itsShape; }
+
+  // Get the shape of the compressed tiles.
+  const IPosition& tileShape() const
+    { return itsTileShape; }
+
+  // Get the BITPIX value of the uncompressed image.
+  Int bitpix() const
+    { return itsBitpix; }
+
+  // Get the header cards of the image as they would be for the
+  // uncompressed image. Each card has 80 characters, the last one is END.
+  Vector<String> header();
+
+  // Get a section of the image. The section can have strides.
+  void get (Array<Float>& buffer, const Slicer& section);
+
+  // Get or set the maximum size of the cache (in bytes).
+  // A cache holds at least one tile.
+  // <group>
+  uInt maximumCacheSize() const
+    { return itsMaxCacheSize; }
+  void setMaximumCacheSize (uInt nbytes);
+  // </group>
+
+  // Set the maximum size of the cache in tiles.
+  void setCacheSize (uInt nrTiles);
+
+  // Set the cache size such that it can hold the tiles needed to step
+  // through the window with the given slice shape along the axis path.
+  void setCacheSize (const IPosition& sliceShape,
+                     const IPosition& windowStart,
+                     const IPosition& windowLength,
+                     const IPosition& axisPath);
+
+  // Remove all tiles from the cache.
+  void clearCache();
+
+  // Show the cache statistics.
+  void showCacheStatistics (ostream& os) const;
+
+  // Write a tile-compressed copy of the first HDU of the FITS file
+  // <src>inName</src>, which must be an image, to the file
+  // <src>outName</src>. The other HDUs are copied unchanged.
+  // <br><src>type</src> is the compression algorithm (RICE_1, GZIP_1,
+  // GZIP_2, HCOMPRESS_1 or PLIO_1). The tiles have the given shape; if
+  // empty, each row is a tile. Floating point data are quantised such that
+  // the noise is sampled with <src>quantizeLevel</src> levels (16 is the
+  // cfitsio default). A negative value gives the absolute quantisation step.
+  // A value of zero compresses floating point data losslessly (only GZIP).
+  static void compress (const String& inName, const String& outName,
+                        const String& type = "RICE_1",
+                        const IPosition& tileShape = IPosition(),
+                        Float quantizeLevel = 16);
+
+private:
+  // Forbid copy constructor and assignment.
+  // <group>
+  FITSCompressedFile (const FITSCompressedFile&);
+  FITSCompressedFile& operator= (const FITSCompressedFile&);
+  // </group>
+
+  // A decompressed tile in the cache.
+  struct CacheEntry {
+    Block<Float> data;
+    uInt64       lastUse;
+  };
+
+  // Get the given tile from the cache, or decompress it.
+  const Float* getTile (const IPosition& tileNr);
+
+  // Remove the least recently used tiles until one more fits in the cache.
+  void makeRoom();
+
+  // Throw an exception with the cfitsio error message if status != 0.
+  static void checkStatus (int status, const String& msg);
+
+  fitsfile*  itsFile;
+  String     itsName;
+  IPosition  itsShape;
+  IPosition  itsTileShape;
+  IPosition  itsNrTiles;
+  Int        itsBitpix;
+  uInt       itsMaxCacheSize;
+  uInt       itsMaxNrTiles;
+  std::map<Int64,CacheEntry> itsCache;
+  uInt64     itsClock;
+  uInt64     itsNrAccess;
+  uInt64     itsNrDecompress;
+  // cfitsio is only thread-safe if built reentrant, so tiles of different
+  // files are not decompressed at the same time.
+  static Mutex theirMutex;
+};
+
+
+} //# NAMESPACE CASA - END
+
+#endif
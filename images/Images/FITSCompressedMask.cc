@@ -0,0 +1,74 @@
+//# FITSCompressedMask.cc: Provides an on-the-fly mask for tile-compressed FITS images
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <images/Images/FITSCompressedMask.h>
+#include <fits/FITS/FITSCompressedFile.h>
+#include <casa/Arrays/Array.h>
+#include <casa/Arrays/Slicer.h>
+
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+FITSCompressedMask::FITSCompressedMask (FITSCompressedFile* compressedFile)
+: itsFilePtr (compressedFile)
+{}
+
+FITSCompressedMask::FITSCompressedMask (const FITSCompressedMask& other)
+: FITSMask   (other),
+  itsFilePtr (other.itsFilePtr)
+{}
+
+FITSCompressedMask::~FITSCompressedMask()
+{}
+
+FITSCompressedMask& FITSCompressedMask::operator=
+                                         (const FITSCompressedMask& other)
+{
+  if (this != &other) {
+    FITSMask::operator= (other);
+    itsFilePtr = other.itsFilePtr;
+  }
+  return *this;
+}
+
+Lattice<Bool>* FITSCompressedMask::clone() const
+{
+  return new FITSCompressedMask (*this);
+}
+
+IPosition FITSCompressedMask::shape() const
+{
+  return itsFilePtr->shape();
+}
+
+void FITSCompressedMask::getData (Array<Float>& buffer, const Slicer& section)
+{
+  itsFilePtr->get (buffer, section);
+}
+
+
+} //# NAMESPACE CASA - END
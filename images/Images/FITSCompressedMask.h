@@ -0,0 +1,97 @@
+//# FITSCompressedMask.h: Provides an on-the-fly mask for tile-compressed FITS images
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef IMAGES_FITSCOMPRESSEDMASK_H
+#define IMAGES_FITSCOMPRESSEDMASK_H
+
+//# Includes
+#include <casa/aips.h>
+#include <lattices/Lattices/FITSMask.h>
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+//# Forward Declarations
+class FITSCompressedFile;
+
+// <summary>
+// Provides an on-the-fly mask for tile-compressed FITS images
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tFITSImage.cc">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class="FITSMask">FITSMask</linkto>
+//   <li> <linkto class="FITSCompressedFile">FITSCompressedFile</linkto>
+// </prerequisite>
+
+// <synopsis>
+// Like <linkto class="FITSMask">FITSMask</linkto> it derives the mask of
+// a FITS image from the NaN (and optionally 0.0) data values, but the
+// data are read from a
+// <linkto class="FITSCompressedFile">FITSCompressedFile</linkto> object.
+// It is the pixel mask of a FITSImage using a tile-compressed FITS file.
+// Because the mask and the image share the FITSCompressedFile object,
+// they also share its cache of decompressed tiles.
+// </synopsis>
+
+class FITSCompressedMask : public FITSMask
+{
+public:
+  // The pointer is not cloned, just copied.
+  explicit FITSCompressedMask (FITSCompressedFile* compressedFile);
+
+  // Copy constructor (reference semantics).
+  // The FITSCompressedFile pointer is just copied.
+  FITSCompressedMask (const FITSCompressedMask& other);
+
+  virtual ~FITSCompressedMask();
+
+  // The assignment operator with reference semantics.
+  // The FITSCompressedFile pointer is just copied.
+  FITSCompressedMask& operator= (const FITSCompressedMask& other);
+
+  // Make a copy of the object (reference semantics).
+  virtual Lattice<Bool>* clone() const;
+
+  // Return the shape of the image.
+  virtual IPosition shape() const;
+
+protected:
+  // Get the data values from the compressed file.
+  virtual void getData (Array<Float>& buffer, const Slicer& section);
+
+private:
+  FITSCompressedFile* itsFilePtr;
+};
+
+
+} //# NAMESPACE CASA - END
+
+#endif
@@ -38,6 +38,8 @@
 #include <lattices/Lattices/TiledShape.h>
 #include <lattices/Lattices/TempLattice.h>
 #include <lattices/Lattices/FITSMask.h>
+#include <images/Images/FITSCompressedMask.h>
+#include <fits/FITS/FITSCompressedFile.h>
 #include <tables/Tables/TiledFileAccess.h>
 #include <coordinates/Coordinates/CoordinateSystem.h>
 #include <coordinates/Coordinates/CoordinateUtil.h>
@@ -57,6 +59,7 @@
 #include <casa/Exceptions/Error.h>
 
 #include <casa/iostream.h>
+#include <casa/sstream.h>
 
 
 
@@ -79,7 +82,8 @@ FITSImage::FITSImage (const String& name, uInt whichRep, uInt whichHDU)
   filterZeroMask_p(False),
   whichRep_p(whichRep),
   whichHDU_p(whichHDU),
-  _hasBeamsTable(False)
+  _hasBeamsTable(False),
+  isCompressed_p(False)
 {
    setup();
 }
@@ -102,7 +106,8 @@ FITSImage::FITSImage (const String& name, const MaskSpecifier& maskSpec, uInt wh
   filterZeroMask_p(False),
   whichRep_p(whichRep),
   whichHDU_p(whichHDU),
-  _hasBeamsTable(False)
+  _hasBeamsTable(False),
+  isCompressed_p(False)
 {
    setup();
 }
@@ -113,6 +118,7 @@ FITSImage::FITSImage (const FITSImage& other)
   fullname_p  (other.fullname_p),
   maskSpec_p  (other.maskSpec_p),
   pTiledFile_p(other.pTiledFile_p),
+  pCompressed_p(other.pCompressed_p),
   pPixelMask_p(0),
   shape_p     (other.shape_p),
   scale_p     (other.scale_p),
@@ -127,7 +133,8 @@ FITSImage::FITSImage (const FITSImage& other)
   filterZeroMask_p(other.filterZeroMask_p),
   whichRep_p(other.whichRep_p),
   whichHDU_p(other.whichHDU_p),
-  _hasBeamsTable(other._hasBeamsTable)
+  _hasBeamsTable(other._hasBeamsTable),
+  isCompressed_p(other.isCompressed_p)
 
 {
    if (other.pPixelMask_p != 0) {
@@ -144,6 +151,7 @@ FITSImage& FITSImage::operator=(const FITSImage& other)
       ImageInterface<Float>::operator= (other);
 //
       pTiledFile_p = other.pTiledFile_p;             // Counted pointer
+      pCompressed_p = other.pCompressed_p;           // Counted pointer
 //
       delete pPixelMask_p;
       pPixelMask_p = 0;
@@ -168,6 +176,7 @@ FITSImage& FITSImage::operator=(const FITSImage& other)
       whichRep_p = other.whichRep_p;
       whichHDU_p = other.whichHDU_p;
       _hasBeamsTable = other._hasBeamsTable;
+      isCompressed_p = other.isCompressed_p;
    }
    return *this;
 } 
@@ -376,7 +385,9 @@ Bool FITSImage::doGetSlice(Array<Float>& buffer,
                            const Slicer& section)
 {
    reopenIfNeeded();
-   if (pTiledFile_p->dataType() == TpFloat) {
+   if (isCompressed_p) {
+      pCompressed_p->get (buffer, section);
+   } else if (pTiledFile_p->dataType() == TpFloat) {
       pTiledFile_p->get (buffer, section);
    } else if (pTiledFile_p->dataType() == TpDouble) {
       Array<Double> tmp;
@@ -482,6 +493,7 @@ void FITSImage::tempClose()
       pPixelMask_p = 0;
 //
       pTiledFile_p = 0;
+      pCompressed_p = 0;
       isClosed_p = True;
    }
 }
@@ -493,9 +505,41 @@ void FITSImage::reopen()
    }
 }
 
+void FITSImage::setTileShape (const IPosition& tileShape)
+{
+   const IPosition& shape = shape_p.shape();
+   Bool valid = (tileShape.nelements() == shape.nelements());
+   for (uInt i=0; valid && i<tileShape.nelements(); i++) {
+      valid = (tileShape(i) > 0  &&  tileShape(i) <= shape(i));
+   }
+   if (!valid) {
+      ostringstream oss;
+      oss << tileShape;
+      throw AipsError ("FITSImage::setTileShape - invalid tile shape "
+                       + String(oss) + " for image " + name_p);
+   }
+   reopenIfNeeded();
+   if (isCompressed_p  ||  pTiledFile_p->isMapped()) {
+      shape_p = TiledShape (shape, tileShape);
+   } else {
+      if (!TiledFileAccess::isContiguous (shape, tileShape)) {
+         throw AipsError ("FITSImage::setTileShape - image " + name_p +
+                          " is not memory-mapped, so the tile shape must"
+                          " consist of full axes followed by part of an axis");
+      }
+// Reopen to use the new tile shape for the cache.
+      shape_p = TiledShape (shape, tileShape);
+      tempClose();
+      open();
+   }
+}
+
 uInt FITSImage::maximumCacheSize() const
 {
    reopenIfNeeded();
+   if (isCompressed_p) {
+      return pCompressed_p->maximumCacheSize() / sizeof(Float);
+   }
    return pTiledFile_p->maximumCacheSize() / ValType::getTypeSize(dataType_p);
 }
 
@@ -503,7 +547,11 @@ void FITSImage::setMaximumCacheSize (uInt howManyPixels)
 {
    reopenIfNeeded();
    const uInt sizeInBytes = howManyPixels * ValType::getTypeSize(dataType_p);
-   pTiledFile_p->setMaximumCacheSize (sizeInBytes);
+   if (isCompressed_p) {
+      pCompressed_p->setMaximumCacheSize (sizeInBytes);
+   } else {
+      pTiledFile_p->setMaximumCacheSize (sizeInBytes);
+   }
 }
 
 void FITSImage::setCacheSizeFromPath (const IPosition& sliceShape, 
@@ -512,21 +560,34 @@ void FITSImage::setCacheSizeFromPath (const IPosition& sliceShape,
 				      const IPosition& axisPath)
 {
    reopenIfNeeded();
-   pTiledFile_p->setCacheSize (sliceShape, windowStart,
-			       windowLength, axisPath);
+   if (isCompressed_p) {
+      pCompressed_p->setCacheSize (sliceShape, windowStart,
+                                   windowLength, axisPath);
+   } else {
+      pTiledFile_p->setCacheSize (sliceShape, windowStart,
+                                  windowLength, axisPath);
+   }
 }
 
 void FITSImage::setCacheSizeInTiles (uInt howManyTiles)  
 {  
    reopenIfNeeded();
-   pTiledFile_p->setCacheSize (howManyTiles);
+   if (isCompressed_p) {
+      pCompressed_p->setCacheSize (howManyTiles);
+   } else {
+      pTiledFile_p->setCacheSize (howManyTiles);
+   }
 }
 
 
 void FITSImage::clearCache()
 {
    if (! isClosed_p) {
-      pTiledFile_p->clearCache();
+      if (isCompressed_p) {
+         pCompressed_p->clearCache();
+      } else {
+         pTiledFile_p->clearCache();
+      }
    }
 }
 
@@ -534,7 +595,11 @@ void FITSImage::showCacheStatistics (ostream& os) const
 {
    reopenIfNeeded();
    os << "FITSImage statistics : ";
-   pTiledFile_p->showCacheStatistics (os);
+   if (isCompressed_p) {
+      pCompressed_p->showCacheStatistics (os);
+   } else {
+      pTiledFile_p->showCacheStatistics (os);
+   }
 }
 
 
@@ -546,28 +611,25 @@ void FITSImage::setup()
 
    name_p = get_fitsname(fullname_p);
 
-// Determine the HDU index from the extension specification
-   uInt HDUnum = get_hdunum(fullname_p);
-
-
-// Compare the HDU index given directly and
-// the one extracted from the name
-   if (HDUnum != whichHDU_p){
-
-// if an extension information was given,
-// the index extracted from it wins
-	   if (name_p != fullname_p){
-		   whichHDU_p = HDUnum;
-	   }
-	   else {
+// A tile-compressed image is stored in a binary table, which is not
+// seen as an image by FITSImgParser. So test for it first; it cannot be
+// given by an extension specification.
+   uInt compressedHDU = whichHDU_p;
+   isCompressed_p = (name_p == fullname_p  &&
+                     FITSCompressedFile::isCompressed (name_p, compressedHDU));
+   if (isCompressed_p) {
+      whichHDU_p = compressedHDU;
+   } else {
 
-// if the index given directly is zero (which means the default),
-// the zeroth index might be emptied and the index retrieved
-// in the method above (which is 1) is used
-		   if (!whichHDU_p) {
-			   whichHDU_p = HDUnum;
-		   }
-	   }
+// Determine the HDU index from the extension specification.
+// If an extension specification was given, the index extracted from it
+// wins. Otherwise, if the index given directly is zero (the default), the
+// zeroth HDU might be empty and the index found by get_hdunum is used.
+      uInt HDUnum = get_hdunum(fullname_p);
+      if (HDUnum != whichHDU_p  &&
+          (name_p != fullname_p  ||  whichHDU_p == 0)) {
+         whichHDU_p = HDUnum;
+      }
    }
 
    if (name_p.empty()) {
@@ -586,19 +648,29 @@ void FITSImage::setup()
    IPosition shape;
    ImageInfo imageInfo;
    Unit brightnessUnit;
-   Int recno;
-   Int recsize;          // Should be 2880 bytes (unless blocking used)
+   Int recno = 0;
+   Int recsize = 0;      // Should be 2880 bytes (unless blocking used)
    FITS::ValueType dataType;
    Record miscInfo;
 
 // hasBlanks only relevant to Integer images.  Says if 'blank' value defined in header
-
-   getImageAttributes(cSys, shape, imageInfo, brightnessUnit, miscInfo, 
-                      recsize, recno, dataType, scale_p, offset_p, 
-		      uCharMagic_p, shortMagic_p,
-                      longMagic_p, hasBlanks_p, fullName,  whichRep_p, whichHDU_p);
-   // shape must be set before image info in cases of multiple beams
-   shape_p = TiledShape (shape, TiledFileAccess::makeTileShape(shape));
+// A compressed image is always read as Float with blanks as NaN.
+
+   if (isCompressed_p) {
+      IPosition tileShape;
+      getCompressedAttributes (cSys, shape, tileShape, imageInfo,
+                               brightnessUnit, miscInfo, fullName, whichRep_p);
+      dataType = FITS::FLOAT;
+      // shape must be set before image info in cases of multiple beams
+      shape_p = TiledShape (shape, tileShape);
+   } else {
+      getImageAttributes(cSys, shape, imageInfo, brightnessUnit, miscInfo, 
+                         recsize, recno, dataType, scale_p, offset_p, 
+                         uCharMagic_p, shortMagic_p,
+                         longMagic_p, hasBlanks_p, fullName,  whichRep_p, whichHDU_p);
+      // shape must be set before image info in cases of multiple beams
+      shape_p = TiledShape (shape, TiledFileAccess::makeTileShape(shape));
+   }
    setMiscInfoMember (miscInfo);
 
 // set ImageInterface data
@@ -618,7 +690,9 @@ void FITSImage::setup()
 // MK: I think there is an additional read() and hence
 // count-up of recno when the file is first accessed and
 // then for every skipped hdu, thats where the "-1 - whichHDU comes from"
-   fileOffset_p += (recno - 1 - whichHDU_p) * recsize;
+   if (!isCompressed_p) {
+      fileOffset_p += (recno - 1 - whichHDU_p) * recsize;
+   }
 //
    dataType_p = TpFloat;
    if (dataType == FITS::DOUBLE) {
@@ -652,7 +726,7 @@ void FITSImage::setup()
    open();
 
    // Finally, read any supported extensions, like a BEAMS table
-   if (_hasBeamsTable) {
+   if (_hasBeamsTable  &&  !isCompressed_p) {
      ImageFITSConverter::readBeamsTable(imageInfo, fullName, dataType_p);
    }
    setImageInfoMember (imageInfo);
@@ -661,14 +735,44 @@ void FITSImage::setup()
 
 void FITSImage::open()
 {
+// A compressed image is decompressed by cfitsio. The mask shares the
+// FITSCompressedFile object, thus also its cache.
+
+   if (isCompressed_p) {
+      pCompressed_p = new FITSCompressedFile (name_p, whichHDU_p);
+      if (hasBlanks_p) {
+         FITSCompressedMask* fitsMask =
+                               new FITSCompressedMask (&(*pCompressed_p));
+         fitsMask->setFilterZero(filterZeroMask_p);
+         pPixelMask_p = fitsMask;
+      }
+      isClosed_p = False;
+      return;
+   }
+
    Bool writable = False;
    Bool canonical = True;    
 
-// The tile shape must not be a subchunk in all dimensions
+// The tile shape must not be a subchunk in all dimensions.
+// A virtual tile shape used for a memory-mapped file may not be a valid
+// tile shape for the cache.
+
+   IPosition tileShape = shape_p.tileShape();
+   if (!TiledFileAccess::isContiguous (shape_p.shape(), tileShape)) {
+      tileShape = TiledFileAccess::makeTileShape (shape_p.shape());
+   }
+
+// Use memory-mapped IO on 64-bit systems; the address space on 32-bit
+// systems is too small for large images.
 
+#ifdef AIPS_64B
+   TSMOption tsmOpt(TSMOption::MMap);
+#else
+   TSMOption tsmOpt;
+#endif
    pTiledFile_p = new TiledFileAccess(name_p, fileOffset_p,
-				      shape_p.shape(), shape_p.tileShape(),
-                                      dataType_p, TSMOption(),
+				      shape_p.shape(), tileShape,
+                                      dataType_p, tsmOpt,
 				      writable, canonical);
 
 // Shares the pTiledFile_p pointer. Scale factors for integers
@@ -827,6 +931,217 @@ void FITSImage::getImageAttributes (CoordinateSystem& cSys,
     recordnumber = infile.recno();
 }
 
+void FITSImage::getCompressedAttributes (CoordinateSystem& cSys,
+                                         IPosition& shape,
+                                         IPosition& tileShape,
+                                         ImageInfo& imageInfo,
+                                         Unit& brightnessUnit,
+                                         RecordInterface& miscInfo,
+                                         const String& name, uInt whichRep)
+{
+    LogIO os(LogOrigin("FITSImage", "getCompressedAttributes", WHERE));
+    FITSCompressedFile file (name, whichHDU_p);
+    shape = file.shape();
+
+// The header cards are those of the uncompressed image.
+// Make a keyword list from them for the history.
+
+    Vector<String> header = file.header();
+    FitsKeywordList kwl;
+    for (uInt i=0; i<header.nelements(); i++) {
+       kwl.parse (header(i).chars(), header(i).length());
+    }
+    ConstFitsKeywordList kw(kwl);
+
+// BITPIX gives the type of the uncompressed data.
+// Scaling and blanking are done by cfitsio.
+
+    DataType dataType = TpFloat;
+    switch (file.bitpix()) {
+    case 8:
+       dataType = TpUChar;
+       break;
+    case 16:
+       dataType = TpShort;
+       break;
+    case 32:
+       dataType = TpInt;
+       break;
+    case -64:
+       dataType = TpDouble;
+       break;
+    }
+    Float scale, offset;
+    uChar uCharMagic;
+    Short shortMagic;
+    Int longMagic;
+    Bool hasBlanks;
+    crackHeaderCards (cSys, shape, imageInfo, brightnessUnit, miscInfo,
+                      scale, offset, uCharMagic, shortMagic, longMagic,
+                      hasBlanks, os, header, kw, dataType, whichRep,
+                      whichHDU_p > 0);
+
+// The virtual tile shape consists of whole compression tiles and holds
+// about 32768 pixels (like TiledFileAccess::makeTileShape).
+
+    tileShape = file.tileShape();
+    uInt64 nrPixels = tileShape.product();
+    for (uInt i=0; i<tileShape.nelements(); i++) {
+       Int64 nrTiles = (shape(i) + tileShape(i) - 1) / tileShape(i);
+       Int64 factor = std::min (nrTiles, Int64(std::max (uInt64(1),
+                                                         32768 / nrPixels)));
+       tileShape(i) = std::min (Int64(shape(i)), tileShape(i) * factor);
+       nrPixels *= factor;
+    }
+}
+
+void FITSImage::crackHeaderCards (CoordinateSystem& cSys,
+                                  IPosition& shape, ImageInfo& imageInfo,
+                                  Unit& brightnessUnit,
+                                  RecordInterface& miscInfo,
+                                  Float& scale, Float& offset, 
+                                  uChar& magicUChar, Short& magicShort, 
+                                  Int& magicInt, Bool& hasBlanks, 
+                                  LogIO& os, const Vector<String>& header,
+                                  ConstFitsKeywordList& kw, DataType dataType,
+                                  uInt whichRep, Bool isExtension)
+{
+// Get Coordinate System.  Return un-used FITS cards in a Record for further use.
+
+    Record headerRec;
+    Bool dropStokes = True;
+    Int stokesFITSValue = 1;
+    cSys = ImageFITSConverter::getCoordinateSystem(stokesFITSValue, headerRec, header,
+                                                   os, whichRep, shape, dropStokes);
+
+    _hasBeamsTable = headerRec.isDefined(ImageFITSConverter::CASAMBM)
+      && headerRec.asRecord(ImageFITSConverter::CASAMBM).asBool("value");
+
+// BITPIX
+
+    Int bitpix;   
+    Record subRec = headerRec.asRecord("bitpix");
+    subRec.get("value", bitpix);
+    headerRec.removeField("bitpix");   
+    if (dataType==TpFloat) {
+       if (bitpix != -32) {
+          throw (AipsError("bitpix card inconsistent with data type: expected bitpix = -32"));
+       }  
+    } else if (dataType==TpDouble) {
+       if (bitpix != -64) {
+          throw (AipsError("bitpix card inconsistent with data type: expected bitpix = -64"));
+       }  
+    } else if (dataType==TpInt) {
+       if (bitpix != 32) {
+          throw (AipsError("bitpix card inconsistent with data type: expected bitpix = 32"));
+       }  
+    } else if (dataType==TpShort) {
+       if (bitpix != 16) {
+          throw (AipsError("bitpix card inconsistent with data type: expected bitpix = 16"));
+       }  
+    } else if (dataType==TpUChar) {
+       if (bitpix != 8) {
+          throw (AipsError("bitpix card inconsistent with data type: expected bitpix = 8"));
+       }  
+    } else {
+       throw (AipsError("Unsupported Template type; Float & Double only are supported"));
+    }
+
+// Scale and blank (will only be present for Int and Short)
+
+    Double s = 1.0;
+    Double o = 0.0;
+    if (headerRec.isDefined("bscale")) {
+       subRec = headerRec.asRecord("bscale");
+       subRec.get("value", s);
+       headerRec.removeField("bscale");
+    }
+    if (headerRec.isDefined("bzero")) {
+       subRec = headerRec.asRecord("bzero");
+       subRec.get("value", o);
+       headerRec.removeField("bzero");
+    }
+    scale = s; 
+    offset = o;
+
+// Will only be present for Int and Short and uChar
+
+    hasBlanks = False;
+    if (headerRec.isDefined("blank")) {
+       subRec = headerRec.asRecord("blank");
+       Int m;
+       subRec.get("value", m);
+       headerRec.removeField("blank");
+       if (dataType==TpUChar) {
+          magicUChar = m;
+       } else if (dataType==TpShort) {
+          magicShort = m;
+       } else if (dataType==TpInt) {
+          magicInt = m;
+       } else {
+          magicUChar = m;
+          magicShort = m;
+          magicInt = m;
+       }
+       hasBlanks = True;
+    }
+
+// Brightness Unit
+
+    brightnessUnit = ImageFITSConverter::getBrightnessUnit(headerRec, os);
+
+// ImageInfo
+
+    imageInfo = ImageFITSConverter::getImageInfo(headerRec);
+
+// If we had one of those unofficial pseudo-Stokes on the Stokes axis, store it in the imageInfo
+
+    if (stokesFITSValue != -1) {
+       ImageInfo::ImageTypes type = ImageInfo::imageTypeFromFITS(stokesFITSValue);
+       if (type!= ImageInfo::Undefined) {
+          imageInfo.setImageType(type);
+       }
+    }
+
+// Get rid of anything else we don't want to end up in MiscInfo
+// that will have passed through the FITS parsing process
+
+    Vector<String> ignore(isExtension ? 12 : 9);
+    ignore(0) = "^datamax$";
+    ignore(1) = "^datamin$";
+    ignore(2) = "^origin$";
+    ignore(3) = "^extend$";
+    ignore(4) = "^blocked$";
+    ignore(5) = "^blank$";
+    ignore(6) = "^simple$";
+    ignore(7) = "bscale";
+    ignore(8) = "bzero";
+    if (isExtension) {
+       ignore(9) = "xtension";
+       ignore(10) = "pcount";
+       ignore(11) = "gcount";
+    }
+    FITSKeywordUtil::removeKeywords(headerRec, ignore);
+
+// MiscInfo is whats left
+
+    ImageFITSConverter::extractMiscInfo(miscInfo, headerRec);
+
+// Set the contents of the ImageInterface logger object (history)
+
+    kw.first();
+    LoggerHolder& log = logger();
+    ImageFITSConverter::restoreHistory(log, kw);
+
+// Try and find the restoring beam in the history cards if
+// its not in the header
+
+    Bool hasBeam = (isExtension ? imageInfo.hasSingleBeam() : imageInfo.hasBeam());
+    if (! hasBeam) {
+       imageInfo.getRestoringBeam(log);
+    }
+}
+
 void FITSImage::setMaskZero(Bool filterZero)
 {
 	// set the zero masking on the
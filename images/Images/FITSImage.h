@@ -47,6 +47,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 //# Forward Declarations
 template <class T> class Array;
 template <class T> class Lattice;
+template <class T> class Vector;
 //
 class MaskSpecifier;
 class IPosition;
@@ -54,6 +55,7 @@ class Slicer;
 class CoordinateSystem;
 class FITSMask;
 class FitsInput;
+class FITSCompressedFile;
 
 
 // <summary>
@@ -85,6 +87,26 @@ class FitsInput;
 //
 //  Because FITS uses magic value blanking, the mask is generated
 //  on the fly as needed.
+//
+//  On 64-bit systems the FITS file is memory-mapped and the data are
+//  read directly from the mapped file (see
+//  <linkto class=TiledFileAccess>TiledFileAccess</linkto>).
+//  The data in a FITS file are not tiled, but the FITSImage has a virtual
+//  tile shape which is used to advise the cursor shape for iterating
+//  through the image (e.g. by
+//  <linkto class=LatticeIterator>LatticeIterator</linkto>).
+//  By default the tile consists of the first axes of the image and holds
+//  about 32768 pixels. Function <src>setTileShape</src> can be used to
+//  define a tile shape suited to the access pattern, for instance
+//  <src>IPosition(3,1,1,nz)</src> for spectrum-wise access or
+//  <src>IPosition(3,nx,ny,1)</src> for plane-wise access.
+//
+//  Tile-compressed FITS images (e.g. made by fpack) are also supported.
+//  They are accessed using <linkto class=FITSCompressedFile>
+//  FITSCompressedFile</linkto>, which decompresses the tiles when needed
+//  and keeps them in a cache. Their virtual tile shape consists of whole
+//  compression tiles. Note that a BEAMS table is not read for a
+//  compressed image.
 // </synopsis> 
 
 // <example>
@@ -219,9 +241,22 @@ public:
   virtual Bool ok() const;
 
   // Return the (internal) data type (TpFloat or TpShort).
+  // It is TpFloat for a tile-compressed image.
   DataType dataType () const
     { return dataType_p; }
 
+  // Is the image tile-compressed?
+  Bool isCompressed() const
+    { return isCompressed_p; }
+
+  // Set the virtual tile shape.
+  // If the file is not memory-mapped nor compressed, the tile shape determines how the
+  // data are held in the cache, so it must consist of full axes optionally
+  // followed by a part of an axis (as made by
+  // <src>TiledFileAccess::makeTileShape</src>). Otherwise an exception
+  // is thrown.
+  void setTileShape (const IPosition& tileShape);
+
   // Return the HDU number
   uInt whichHDU () const
     { return whichHDU_p; }
@@ -261,6 +296,7 @@ private:
   String         fullname_p;
   MaskSpecifier  maskSpec_p;
   CountedPtr<TiledFileAccess> pTiledFile_p;
+  CountedPtr<FITSCompressedFile> pCompressed_p;
   Lattice<Bool>* pPixelMask_p;
   TiledShape     shape_p;
   Float          scale_p;
@@ -276,6 +312,7 @@ private:
   uInt           whichRep_p;
   uInt           whichHDU_p;
   Bool           _hasBeamsTable;
+  Bool           isCompressed_p;
 
 // Reopen the image if needed.
    void reopenIfNeeded() const
@@ -298,6 +335,25 @@ private:
                             Int& longMagic, Bool& hasBlanks, const String& name,
                             uInt whichRep, uInt whichHDU);
 
+// Fish things out of a tile-compressed FITS image.
+// The virtual tile shape is returned as well.
+   void getCompressedAttributes (CoordinateSystem& cSys,
+                                 IPosition& shape, IPosition& tileShape,
+                                 ImageInfo& info, Unit& brightnessUnit,
+                                 RecordInterface& miscInfo,
+                                 const String& name, uInt whichRep);
+
+// Crack the header cards of an image (used by the functions below).
+// The shape must have been filled in. The data type is used to check BITPIX.
+   void crackHeaderCards (CoordinateSystem& cSys, IPosition& shape,
+                          ImageInfo& imageInfo,
+                          Unit& brightnessUnit, RecordInterface& miscInfo,
+                          Float& scale, Float& offset, uChar& magicUChar,
+                          Short& magicShort, Int& magicLong, Bool& hasBlanks,
+                          LogIO& os, const Vector<String>& header,
+                          ConstFitsKeywordList& kw, DataType dataType,
+                          uInt whichRep, Bool isExtension);
+
 // Crack a primary header
    template <typename T>
    void crackHeader (CoordinateSystem& cSys, IPosition& shape, ImageInfo& imageInfo,
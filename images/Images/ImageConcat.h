@@ -77,6 +77,12 @@ template <class T> class MaskedLattice;
 // underlying images if they are writable.
 //
 // You can also concatenate  a lattice to an image.  
+//
+// The coordinates and shape of the images are kept when they are added,
+// so images need not be reopened to check the next image.
+// The images are accessed through a <linkto class=LatticeConcat>
+// LatticeConcat</linkto> object, which keeps a limited number of images
+// open and can read them in parallel.
 // </synopsis>
 //
 // <example>
@@ -184,6 +190,11 @@ public:
    uInt imageDim() const
      { return latticeConcat_p.latticeDim(); }
 
+// Set the maximum number of images kept open if tempClose is True.
+// See <linkto class=LatticeConcat>LatticeConcat</linkto>.
+   void setMaxOpen (uInt maxOpen)
+     { latticeConcat_p.setMaxOpen (maxOpen); }
+
 // Handle the (un)locking and syncing, etc.
 // <group>
    virtual Bool lock (FileLocker::LockType, uInt nattempts);
@@ -269,6 +280,11 @@ private:
    Vector<Double> pixelValues_p;
    Vector<Double> worldValues_p;
    Coordinate::Type originalAxisType_p;
+   // The coordinates and shape of the image or lattice added last.
+   CoordinateSystem cSysLast_p;
+   IPosition shapeLast_p;
+   // The reference pixels, values and increments of the first image.
+   Vector<Double> refPix0_p, refVal0_p, inc0_p;
 
    Double coordConvert(Int& worldAxis, LogIO& os,
                        const CoordinateSystem& cSys,
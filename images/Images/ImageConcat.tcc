@@ -100,7 +100,12 @@ ImageConcat<T>::ImageConcat (const ImageConcat<T>& other)
   fileName_p(other.fileName_p),
   pixelValues_p(other.pixelValues_p.copy()),
   worldValues_p(other.worldValues_p.copy()),
-  originalAxisType_p(other.originalAxisType_p)
+  originalAxisType_p(other.originalAxisType_p),
+  cSysLast_p(other.cSysLast_p),
+  shapeLast_p(other.shapeLast_p),
+  refPix0_p(other.refPix0_p.copy()),
+  refVal0_p(other.refVal0_p.copy()),
+  inc0_p(other.inc0_p.copy())
 {
   isImage_p.resize(other.isImage_p.nelements());
   isImage_p = other.isImage_p;
@@ -133,6 +138,12 @@ ImageConcat<T>& ImageConcat<T>::operator= (const ImageConcat<T>& other)
      worldValues_p.resize(other.worldValues_p.nelements());
      worldValues_p = other.worldValues_p;
      originalAxisType_p = other.originalAxisType_p;
+     cSysLast_p = other.cSysLast_p;
+     shapeLast_p.resize (other.shapeLast_p.nelements());
+     shapeLast_p = other.shapeLast_p;
+     refPix0_p.assign (other.refPix0_p);
+     refVal0_p.assign (other.refVal0_p);
+     inc0_p.assign (other.inc0_p);
   }
   return *this;
 }
@@ -252,6 +263,12 @@ void ImageConcat<T>::setImage (ImageInterface<T>& image, Bool relax)
     this->setUnitMember (image.units());
     this->setImageInfo (image.imageInfo());
     this->setMiscInfoMember (image.miscInfo());
+    ImageSummary<T> sum0(image);
+    refPix0_p = sum0.referencePixels();
+    refVal0_p = sum0.referenceValues(True);
+    inc0_p = sum0.axisIncrements(True);
+    cSysLast_p = image.coordinates();
+    shapeLast_p = image.shape();
     this->setCoordinates();
   } else {
     TableRecord rec = miscInfo();
@@ -311,17 +328,12 @@ void ImageConcat<T>::setImage (ImageInterface<T>& image, Bool relax)
     }
 
     // Compare coordinates at end of last image and start of new image
-    if (latticeConcat_p.isTempClose()) latticeConcat_p.reopen(nIm-1);
-    const ImageInterface<T>* pImLast =
-      dynamic_cast<const ImageInterface<T>*>(latticeConcat_p.lattice(nIm-1));
-    const CoordinateSystem& cSysLast = pImLast->coordinates();
-    if (latticeConcat_p.isTempClose()) latticeConcat_p.tempClose(nIm-1);
     // once a lattice has been added that is not contiguous, the output coordinate
     // system will not be contiguous no matter what type of additional coordinate
     // systems are concatenated.
     if (isContig_p) {
     	_checkContiguous (
-    		pImLast->shape(), cSysLast, cSys,
+    		shapeLast_p, cSysLast_p, cSys,
     		os, latticeConcat_p.axis(), relax
     	);
     }
@@ -334,6 +346,8 @@ void ImageConcat<T>::setImage (ImageInterface<T>& image, Bool relax)
     }
     // Compare coordinate descriptors not on concatenation axis
     checkNonConcatAxisCoordinates (os, image, relax);
+    cSysLast_p = cSys;
+    shapeLast_p = image.shape();
 
     // Update the coordinates in the ImageConcat object now we are happy
     // all is well
@@ -381,6 +395,7 @@ void ImageConcat<T>::setLattice(MaskedLattice<T>& lattice)
    isImage_p.resize(nIm+1,True);
    isImage_p(nIm) = False;
    isContig_p = False;
+   shapeLast_p = lattice.shape();
 //
    this->setCoordinates();
 } 
@@ -539,20 +554,16 @@ void ImageConcat<T>::checkNonConcatAxisCoordinates (LogIO& os,
    const uInt axis = latticeConcat_p.axis();
    ImageSummary<T> sumIn(imageIn);
 //
-   if (latticeConcat_p.isTempClose()) latticeConcat_p.reopen(0);
-   const ImageInterface<T>* pIm0 =
-     dynamic_cast<const ImageInterface<T>*>(latticeConcat_p.lattice(0));
-   ImageSummary<T> sum0(*pIm0);
-   if (latticeConcat_p.isTempClose()) latticeConcat_p.tempClose(0);
+// The descriptors of the first image were kept when it was set.
 //
    Bool pixelOrder = True;
    const uInt dim = sumIn.ndim();
    Vector<Double> refPix = sumIn.referencePixels();
-   Vector<Double> refPix0 = sum0.referencePixels();
+   const Vector<Double>& refPix0 = refPix0_p;
    Vector<Double> refVal = sumIn.referenceValues(pixelOrder);
-   Vector<Double> refVal0 = sum0.referenceValues(pixelOrder);
+   const Vector<Double>& refVal0 = refVal0_p;
    Vector<Double> inc = sumIn.axisIncrements(pixelOrder);
-   Vector<Double> inc0 = sum0.axisIncrements(pixelOrder);
+   const Vector<Double>& inc0 = inc0_p;
 //
    for (uInt j=0; j<dim; j++) {
       if (j!= axis) {
@@ -614,12 +625,10 @@ void ImageConcat<T>::setCoordinates()
     	return;
    }
    if (isContig_p) {
-      if (latticeConcat_p.isTempClose()) latticeConcat_p.reopen(iIm);
       if (cSys.type(coord)==Coordinate::STOKES) {
          if (isImage_p(iIm)) {
-            const ImageInterface<T>* pIm = dynamic_cast<const ImageInterface<T>*>(latticeConcat_p.lattice(iIm));
             stokes = makeNewStokes(cSys.stokesCoordinate(coord).stokes(),
-                                   pIm->coordinates().stokesCoordinate(coord).stokes());
+                                   cSysLast_p.stokesCoordinate(coord).stokes());
          } else {
 
 // This is unlikely to work.  We make a Stokes axis starting from the
@@ -628,7 +637,7 @@ void ImageConcat<T>::setCoordinates()
                     
             Vector<Int> stokes1 = coordinates().stokesCoordinate(coord).stokes();
             Int last = stokes1(stokes1.nelements()-1);
-            const uInt shape = latticeConcat_p.lattice(nIm-1)->shape()(axis);
+            const uInt shape = shapeLast_p(axis);
             Vector<Int> stokes2 (shape,0);
             indgen(stokes2, last+1, 1);
             stokes = makeNewStokes(stokes1, stokes2);
@@ -647,7 +656,6 @@ void ImageConcat<T>::setCoordinates()
             }
          } 
       }
-      if (latticeConcat_p.isTempClose()) latticeConcat_p.tempClose(iIm);
    }
    else {
 // The first lattice is enforced to be an image.  Always use its units and names
@@ -702,19 +710,12 @@ template <class T>
 void ImageConcat<T>::_updatePixelAndWorldValues(uInt iIm) {
 	const uInt nPixelsOld = pixelValues_p.nelements();
 	uInt axis = latticeConcat_p.axis();
-	const uInt shapeNew = latticeConcat_p.lattice(iIm)->shape()(axis);
+	const uInt shapeNew = shapeLast_p(axis);
 	pixelValues_p.resize(nPixelsOld+shapeNew, True);
 	worldValues_p.resize(nPixelsOld+shapeNew, True);
 	if (isImage_p(iIm)) {
-		if (latticeConcat_p.isTempClose()) {
-			latticeConcat_p.reopen(iIm);
-		}
-		const ImageInterface<T>* pIm =
-				dynamic_cast<const ImageInterface<T>*>(latticeConcat_p.lattice(iIm));
-		const CoordinateSystem& cSys2 = pIm->coordinates();
-		if (latticeConcat_p.isTempClose()) {
-			latticeConcat_p.tempClose(iIm);
-		}
+		// The coordinates of the image just added.
+		const CoordinateSystem& cSys2 = cSysLast_p;
 		Vector<Double> p = cSys2.referencePixel();
 		Vector<Double> w = cSys2.referenceValue();
 		// For each pixel in concatenation axis for this image, find world
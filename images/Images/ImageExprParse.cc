@@ -45,6 +45,7 @@
 #include <casa/BasicSL/Constants.h>
 #include <casa/Utilities/Assert.h>
 #include <casa/Exceptions/Error.h>
+#include <map>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
@@ -62,6 +63,11 @@ static Block<void*> theNodes;
 static Block<Bool>  theNodesType;
 static uInt theNrNodes;
 
+//# Hold the nodes of the lattices and images used in the expression.
+//# A lattice used multiple times is opened only once and all its
+//# occurrences share the same node.
+static std::map<String,LatticeExprNode> theLattNodes;
+
 //# Hold the last table used to lookup unqualified region names.
 static Table theLastTable;
 
@@ -184,6 +190,7 @@ LatticeExprNode ImageExprParse::command
     theTempLattices = &tempLattices;
     theTempRegions  = &tempRegions;
     theDirName      = dirName;
+    theLattNodes.clear();
     imageExprParse_clear();
     String message;
     String command = str + '\n';
@@ -200,6 +207,7 @@ LatticeExprNode ImageExprParse::command
     //# Save the resulting expression and clear the common node object.
     LatticeExprNode node = theirNode;
     theirNode = LatticeExprNode();
+    theLattNodes.clear();
     deleteNodes();
     imageExprParse_clear();
     //# If an exception was thrown; throw it again with the message.
@@ -566,6 +574,13 @@ LatticeExprNode ImageExprParse::makeLRNode() const
 	return ((*theTempLattices)[latnr]);
     }
     // A true name has been given.
+    // If used before, use the same node (common subexpression), so
+    // a binary operator on the same image only reads it once.
+    std::map<String,LatticeExprNode>::const_iterator iter =
+                                             theLattNodes.find (itsSval);
+    if (iter != theLattNodes.end()) {
+        return iter->second;
+    }
     // Split it using : as separator (:: is full separator).
     // Test if it is a region.
     Vector<String> names = stringToVector (itsSval, ':');
@@ -584,12 +599,15 @@ LatticeExprNode ImageExprParse::makeLRNode() const
     if (names.nelements() == 1) {
 	LatticeExprNode node;
 	if (tryLatticeNode (node, addDir(names(0)))) {
+	    theLattNodes[itsSval] = node;
 	    return node;
 	}
     }
     // If 2 elements given, it should be an image with a mask name.
     if (names.nelements() == 2) {
-        return makeImageNode (addDir(names(0)), names(1));
+        LatticeExprNode node = makeImageNode (addDir(names(0)), names(1));
+	theLattNodes[itsSval] = node;
+	return node;
     }
     // One or three elements have been given.
     // If the first one is empty, a table must have been used already.
@@ -54,6 +54,7 @@
 #include <casa/Arrays/IPosition.h>
 #include <casa/BasicMath/Math.h>
 #include <casa/Arrays/ArrayMath.h>
+#include <casa/Containers/Block.h>
 #include <casa/Containers/Record.h>
 #include <casa/Containers/RecordField.h>
 #include <casa/Quanta/MVTime.h>
@@ -346,7 +347,8 @@ IPosition ImageFITSConverter::copyCursorShape(String &report,
 					      const IPosition &shape, 
 					      uInt imagePixelSize,
 					      uInt fitsPixelSize,
-					      uInt memoryInMB)
+					      uInt memoryInMB,
+					      const IPosition& tileShape)
 {
 
     // We could make this more sophisticated by querying the actual tile
@@ -407,6 +409,16 @@ IPosition ImageFITSConverter::copyCursorShape(String &report,
     for (i=0; Int(i)<=axis; i++) {
 	cursorShape(i) = shape(i);
     }
+    // Take the tile length of the next axis into account, so the tiles
+    // do not have to be held in the cache while stepping along that axis.
+    uInt nextAxis = axis+1;
+    if (nextAxis < ndim  &&  tileShape.nelements() == ndim) {
+	uInt nslice = maxPixels / cursorShape.product();
+	nslice = min(nslice, uInt(std::min(tileShape(nextAxis), shape(nextAxis))));
+	if (nslice > 1) {
+	    cursorShape(nextAxis) = nslice;
+	}
+    }
 
     ostringstream buffer;
     if (axis == Int(ndim) - 1) {
@@ -781,6 +793,107 @@ Bool ImageFITSConverter::removeFile (String& error, const File& outFile,
     return True;
 }
 
+// Convert a chunk of image pixels to the FITS data type and write it.
+// Masked-off pixels become NaN (32 bits) or blank (16 bits).
+// The conversion loops use selects instead of branches, so the compiler
+// can vectorise them.
+// It returns an error message or an empty string if successful.
+static String writeFITSChunk (FitsOutput* outfile,
+			      PrimaryArray<Float>* fits32,
+			      PrimaryArray<Short>* fits16,
+			      const Array<Float>& data,
+			      const Array<Bool>* mask,
+			      Block<Float>& buffer32,
+			      Block<Short>& buffer16,
+			      Bool hasBlanks, Float minPix, Float maxPix,
+			      Double bscale, Double bzero)
+{
+	const Int nPts = data.nelements();
+	Bool deletePtr;
+	const Float* ptr = data.getStorage(deletePtr);
+	const Bool* maskPtr = 0;
+	Bool deleteMaskPtr = False;
+	if (mask) {
+		maskPtr = mask->getStorage(deleteMaskPtr);
+	}
+	String error;
+	Int n = 0;
+	if (fits32) {
+		if (maskPtr) {
+			buffer32.resize (nPts, False, False);
+			Float* ptr2 = buffer32.storage();
+			Float nan;
+			setNaN(nan);
+			for (Int j=0; j<nPts; j++) {
+				ptr2[j] = maskPtr[j] ? ptr[j] : nan;
+			}
+			fits32->store(ptr2, nPts);
+		}
+		else {
+			fits32->store(ptr, nPts);
+		}
+		Int hduErr = 0;
+		if (!(hduErr = fits32->err())){
+			n = fits32->write(*outfile);
+			if (n != nPts) {
+				error = "Write failed (full disk or tape?)";
+			}
+		} else {
+			error = "ImageFITS2Converter: Storing FITS primary Float array failed with HDU error code "
+					+ String::toString(hduErr);
+		}
+	}
+	else if (fits16) {
+		const Short maxshort = 32767;
+		const Short minshort = -32768;
+		const Short blank = minshort;
+		const Short low = minshort + (hasBlanks ? 1 : 0);
+		const Short high = maxshort;
+		buffer16.resize (nPts, False, False);
+		Short* ptr16 = buffer16.storage();
+		for (Int j=0; j<nPts; j++) {
+			const Float p = ptr[j];
+			// Clamp first, so the conversion is always in range.
+			Float c = (p < minPix ? minPix : p);
+			c = (c > maxPix ? maxPix : c);
+			c = (isNaN(p) ? minPix : c);
+			Short s = Short((c - bzero)/bscale);
+			s = (p > maxPix ? high : s);
+			s = (p < minPix ? low : s);
+			ptr16[j] = (isNaN(p) ? blank : s);
+		}
+		if (maskPtr) {
+			for (Int j=0; j<nPts; j++) {
+				ptr16[j] = (maskPtr[j] ? ptr16[j] : blank);
+			}
+		}
+		fits16->store(ptr16, nPts);
+		Int hduErr = 0;
+		if (!(hduErr = fits16->err())) {
+			n = fits16->write(*outfile);
+			if (n != nPts) {
+				error = "Write failed (full disk or tape?";
+			}
+		}
+		else {
+			error = "ImageFITS2Converter: Storing FITS primary Short array failed with HDU error code "
+					+ String::toString(hduErr);
+		}
+	}
+	else {
+		AlwaysAssert(0, AipsError); // NOTREACHED
+	}
+	data.freeStorage(ptr, deletePtr);
+	if (mask) mask->freeStorage(maskPtr, deleteMaskPtr);
+	if (error.empty()  &&
+	    ((fits32 && fits32->err()) ||
+	     (fits16 && fits16->err()) ||
+	     outfile->err())) {
+		error = String("Error writing into file!");
+	}
+	return error;
+}
+
 Bool ImageFITSConverter::ImageToFITSOut(
 	String &error, LogIO &os, const ImageInterface<Float>& image,
 	FitsOutput *outfile, uInt memoryInMB, Bool preferVelocity,
@@ -1245,7 +1358,8 @@ Bool ImageFITSConverter::ImageToFITSOut(
 			shape,
 			sizeof(Float),
 			sizeof(Float),
-			memoryInMB);
+			memoryInMB,
+			needNonOptimalCursor ? IPosition() : image.niceCursorShape());
 	if(needNonOptimalCursor && newShape.nelements()>0){
 		// use cursor the size of one image row in order to enable axis re-ordering
 		newCursorShape.resize(1);
@@ -1270,12 +1384,12 @@ Bool ImageFITSConverter::ImageToFITSOut(
 		if (verbose) pMeter = new ProgressMeter(0.0, 1.0*shape.product(),
 				"Image to FITS", "Pixels copied", "",
 				"", True, iUpdate);
-		uInt count = 0;
-		Double curpixels = 1.0*newCursorShape.product();
+		Double npixels = 0;
 		//
-		LatticeStepper stepper(shape, newCursorShape, cursorOrder);
-		RO_MaskedLatticeIterator<Float> iter(image, stepper);
-		const Int bufferSize = newCursorShape.product();
+		// The cursor can be shorter than the tile length at the end of
+		// an axis, so let the stepper resize it.
+		LatticeStepper stepper(shape, newCursorShape, cursorOrder,
+				LatticeStepper::RESIZE);
 
 		PrimaryArray<Float>* fits32 = 0;
 		PrimaryArray<Short>* fits16 = 0;
@@ -1317,141 +1431,83 @@ Bool ImageFITSConverter::ImageToFITSOut(
 		else {
 			AlwaysAssert(0, AipsError); // NOTREACHED
 		}
-
-		Short *buffer16 = 0; // Use this to write the scaled shorts into
-		if (fits16) {
-			buffer16 = new Short[bufferSize];
-			AlwaysAssert(buffer16, AipsError);
-		}
 		//
-		// Iterate through the image.
+		// Iterate through the image using two buffers. While a chunk is
+		// converted and written to the FITS file, the next chunk is read
+		// from the image.
 		//
-		for (iter.reset(); !iter.atEnd(); iter++) {
-			const Array<Float>& cursor = iter.cursor();
-			Bool deletePtr;
-			const Float* ptr = cursor.getStorage(deletePtr);
-			//
-			const Bool* maskPtr = 0;
-			Bool deleteMaskPtr;
-			if (applyMask) {
-				if (!pMask->shape().isEqual(cursor.shape())) {
-					pMask->resize(cursor.shape());
-				}
-				(*pMask) = iter.getMask(False);
-				maskPtr = pMask->getStorage(deleteMaskPtr);
-			}
-			//
-			//	    pMeter->update((count*1.0 - 0.5)*curpixels);
-			//
-			const uInt nPts = cursor.nelements();
-			error= "";
-			Int n = 0;
-			if (fits32) {
-				if (applyMask) {
-					Float* ptr2 = new float[nPts];
-					for (uInt j=0; j<nPts; j++) {
-						if (maskPtr[j]) {
-							ptr2[j] = ptr[j];
-						}
-						else {
-							ptr2[j] = ptr[j];
-							setNaN(ptr2[j]);
-						}
-					}
-					fits32->store(ptr2, bufferSize);
-					delete [] ptr2;
-				}
-				else {
-					fits32->store(ptr, bufferSize);
-				}
-				Int hduErr = 0;
-				if (!(hduErr = fits32->err())){
-					n = fits32->write(*outfile);
-					if (n != bufferSize) {
-						delete outfile;
-						error = "Write failed (full disk or tape?)";
-						return False;
-					}
-				} else {
-					error = "ImageFITS2Converter: Storing FITS primary Float array failed with HDU error code "
-							+ String::toString(hduErr);
-					return False;
-				}
+		Array<Float> data[2];
+		Array<Bool> mask[2];
+		Block<Float> buffer32;
+		Block<Short> buffer16;
+		IPosition pos = stepper.position();
+		IPosition chunkShape = stepper.cursorShape();
+		image.getSlice (data[0], pos, chunkShape);
+		if (applyMask) {
+			image.getMaskSlice (mask[0], pos, chunkShape);
+		}
+		uInt cur = 0;
+		while (True) {
+			stepper++;
+			Bool more = !stepper.atEnd();
+			uInt next = 1-cur;
+			String readError;
+			if (more) {
+				pos = stepper.position();
+				chunkShape = stepper.cursorShape();
 			}
-			else if (fits16) {
-				short blankOffset = hasBlanks ? 1 : 0;
-				//
-				if (applyMask) {
-					for (Int j=0; j<bufferSize; j++) {
-						//                    if (ptr[j] != ptr[j] || maskPtr[j]) {
-						if (isNaN(ptr[j]) || !maskPtr[j]) {
-							buffer16[j] = minshort;
-						} else {
-							if (ptr[j] > maxPix) {
-								buffer16[j] = maxshort;
-							} else if (ptr[j] < minPix) {
-								buffer16[j] = minshort + blankOffset;
-							} else {
-								buffer16[j] = Short((ptr[j] - bzero)/bscale);
-							}
-						}
-					}
-				}
-				else {
-					for (Int j=0; j<bufferSize; j++) {
-						//                    if (ptr[j] != ptr[j]) {
-						if (isNaN(ptr[j])) {
-							buffer16[j] = minshort;
-						} else {
-							if (ptr[j] > maxPix) {
-								buffer16[j] = maxshort;
-							} else if (ptr[j] < minPix) {
-								buffer16[j] = minshort + blankOffset;
-							} else {
-								buffer16[j] = Short((ptr[j] - bzero)/bscale);
+#ifdef _OPENMP
+#pragma omp parallel sections num_threads(2) if(more)
+#endif
+			{
+#ifdef _OPENMP
+#pragma omp section
+#endif
+				{
+					if (more) {
+						try {
+							image.getSlice (data[next], pos, chunkShape);
+							if (applyMask) {
+								image.getMaskSlice (mask[next], pos, chunkShape);
 							}
+						} catch (const AipsError& x) {
+							readError = x.getMesg();
 						}
 					}
 				}
-				fits16->store(buffer16, bufferSize);
-				Int hduErr = 0;
-				if (!(hduErr = fits16->err())) {
-					n = fits16->write(*outfile);
-					if (n != bufferSize) {
-						delete outfile;
-						error = "Write failed (full disk or tape?";
-						return False;
+#ifdef _OPENMP
+#pragma omp section
+#endif
+				{
+					try {
+						error = writeFITSChunk (outfile, fits32, fits16, data[cur],
+								(applyMask ? &(mask[cur]) : 0),
+								buffer32, buffer16, hasBlanks,
+								minPix, maxPix, bscale, bzero);
+					} catch (const AipsError& x) {
+						error = x.getMesg();
 					}
 				}
-				else {
-					error = "ImageFITS2Converter: Storing FITS primary Short array failed with HDU error code "
-							+ String::toString(hduErr);
-					return False;
-				}
 			}
-			else {
-				AlwaysAssert(0, AipsError); // NOTREACHED
-			}
-			//
-			cursor.freeStorage(ptr, deletePtr);
-			if (applyMask) pMask->freeStorage(maskPtr, deleteMaskPtr);
-			//
-			if ((fits32 && fits32->err()) ||
-					(fits16 && fits16->err()) ||
-					outfile->err()) {
-				error = String("Error writing into file!");
+			if (! error.empty()) {
 				delete outfile;
 				return False;
 			}
-			count++;
-			if (verbose) pMeter->update(count*curpixels);
+			if (! readError.empty()) {
+				throw AipsError (readError);
+			}
+			npixels += data[cur].nelements();
+			if (verbose) pMeter->update(npixels);
+			if (!more) {
+				break;
+			}
+			cur = next;
 		}
 		if (fits32) {
 			delete fits32; fits32 = 0;
 		}
 		else if (fits16) {
 			delete fits16; fits16 = 0;
-			delete buffer16; buffer16 = 0;
 		}
 		else {
 			AlwaysAssert(0, AipsError); // NOTREACHED
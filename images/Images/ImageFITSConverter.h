@@ -32,6 +32,7 @@
 
 #include <casa/aips.h>
 #include <casa/BasicSL/String.h>
+#include <casa/Arrays/IPosition.h>
 #include <casa/Utilities/DataType.h>
 
 #ifndef WCSLIB_GETWCSTAB
@@ -43,8 +44,9 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 template<class T> class PagedImage;
 template<class T> class ImageInterface;
 template<class T> class Vector;
+template<class T> class Array;
 class FitsOutput;
-class IPosition;
+class LCRegion;
 class File;
 class ImageInfo;
 class CoordinateSystem;
@@ -242,11 +244,16 @@ public:
     // Helper function - used to calculate a cursor appropriate for the desired
     // memory use. It's not intended that application programmers call this, but
     // you may if it's useful to you.
+    // <br>The cursor contains whole lines, planes, etc. so it maps to a
+    // contiguous part of the FITS data array. If the tile shape of the image
+    // is given, the cursor also spans the tile length of the next axis (as far
+    // as memory permits), so each tile is read or written only once.
     static IPosition copyCursorShape(String &report,
 				     const IPosition &shape, 
 				     uInt imagePixelSize,
 				     uInt fitsPixelSize,
-				     uInt memoryInMB);
+				     uInt memoryInMB,
+				     const IPosition& tileShape = IPosition());
 
 // Recover CoordinateSystem from header.  Used keywords are removed from header
 // and the unused one returned in a Record for ease of use.  Degenerate axes 
@@ -373,6 +380,13 @@ public:
     	const Bool zeroBlanks=False
     	);
 
+private:
+    // Set the mask of a chunk of pixels read from FITS (False for NaN)
+    // if a mask is given, and replace NaNs by zero if requested.
+    // It returns True if the chunk contains NaNs.
+    static Bool blanksToMask (Float* data, const IPosition& shape,
+                              const LCRegion* mask, Array<Bool>& maskBuf,
+                              Bool zeroBlanks);
 };
 
 
@@ -51,6 +51,7 @@
 #include <casa/BasicMath/Math.h>
 #include <casa/Exceptions/Error.h>
 #include <casa/Logging/LogIO.h>
+#include <casa/Containers/Block.h>
 #include <casa/Containers/Record.h>
 #include <casa/System/ProgressMeter.h>
 
@@ -187,102 +188,121 @@ void ImageFITSConverterImpl<HDUType>::FITSToImage(
 	cursorShape =
 			ImageFITSConverter::copyCursorShape(report, shape, sizeof(Float),
 					sizeof(typename HDUType::ElementType),
-					memoryInMB);
+					memoryInMB, pNewImage->niceCursorShape());
 
 	os << LogIO::NORMAL << "Copy FITS file to '" << pNewImage->name() << "' " <<
 			report << LogIO::POST;
-	LatticeStepper imStepper(shape, cursorShape, IPosition::makeAxisPath(ndim));
-	LatticeIterator<Float> imIter(*pNewImage, imStepper);
+	// The cursor can be shorter than the tile length at the end of
+	// an axis, so let the stepper resize it.
+	LatticeStepper imStepper(shape, cursorShape, IPosition::makeAxisPath(ndim),
+			LatticeStepper::RESIZE);
 	Int nIter = max(1,pNewImage->shape().product()/cursorShape.product());
 	Int iUpdate = max(1,nIter/20);
 	ProgressMeter meter(0.0, Double(pNewImage->shape().product()),
 			"FITS to Image", "Pixels copied", "", "",  True, 
 			iUpdate);
-	Double nPixPerIter = cursorShape.product();
-	Double meterValue;
+	Double meterValue = 0;
 
 	// With floating point, we don't know ahead of time if there
 	// are blanks or not.   SO we have to make the mask, and then
 	// delete it if its not needed.
 
 	ImageRegion maskReg;
-	LatticeIterator<Bool>* pMaskIter = 0;
+	LCRegion* pMask = 0;
 	Bool madeMask = False;
 	if (bitpix<0 || isBlanked) {
 		maskReg = pNewImage->makeMask ("mask0", False, False);
-		LCRegion& mask = maskReg.asMask();
-		LatticeStepper pMaskStepper (shape, cursorShape,
-				IPosition::makeAxisPath(ndim));
-		pMaskIter = new LatticeIterator<Bool>(mask, pMaskStepper);
-		pMaskIter->reset();
+		pMask = &(maskReg.asMask());
 		madeMask = True;
 	}
 
-	// Do the work. Iterate through in chunks.
+	// Do the work. Iterate through in chunks using two buffers.
+	// While a chunk is converted and put into the image, the next
+	// chunk is read from the FITS file.
 	Bool hasBlanks = False;
 	try {
-		Int bufferSize = cursorShape.product();
-		for (imIter.reset(),meterValue=0.0; !imIter.atEnd(); imIter++) {
-			Array<Float>& cursor = imIter.woCursor();
-			fitsImage.read(bufferSize);                  // Read from FITS
-			meterValue += nPixPerIter*1.0/2.0;
-			meter.update(meterValue);
-
-			if (fitsImage.err()) {
-				error = "Error reading from FITS image";
-				delete pNewImage;
-				pNewImage = 0;
-				return;
+		Block<Float> buffer[2];
+		Array<Bool> maskBuf;
+		IPosition pos = imStepper.position();
+		IPosition chunkShape = imStepper.cursorShape();
+		Int n = chunkShape.product();
+		fitsImage.read(n);                           // Read from FITS
+		if (fitsImage.err()) {
+			error = "Error reading from FITS image";
+			delete pNewImage;
+			pNewImage = 0;
+			return;
+		}
+		buffer[0].resize (n, False, False);
+		fitsImage.copy(buffer[0].storage(), n);      // Copy from fits
+		uInt cur = 0;
+		while (True) {
+			IPosition curPos = pos;
+			IPosition curShape = chunkShape;
+			imStepper++;
+			Bool more = !imStepper.atEnd();
+			uInt next = 1-cur;
+			Bool readError = False;
+			String putError;
+			if (more) {
+				pos = imStepper.position();
+				chunkShape = imStepper.cursorShape();
+				n = chunkShape.product();
+				buffer[next].resize (n, False, False);
 			}
-
-			Bool deletePtr;
-			Float *ptr = cursor.getStorage(deletePtr);   // Get Image ptr
-			fitsImage.copy(ptr, bufferSize);             // Copy from fits
-
-			// Deal with mask if necessary
-			if (madeMask) {
-				Array<Bool>& maskCursor = pMaskIter->woCursor();
-				Bool deleteMaskPtr;
-				Bool* mPtr = maskCursor.getStorage(deleteMaskPtr);
-				if (zeroBlanks) {
-					for (uInt i=0; i<maskCursor.nelements(); i++) {
-						if (isNaN(ptr[i])) {
-							mPtr[i] = False;
-							hasBlanks = True;
-							ptr[i] = 0.0;
-						}
-						else {
-							mPtr[i] = True;
+#ifdef _OPENMP
+#pragma omp parallel sections num_threads(2) if(more)
+#endif
+			{
+#ifdef _OPENMP
+#pragma omp section
+#endif
+				{
+					if (more) {
+						fitsImage.read(n);
+						if (fitsImage.err()) {
+							readError = True;
+						} else {
+							fitsImage.copy(buffer[next].storage(), n);
 						}
 					}
 				}
-				else {
-					for (uInt i=0; i<maskCursor.nelements(); i++) {
-						if (isNaN(ptr[i])) {
-							mPtr[i] = False;
+#ifdef _OPENMP
+#pragma omp section
+#endif
+				{
+					try {
+						if (ImageFITSConverterImpl<HDUType>::blanksToMask
+								(buffer[cur].storage(), curShape, pMask,
+								 maskBuf, zeroBlanks)) {
 							hasBlanks = True;
 						}
-						else {
-							mPtr[i] = True;
+						Array<Float> cursor(curShape, buffer[cur].storage(),
+								SHARE);
+						pNewImage->putSlice (cursor, curPos);
+						if (madeMask) {
+							pMask->putSlice (maskBuf, curPos);
 						}
+					} catch (const AipsError& x) {
+						putError = x.getMesg();
 					}
 				}
-				maskCursor.putStorage(mPtr, deleteMaskPtr);
-				pMaskIter->operator++();
 			}
-			else {
-				if (zeroBlanks) {
-					for (uInt i=0; i<cursor.nelements(); i++) {
-						if (isNaN(ptr[i])) {
-							hasBlanks = True;
-							ptr[i] = 0.0;
-						}
-					}
-				}
+			if (! putError.empty()) {
+				throw AipsError (putError);
 			}
-			cursor.putStorage(ptr, deletePtr);
-			meterValue += nPixPerIter*1.0/2.0;
+			if (readError) {
+				error = "Error reading from FITS image";
+				delete pNewImage;
+				pNewImage = 0;
+				return;
+			}
+			meterValue += curShape.product();
 			meter.update(meterValue);
+			if (!more) {
+				break;
+			}
+			cur = next;
 		}
 
 		// Now attach the mask to the image if required
@@ -293,9 +313,6 @@ void ImageFITSConverterImpl<HDUType>::FITSToImage(
 				pNewImage->defineRegion ("mask0", maskReg, RegionHandler::Masks);
 				pNewImage->setDefaultMask(String("mask0"));
 			}
-			// Clean up pointers
-
-			delete pMaskIter;
 		}
 	}
 	catch (const AipsError& x) {
@@ -338,5 +355,36 @@ void ImageFITSConverterImpl<HDUType>::FITSToImage(
 
 
 
+template<class HDUType>
+Bool ImageFITSConverterImpl<HDUType>::blanksToMask (Float* data,
+						    const IPosition& shape,
+						    const LCRegion* mask,
+						    Array<Bool>& maskBuf,
+						    Bool zeroBlanks)
+{
+	const uInt n = shape.product();
+	// The loops use selects instead of branches, so they can be vectorised.
+	uInt nblank = 0;
+	for (uInt i=0; i<n; i++) {
+		nblank += (isNaN(data[i]) ? 1 : 0);
+	}
+	if (mask) {
+		maskBuf.resize (shape);
+		Bool deleteMaskPtr;
+		Bool* mPtr = maskBuf.getStorage(deleteMaskPtr);
+		for (uInt i=0; i<n; i++) {
+			mPtr[i] = !isNaN(data[i]);
+		}
+		maskBuf.putStorage(mPtr, deleteMaskPtr);
+	}
+	if (zeroBlanks  &&  nblank > 0) {
+		for (uInt i=0; i<n; i++) {
+			data[i] = (isNaN(data[i]) ? Float(0) : data[i]);
+		}
+	}
+	return nblank > 0;
+}
+
+
 } //# NAMESPACE CASA - END
 
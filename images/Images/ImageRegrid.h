@@ -35,6 +35,7 @@
 #include <measures/Measures/MDirection.h>
 #include <measures/Measures/MFrequency.h>
 #include <scimath/Mathematics/Interpolate2D.h>
+#include <casa/Utilities/CountedPtr.h>
 #include <set>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
@@ -164,6 +165,10 @@ public:
 // is cached for you.   To trigger successive calls to regrid to go back to
 // internal computation, set zero length Cube and Matrix.  <src>gridMask</src>
 // is True for successfull coordinate conversions, and False otherwise.
+// <br>The internally computed grid is also kept between calls to
+// <src>regrid</src>. It is reused if the 2D coordinates, their axes and
+// shapes, and the observation date and position are the same, for example
+// when regridding images that only differ in spectral or Stokes axes.
 // <group>
   void get2DCoordinateGrid (Cube<Double>& grid, Matrix<Bool>& gridMask) const;
   void set2DCoordinateGrid (const Cube<Double>& grid, const Matrix<Bool>& gridMask, Bool notify=False);
@@ -225,6 +230,27 @@ public:
   Cube<Double> itsUser2DCoordinateGrid;
   Matrix<Bool> itsUser2DCoordinateGridMask;
   Bool itsNotify;
+//
+  // The 2D coordinate grid computed by the last call to regrid and
+  // what it was computed for.
+  Cube<Double> itsCached2DCoordinateGrid;
+  Matrix<Bool> itsCached2DCoordinateGridMask;
+  Bool itsCachedAllFailed;
+  Bool itsCachedMissedIt;
+  CountedPtr<Coordinate> itsCachedInCoord;
+  CountedPtr<Coordinate> itsCachedOutCoord;
+  Vector<Double> itsCachedObsInfo;
+  IPosition itsCachedGridKey;
+//
+  // Get the values of the ObsInfo that affect the coordinate conversions.
+  static Vector<Double> obsInfoKey (const CoordinateSystem& inCoords,
+                                    const CoordinateSystem& outCoords);
+
+  // Can the cached 2D coordinate grid be used?
+  Bool hasCached2DCoordinateGrid (const CoordinateSystem& inCoords,
+                                  const CoordinateSystem& outCoords,
+                                  Int inCoordinate, Int outCoordinate,
+                                  const IPosition& key) const;
 //  
   // Check shape and axes.  Exception if no good.  If pixelAxes
   // of length 0, set to all axes according to shape
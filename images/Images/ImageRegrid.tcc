@@ -29,10 +29,12 @@
 #include <images/Images/ImageRegrid.h>
 
 #include <casa/Arrays/ArrayAccessor.h>
+#include <casa/Arrays/ArrayLogical.h>
 #include <casa/Exceptions/Error.h>
 #include <coordinates/Coordinates/DirectionCoordinate.h>
 #include <coordinates/Coordinates/LinearCoordinate.h>
 #include <coordinates/Coordinates/SpectralCoordinate.h>
+#include <coordinates/Coordinates/ObsInfo.h>
 #include <images/Images/SubImage.h>
 #include <images/Images/TempImage.h>
 #include <lattices/Lattices/LatticeUtilities.h>
@@ -44,20 +46,28 @@
 #include <casa/sstream.h>
 #include <casa/fstream.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace casa { //# NAMESPACE CASA - BEGIN
 
 template<class T>
 ImageRegrid<T>::ImageRegrid()
 : itsShowLevel(0),
   itsDisableConversions(False),
-  itsNotify(False)
+  itsNotify(False),
+  itsCachedAllFailed(False),
+  itsCachedMissedIt(False)
 {;}
 
 template<class T>
 ImageRegrid<T>::ImageRegrid(const ImageRegrid& other)  
 : itsShowLevel(other.itsShowLevel),
   itsDisableConversions(other.itsDisableConversions),
-  itsNotify(other.itsNotify)
+  itsNotify(other.itsNotify),
+  itsCachedAllFailed(False),
+  itsCachedMissedIt(False)
 {;}
 
 
@@ -923,14 +933,55 @@ void ImageRegrid<T>::regridTwoAxisCoordinate (
 			its2DCoordinateGridMask.set(True);
 		}
 		else {
-			make2DCoordinateGrid (os, allFailed, missedIt, minInX, minInY, maxInX,
-					maxInY,
-					its2DCoordinateGrid, its2DCoordinateGridMask,
-					inCoords, outCoords, inCoordinate, outCoordinate,
-					xInAxis, yInAxis, xOutAxis,
-					yOutAxis,
-					inPixelAxes, outPixelAxes, inShape, outPosFull,
-					outShape, decimate);
+			// Reuse the grid of a previous call if made for the same
+			// 2D coordinates (e.g. when regridding planes of a cube
+			// in separate calls).
+			IPosition gridKey(14);
+			gridKey[0] = xInAxis;
+			gridKey[1] = yInAxis;
+			gridKey[2] = xOutAxis;
+			gridKey[3] = yOutAxis;
+			gridKey[4] = inPixelAxes[0];
+			gridKey[5] = inPixelAxes[1];
+			gridKey[6] = outPixelAxes[0];
+			gridKey[7] = outPixelAxes[1];
+			gridKey[8] = inShape[xInAxis];
+			gridKey[9] = inShape[yInAxis];
+			gridKey[10] = outShape[xOutAxis];
+			gridKey[11] = outShape[yOutAxis];
+			gridKey[12] = decimate;
+			gridKey[13] = itsDisableConversions;
+			if (hasCached2DCoordinateGrid (inCoords, outCoords, inCoordinate,
+					outCoordinate, gridKey)) {
+				if (itsShowLevel>0) {
+					cerr << "Reusing the cached 2D coordinate grid" << endl;
+				}
+				its2DCoordinateGrid = itsCached2DCoordinateGrid;
+				its2DCoordinateGridMask = itsCached2DCoordinateGridMask;
+				allFailed = itsCachedAllFailed;
+				missedIt = itsCachedMissedIt;
+			} else {
+				make2DCoordinateGrid (os, allFailed, missedIt, minInX, minInY, maxInX,
+						maxInY,
+						its2DCoordinateGrid, its2DCoordinateGridMask,
+						inCoords, outCoords, inCoordinate, outCoordinate,
+						xInAxis, yInAxis, xOutAxis,
+						yOutAxis,
+						inPixelAxes, outPixelAxes, inShape, outPosFull,
+						outShape, decimate);
+				itsCached2DCoordinateGrid.resize();
+				itsCached2DCoordinateGrid = its2DCoordinateGrid;
+				itsCached2DCoordinateGridMask.resize();
+				itsCached2DCoordinateGridMask = its2DCoordinateGridMask;
+				itsCachedAllFailed = allFailed;
+				itsCachedMissedIt = missedIt;
+				itsCachedInCoord = inCoords.coordinate(inCoordinate).clone();
+				itsCachedOutCoord = outCoords.coordinate(outCoordinate).clone();
+				itsCachedObsInfo.resize();
+				itsCachedObsInfo = obsInfoKey (inCoords, outCoords);
+				itsCachedGridKey.resize (0);
+				itsCachedGridKey = gridKey;
+			}
 		}
 	}
 	s1 += t1.all();
@@ -1096,6 +1147,37 @@ void ImageRegrid<T>::regridTwoAxisCoordinate (
 
 
 
+template<class T>
+Vector<Double> ImageRegrid<T>::obsInfoKey (const CoordinateSystem& inCoords,
+                                          const CoordinateSystem& outCoords)
+{
+  // The epoch and position are used for direction reference conversions.
+  Vector<Double> key(8);
+  const ObsInfo* info[2] = {&inCoords.obsInfo(), &outCoords.obsInfo()};
+  for (uInt i=0; i<2; ++i) {
+    key[4*i] = info[i]->obsDate().getValue().get();
+    const Vector<Double>& pos = info[i]->telescopePosition().getValue().getValue();
+    key[4*i+1] = pos[0];
+    key[4*i+2] = pos[1];
+    key[4*i+3] = pos[2];
+  }
+  return key;
+}
+
+template<class T>
+Bool ImageRegrid<T>::hasCached2DCoordinateGrid (const CoordinateSystem& inCoords,
+                                                const CoordinateSystem& outCoords,
+                                                Int inCoordinate,
+                                                Int outCoordinate,
+                                                const IPosition& key) const
+{
+  return (!itsCachedInCoord.null()  &&
+          key.isEqual (itsCachedGridKey)  &&
+          itsCachedInCoord->near (inCoords.coordinate(inCoordinate), 1e-10)  &&
+          itsCachedOutCoord->near (outCoords.coordinate(outCoordinate), 1e-10)  &&
+          allEQ (obsInfoKey (inCoords, outCoords), itsCachedObsInfo));
+}
+
 template<class T>
 void ImageRegrid<T>::make2DCoordinateGrid(LogIO& os, Bool& allFailed, Bool&missedIt,
 					  Double& minInX, Double& minInY, 
@@ -1553,10 +1635,7 @@ void ImageRegrid<T>::regrid2DMatrix(Lattice<T>& outCursor,
   inChunk2DShape[0] = inChunkTrc2D[xInAxis] - inChunkBlc2D[xInAxis] + 1;
   inChunk2DShape[1] = inChunkTrc2D[yInAxis] - inChunkBlc2D[yInAxis] + 1;
   //
-  Vector<Double> pix2DPos2(2);
   IPosition outPos3;
-  Bool interpOK;
-  T result(0);
   //
   for (outCursorIter.reset(); !outCursorIter.atEnd(); outCursorIter++) {
     
@@ -1595,54 +1674,51 @@ void ImageRegrid<T>::regrid2DMatrix(Lattice<T>& outCursor,
       outMaskMCursor = &(outMaskCursorIterPtr->rwMatrixCursor());
     };
     
-    ArrayAccessor<Bool, Axis<0> > sucp0;
-    ArrayAccessor<Bool, Axis<1> > sucp1(succeed);
-    ArrayAccessor<T, Axis<0> > outMp0;
-    ArrayAccessor<T, Axis<1> > outMp1(outMCursor);
-    ArrayAccessor<Bool, Axis<0> > outMaskMp0;
-    ArrayAccessor<Bool, Axis<1> > outMaskMp1;
-    if (outIsMasked) outMaskMp1.init(*outMaskMCursor);
-    uInt dpix2DPos = &pix2DPos(0,0,1) - &pix2DPos(0,0,0);
-
-    for (uInt j=0; j<nCol; j++) {
-      if (outIsMasked) outMaskMp0 = outMaskMp1;
-      sucp0 = sucp1;
-      outMp0 = outMp1;
+    // The columns are independent, so they are interpolated in parallel
+    // (Interpolate2D is stateless). Each thread has its own positions and
+    // results. A column is interpolated in a single batch call.
+    const uInt iOff = outPos3[xOutAxis];
+    const uInt jOff = outPos3[yOutAxis];
+    const Double xBlc = inChunkBlc[xInAxis];
+    const Double yBlc = inChunkBlc[yInAxis];
+    const Bool parallel = (nRow*nCol >= 16384);
+    const Int nColI = nCol;
+#ifdef _OPENMP
+#pragma omp parallel for if(parallel) schedule(dynamic,8)
+#endif
+    for (Int j=0; j<nColI; j++) {
+      Vector<Double> xPos(nRow), yPos(nRow);
+      Vector<T> result;
+      Vector<Bool> interpOK;
+      const uInt jj = jOff + j;
+
+      // pix2DPos(i,j,) is the absolute input pixel coordinate in the input
+      // lattice for the current output pixel. Pixels for which the
+      // coordinate conversion failed get a position outside the input.
       for (uInt i=0; i<nRow; i++) {
-	if (! *sucp0) {
-	  *outMp0 = 0.0;
-	  if (outIsMasked) *outMaskMp0 = False;
+	const uInt ii = iOff + i;
+	if (succeed(i,j)) {
+	  xPos[i] = pix2DPos(ii,jj,0) - xBlc;
+	  yPos[i] = pix2DPos(ii,jj,1) - yBlc;
 	} else {
-	  
-	  // Now do the interpolation. pix2DPos(i,j,) is the absolute input
-	  // pixel coordinate in the input lattice for the
-	  // current output pixel.
-	  uInt ii = outPos3[xOutAxis] + i;
-	  uInt jj = outPos3[yOutAxis] + j;
-	  const Double *pix2Dp = &pix2DPos(ii,jj,0);
-	  pix2DPos2[0] = *pix2Dp - inChunkBlc[xInAxis];
-	  pix2DPos2[1] = *(pix2Dp + dpix2DPos) - inChunkBlc[yInAxis];
-	  if (inIsMasked) {                     
-	    interpOK = interp.interp(result, pix2DPos2, inDataChunk2D,
-				     *inMaskChunk2DPtr);
-	  } else {
-	    interpOK = interp.interp(result, pix2DPos2, inDataChunk2D);
-	  };
-	  if (interpOK) {
-	    *outMp0 = scale * result;
-	    if (outIsMasked) *outMaskMp0 = True; 
-	  } else {
-	    *outMp0 = 0.0;
-	    if (outIsMasked) *outMaskMp0 = False; 
-	  };
+	  xPos[i] = -10;
+	  yPos[i] = -10;
+	}
+      }
+      if (inIsMasked) {
+	interp.interp(result, interpOK, xPos, yPos, inDataChunk2D,
+		      *inMaskChunk2DPtr);
+      } else {
+	interp.interp(result, interpOK, xPos, yPos, inDataChunk2D);
+      };
+      for (uInt i=0; i<nRow; i++) {
+	if (interpOK[i]) {
+	  outMCursor(i,j) = scale * result[i];
+	} else {
+	  outMCursor(i,j) = 0.0;
 	};
-	sucp0++;
-	outMp0++;
-	outMaskMp0++;
+	if (outIsMasked) (*outMaskMCursor)(i,j) = interpOK[i];
       };
-      sucp1++;
-      outMp1++;
-      outMaskMp1++;
     };
     //
     if (pProgressMeter) {
@@ -368,6 +368,11 @@ public:
   // Report on cache success.
   virtual void showCacheStatistics (ostream& os) const;
 
+  // Set the advisor recording the shape of each slice of pixels accessed
+  // (see <linkto class=TileShapeAdvisor>TileShapeAdvisor</linkto>).
+  // The advisor is not owned. A null pointer stops the tracing.
+  void setAccessTracer (TileShapeAdvisor* tracer);
+
   // Handle the (un)locking.
   // Unlocking also unlocks the logtable and a possible mask table.
   // Locking only locks the image itself.
@@ -695,6 +695,12 @@ void PagedImage<T>::clearCache()
   }
 }
 
+template<class T> 
+void PagedImage<T>::setAccessTracer (TileShapeAdvisor* tracer)
+{
+  map_p.setAccessTracer (tracer);
+}
+
 template<class T> 
 void PagedImage<T>::showCacheStatistics(ostream& os) const
 {
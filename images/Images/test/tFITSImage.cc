@@ -32,12 +32,14 @@
 #include <casa/Inputs/Input.h>
 #include <casa/BasicMath/Math.h>
 #include <casa/OS/Path.h>
+#include <casa/OS/RegularFile.h>
 #include <casa/BasicSL/String.h>
 #include <casa/Utilities/DataType.h>
 #include <casa/Exceptions/Error.h>
 #include <casa/Logging/LogIO.h>
 
 #include <images/Images/FITSImage.h>
+#include <fits/FITS/FITSCompressedFile.h>
 #include <images/Images/ImageInterface.h>
 #include <images/Images/ImageFITSConverter.h>
 #include <coordinates/Coordinates/CoordinateSystem.h>
@@ -128,6 +130,26 @@ try {
    Array<Bool> dataMask = pTempImage->getMask();
    CoordinateSystem fitsCS = fitsImage.coordinates();
    CoordinateSystem dataCS = pTempImage->coordinates();
+
+// Convert back and forth in small chunks.
+
+   {
+      String tmpName("tFITSImage_tmp.fits");
+      if (!ImageFITSConverter::ImageToFITS(error, *pTempImage, tmpName,
+                                           0, True, True, -32, 1.0, -1.0,
+                                           True, False, False)) {
+         os << error << LogIO::EXCEPTION;
+      }
+      ImageInterface<Float>* pTempImage2 = 0;
+      if (!ImageFITSConverter::FITSToImage(pTempImage2, error,
+                                           imageName, tmpName, 0, 0, 0)) {
+         os << error << LogIO::EXCEPTION;
+      }
+      AlwaysAssert(allNear(dataArray, dataMask, pTempImage2->get(),
+                           pTempImage2->getMask()), AipsError);
+      delete pTempImage2;
+      RegularFile(tmpName).remove();
+   }
    delete pTempImage;
 //
    AlwaysAssert(allNear(dataArray, dataMask, fitsArray, fitsMask), AipsError);
@@ -143,6 +165,50 @@ try {
 //
    AlwaysAssert(allNear(dataArray, dataMask, fitsArray2, fitsMask2), AipsError);
    AlwaysAssert(fitsCS2.near(dataCS), AipsError);
+
+// Test a virtual tile shape for spectrum-wise access.
+
+   {
+      FITSImage fitsImage3(in, 0, hdunum);
+      IPosition tileShape(fitsImage3.ndim(), 1);
+      tileShape(fitsImage3.ndim()-1) = fitsImage3.shape()(fitsImage3.ndim()-1);
+      Bool mapped = True;
+      try {
+         fitsImage3.setTileShape (tileShape);
+      } catch (AipsError&) {
+         // Not memory-mapped (e.g. on 32-bit systems).
+         mapped = False;
+      }
+      if (mapped) {
+         AlwaysAssert(fitsImage3.niceCursorShape() == tileShape, AipsError);
+      }
+      fitsImage3.setTileShape (fitsImage3.shape());
+      AlwaysAssert(fitsImage3.niceCursorShape() == fitsImage3.shape(),
+                   AipsError);
+      fitsImage3.tempClose();
+      AlwaysAssert(allNear(dataArray, dataMask, fitsImage3.get(),
+                           fitsImage3.getMask()), AipsError);
+   }
+
+// Test a tile-compressed copy (lossless, thus gzip without quantisation).
+
+   if (hdunum == 0) {
+      String compName("tFITSImage_tmp.fits.fz");
+      FITSCompressedFile::compress (in, compName, "GZIP_1", IPosition(), 0);
+      {
+         FITSImage fitsImage4(compName);
+         AlwaysAssert(fitsImage4.isCompressed(), AipsError);
+         AlwaysAssert(fitsImage4.shape() == fitsImage.shape(), AipsError);
+         AlwaysAssert(fitsImage4.coordinates().near(dataCS), AipsError);
+         AlwaysAssert(allNear(dataArray, dataMask, fitsImage4.get(),
+                              fitsImage4.getMask()), AipsError);
+         fitsImage4.tempClose();
+         fitsImage4.setCacheSizeInTiles (1);
+         AlwaysAssert(allNear(dataArray, dataMask, fitsImage4.get(),
+                              fitsImage4.getMask()), AipsError);
+      }
+      RegularFile(compName).remove();
+   }
 //
    cerr << "ok " << endl;
 
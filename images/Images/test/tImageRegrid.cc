@@ -170,6 +170,16 @@ try {
       Interpolate2D::Method emethod = Interpolate2D::stringToMethod(method);
       regridder.showDebugInfo(dbg);
       regridder.regrid(*pImOut, emethod, axes, *pIm, replicate, decimate, False, force);
+//
+// Regridding again reuses the cached coordinate grid; the result
+// must be the same.
+//
+      Array<Float> first = pImOut->get();
+      Array<Bool> firstMask = pImOut->getMask();
+      pImOut->set(0.0);
+      regridder.regrid(*pImOut, emethod, axes, *pIm, replicate, decimate, False, force);
+      AlwaysAssert(allEQ(pImOut->get(), first), AipsError);
+      AlwaysAssert(allEQ(pImOut->getMask(), firstMask), AipsError);
       delete pImOut;
     }
 //
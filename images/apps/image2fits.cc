@@ -34,6 +34,8 @@
 #include <images/Images/ImageFITSConverter.h>
 #include <images/Images/FITSImage.h>
 #include <images/Images/MIRIADImage.h>
+#include <fits/FITS/FITSCompressedFile.h>
+#include <casa/OS/RegularFile.h>
 #include <casa/Exceptions/Error.h>
 #include <casa/iostream.h>
 
@@ -56,6 +58,16 @@ int main (int argc, const char* argv[])
     inputs.create ("out", "",
 		   "Name of output FITS file",
 		   "string");
+    inputs.create ("compress", "none",
+		   "Tile compression (none, rice, gzip, gzip2, hcompress or plio)",
+		   "string");
+    inputs.create ("tileshape", "",
+		   "Shape of the compression tiles (default is a row)",
+		   "Block<Int>");
+    inputs.create ("quantize", "16",
+		   "Quantisation level of floating point data when compressing"
+		   " (0 is lossless, only for gzip)",
+		   "float");
     // Fill the input structure from the command line.
     inputs.readArguments (argc, argv);
 
@@ -70,6 +82,27 @@ int main (int argc, const char* argv[])
     if (ffout == "") {
       throw AipsError(" an output FITS file name must be given");
     }
+    String compress (downcase(inputs.getString("compress")));
+    String compressType;
+    if (compress == "rice") {
+      compressType = "RICE_1";
+    } else if (compress == "gzip") {
+      compressType = "GZIP_1";
+    } else if (compress == "gzip2") {
+      compressType = "GZIP_2";
+    } else if (compress == "hcompress") {
+      compressType = "HCOMPRESS_1";
+    } else if (compress == "plio") {
+      compressType = "PLIO_1";
+    } else if (compress != "none"  &&  !compress.empty()) {
+      throw AipsError(" invalid compress value " + compress);
+    }
+    Block<Int> tileBlock (inputs.getIntArray("tileshape"));
+    IPosition tileShape (tileBlock.nelements());
+    for (uInt i=0; i<tileBlock.nelements(); ++i) {
+      tileShape[i] = tileBlock[i];
+    }
+    Float quantize = inputs.getDouble("quantize");
 
     // First try to open as a normal image.
     ImageInterface<Float>* img = 0;
@@ -93,11 +126,26 @@ int main (int argc, const char* argv[])
       img = new ImageExpr<Float> (lat, imgin);
     }
     // Now write the fits file.
-    res = ImageFITSConverter::ImageToFITS (error, *img, ffout);
+    // A compressed file is made from a temporary uncompressed one.
+    String fitsName (ffout);
+    if (! compressType.empty()) {
+      fitsName = ffout + "_tmp_uncompressed";
+    }
+    res = ImageFITSConverter::ImageToFITS (error, *img, fitsName);
     delete img;
     if (!res) {
       throw AipsError(error);
     }
+    if (! compressType.empty()) {
+      try {
+        FITSCompressedFile::compress (fitsName, ffout, compressType,
+                                      tileShape, quantize);
+      } catch (...) {
+        RegularFile(fitsName).remove();
+        throw;
+      }
+      RegularFile(fitsName).remove();
+    }
   } catch (std::exception& x) {
     cout << x.what() << endl;
     return 1;
@@ -0,0 +1,134 @@
+//# imageretile: copy an image to an image with another tile shape
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id:
+
+#include <casa/aips.h>
+#include <casa/BasicSL/String.h>
+#include <casa/Inputs/Input.h>
+#include <casa/Arrays/IPosition.h>
+#include <casa/Containers/Block.h>
+
+#include <images/Images/ImageOpener.h>
+#include <images/Images/PagedImage.h>
+#include <images/Images/FITSImage.h>
+#include <images/Images/MIRIADImage.h>
+#include <images/Images/ImageUtilities.h>
+#include <lattices/Lattices/LatticeUtilities.h>
+#include <lattices/Lattices/TileShapeAdvisor.h>
+#include <lattices/Lattices/TiledShape.h>
+#include <coordinates/Coordinates/CoordinateSystem.h>
+
+using namespace casa;
+
+int main(int argc, const char* argv[]) {
+
+  try {
+    Input inputs(1);
+    inputs.create("in", "", "Input image name", "string");
+    inputs.create("out", "", "Output image name", "string");
+    inputs.create("tileshape", "", "Output tile shape; if not given, it is derived from the access pattern", "Block<Int>");
+    inputs.create("access", "spectra", "Access pattern to optimise for (spectra, planes or sweep)", "string");
+    inputs.create("memory", "-1", "Memory (in MB) to use for the copy; -1 is 1/4 of the free memory", "int");
+    inputs.readArguments(argc, argv);
+
+    const String in = inputs.getString("in");
+    if ( in.empty() ) {
+      cout << "Please specify input image name" << endl;
+      exit(1);
+    }
+    const String out = inputs.getString("out");
+    if ( out.empty() ) {
+      cout << "Please specify output image name" << endl;
+      exit(1);
+    }
+    const Block<Int> tileshape = inputs.getIntArray("tileshape");
+    const String access = downcase(inputs.getString("access"));
+    const Int memory = inputs.getInt("memory");
+
+    FITSImage::registerOpenFunction();
+    MIRIADImage::registerOpenFunction();
+    LatticeBase* pLatt = ImageOpener::openImage(in);
+    ImageInterface<Float>* pImage = dynamic_cast<ImageInterface<Float>*>(pLatt);
+    if (!pImage) {
+      cout << "The input image must have data type Float" << endl;
+      exit(1);
+    }
+    const IPosition imshape = pImage->shape();
+
+    IPosition tile(imshape.nelements());
+    if (tileshape.nelements() > 0) {
+      if (tileshape.nelements() != imshape.nelements()) {
+        cout << "The tile shape must have a length for all axes" << endl;
+        cout << "The shape of the image is " << imshape << endl;
+        exit(1);
+      }
+      for (uInt i=0; i<tileshape.nelements(); ++i) {
+        tile(i) = tileshape[i];
+      }
+    } else {
+      TileShapeAdvisor advisor (imshape, sizeof(Float));
+      if (access == "spectra") {
+        Int axis = pImage->coordinates().spectralAxisNumber();
+        if (axis < 0) {
+          axis = imshape.nelements() - 1;
+        }
+        advisor.addLines (axis);
+      } else if (access == "planes") {
+        if (imshape.nelements() < 2) {
+          cout << "Plane access needs an image with at least 2 axes" << endl;
+          exit(1);
+        }
+        advisor.addPlanes (0, 1);
+      } else if (access == "sweep") {
+        advisor.addSweep();
+      } else {
+        cout << "access must be spectra, planes or sweep" << endl;
+        exit(1);
+      }
+      tile = advisor.tileShape();
+    }
+    cout << "Retiling " << in << " with tile shape "
+         << pImage->niceCursorShape() << " to " << out
+         << " with tile shape " << tile << endl;
+
+    PagedImage<Float> outImage (TiledShape(imshape, tile),
+                                pImage->coordinates(), out);
+    LatticeUtilities::copyRetiled (outImage, *pImage, memory);
+    if (pImage->hasPixelMask()) {
+      outImage.makeMask ("mask0", True, True);
+      LatticeUtilities::copyRetiled (outImage.pixelMask(),
+                                     pImage->pixelMask(), memory);
+    }
+    ImageUtilities::copyMiscellaneous (outImage, *pImage);
+
+    delete pImage;
+  } catch (const AipsError &x) {
+    cerr << "Exception caught:" << endl;
+    cerr << x.getMesg() << endl;
+    return 1;
+  }
+  return 0;
+}
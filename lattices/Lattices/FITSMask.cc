@@ -99,6 +99,17 @@ FITSMask::FITSMask (TiledFileAccess* tiledFile, Float scale, Float offset,
 }
 
 
+FITSMask::FITSMask()
+: itsTiledFilePtr(0),
+  itsScale(1.0),
+  itsOffset(0.0),
+  itsUCharMagic(0),
+  itsShortMagic(0),
+  itsLongMagic(0),
+  itsHasIntBlanks(False),
+  itsFilterZero(False)
+{}
+
 FITSMask::FITSMask (const FITSMask& other)
 : Lattice<Bool>(other),
   itsTiledFilePtr(other.itsTiledFilePtr),
@@ -151,23 +162,7 @@ Bool FITSMask::doGetSlice (Array<Bool>& mask, const Slicer& section)
    IPosition shp = section.length();
    if (!mask.shape().isEqual(shp)) mask.resize(shp);
    if (!itsBuffer.shape().isEqual(shp)) itsBuffer.resize(shp);
-//
-   if (itsTiledFilePtr->dataType()==TpFloat) {
-      itsTiledFilePtr->get(itsBuffer, section);
-   } else if (itsTiledFilePtr->dataType()==TpDouble) {
-      Array<Double> tmp(shp);
-      itsTiledFilePtr->get(tmp, section);
-      convertArray(itsBuffer, tmp);
-   } else if (itsTiledFilePtr->dataType()==TpInt) {
-      itsTiledFilePtr->get(itsBuffer, section, itsScale, itsOffset, 
-                           itsLongMagic, itsHasIntBlanks);
-   } else if (itsTiledFilePtr->dataType()==TpShort) {
-      itsTiledFilePtr->get(itsBuffer, section, itsScale, itsOffset, 
-                           itsShortMagic, itsHasIntBlanks);
-   } else if (itsTiledFilePtr->dataType()==TpUChar) {
-      itsTiledFilePtr->get(itsBuffer, section, itsScale, itsOffset, 
-                           itsUCharMagic, itsHasIntBlanks);
-   }
+   getData (itsBuffer, section);
 //
    Bool deletePtrD;
    const Float* pData = itsBuffer.getStorage(deletePtrD);
@@ -187,25 +182,42 @@ Bool FITSMask::doGetSlice (Array<Bool>& mask, const Slicer& section)
    return False;            // Not a reference
 }
 
+void FITSMask::getData (Array<Float>& buffer, const Slicer& section)
+{
+   IPosition shp = section.length();
+   if (itsTiledFilePtr->dataType()==TpFloat) {
+      itsTiledFilePtr->get(buffer, section);
+   } else if (itsTiledFilePtr->dataType()==TpDouble) {
+      Array<Double> tmp(shp);
+      itsTiledFilePtr->get(tmp, section);
+      convertArray(buffer, tmp);
+   } else if (itsTiledFilePtr->dataType()==TpInt) {
+      itsTiledFilePtr->get(buffer, section, itsScale, itsOffset, 
+                           itsLongMagic, itsHasIntBlanks);
+   } else if (itsTiledFilePtr->dataType()==TpShort) {
+      itsTiledFilePtr->get(buffer, section, itsScale, itsOffset, 
+                           itsShortMagic, itsHasIntBlanks);
+   } else if (itsTiledFilePtr->dataType()==TpUChar) {
+      itsTiledFilePtr->get(buffer, section, itsScale, itsOffset, 
+                           itsUCharMagic, itsHasIntBlanks);
+   }
+}
+
 void FITSMask::filterNaN (Bool *pMask, const Float *pData, uInt nelems)
 {
-  // loop over all elements
+  // blanked values are NaNs (which are not equal to themselves)
+  // the loop has no branches, so it can be vectorised
   for (uInt i=0; i<nelems; i++) {
-    // set defaults;
-    // blanked values are NaNs.
-    pMask[i] = True;
-    if (isNaN(pData[i])) pMask[i] = False;
+    pMask[i] = (pData[i] == pData[i]);
   }
 }
 
 void FITSMask::filterZeroNaN (Bool *pMask, const Float *pData, uInt nelems)
 {
-  // loop over all elements
+  // blanked values are NaNs and "0.0"
+  // the loop has no branches, so it can be vectorised
   for (uInt i=0; i<nelems; i++) {
-    // set defaults;
-    // blanked values are NaNs and "0.0"
-    pMask[i] = True;
-    if (isNaN(pData[i]) || pData[i] == (Float)0.0) pMask[i] = False;
+    pMask[i] = (pData[i] == pData[i])  &  (pData[i] != (Float)0.0);
   }
 }
 
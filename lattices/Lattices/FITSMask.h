@@ -152,6 +152,14 @@ public:
   
   // Set the switch for also filtering 0.0 (besides NaNs).
   virtual void setFilterZero (Bool filterZero);
+
+protected:
+  // Constructor for a derived class getting the data in another way.
+  FITSMask();
+
+  // Get the data values of the section as Float.
+  // By default they are read from the TiledFileAccess object.
+  virtual void getData (Array<Float>& buffer, const Slicer& section);
  
 private:
 
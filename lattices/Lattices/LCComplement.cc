@@ -135,6 +135,11 @@ void LCComplement::multiGetSlice (Array<Bool>& buffer,
     IPosition endreg(nrdim);
     const IPosition& inc = section.stride();
     if (findAreas (stbuf, endbuf, streg, endreg, section, 0)) {
+        // A region without a mask covers its entire bounding box.
+        if (! regions()[0]->hasMask()) {
+	    buffer(stbuf,endbuf) = False;
+	    return;
+	}
         Array<Bool> tmpbuf;
 	((LCRegion*)(regions()[0]))->doGetSlice
                        (tmpbuf, Slicer(streg, endreg, inc, Slicer::endIsLast));
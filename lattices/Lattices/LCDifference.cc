@@ -136,24 +136,25 @@ void LCDifference::multiGetSlice (Array<Bool>& buffer,
     IPosition endreg(nrdim);
     const IPosition& inc = section.stride();
     if (findAreas (stbuf, endbuf, streg, endreg, section, 1)) {
-        Array<Bool> tmpbuf;
 	LCRegion* reg = (LCRegion*)(regions()[1]);
+	Array<Bool> bufreg = buffer(stbuf,endbuf);
+	// A region without a mask covers its entire bounding box,
+	// so its mask does not need to be made.
+	if (! reg->hasMask()) {
+	    bufreg = False;
+	    return;
+	}
+        Array<Bool> tmpbuf;
 	reg->doGetSlice (tmpbuf, Slicer(streg, endreg, inc,
 					Slicer::endIsLast));
-	Array<Bool> bufreg = buffer(stbuf,endbuf);
 	DebugAssert (bufreg.shape() == tmpbuf.shape(), AipsError);
 	// Make pixel in buffer False when tmpbuf has a True pixel.
 	Bool deleteBuf, deleteTmp;
 	Bool* buf = bufreg.getStorage (deleteBuf);
-	Bool* bufptr = buf;
-	Bool* bufend = buf + bufreg.nelements();
 	const Bool* tmp = tmpbuf.getStorage (deleteTmp);
-	const Bool* tmpptr = tmp;
-	while (bufptr < bufend) {
-	    if (*tmpptr++) {
-	        *bufptr = False;
-	    }
-	    bufptr++;
+	const uInt n = bufreg.nelements();
+	for (uInt j=0; j<n; j++) {
+	    buf[j] = buf[j] & !tmp[j];
 	}
 	bufreg.putStorage (buf, deleteBuf);
 	tmpbuf.freeStorage (tmp, deleteTmp);
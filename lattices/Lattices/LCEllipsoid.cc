@@ -452,22 +452,42 @@ void LCEllipsoid::_defineMask2D() {
 		center[i] = itsCenter[i] - Float(boundingBox().start()(i));
 		rad2[i] = itsRadii[i]*itsRadii[i];
 	}
-	// Initialize some variables for the loop below.
-	Float prevSum = 0;
+	// Each line of the ellipse is a span of pixels. Its ends follow from
+	// solving the quadratic equation sum(x) = A*x*x + B*x + C = 1.
+	// Only the pixels near the ends are tested explicitly, so the result
+	// is the same as testing every pixel.
+	const Float cosTheta = cos(-_theta);
+	const Float sinTheta = sin(-_theta);
+	const Double qa = Double(cosTheta)*cosTheta/rad2[0] +
+			Double(sinTheta)*sinTheta/rad2[1];
+	const Double qb = 2*Double(sinTheta)*cosTheta * (1/Double(rad2[1]) -
+			1/Double(rad2[0]));
+	const Double qc = Double(sinTheta)*sinTheta/rad2[0] +
+			Double(cosTheta)*cosTheta/rad2[1];
+	const Int nx = length[0];
 	for (Int y=0; y<length[1]; y++) {
 		Float ydiff = Float(y-center[1]);
-		for (Int x=0; x<length[0]; x++) {
+		Double b = qb*ydiff;
+		Double disc = b*b - 4*qa*(qc*ydiff*ydiff - 1);
+		Double xmid = center[0] - b/(2*qa);
+		Double hw = (disc > 0  ?  sqrt(disc)/(2*qa) : 0);
+		// The first and last pixel to test and the pixels certainly inside.
+		Int xs = Int(max(0., floor(xmid - hw) - 2));
+		Int xe = Int(min(Double(nx-1), ceil(xmid + hw) + 2));
+		Double ins = ceil(xmid - hw) + 2;
+		Double ine = floor(xmid + hw) - 2;
+		for (Int x=xs; x<=xe; x++) {
+			if (x >= ins  &&  x <= ine) {
+				maskData[x] = True;
+				continue;
+			}
 			Float xdiff = Float(x-center[0]);
-			Float xp = xdiff*cos(-_theta) - ydiff*sin(-_theta);
-			Float yp = xdiff*sin(-_theta) + ydiff*cos(-_theta);
+			Float xp = xdiff*cosTheta - ydiff*sinTheta;
+			Float yp = xdiff*sinTheta + ydiff*cosTheta;
 			Float sum = xp*xp/rad2[0] + yp*yp/rad2[1];
 			if (sum <= 1) {
 				maskData[x] = True;
 			}
-			else if (x != 0 && sum > prevSum) {
-				break;
-			}
-			prevSum = sum;
 		}
 		maskData += length[0];
 	}
@@ -185,19 +185,18 @@ void LCIntersection::multiGetSlice (Array<Bool>& buffer,
     uInt nr = regions().nelements();
     for (uInt i=1; i<nr; i++) {
         LCRegion* reg = (LCRegion*)(regions()[i]);
+        // A region without a mask is True in the entire intersection.
+        if (! reg->hasMask()) {
+	    continue;
+	}
         reg->doGetSlice (tmpbuf, Slicer(section.start()+itsOffsets[i],
 					section.length(),
 					section.stride()));
         const Bool* tmp = tmpbuf.getStorage (deleteTmp);
-	const Bool* tmpptr = tmp;
-	Bool* bufptr = buf;
+	const uInt n = bufend - buf;
 	// Take the 'and' of all elements.
-	while (bufptr < bufend) {
-	    if (*bufptr) {
-	        *bufptr = *tmpptr;
-	    }
-	    bufptr++;
-	    tmpptr++;
+	for (uInt j=0; j<n; j++) {
+	    buf[j] = buf[j] & tmp[j];
 	}
 	tmpbuf.freeStorage (tmp, deleteTmp);
     }
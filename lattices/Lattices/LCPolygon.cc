@@ -34,6 +34,7 @@
 #include <casa/Utilities/GenSort.h>
 #include <casa/Utilities/Assert.h>
 #include <casa/Exceptions/Error.h>
+#include <algorithm>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
@@ -351,38 +352,80 @@ void LCPolygon::fillMask (Bool* mask, Int ny, Int nx,
       prev = i;
     }
   }
+  // Determine for each non-vertical line segment the range of y-es it
+  // can cross (taking the tolerance of near() into account) and order the
+  // segments on their first y. In this way each y only needs to test the
+  // segments spanning it, which matters for polygons with many points.
+  Block<Int> ystart(nrline, 0);
+  Block<Int> yend(nrline, -1);
+  Block<uInt> nrstart(ny+1, 0u);
+  for (i=0; i<nrline; i++) {
+    if (dir[i] != 0) {
+      Float ymin = std::min (ptrY[i], ptrY[i+1]);
+      Float ymax = std::max (ptrY[i], ptrY[i+1]);
+      Double tol = 1e-4 * (std::max (abs(ymin), abs(ymax)) + 1);
+      Double ys = std::max (ceil(ymin - tol) - blcy, 0.);
+      Double ye = std::min (floor(ymax + tol) - blcy, Double(ny-1));
+      if (ys <= ye) {
+        ystart[i] = Int(ys);
+        yend[i]   = Int(ye);
+        nrstart[ystart[i] + 1]++;
+      }
+    }
+  }
+  for (Int y=0; y<ny; y++) {
+    nrstart[y+1] += nrstart[y];
+  }
+  Block<uInt> sorted(nrstart[ny]);
+  Block<uInt> fillIndex(nrstart);
+  for (i=0; i<nrline; i++) {
+    if (yend[i] >= 0) {
+      sorted[fillIndex[ystart[i]]++] = i;
+    }
+  }
   // Loop through all y-es and mask the x-points inside or on the polygon.
   // This is done by determining the crossing point of all the y-lines
-  // with all line segments (the in/out algorithm).
+  // with the active line segments (the in/out algorithm).
   Block<Float> cross(nrline);
+  Block<uInt> active(nrline);
+  uInt nractive = 0;
   Bool* maskPtr = mask;
   for (Int y=0; y<ny; y++) {
+    // Remove the segments ending before this y and add the ones starting.
+    uInt nr = 0;
+    for (uInt j=0; j<nractive; j++) {
+      if (yend[active[j]] >= y) {
+        active[nr++] = active[j];
+      }
+    }
+    nractive = nr;
+    for (uInt j=nrstart[y]; j<nrstart[y+1]; j++) {
+      active[nractive++] = sorted[j];
+    }
     uInt nrcross = 0;
     Float yf = y + blcy;
-    for (i=0; i<nrline; i++) {
-      // Ignore vertical lines.
-      if (dir[i] != 0) {
-        Bool take = False;
-        // Calculate the crossing point if yf is inside the line segment.
-        if ((yf > ptrY[i]  &&  yf < ptrY[i+1])
-        ||  (yf < ptrY[i]  &&  yf > ptrY[i+1])
-        ||  near(yf, ptrY[i])  ||  near(yf, ptrY[i+1])) {
-          Float cr = a[i] * yf + b[i] - blcx;
-          take = True;
-          // If a polygon point is a pixel point (in y), always
-          // count the ending point of the line segment.
-          // Do not count the starting point if the direction has
-          // not changed with respect to the previous non-vertical
-          // line segment.
-          if (near (yf, ptrY[i])) {
-            if (dir[i] != 1) {
-              take = False;
-            }
-          }
-          if (take) {
-            cross[nrcross++] = cr;
+    for (uInt j=0; j<nractive; j++) {
+      i = active[j];
+      Bool take = False;
+      // Calculate the crossing point if yf is inside the line segment.
+      if ((yf > ptrY[i]  &&  yf < ptrY[i+1])
+      ||  (yf < ptrY[i]  &&  yf > ptrY[i+1])
+      ||  near(yf, ptrY[i])  ||  near(yf, ptrY[i+1])) {
+        Float cr = a[i] * yf + b[i] - blcx;
+        take = True;
+        // If a polygon point is a pixel point (in y), always
+        // count the ending point of the line segment.
+        // Do not count the starting point if the direction has
+        // not changed with respect to the previous non-vertical
+        // line segment.
+        if (near (yf, ptrY[i])) {
+          if (dir[i] != 1) {
+            take = False;
           }
         }
+        if (take) {
+          cross[nrcross++] = cr;
+        }
       }
     }
     DebugAssert (nrcross >= 2, AipsError);
@@ -167,24 +167,25 @@ void LCUnion::multiGetSlice (Array<Bool>& buffer,
     uInt nr = regions().nelements();
     for (uInt i=0; i<nr; i++) {
         if (findAreas (stbuf, endbuf, streg, endreg, section, i)) {
-	    Array<Bool> tmpbuf;
 	    LCRegion* reg = (LCRegion*)(regions()[i]);
+	    Array<Bool> bufreg = buffer(stbuf,endbuf);
+	    // A region without a mask covers its entire bounding box,
+	    // so its mask does not need to be made.
+	    if (! reg->hasMask()) {
+	        bufreg = True;
+		continue;
+	    }
+	    Array<Bool> tmpbuf;
 	    reg->doGetSlice (tmpbuf, Slicer(streg, endreg, inc,
 					    Slicer::endIsLast));
-	    Array<Bool> bufreg = buffer(stbuf,endbuf);
 	    DebugAssert (bufreg.shape() == tmpbuf.shape(), AipsError);
 	    // Make pixel in buffer True when tmpbuf has a True pixel.
 	    Bool deleteBuf, deleteTmp;
 	    Bool* buf = bufreg.getStorage (deleteBuf);
-	    Bool* bufptr = buf;
-	    Bool* bufend = buf + bufreg.nelements();
 	    const Bool* tmp = tmpbuf.getStorage (deleteTmp);
-	    const Bool* tmpptr = tmp;
-	    while (bufptr < bufend) {
-	      if (*tmpptr++) {
-	        *bufptr = True;
-	      }
-	      bufptr++;
+	    const uInt n = bufreg.nelements();
+	    for (uInt j=0; j<n; j++) {
+	        buf[j] = buf[j] | tmp[j];
 	    }
 	    bufreg.putStorage (buf, deleteBuf);
 	    tmpbuf.freeStorage (tmp, deleteTmp);
@@ -124,6 +124,13 @@ public:
 // Do further preparations (e.g. optimization) on the expression.
    virtual Bool prepareScalarExpr();
 
+// Replace common subexpressions in the operand(s) and get the signature
+// for sharing this expression.
+// <group>
+   virtual void prepareSubExpr (LELSubExprMap& map);
+   virtual String signature() const;
+// </group>
+
 // Get class name
    virtual String className() const;    
 
@@ -229,6 +236,13 @@ public:
 // Do further preparations (e.g. optimization) on the expression.
    virtual Bool prepareScalarExpr();
 
+// Replace common subexpressions in the operand(s) and get the signature
+// for sharing this expression.
+// <group>
+   virtual void prepareSubExpr (LELSubExprMap& map);
+   virtual String signature() const;
+// </group>
+
 // Get class name
    virtual String className() const;    
 
@@ -330,6 +344,13 @@ public:
 // Do further preparations (e.g. optimization) on the expression.
    virtual Bool prepareScalarExpr();
 
+// Replace common subexpressions in the operand(s) and get the signature
+// for sharing this expression.
+// <group>
+   virtual void prepareSubExpr (LELSubExprMap& map);
+   virtual String signature() const;
+// </group>
+
 // Get class name
    virtual String className() const;    
 
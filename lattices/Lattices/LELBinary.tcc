@@ -26,6 +26,7 @@
 //# $Id$
 
 #include <lattices/Lattices/LELBinary.h>
+#include <lattices/Lattices/LELEvalContext.h>
 #include <lattices/Lattices/LELScalar.h>
 #include <lattices/Lattices/LELArray.h>
 #include <casa/Arrays/Slicer.h>
@@ -74,6 +75,30 @@ void LELBinary<T>::eval(LELArray<T>& result,
    cout << "LELBinary: eval " << endl;
 #endif
 
+// If both operands are the same array subexpression (e.g. a*a),
+// it is evaluated only once. The mask does not change in that case.
+
+   if (pLeftExpr_p == pRightExpr_p  &&  !pLeftExpr_p->isScalar()) {
+      pLeftExpr_p->eval(result, section);
+      switch(op_p) {
+      case LELBinaryEnums::ADD :
+	 result.value() += result.value();
+	 break;
+      case LELBinaryEnums::SUBTRACT:
+	 result.value() -= result.value();
+	 break;
+      case LELBinaryEnums::MULTIPLY:
+	 result.value() *= result.value();
+	 break;
+      case LELBinaryEnums::DIVIDE:
+	 result.value() /= result.value();
+	 break;
+      default:
+	 throw(AipsError("LELBinary::eval - unknown operation"));
+      }
+      return;
+   }
+
 // Evaluate the expression.      
 // We are sure that the operands do not have an all false mask,
 // so in the scalar case the possible mask is not changed.
@@ -192,6 +217,21 @@ Bool LELBinary<T>::prepareScalarExpr()
    return False;
 }
 
+template <class T>
+void LELBinary<T>::prepareSubExpr (LELSubExprMap& map)
+{
+   LELInterface<T>::replaceSubExpr (pLeftExpr_p, map);
+   LELInterface<T>::replaceSubExpr (pRightExpr_p, map);
+}
+
+template <class T>
+String LELBinary<T>::signature() const
+{
+   return "LELBinary(" + String::toString(Int(op_p)) + ',' +
+          LELSubExprMap::id (*pLeftExpr_p) + ',' +
+          LELSubExprMap::id (*pRightExpr_p) + ')';
+}
+
 
 template <class T>
 String LELBinary<T>::className() const
@@ -410,6 +450,21 @@ Bool LELBinaryCmp<T>::prepareScalarExpr()
    return False;
 }
 
+template <class T>
+void LELBinaryCmp<T>::prepareSubExpr (LELSubExprMap& map)
+{
+   LELInterface<T>::replaceSubExpr (pLeftExpr_p, map);
+   LELInterface<T>::replaceSubExpr (pRightExpr_p, map);
+}
+
+template <class T>
+String LELBinaryCmp<T>::signature() const
+{
+   return "LELBinaryCmp(" + String::toString(Int(op_p)) + ',' +
+          LELSubExprMap::id (*pLeftExpr_p) + ',' +
+          LELSubExprMap::id (*pRightExpr_p) + ')';
+}
+
 
 template <class T>
 String LELBinaryCmp<T>::className() const
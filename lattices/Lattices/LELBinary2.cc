@@ -26,6 +26,7 @@
 //# $Id$
 
 #include <lattices/Lattices/LELBinary.h>
+#include <lattices/Lattices/LELEvalContext.h>
 #include <lattices/Lattices/LELScalar.h>
 #include <lattices/Lattices/LELArray.h>
 #include <casa/Arrays/Slicer.h>
@@ -255,6 +256,19 @@ Bool LELBinaryBool::prepareScalarExpr()
    return  (nrinv==2);
 }
 
+void LELBinaryBool::prepareSubExpr (LELSubExprMap& map)
+{
+   LELInterface<Bool>::replaceSubExpr (pLeftExpr_p, map);
+   LELInterface<Bool>::replaceSubExpr (pRightExpr_p, map);
+}
+
+String LELBinaryBool::signature() const
+{
+   return "LELBinaryBool(" + String::toString(Int(op_p)) + ',' +
+          LELSubExprMap::id (*pLeftExpr_p) + ',' +
+          LELSubExprMap::id (*pRightExpr_p) + ')';
+}
+
 
 String LELBinaryBool::className() const
 {
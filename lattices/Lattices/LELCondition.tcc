@@ -27,6 +27,7 @@
 
 
 #include <lattices/Lattices/LELCondition.h>
+#include <lattices/Lattices/LELEvalContext.h>
 #include <lattices/Lattices/LELArray.h>
 #include <lattices/Lattices/LELScalar.h>
 #include <casa/Arrays/Slicer.h>
@@ -112,6 +113,20 @@ Bool LELCondition<T>::prepareScalarExpr()
    return False;
 }
 
+template <class T>
+void LELCondition<T>::prepareSubExpr (LELSubExprMap& map)
+{
+   LELInterface<T>::replaceSubExpr (pExpr_p, map);
+   LELInterface<Bool>::replaceSubExpr (pCond_p, map);
+}
+
+template <class T>
+String LELCondition<T>::signature() const
+{
+   return "LELCondition(" + LELSubExprMap::id (*pExpr_p) + ',' +
+          LELSubExprMap::id (*pCond_p) + ')';
+}
+
 
 template <class T>
 String LELCondition<T>::className() const
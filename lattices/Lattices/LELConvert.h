@@ -112,6 +112,13 @@ public:
 // Do further preparations (e.g. optimization) on the expression.
    virtual Bool prepareScalarExpr();
 
+// Replace common subexpressions in the operand(s) and get the signature
+// for sharing this expression.
+// <group>
+   virtual void prepareSubExpr (LELSubExprMap& map);
+   virtual String signature() const;
+// </group>
+
 // Get class name
    virtual String className() const;    
 
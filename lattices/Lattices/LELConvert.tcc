@@ -27,6 +27,7 @@
 
 
 #include <lattices/Lattices/LELConvert.h>
+#include <lattices/Lattices/LELEvalContext.h>
 #include <lattices/Lattices/LELArray.h>
 #include <lattices/Lattices/LELScalar.h>
 #include <casa/Arrays/Slicer.h>
@@ -100,6 +101,18 @@ Bool LELConvert<T,F>::prepareScalarExpr()
    return LELInterface<F>::replaceScalarExpr (pExpr_p);
 }
 
+template <class T, class F>
+void LELConvert<T,F>::prepareSubExpr (LELSubExprMap& map)
+{
+   LELInterface<F>::replaceSubExpr (pExpr_p, map);
+}
+
+template <class T, class F>
+String LELConvert<T,F>::signature() const
+{
+   return "LELConvert(" + LELSubExprMap::id (*pExpr_p) + ')';
+}
+
 
 template <class T, class F>
 String LELConvert<T,F>::className() const
@@ -0,0 +1,160 @@
+//# LELEvalContext.cc:  Evaluation context for shared LEL subexpressions
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+#include <lattices/Lattices/LELEvalContext.h>
+#include <lattices/Lattices/LELShared.h>
+#include <casa/Exceptions/Error.h>
+
+#ifdef USE_THREADS
+#include <pthread.h>
+#endif
+
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+#ifdef USE_THREADS
+// Each thread has its own current context.
+static pthread_key_t theirContextKey;
+static int theirContextKeyStatus = pthread_key_create (&theirContextKey, 0);
+#else
+static LELEvalContext* theirContext = 0;
+#endif
+
+
+LELEvalContext::Entry::Entry (const void* node, const Slicer& section)
+: itsNode    (node),
+  itsSection (section),
+  itsNServed (0)
+{}
+
+LELEvalContext::Entry::~Entry()
+{}
+
+Bool LELEvalContext::Entry::matches (const void* node,
+                                     const Slicer& section) const
+{
+  return (node == itsNode
+      &&  section.start().isEqual (itsSection.start())
+      &&  section.end().isEqual (itsSection.end())
+      &&  section.stride().isEqual (itsSection.stride()));
+}
+
+
+LELEvalContext::LELEvalContext()
+: itsIsCurrent (False)
+{
+  if (current() == 0) {
+    setCurrent (this);
+    itsIsCurrent = True;
+  }
+}
+
+LELEvalContext::~LELEvalContext()
+{
+  if (itsIsCurrent) {
+    setCurrent (0);
+  }
+  for (uInt i=0; i<itsEntries.size(); ++i) {
+    delete itsEntries[i];
+  }
+}
+
+LELEvalContext* LELEvalContext::current()
+{
+#ifdef USE_THREADS
+  return static_cast<LELEvalContext*>(pthread_getspecific (theirContextKey));
+#else
+  return theirContext;
+#endif
+}
+
+void LELEvalContext::setCurrent (LELEvalContext* context)
+{
+#ifdef USE_THREADS
+  if (theirContextKeyStatus != 0) {
+    throw SystemCallError ("pthread_key_create", theirContextKeyStatus);
+  }
+  int error = pthread_setspecific (theirContextKey, context);
+  if (error != 0) {
+    throw SystemCallError ("pthread_setspecific", error);
+  }
+#else
+  theirContext = context;
+#endif
+}
+
+LELEvalContext::Entry* LELEvalContext::find (const void* node,
+                                             const Slicer& section) const
+{
+  for (uInt i=0; i<itsEntries.size(); ++i) {
+    if (itsEntries[i]->matches (node, section)) {
+      return itsEntries[i];
+    }
+  }
+  return 0;
+}
+
+void LELEvalContext::add (Entry* entry)
+{
+  itsEntries.push_back (entry);
+}
+
+void LELEvalContext::remove (Entry* entry)
+{
+  for (uInt i=0; i<itsEntries.size(); ++i) {
+    if (itsEntries[i] == entry) {
+      itsEntries.erase (itsEntries.begin() + i);
+      delete entry;
+      return;
+    }
+  }
+}
+
+
+// The map holds one reference to each LELShared object, the other ones
+// are held by the parents in the expression tree.
+template <class T>
+static void setSharedUsers (std::map<String, CountedPtr<LELShared<T> > >& smap)
+{
+  typedef typename std::map<String, CountedPtr<LELShared<T> > >::iterator Iter;
+  for (Iter iter = smap.begin(); iter != smap.end(); ++iter) {
+    iter->second->setUsers (iter->second.nrefs() - 1);
+  }
+  smap.clear();
+}
+
+void LELSubExprMap::setUsers()
+{
+  setSharedUsers (itsFloat);
+  setSharedUsers (itsDouble);
+  setSharedUsers (itsComplex);
+  setSharedUsers (itsDComplex);
+  setSharedUsers (itsBool);
+}
+
+} //# NAMESPACE CASA - END
@@ -0,0 +1,225 @@
+//# LELEvalContext.h:  Evaluation context for shared LEL subexpressions
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef LATTICES_LELEVALCONTEXT_H
+#define LATTICES_LELEVALCONTEXT_H
+
+
+//# Includes
+#include <casa/aips.h>
+#include <casa/Arrays/Slicer.h>
+#include <casa/BasicSL/String.h>
+#include <casa/BasicSL/Complex.h>
+#include <casa/Utilities/CountedPtr.h>
+#include <casa/sstream.h>
+#include <casa/iomanip.h>
+#include <map>
+#include <vector>
+
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+//# Forward Declarations
+template <class T> class LELInterface;
+template <class T> class LELScalar;
+template <class T> class LELShared;
+
+
+// <summary>
+// Cache of shared subexpression results for one evaluation
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="yyyy/mm/dd" tests="" demos="">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class="LELShared"> LELShared</linkto>
+// </prerequisite>
+
+// <synopsis>
+// An LELEvalContext object holds the results of the shared subexpressions
+// (see class <linkto class=LELShared>LELShared</linkto>) evaluated for
+// a section of a lattice expression.
+// <br>LatticeExprNode::eval creates an LELEvalContext on the stack.
+// It becomes the current context of the thread if the thread does not
+// have a current context yet, otherwise it does nothing. In this way
+// the nested evaluations of function arguments use the context of the
+// outermost evaluation, while different threads evaluating different
+// sections (as done by LatticeExpr) have their own context.
+// <br>The destructor removes all results still held.
+// </synopsis>
+
+class LELEvalContext
+{
+public:
+  // Base class of a cached result of a node for a section.
+  class Entry
+  {
+  public:
+    Entry (const void* node, const Slicer& section);
+    virtual ~Entry();
+    // Is it the result of the given node and section?
+    Bool matches (const void* node, const Slicer& section) const;
+    // Count a use of the result and return the total number of uses.
+    uInt serve()
+      { return ++itsNServed; }
+  private:
+    const void* itsNode;
+    Slicer      itsSection;
+    uInt        itsNServed;
+  };
+
+  // Make this context the current one of the thread if there is none.
+  LELEvalContext();
+
+  // Reset the current context (if set by this object) and delete
+  // the remaining entries.
+  ~LELEvalContext();
+
+  // Get the current context of the thread (0 if none).
+  static LELEvalContext* current();
+
+  // Find the entry for the given node and section (0 if not found).
+  Entry* find (const void* node, const Slicer& section) const;
+
+  // Add an entry. The context takes over the pointer.
+  void add (Entry* entry);
+
+  // Remove (and delete) an entry.
+  void remove (Entry* entry);
+
+private:
+  // Forbid copy constructor and assignment.
+  // <group>
+  LELEvalContext (const LELEvalContext&);
+  LELEvalContext& operator= (const LELEvalContext&);
+  // </group>
+
+  // Set the current context of the thread.
+  static void setCurrent (LELEvalContext* context);
+
+  Bool                itsIsCurrent;
+  std::vector<Entry*> itsEntries;
+};
+
+
+
+// <summary>
+// Map of the shared subexpressions found while preparing an expression
+// </summary>
+
+// <use visibility=local>
+
+// <synopsis>
+// This class is used by LELInterface::replaceSubExpr to find the
+// subexpressions with equal signatures. It has a map per data type.
+// <br>Function <src>setUsers</src> has to be called at the end to
+// tell each LELShared object how many parents it has.
+// </synopsis>
+
+class LELSubExprMap
+{
+public:
+  LELSubExprMap()
+    {}
+
+  // Return the LELShared object for the given signature.
+  // The subexpression is wrapped in a new one if the signature is unknown.
+  template <class T>
+  CountedPtr<LELInterface<T> > share (const CountedPtr<LELInterface<T> >& expr,
+                                      const String& signature)
+  {
+    typedef std::map<String, CountedPtr<LELShared<T> > > Map;
+    Map& smap = typedMap ((T*)0);
+    typename Map::iterator iter = smap.find (signature);
+    if (iter == smap.end()) {
+      iter = smap.insert (std::make_pair
+                          (signature,
+                           CountedPtr<LELShared<T> > (new LELShared<T>(expr))))
+                         .first;
+    }
+    return iter->second;
+  }
+
+  // Set the number of users (parents) of the LELShared objects
+  // and clear the maps.
+  void setUsers();
+
+  // Get the identity of an operand for use in a signature.
+  // A scalar is identified by its value, otherwise by its address.
+  template <class T>
+  static String id (const LELInterface<T>& expr)
+  {
+    std::ostringstream ostr;
+    if (expr.isScalar()) {
+      LELScalar<T> scalar = expr.getScalar();
+      if (scalar.mask()) {
+        ostr << std::setprecision(20) << "s" << scalar.value();
+      } else {
+        ostr << "invalid";
+      }
+    } else {
+      ostr << &expr;
+    }
+    return ostr.str();
+  }
+
+private:
+  // Forbid copy constructor and assignment.
+  // <group>
+  LELSubExprMap (const LELSubExprMap&);
+  LELSubExprMap& operator= (const LELSubExprMap&);
+  // </group>
+
+  // Get the map for the data type of the pointer.
+  // <group>
+  std::map<String, CountedPtr<LELShared<Float> > >& typedMap (Float*)
+    { return itsFloat; }
+  std::map<String, CountedPtr<LELShared<Double> > >& typedMap (Double*)
+    { return itsDouble; }
+  std::map<String, CountedPtr<LELShared<Complex> > >& typedMap (Complex*)
+    { return itsComplex; }
+  std::map<String, CountedPtr<LELShared<DComplex> > >& typedMap (DComplex*)
+    { return itsDComplex; }
+  std::map<String, CountedPtr<LELShared<Bool> > >& typedMap (Bool*)
+    { return itsBool; }
+  // </group>
+
+  std::map<String, CountedPtr<LELShared<Float> > >    itsFloat;
+  std::map<String, CountedPtr<LELShared<Double> > >   itsDouble;
+  std::map<String, CountedPtr<LELShared<Complex> > >  itsComplex;
+  std::map<String, CountedPtr<LELShared<DComplex> > > itsDComplex;
+  std::map<String, CountedPtr<LELShared<Bool> > >     itsBool;
+};
+
+
+
+} //# NAMESPACE CASA - END
+
+#endif
@@ -34,6 +34,7 @@
 #include <lattices/Lattices/LatticeExprNode.h>
 #include <lattices/Lattices/LELFunctionEnums.h>
 #include <casa/Containers/Block.h>
+#include <scimath/Mathematics/NumericTraits.h>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
@@ -124,6 +125,13 @@ public:
 // Do further preparations (e.g. optimization) on the expression.
    virtual Bool prepareScalarExpr();
 
+// Replace common subexpressions in the operand(s) and get the signature
+// for sharing this expression.
+// <group>
+   virtual void prepareSubExpr (LELSubExprMap& map);
+   virtual String signature() const;
+// </group>
+
 // Get class name
    virtual String className() const;
 
@@ -136,6 +144,13 @@ public:
   // </group>
 
 private:
+   // Get the number of chunks to evaluate at a time in a reduction.
+   static uInt nChunkBuffers();
+
+   // Sum the (unmasked) values of the expression.
+   // It returns the number of values summed.
+   Int sumChunks (typename NumericTraits<T>::PrecisionType& sumVal) const;
+
    LELFunctionEnums::Function   function_p;
    CountedPtr<LELInterface<T> > pExpr_p;
 };
@@ -226,6 +241,13 @@ public:
 // Do further preparations (e.g. optimization) on the expression.
    virtual Bool prepareScalarExpr();
 
+// Replace common subexpressions in the operand(s) and get the signature
+// for sharing this expression.
+// <group>
+   virtual void prepareSubExpr (LELSubExprMap& map);
+   virtual String signature() const;
+// </group>
+
 // Get class name
    virtual String className() const;
 
@@ -331,6 +353,13 @@ public:
 // Do further preparations (e.g. optimization) on the expression.
    virtual Bool prepareScalarExpr();
 
+// Replace common subexpressions in the operand(s) and get the signature
+// for sharing this expression.
+// <group>
+   virtual void prepareSubExpr (LELSubExprMap& map);
+   virtual String signature() const;
+// </group>
+
 // Get class name
    virtual String className() const;
 
@@ -437,6 +466,13 @@ public:
 // Do further preparations (e.g. optimization) on the expression.
    virtual Bool prepareScalarExpr();
 
+// Replace common subexpressions in the operand(s) and get the signature
+// for sharing this expression.
+// <group>
+   virtual void prepareSubExpr (LELSubExprMap& map);
+   virtual String signature() const;
+// </group>
+
 // Get class name
    virtual String className() const;
 
@@ -549,6 +585,13 @@ public:
 // Do further preparations (e.g. optimization) on the expression.
    virtual Bool prepareScalarExpr();
 
+// Replace common subexpressions in the operand(s) and get the signature
+// for sharing this expression.
+// <group>
+   virtual void prepareSubExpr (LELSubExprMap& map);
+   virtual String signature() const;
+// </group>
+
 // Get class name
    virtual String className() const;
 
@@ -651,6 +694,13 @@ public:
 // Do further preparations (e.g. optimization) on the expression.
    virtual Bool prepareScalarExpr();
 
+// Replace common subexpressions in the operand(s) and get the signature
+// for sharing this expression.
+// <group>
+   virtual void prepareSubExpr (LELSubExprMap& map);
+   virtual String signature() const;
+// </group>
+
 // Get class name
    virtual String className() const;
 
@@ -748,6 +798,13 @@ public:
 // Do further preparations (e.g. optimization) on the expression.
    virtual Bool prepareScalarExpr();
 
+// Replace common subexpressions in the operand(s) and get the signature
+// for sharing this expression.
+// <group>
+   virtual void prepareSubExpr (LELSubExprMap& map);
+   virtual String signature() const;
+// </group>
+
 // Get class name
    virtual String className() const;
 
@@ -844,6 +901,13 @@ public:
 // Do further preparations (e.g. optimization) on the expression.
    virtual Bool prepareScalarExpr();
 
+// Replace common subexpressions in the operand(s) and get the signature
+// for sharing this expression.
+// <group>
+   virtual void prepareSubExpr (LELSubExprMap& map);
+   virtual String signature() const;
+// </group>
+
 // Get class name
    virtual String className() const;
 
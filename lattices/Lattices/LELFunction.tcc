@@ -28,18 +28,24 @@
 #include <lattices/Lattices/LatticeExpr.h>
 #include <lattices/Lattices/LELFunction.h> 
 #include <lattices/Lattices/LELFunctionEnums.h>
+#include <lattices/Lattices/LELEvalContext.h>
 #include <lattices/Lattices/LELScalar.h>
 #include <lattices/Lattices/LELArray.h>
 #include <lattices/Lattices/LatticeFractile.h>
 #include <lattices/Lattices/LatticeExpr.h>
 #include <lattices/Lattices/MaskedLatticeIterator.h>
 #include <lattices/Lattices/LatticeIterator.h>
+#include <lattices/Lattices/TileStepper.h>
 #include <casa/Arrays/Slicer.h>
 #include <casa/Arrays/Vector.h>
 #include <casa/Arrays/ArrayMath.h>
 #include <scimath/Mathematics/NumericTraits.h> 
 #include <casa/Exceptions/Error.h> 
 
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
@@ -196,37 +202,39 @@ LELScalar<T> LELFunction1D<T>::getScalar() const
       Bool firstTime = True;
       T minVal = T();
       LatticeExpr<T> latExpr(pExpr_p);
-      if (! latExpr.isMasked()) {
-	 RO_LatticeIterator<T> iter(latExpr);
-	 while (! iter.atEnd()) {
-	    T minv = min(iter.cursor());
-	    if (firstTime  ||  minv < minVal) {
-	       firstTime = False;
-	       minVal = minv;
-	    }
-	    iter++;
-	 }
-      } else {
-	 RO_MaskedLatticeIterator<T> iter(latExpr);
-	 Bool delMask, delData;
-	 Array<Bool> mask;
-	 while (! iter.atEnd()) {
-	    const Array<T>& array = iter.cursor();
-	    iter.getMask (mask);
-	    const Bool* maskPtr = mask.getStorage (delMask);
-	    const T* dataPtr = array.getStorage (delData);
-	    uInt n = array.nelements();
-	    for (uInt i=0; i<n; i++) {
-	       if (maskPtr[i]) {
-		  if (firstTime  ||  dataPtr[i] < minVal) {
-		     firstTime = False;
-		     minVal = dataPtr[i];
+      TileStepper stepper(latExpr.shape(), latExpr.niceCursorShape());
+      const uInt nbuf = nChunkBuffers();
+      Block<Array<T> > values(nbuf);
+      Block<Array<Bool> > masks(nbuf);
+      Block<IPosition> positions(nbuf);
+      Bool delMask, delData;
+      uInt nchunk;
+      while ((nchunk = latExpr.evalChunks (values, masks, positions,
+					   stepper)) > 0) {
+	 for (uInt j=0; j<nchunk; j++) {
+	    const Array<T>& array = values[j];
+	    const Array<Bool>& mask = masks[j];
+	    if (mask.empty()) {
+	       T minv = min(array);
+	       if (firstTime  ||  minv < minVal) {
+		  firstTime = False;
+		  minVal = minv;
+	       }
+	    } else {
+	       const Bool* maskPtr = mask.getStorage (delMask);
+	       const T* dataPtr = array.getStorage (delData);
+	       uInt n = array.nelements();
+	       for (uInt i=0; i<n; i++) {
+		  if (maskPtr[i]) {
+		     if (firstTime  ||  dataPtr[i] < minVal) {
+			firstTime = False;
+			minVal = dataPtr[i];
+		     }
 		  }
 	       }
+	       mask.freeStorage (maskPtr, delMask);
+	       array.freeStorage (dataPtr, delData);
 	    }
-	    mask.freeStorage (maskPtr, delMask);
-	    array.freeStorage (dataPtr, delData);
-	    iter++;
 	 }
       }
       if (firstTime) {
@@ -242,37 +250,39 @@ LELScalar<T> LELFunction1D<T>::getScalar() const
       Bool firstTime = True;
       T maxVal = T();
       LatticeExpr<T> latExpr(pExpr_p);
-      if (! latExpr.isMasked()) {
-	 RO_LatticeIterator<T> iter(latExpr);
-	 while (! iter.atEnd()) {
-	    T maxv = max(iter.cursor());
-	    if (firstTime  ||  maxv > maxVal) {
-	       firstTime = False;
-	       maxVal = maxv;
-	    }
-	    iter++;
-	 }
-      } else {
-	 RO_MaskedLatticeIterator<T> iter(latExpr);
-	 Bool delMask, delData;
-	 Array<Bool> mask;
-	 while (! iter.atEnd()) {
-	    const Array<T>& array = iter.cursor();
-	    iter.getMask (mask);
-	    const Bool* maskPtr = mask.getStorage (delMask);
-	    const T* dataPtr = array.getStorage (delData);
-	    uInt n = array.nelements();
-	    for (uInt i=0; i<n; i++) {
-	       if (maskPtr[i]) {
-		  if (firstTime  ||  dataPtr[i] > maxVal) {
-		     firstTime = False;
-		     maxVal = dataPtr[i];
+      TileStepper stepper(latExpr.shape(), latExpr.niceCursorShape());
+      const uInt nbuf = nChunkBuffers();
+      Block<Array<T> > values(nbuf);
+      Block<Array<Bool> > masks(nbuf);
+      Block<IPosition> positions(nbuf);
+      Bool delMask, delData;
+      uInt nchunk;
+      while ((nchunk = latExpr.evalChunks (values, masks, positions,
+					   stepper)) > 0) {
+	 for (uInt j=0; j<nchunk; j++) {
+	    const Array<T>& array = values[j];
+	    const Array<Bool>& mask = masks[j];
+	    if (mask.empty()) {
+	       T maxv = max(array);
+	       if (firstTime  ||  maxv > maxVal) {
+		  firstTime = False;
+		  maxVal = maxv;
+	       }
+	    } else {
+	       const Bool* maskPtr = mask.getStorage (delMask);
+	       const T* dataPtr = array.getStorage (delData);
+	       uInt n = array.nelements();
+	       for (uInt i=0; i<n; i++) {
+		  if (maskPtr[i]) {
+		     if (firstTime  ||  dataPtr[i] > maxVal) {
+			firstTime = False;
+			maxVal = dataPtr[i];
+		     }
 		  }
 	       }
+	       mask.freeStorage (maskPtr, delMask);
+	       array.freeStorage (dataPtr, delData);
 	    }
-	    mask.freeStorage (maskPtr, delMask);
-	    array.freeStorage (dataPtr, delData);
-	    iter++;
 	 }
       }
       if (firstTime) {
@@ -286,45 +296,7 @@ LELScalar<T> LELFunction1D<T>::getScalar() const
          return pExpr_p->getScalar();
       }
       typename NumericTraits<T>::PrecisionType sumVal = 0;
-      Int nrVal = 0;
-      LatticeExpr<T> latExpr(pExpr_p);
-      Bool delData, delMask;
-
-// Do the sum ourselves to avoid round off
-
-      if (! latExpr.isMasked()) {
-	 RO_LatticeIterator<T> iter(latExpr);
-	 while (! iter.atEnd()) {
-	    const Array<T>& array = iter.cursor();
-	    const T* dataPtr = array.getStorage(delData);
-	    uInt n = array.nelements();
-	    for (uInt i=0; i<n; i++) {
-		sumVal += dataPtr[i];
-	    }
-	    array.freeStorage(dataPtr, delData);
-	    nrVal += n;
-	    iter++;
-	 }
-      } else {
-	 RO_MaskedLatticeIterator<T> iter(latExpr);
-	 Array<Bool> mask;
-	 while (! iter.atEnd()) {
-	    const Array<T>& array = iter.cursor();
-	    iter.getMask (mask);
-	    const Bool* maskPtr = mask.getStorage (delMask);
-	    const T* dataPtr = array.getStorage (delData);
-	    uInt n = array.nelements();
-	    for (uInt i=0; i<n; i++) {
-	       if (maskPtr[i]) {
-		  sumVal += dataPtr[i];
-		  nrVal++;
-	       }
-	    }
-	    mask.freeStorage (maskPtr, delMask);
-	    array.freeStorage (dataPtr, delData);
-	    iter++;
-	 }
-      }
+      Int nrVal = sumChunks (sumVal);
       if (nrVal == 0) {
 	  return LELScalar<T>();           // no element found
       }
@@ -336,48 +308,68 @@ LELScalar<T> LELFunction1D<T>::getScalar() const
          return pExpr_p->getScalar();
       }
       typename NumericTraits<T>::PrecisionType sumVal = 0;
-      LatticeExpr<T> latExpr(pExpr_p);
-      Bool delData, delMask;
+      sumChunks (sumVal);
+      return T(sumVal);
+   }
+   default:
+      throw(AipsError("LELFunction1D::getScalar - unknown function"));
+   }
+   return pExpr_p->getScalar();         // to make compiler happy
+}
 
-// Do the sum ourselves to avoid round off
+template <class T>
+uInt LELFunction1D<T>::nChunkBuffers()
+{
+// Evaluate two chunks per thread at a time to keep all threads busy.
+#ifdef _OPENMP
+   return 2 * std::max(1, omp_get_max_threads());
+#else
+   return 1;
+#endif
+}
 
-      if (! latExpr.isMasked()) {
-	 RO_LatticeIterator<T> iter(latExpr);
-	 while (! iter.atEnd()) {
-	    const Array<T>& array = iter.cursor();
-	    const T* dataPtr = array.getStorage(delData);
-	    uInt n = array.nelements();
+template <class T>
+Int LELFunction1D<T>::sumChunks
+                   (typename NumericTraits<T>::PrecisionType& sumVal) const
+{
+// Do the sum ourselves to avoid round off.
+// The chunks are evaluated in parallel, but summed in stepper order,
+// so the result does not depend on the number of threads.
+   Int nrVal = 0;
+   LatticeExpr<T> latExpr(pExpr_p);
+   TileStepper stepper(latExpr.shape(), latExpr.niceCursorShape());
+   const uInt nbuf = nChunkBuffers();
+   Block<Array<T> > values(nbuf);
+   Block<Array<Bool> > masks(nbuf);
+   Block<IPosition> positions(nbuf);
+   Bool delData, delMask;
+   uInt nchunk;
+   while ((nchunk = latExpr.evalChunks (values, masks, positions,
+					stepper)) > 0) {
+      for (uInt j=0; j<nchunk; j++) {
+	 const Array<T>& array = values[j];
+	 const Array<Bool>& mask = masks[j];
+	 const T* dataPtr = array.getStorage (delData);
+	 uInt n = array.nelements();
+	 if (mask.empty()) {
 	    for (uInt i=0; i<n; i++) {
-		sumVal += dataPtr[i];
+	       sumVal += dataPtr[i];
 	    }
-	    array.freeStorage(dataPtr, delData);
-	    iter++;
-	 }
-      } else {
-	 RO_MaskedLatticeIterator<T> iter(latExpr);
-	 Array<Bool> mask;
-	 while (! iter.atEnd()) {
-	    const Array<T>& array = iter.cursor();
-	    iter.getMask (mask);
+	    nrVal += n;
+	 } else {
 	    const Bool* maskPtr = mask.getStorage (delMask);
-	    const T* dataPtr = array.getStorage (delData);
-	    uInt n = array.nelements();
 	    for (uInt i=0; i<n; i++) {
 	       if (maskPtr[i]) {
 		  sumVal += dataPtr[i];
+		  nrVal++;
 	       }
 	    }
 	    mask.freeStorage (maskPtr, delMask);
-	    array.freeStorage (dataPtr, delData);
-	    iter++;
 	 }
+	 array.freeStorage (dataPtr, delData);
       }
-      return T(sumVal);
-   }
-   default:
-      throw(AipsError("LELFunction1D::getScalar - unknown function"));
    }
-   return pExpr_p->getScalar();         // to make compiler happy
+   return nrVal;
 }
 
 template <class T>
@@ -390,6 +382,19 @@ Bool LELFunction1D<T>::prepareScalarExpr()
    return LELInterface<T>::replaceScalarExpr (pExpr_p);
 }
 
+template <class T>
+void LELFunction1D<T>::prepareSubExpr (LELSubExprMap& map)
+{
+   LELInterface<T>::replaceSubExpr (pExpr_p, map);
+}
+
+template <class T>
+String LELFunction1D<T>::signature() const
+{
+   return "LELFunction1D(" + String::toString(Int(function_p)) + ',' +
+          LELSubExprMap::id (*pExpr_p) + ')';
+}
+
 template <class T>
 String LELFunction1D<T>::className() const
 {
@@ -591,6 +596,24 @@ Bool LELFunctionReal1D<T>::prepareScalarExpr()
    return False;
 }
 
+template <class T>
+void LELFunctionReal1D<T>::prepareSubExpr (LELSubExprMap& map)
+{
+   if (! pExpr_p.null()) {
+      LELInterface<T>::replaceSubExpr (pExpr_p, map);
+   }
+}
+
+template <class T>
+String LELFunctionReal1D<T>::signature() const
+{
+   if (pExpr_p.null()) {
+      return String();
+   }
+   return "LELFunctionReal1D(" + String::toString(Int(function_p)) + ',' +
+          LELSubExprMap::id (*pExpr_p) + ')';
+}
+
 template <class T>
 String LELFunctionReal1D<T>::className() const
 {
@@ -1004,6 +1027,21 @@ Bool LELFunctionND<T>::prepareScalarExpr()
    return False;
 }
 
+template <class T>
+void LELFunctionND<T>::prepareSubExpr (LELSubExprMap& map)
+{
+   for (uInt i=0; i<arg_p.nelements(); i++) {
+      arg_p[i].replaceSubExpr (map);
+   }
+}
+
+// The functions are not compared, so only the same object is shared.
+template <class T>
+String LELFunctionND<T>::signature() const
+{
+   return LELSubExprMap::id (*this);
+}
+
 template <class T>
 String LELFunctionND<T>::className() const
 {
@@ -27,6 +27,7 @@
 
 #include <lattices/Lattices/LELFunction.h>
 #include <lattices/Lattices/LELFunctionEnums.h>
+#include <lattices/Lattices/LELEvalContext.h>
 #include <lattices/Lattices/LELArray.h>
 #include <lattices/Lattices/LELScalar.h>
 #include <lattices/Lattices/LatticeFractile.h>
@@ -477,6 +478,18 @@ Bool LELFunctionFloat::prepareScalarExpr()
    return False;
 }
 
+void LELFunctionFloat::prepareSubExpr (LELSubExprMap& map)
+{
+   for (uInt i=0; i<arg_p.nelements(); i++) {
+      arg_p[i].replaceSubExpr (map);
+   }
+}
+
+String LELFunctionFloat::signature() const
+{
+   return LELSubExprMap::id (*this);
+}
+
 String LELFunctionFloat::className() const
 {
    return String("LELFunctionFloat");
@@ -1061,6 +1074,18 @@ Bool LELFunctionDouble::prepareScalarExpr()
    return False;
 }
 
+void LELFunctionDouble::prepareSubExpr (LELSubExprMap& map)
+{
+   for (uInt i=0; i<arg_p.nelements(); i++) {
+      arg_p[i].replaceSubExpr (map);
+   }
+}
+
+String LELFunctionDouble::signature() const
+{
+   return LELSubExprMap::id (*this);
+}
+
 String LELFunctionDouble::className() const
 {
    return String("LELFunctionDouble");
@@ -1335,6 +1360,18 @@ Bool LELFunctionComplex::prepareScalarExpr()
    return False;
 }
 
+void LELFunctionComplex::prepareSubExpr (LELSubExprMap& map)
+{
+   for (uInt i=0; i<arg_p.nelements(); i++) {
+      arg_p[i].replaceSubExpr (map);
+   }
+}
+
+String LELFunctionComplex::signature() const
+{
+   return LELSubExprMap::id (*this);
+}
+
 String LELFunctionComplex::className() const
 {
    return String("LELFunctionComplex");
@@ -1608,6 +1645,18 @@ Bool LELFunctionDComplex::prepareScalarExpr()
    return False;
 }
 
+void LELFunctionDComplex::prepareSubExpr (LELSubExprMap& map)
+{
+   for (uInt i=0; i<arg_p.nelements(); i++) {
+      arg_p[i].replaceSubExpr (map);
+   }
+}
+
+String LELFunctionDComplex::signature() const
+{
+   return LELSubExprMap::id (*this);
+}
+
 String LELFunctionDComplex::className() const
 {
    return String("LELFunctionDComplex");
@@ -2035,6 +2084,18 @@ Bool LELFunctionBool::prepareScalarExpr()
    return False;
 }
 
+void LELFunctionBool::prepareSubExpr (LELSubExprMap& map)
+{
+   for (uInt i=0; i<arg_p.nelements(); i++) {
+      arg_p[i].replaceSubExpr (map);
+   }
+}
+
+String LELFunctionBool::signature() const
+{
+   return LELSubExprMap::id (*this);
+}
+
 String LELFunctionBool::className() const
 {
    return String("LELFunctionBool");
@@ -44,6 +44,7 @@ template <class T> class LELScalar;
 template <class T> class LELArray;
 template <class T> class LELArrayRef;
 class Slicer;
+class LELSubExprMap;
 
 
 // <summary> This base class provides the interface for Lattice expressions </summary>
@@ -192,6 +193,22 @@ public:
 // is an invalid scalar (i.e. with a False mask).
    static Bool replaceScalarExpr (CountedPtr<LELInterface<T> >& expr);
 
+// Replace the subexpressions of this node by shared ones
+// (see class <linkto class=LELShared>LELShared</linkto>).
+// By default it does nothing.
+   virtual void prepareSubExpr (LELSubExprMap& map);
+
+// Get the signature of the expression. Expressions with equal signatures
+// give the same result, so they can be shared.
+// An empty signature (the default) means that the expression is not shared.
+   virtual String signature() const;
+
+// Recursively replace equal subexpressions by a shared one.
+// The given expression itself is replaced if its signature was seen
+// before. Scalar expressions are left alone.
+   static void replaceSubExpr (CountedPtr<LELInterface<T> >& expr,
+                               LELSubExprMap& map);
+
   // Handle locking/syncing of the parts of a lattice expression.
   // <br>By default the functions do not do anything at all.
   // lock() and hasLock return True.
@@ -220,7 +237,10 @@ private:
 //# fails to compile, because the LELUnary declarations are not seen yet.
 //# Therefore LELUnary.h is included here, while LELUnary.h includes
 //# LELInterface.tcc.
+//# LELShared.h is included for the same reason, because it defines
+//# LELInterface::replaceSubExpr.
 #ifndef CASACORE_NO_AUTO_TEMPLATES
 #include <lattices/Lattices/LELUnary.h>
+#include <lattices/Lattices/LELShared.h>
 #endif //# CASACORE_NO_AUTO_TEMPLATES
 #endif
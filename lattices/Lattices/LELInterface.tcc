@@ -89,6 +89,15 @@ Bool LELInterface<T>::replaceScalarExpr (CountedPtr<LELInterface<T> >& expr)
     return isInvalidScalar;
 }
 
+template<class T>
+void LELInterface<T>::prepareSubExpr (LELSubExprMap&)
+{}
+
+template<class T>
+String LELInterface<T>::signature() const
+{
+    return String();
+}
 
 template<class T>
 Bool LELInterface<T>::lock (FileLocker::LockType, uInt)
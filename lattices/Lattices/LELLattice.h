@@ -31,6 +31,7 @@
 
 //# Includes
 #include <lattices/Lattices/LELInterface.h>
+#include <casa/OS/Mutex.h>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
@@ -91,6 +92,31 @@ template <class T> class MaskedLattice;
 
 
 
+// <summary> Global lock serialising LEL access to Lattices </summary>
+// <synopsis>
+// The LEL letter classes are stateless during evaluation, so several
+// chunks of an expression can be evaluated in parallel (see
+// <linkto class=LatticeExpr>LatticeExpr::evalChunks</linkto>).
+// The lattices they read from (e.g. a PagedArray or a LatticeExpr with its
+// chunk cache) are not thread-safe, so all reads done by
+// <linkto class=LELLattice>LELLattice</linkto> and LELRegionAsBool
+// are serialised by this lock.
+// The mutex is recursive, because reading a lattice can evaluate a nested
+// lattice expression on the same thread.
+// </synopsis>
+
+class LELLatticeLock
+{
+public:
+  // Get the global mutex.
+  static Mutex& mutex()
+    { return theirMutex; }
+
+private:
+  static Mutex theirMutex;
+};
+
+
 template <class T> class LELLattice : public LELInterface<T>
 {
   //# Make members of parent class known.
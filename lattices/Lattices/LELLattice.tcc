@@ -88,6 +88,7 @@ void LELLattice<T>::eval(LELArray<T>& result,
 	<< pLattice_p.nrefs() << endl;
 #endif
 
+   ScopedMutexLock locker(LELLatticeLock::mutex());
    Array<T> tmp = pLattice_p->getSlice (section);
    result.value().reference(tmp);
    if (getAttribute().isMasked()) {
@@ -107,6 +108,7 @@ void LELLattice<T>::evalRef(LELArrayRef<T>& result,
 	<< pLattice_p.nrefs() << endl;
 #endif
 
+   ScopedMutexLock locker(LELLatticeLock::mutex());
    Array<T> tmp;
    pLattice_p->getSlice (tmp, section);
    // Cast to its base class LELArray to use the non-const value function.
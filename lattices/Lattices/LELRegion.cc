@@ -30,6 +30,7 @@
 #include <lattices/Lattices/LattRegionHolder.h>
 #include <lattices/Lattices/LELArray.h>
 #include <lattices/Lattices/LELScalar.h>
+#include <lattices/Lattices/LELLattice.h>
 #include <casa/Utilities/Assert.h>
 #include <casa/Exceptions/Error.h>
 
@@ -165,6 +166,7 @@ LELRegionAsBool::~LELRegionAsBool()
 void LELRegionAsBool::eval(LELArray<Bool>& result, 
 			   const Slicer& section) const
 {
+   ScopedMutexLock locker(LELLatticeLock::mutex());
    Array<Bool> tmp = region_p.getSlice (section);
    result.value().reference(tmp);
 }
@@ -0,0 +1,160 @@
+//# LELShared.h:  Share a common subexpression in a LEL tree
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef LATTICES_LELSHARED_H
+#define LATTICES_LELSHARED_H
+
+
+//# Includes
+#include <lattices/Lattices/LELInterface.h>
+#include <lattices/Lattices/LELEvalContext.h>
+#include <lattices/Lattices/LELArray.h>
+#include <casa/Arrays/Slicer.h>
+#include <casa/Utilities/CountedPtr.h>
+
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+
+// <summary>
+// Cached result of a shared subexpression
+// </summary>
+// <use visibility=local>
+template <class T> class LELSharedEntry : public LELEvalContext::Entry
+{
+public:
+  LELSharedEntry (const void* node, const Slicer& section,
+                  const LELArray<T>& value)
+    : LELEvalContext::Entry (node, section),
+      itsValue (value)
+    {}
+  const LELArray<T>& value() const
+    { return itsValue; }
+private:
+  LELArray<T> itsValue;
+};
+
+
+
+// <summary>
+// Share a common subexpression in a LEL tree
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="yyyy/mm/dd" tests="" demos="">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class="Lattice"> Lattice</linkto>
+//   <li> <linkto class="LatticeExpr"> LatticeExpr</linkto>
+//   <li> <linkto class="LatticeExprNode"> LatticeExprNode</linkto>
+//   <li> <linkto class="LELInterface"> LELInterface</linkto>
+// </prerequisite>
+
+// <etymology>
+//  This derived LEL letter class wraps a subexpression shared by
+//  several parents in the expression tree.
+// </etymology>
+
+// <synopsis>
+// When an expression is prepared, LatticeExprNode gives each
+// non-scalar subexpression a signature made of its operation and the
+// identities of its operands (see LELInterface::signature).
+// Subexpressions with equal signatures compute the same values, so they
+// are replaced by a single LELShared object wrapping one of them.
+// This is done bottom-up, so equal subexpressions are found at all levels
+// of the tree. E.g. in
+// <srcblock>
+//   LatticeExpr<Float> expr (sin(a+b) * sin(a+b) + (a+b));
+// </srcblock>
+// <src>a+b</src> and <src>sin(a+b)</src> are evaluated only once per
+// chunk.
+// <p>
+// When evaluated, an LELShared object with several users stores the result
+// for the given section in the current
+// <linkto class=LELEvalContext>LELEvalContext</linkto>, from where
+// the other users take it. The result is removed when all users have
+// taken it. If the object has only one user, or if there is no current
+// context, it simply forwards the evaluation to the shared subexpression.
+// </synopsis>
+
+// <motivation>
+// Expressions as created by users (e.g. in image analysis scripts)
+// often contain the same subexpression multiple times.
+// </motivation>
+
+template <class T> class LELShared : public LELInterface<T>
+{
+public:
+  // Wrap the given subexpression.
+  explicit LELShared (const CountedPtr<LELInterface<T> >& expr);
+
+  ~LELShared();
+
+  // Set the number of users of this subexpression.
+  void setUsers (uInt nusers)
+    { itsNUsers = nusers; }
+
+  // Get the result from the current context or evaluate it.
+  // <group>
+  virtual void eval (LELArray<T>& result,
+                     const Slicer& section) const;
+  virtual void evalRef (LELArrayRef<T>& result,
+                        const Slicer& section) const;
+  // </group>
+
+  // Forward to the shared subexpression.
+  // <group>
+  virtual LELScalar<T> getScalar() const;
+  virtual Bool prepareScalarExpr();
+  // </group>
+
+  // Get class name
+  virtual String className() const;
+
+  // Handle locking/syncing of a lattice in a lattice expression.
+  // <group>
+  virtual Bool lock (FileLocker::LockType, uInt nattempts);
+  virtual void unlock();
+  virtual Bool hasLock (FileLocker::LockType) const;
+  virtual void resync();
+  // </group>
+
+private:
+  CountedPtr<LELInterface<T> > pExpr_p;
+  uInt                         itsNUsers;
+};
+
+
+
+} //# NAMESPACE CASA - END
+
+#ifndef CASACORE_NO_AUTO_TEMPLATES
+#include <lattices/Lattices/LELShared.tcc>
+#endif //# CASACORE_NO_AUTO_TEMPLATES
+#endif
@@ -0,0 +1,198 @@
+//# LELShared.tcc:  Share a common subexpression in a LEL tree
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+#include <lattices/Lattices/LELShared.h>
+#include <lattices/Lattices/LELArray.h>
+#include <lattices/Lattices/LELScalar.h>
+#include <casa/Arrays/Slicer.h>
+#include <casa/Arrays/Array.h>
+
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+template<class T>
+void LELInterface<T>::replaceSubExpr (CountedPtr<LELInterface<T> >& expr,
+				      LELSubExprMap& map)
+{
+// Scalars have been replaced by their values already.
+    if (expr->isScalar()) {
+        return;
+    }
+// Do the children first, so their signatures can be used in the
+// signature of this node.
+    expr->prepareSubExpr (map);
+    String signature = expr->signature();
+    if (! signature.empty()) {
+        expr = map.share (expr, signature);
+    }
+}
+
+
+template <class T>
+LELShared<T>::LELShared (const CountedPtr<LELInterface<T> >& expr)
+: pExpr_p   (expr),
+  itsNUsers (1)
+{
+   this->setAttr (expr->getAttribute());
+
+#if defined(AIPS_TRACE)
+   cout << "LELShared:: constructor" << endl;
+#endif
+}
+
+template <class T>
+LELShared<T>::~LELShared()
+{
+#if defined(AIPS_TRACE)
+   cout << "LELShared:: destructor" << endl;
+#endif
+}
+
+
+template <class T>
+void LELShared<T>::eval (LELArray<T>& result,
+                         const Slicer& section) const
+{
+#if defined(AIPS_TRACE)
+   cout << "LELShared::eval" << endl;
+#endif
+
+   LELEvalContext* context = 0;
+   if (itsNUsers > 1) {
+      context = LELEvalContext::current();
+   }
+   if (context == 0) {
+      pExpr_p->eval (result, section);
+      return;
+   }
+   LELSharedEntry<T>* entry =
+                   static_cast<LELSharedEntry<T>*>(context->find (this, section));
+   if (entry == 0) {
+// First user; evaluate and keep a copy for the other users,
+// because the caller can change the result in place.
+      pExpr_p->eval (result, section);
+      LELArray<T> value (result.value().copy());
+      if (result.isMasked()) {
+         value.setMask (result.mask().copy());
+      }
+      entry = new LELSharedEntry<T> (this, section, value);
+      context->add (entry);
+      entry->serve();
+   } else {
+      result.value() = entry->value().value();
+      if (entry->value().isMasked()) {
+         result.setMask (entry->value().mask().copy());
+      } else {
+         result.removeMask();
+      }
+      if (entry->serve() >= itsNUsers) {
+         context->remove (entry);
+      }
+   }
+}
+
+template <class T>
+void LELShared<T>::evalRef (LELArrayRef<T>& result,
+                            const Slicer& section) const
+{
+#if defined(AIPS_TRACE)
+   cout << "LELShared::evalRef" << endl;
+#endif
+
+   LELEvalContext* context = 0;
+   if (itsNUsers > 1) {
+      context = LELEvalContext::current();
+   }
+   if (context == 0) {
+      pExpr_p->evalRef (result, section);
+      return;
+   }
+   LELSharedEntry<T>* entry =
+                   static_cast<LELSharedEntry<T>*>(context->find (this, section));
+   if (entry == 0) {
+// A reference result is not changed by the caller, so the entry
+// can share the data with it.
+      LELArray<T> value (result.shape());
+      pExpr_p->eval (value, section);
+      entry = new LELSharedEntry<T> (this, section, value);
+      context->add (entry);
+   }
+   // Cast to its base class LELArray to use the non-const value function.
+   ((LELArray<T>&)result).value().reference
+                             (const_cast<Array<T>&>(entry->value().value()));
+   if (entry->value().isMasked()) {
+      result.setMask (entry->value().mask());
+   } else {
+      result.removeMask();
+   }
+   if (entry->serve() >= itsNUsers) {
+      context->remove (entry);
+   }
+}
+
+template <class T>
+LELScalar<T> LELShared<T>::getScalar() const
+{
+   return pExpr_p->getScalar();
+}
+
+template <class T>
+Bool LELShared<T>::prepareScalarExpr()
+{
+   return LELInterface<T>::replaceScalarExpr (pExpr_p);
+}
+
+template <class T>
+String LELShared<T>::className() const
+{
+   return "LELShared";
+}
+
+
+template <class T>
+Bool LELShared<T>::lock (FileLocker::LockType type, uInt nattempts)
+{
+  return pExpr_p->lock (type, nattempts);
+}
+template <class T>
+void LELShared<T>::unlock()
+{
+    pExpr_p->unlock();
+}
+template <class T>
+Bool LELShared<T>::hasLock (FileLocker::LockType type) const
+{
+    return pExpr_p->hasLock (type);
+}
+template <class T>
+void LELShared<T>::resync()
+{
+    pExpr_p->resync();
+}
+
+} //# NAMESPACE CASA - END
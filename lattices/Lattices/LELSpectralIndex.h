@@ -93,6 +93,9 @@ public:
   // Returns False.
    virtual Bool prepareScalarExpr();
 
+// Replace common subexpressions in the operands.
+   virtual void prepareSubExpr (LELSubExprMap& map);
+
   // Get class name
   virtual String className() const;
 
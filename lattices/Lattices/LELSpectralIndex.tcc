@@ -238,5 +238,12 @@ Bool LELSpectralIndex<T>::prepareScalarExpr()
   return False;
 }
 
+template<class T>
+void LELSpectralIndex<T>::prepareSubExpr (LELSubExprMap& map)
+{
+  arg0_p.replaceSubExpr (map);
+  arg1_p.replaceSubExpr (map);
+}
+
 } //# NAMESPACE CASA - END
 
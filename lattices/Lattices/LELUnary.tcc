@@ -26,6 +26,7 @@
 //# $Id$
 
 #include <lattices/Lattices/LELUnary.h>
+#include <lattices/Lattices/LELEvalContext.h>
 #include <lattices/Lattices/LELScalar.h>
 #include <lattices/Lattices/LELArray.h>
 #include <casa/Arrays/Slicer.h>
@@ -164,6 +165,19 @@ Bool LELUnary<T>::prepareScalarExpr()
    return LELInterface<T>::replaceScalarExpr (pExpr_p);
 }
 
+template <class T>
+void LELUnary<T>::prepareSubExpr (LELSubExprMap& map)
+{
+   LELInterface<T>::replaceSubExpr (pExpr_p, map);
+}
+
+template <class T>
+String LELUnary<T>::signature() const
+{
+   return "LELUnary(" + String::toString(Int(op_p)) + ',' +
+          LELSubExprMap::id (*pExpr_p) + ')';
+}
+
 template <class T>
 String LELUnary<T>::className() const
 {
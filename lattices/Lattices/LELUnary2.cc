@@ -26,6 +26,7 @@
 //# $Id$
 
 #include <lattices/Lattices/LELUnary.h>
+#include <lattices/Lattices/LELEvalContext.h>
 #include <lattices/Lattices/LELArray.h>
 #include <casa/Arrays/Slicer.h>
 #include <casa/Arrays/Array.h>
@@ -101,6 +102,17 @@ Bool LELUnaryBool::prepareScalarExpr()
    return LELInterface<Bool>::replaceScalarExpr (pExpr_p);
 }
 
+void LELUnaryBool::prepareSubExpr (LELSubExprMap& map)
+{
+   LELInterface<Bool>::replaceSubExpr (pExpr_p, map);
+}
+
+String LELUnaryBool::signature() const
+{
+   return "LELUnaryBool(" + String::toString(Int(op_p)) + ',' +
+          LELSubExprMap::id (*pExpr_p) + ')';
+}
+
 String LELUnaryBool::className() const
 {
    return String("LELUnaryBool");
@@ -38,6 +38,7 @@
 #include <lattices/Lattices/LatticeIterator.h>
 #include <lattices/Lattices/LatticeExprNode.h>
 #include <lattices/Lattices/LatticeExpr.h>
+#include <lattices/Lattices/LatticeFractile.h>
 #include <lattices/Lattices/MaskedLattice.h>
 #include <casa/BasicSL/Complex.h>
 #include <casa/BasicMath/Math.h>
@@ -176,6 +177,112 @@ void LattStatsSpecialize::accumulate (
 	}
 }
 
+// Merge the running mean and variance of two accumulators.
+// Merging into an empty accumulator copies the values, so the result is
+// exactly the same as if the data had been accumulated directly.
+static void mergeMoments (Double& nPts, Double& mean, Double& nvariance,
+			  Double nPts2, Double mean2, Double nvariance2)
+{
+	Double n = nPts + nPts2;
+	if (nPts == 0) {
+		nPts = nPts2;
+		mean = mean2;
+		nvariance = nvariance2;
+	} else if (nPts2 > 0) {
+		Double delta = mean2 - mean;
+		mean += delta * nPts2 / n;
+		nvariance += nvariance2 + delta*delta * nPts * nPts2 / n;
+		nPts = n;
+	}
+}
+
+void LattStatsSpecialize::merge (
+	Double& nPts, Double& sum,
+	Double& mean, Double& nvariance, Double& variance,
+	Double& sumSq, Float& dataMin, Float& dataMax,
+	Bool& minMaxInit, Bool& minTaken, Bool& maxTaken,
+	Double nPts2, Double sum2,
+	Double mean2, Double nvariance2,
+	Double sumSq2, Float dataMin2, Float dataMax2,
+	Bool minMaxInit2
+) {
+	minTaken = False;
+	maxTaken = False;
+	sum += sum2;
+	sumSq += sumSq2;
+	mergeMoments (nPts, mean, nvariance, nPts2, mean2, nvariance2);
+	variance = (nPts <= 1) ? 0 : nvariance/(nPts-1);
+	if (minMaxInit2) {
+		return;
+	}
+	if (minMaxInit  ||  dataMin2 < dataMin) {
+		dataMin = dataMin2;
+		minTaken = True;
+	}
+	if (minMaxInit  ||  dataMax2 > dataMax) {
+		dataMax = dataMax2;
+		maxTaken = True;
+	}
+	minMaxInit = False;
+}
+
+void LattStatsSpecialize::merge (
+	DComplex& nPts, DComplex& sum,
+	DComplex& mean, DComplex& nvariance, DComplex& variance,
+	DComplex& sumSq, Complex& dataMin, Complex& dataMax,
+	Bool& minMaxInit, Bool& minTaken, Bool& maxTaken,
+	DComplex nPts2, DComplex sum2,
+	DComplex mean2, DComplex nvariance2,
+	DComplex sumSq2, Complex dataMin2, Complex dataMax2,
+	Bool minMaxInit2
+) {
+	// The real and imaginary parts are accumulated independently.
+	minTaken = False;
+	maxTaken = False;
+	sum += sum2;
+	sumSq += sumSq2;
+	Double rn = real(nPts);
+	Double in = imag(nPts);
+	Double rm = real(mean);
+	Double im = imag(mean);
+	Double rv = real(nvariance);
+	Double iv = imag(nvariance);
+	mergeMoments (rn, rm, rv, real(nPts2), real(mean2), real(nvariance2));
+	mergeMoments (in, im, iv, imag(nPts2), imag(mean2), imag(nvariance2));
+	nPts = DComplex(rn, in);
+	mean = DComplex(rm, im);
+	nvariance = DComplex(rv, iv);
+	variance = DComplex((rn <= 1) ? 0 : rv/(rn-1),
+			    (in <= 1) ? 0 : iv/(in-1));
+	if (minMaxInit2) {
+		return;
+	}
+	if (minMaxInit) {
+		dataMin = dataMin2;
+		dataMax = dataMax2;
+		minMaxInit = False;
+		minTaken = True;
+		maxTaken = True;
+		return;
+	}
+	if (real(nPts2) > 0) {
+		if (real(dataMin2) < real(dataMin)) {
+			dataMin = Complex(real(dataMin2), dataMin.imag());
+		}
+		if (real(dataMax2) > real(dataMax)) {
+			dataMax = Complex(real(dataMax2), dataMax.imag());
+		}
+	}
+	if (imag(nPts2) > 0) {
+		if (imag(dataMin2) < imag(dataMin)) {
+			dataMin = Complex(dataMin.real(), imag(dataMin2));
+		}
+		if (imag(dataMax2) > imag(dataMax)) {
+			dataMax = Complex(dataMax.real(), imag(dataMax2));
+		}
+	}
+}
+
 Double LattStatsSpecialize::getMean (Double sum, Double n)
 {
    Double tmp = 0.0;
@@ -287,6 +394,42 @@ Complex LattStatsSpecialize::getNodeScalarValue(const LatticeExprNode& node, Com
    return node.getComplex();
 }
 
+void LattStatsSpecialize::getRobustStats (Float& median, Float& medAbsDevMed,
+                                          Float& iqr,
+                                          const MaskedLattice<Float>& lattice)
+{
+   // Get the quartiles and median in one go.
+   Vector<Float> fractions(3);
+   fractions(0) = 0.25;
+   fractions(1) = 0.5;
+   fractions(2) = 0.75;
+   Vector<Float> res = LatticeFractile<Float>::maskedFractiles (lattice,
+                                                                fractions);
+   if (res.nelements() == 0) {
+      median = medAbsDevMed = iqr = 0;
+      return;
+   }
+   median = res(1);
+   iqr = res(2) - res(0);
+   Vector<Float> res2 = LatticeFractile<Float>::maskedFractile
+      (LatticeExpr<Float>(abs(LatticeExprNode(lattice) - median)), 0.5);
+   medAbsDevMed = res2(0);
+}
+
+void LattStatsSpecialize::getRobustStats (Complex& median,
+                                          Complex& medAbsDevMed,
+                                          Complex& iqr,
+                                          const MaskedLattice<Complex>& lattice)
+{
+   LatticeExprNode latNode(lattice);
+   LatticeExprNode node(casa::median(latNode));
+   median = node.getComplex();
+   LatticeExprNode node2(casa::median(abs(latNode - median)));
+   medAbsDevMed = node2.getComplex();
+   LatticeExprNode nodeIQR(fractileRange(latNode, .25, .75));
+   iqr = nodeIQR.getComplex();
+}
+
 
 Float LattStatsSpecialize::usePixelInc (Float dMin, Float dMax, Float datum)
 {
@@ -91,6 +91,31 @@ public:
                            const Bool fixedMinMax, const Complex datum,
                            const uInt& pos, const Complex useIt);
 
+   // Merge the values accumulated by another accumulator (the arguments
+   // with suffix 2) into this one. The mean and variance are combined
+   // with the pairwise update formula of Chan et al., so the result is the
+   // same as if all data had been accumulated by a single accumulator.
+   // <src>minTaken</src> and <src>maxTaken</src> are set to True if
+   // the minimum or maximum is taken from the other accumulator.
+   // <group>
+   static void merge (Double& nPts, Double& sum,
+                      Double& mean, Double& nvariance, Double& variance,
+                      Double& sumSq, Float& dataMin, Float& dataMax,
+                      Bool& minMaxInit, Bool& minTaken, Bool& maxTaken,
+                      Double nPts2, Double sum2,
+                      Double mean2, Double nvariance2,
+                      Double sumSq2, Float dataMin2, Float dataMax2,
+                      Bool minMaxInit2);
+   static void merge (DComplex& nPts, DComplex& sum,
+                      DComplex& mean, DComplex& nvariance, DComplex& variance,
+                      DComplex& sumSq, Complex& dataMin, Complex& dataMax,
+                      Bool& minMaxInit, Bool& minTaken, Bool& maxTaken,
+                      DComplex nPts2, DComplex sum2,
+                      DComplex mean2, DComplex nvariance2,
+                      DComplex sumSq2, Complex dataMin2, Complex dataMax2,
+                      Bool minMaxInit2);
+   // </group>
+
    static Bool hasSomePoints (Double npts);
    static Bool hasSomePoints (DComplex npts);
 //
@@ -126,6 +151,18 @@ public:
 //
    static Float getNodeScalarValue(const LatticeExprNode& node, Float);
    static Complex getNodeScalarValue(const LatticeExprNode& node, Complex);
+//
+   // Get the median, the median of the absolute deviations from the median
+   // and the inter-quartile range of the masked-on values in the lattice.
+   // For Float the median and quartiles are found in the same passes
+   // over the data.
+   // <group>
+   static void getRobustStats (Float& median, Float& medAbsDevMed, Float& iqr,
+                               const MaskedLattice<Float>& lattice);
+   static void getRobustStats (Complex& median, Complex& medAbsDevMed,
+                               Complex& iqr,
+                               const MaskedLattice<Complex>& lattice);
+   // </group>
 //
    static Bool setIncludeExclude (String& errorMessage,
                                   Vector<Float>& range,
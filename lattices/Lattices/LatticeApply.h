@@ -41,6 +41,10 @@ template <class T, class U> class TiledCollapser;
 template <class T, class U> class LineCollapser;
 template <class T> class Lattice;
 template <class T> class MaskedLattice;
+template <class T> class RO_LatticeIterator;
+template <class T> class Array;
+template <class T> class Vector;
+template <class T> class CountedPtr;
 class LatticeProgress;
 class IPosition;
 class LatticeRegion;
@@ -111,6 +115,22 @@ class LatticeRegion;
 // For example, if you are computing sums of squares for statistical
 // purposes, you might use higher precision (Float->Double) for this.
 // No check is made that the template types are self-consistent.
+// <p>
+// When compiled with OpenMP and the collapser can be cloned (see
+// <src>LineCollapser::clone</src> and <src>TiledCollapser::clone</src>),
+// the collapse is done in parallel. The lines of a chunk or the tiles
+// of an output chunk are read by the calling thread and processed
+// by the threads, each using its own clone of the collapser.
+// For <src>tiledApply</src> the accumulators of the clones are merged
+// using <src>TiledCollapser::mergeAccumulator</src>.
+// If a chunk has at least as many output positions (e.g. planes or
+// spectra) as there are threads, the output positions are distributed
+// over the threads. Each thread processes all tiles for its own output
+// positions, so each accumulator is filled by a single thread in the same
+// order as in a sequential run. Provided that merging into an empty
+// accumulator is exact, the result is then the same as the sequential one.
+// Otherwise the tiles are distributed statically over the threads, so for
+// a given number of threads the result does not depend on timing.
 // </synopsis>
 
 // <example>
@@ -247,6 +267,46 @@ private:
 			      const IPosition& shapeOut,
 			      const IPosition& collapseAxes,
 			      Int newOutAxis);
+
+    // Make a clone of the collapser for each thread to be used.
+    // Element 0 is the collapser itself. It returns the number of threads,
+    // which is 1 if OpenMP is not used or if the collapser cannot be cloned.
+    // <group>
+    static uInt makeClones (Block<CountedPtr<LineCollapser<T,U> > >& clones,
+			    LineCollapser<T,U>& collapser);
+    static uInt makeClones (Block<CountedPtr<TiledCollapser<T,U> > >& clones,
+			    TiledCollapser<T,U>& collapser);
+    // </group>
+
+    // Read the next <src>n</src> lines (with their masks and positions)
+    // from the iterator, so they can be processed in parallel.
+    static void readLines (Block<Vector<T> >& lines,
+			   Block<Vector<Bool> >& masks,
+			   Block<IPosition>& positions, uInt n,
+			   RO_LatticeIterator<T>& inIter,
+			   const MaskedLattice<T>& latticeIn, Bool useMask,
+			   LatticeProgress* tellProgress);
+
+    // Let the collapser process the data of a single cursor (tile).
+    // Only the output positions (accumulator indices) from
+    // <src>outStart</src> till <src>outEnd</src> are processed.
+    static void processTile (TiledCollapser<T,U>& collapser,
+			     const Array<T>& cursor, const Array<Bool>& mask,
+			     Bool useMask, const IPosition& pos,
+			     const IPosition& collapseAxes, uInt collStart,
+			     const IPosition& iterAxes, const IPosition& ioMap,
+			     uInt resultAxis, uInt outStart, uInt outEnd);
+
+    // Process the first <src>ntile</src> buffered tiles in parallel,
+    // each thread using its own clone of the collapser.
+    static void processTiles (Block<CountedPtr<TiledCollapser<T,U> > >& clones,
+			      uInt nthr, uInt ntile,
+			      const Block<Array<T> >& tiles,
+			      const Block<Array<Bool> >& masks,
+			      const Block<IPosition>& positions, Bool useMask,
+			      const IPosition& collapseAxes, uInt collStart,
+			      const IPosition& iterAxes, const IPosition& ioMap,
+			      uInt resultAxis);
 };
 
 
@@ -42,8 +42,12 @@
 #include <casa/Arrays/Vector.h>
 #include <casa/BasicMath/Math.h>
 #include <casa/Utilities/Assert.h>
+#include <casa/Utilities/CountedPtr.h>
 #include <casa/Exceptions/Error.h>
 #include <casa/iostream.h>
+#ifdef _OPENMP
+# include <omp.h>
+#endif
 
 
 namespace casa { //# NAMESPACE CASA - BEGIN
@@ -150,6 +154,14 @@ void LatticeApply<T,U>::lineApply (MaskedLattice<U>& latticeOut,
     collapser.init (nResult);
     if (tellProgress != 0) tellProgress->init (nLine);
 
+// Clone the collapser if the lines can be processed in parallel.
+
+    Block<CountedPtr<LineCollapser<T,U> > > clones;
+    const uInt nthr = makeClones (clones, collapser);
+    Block<Vector<T> > lines;
+    Block<Vector<Bool> > masks;
+    Block<IPosition> positions;
+
 // Iterate through all the lines.
 // Per tile the lines (in the collapseAxis direction) are
 // assembled into a single array, which is put thereafter.
@@ -185,22 +197,51 @@ void LatticeApply<T,U>::lineApply (MaskedLattice<U>& latticeOut,
 	U* result = array.getStorage (deleteIt);
 	Bool* resultMask = arrayMask.getStorage (deleteMask);
 	uInt n = array.nelements() / nResult;
-	for (uInt i=0; i<n; i++) {
-	    DebugAssert (! inIter.atEnd(), AipsError);
-	    const IPosition pos (inIter.position());
-	    Vector<Bool> mask;
-	    if (useMask) {
-		// Casting const away is innocent.
-		// Remove degenerate axes to get a 1D array.
-		Array<Bool> tmp;
-		((MaskedLattice<T>&)latticeIn).getMaskSlice
-                          (tmp, Slicer(pos, inIter.cursorShape()), True);
-		mask.reference (tmp);
+	if (nthr > 1) {
+	    readLines (lines, masks, positions, n, inIter,
+		       latticeIn, useMask, tellProgress);
+	    String errMsg;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+	    for (Int i=0; i<Int(n); i++) {
+		uInt thr = 0;
+#ifdef _OPENMP
+		thr = omp_get_thread_num();
+#endif
+		try {
+		    clones[thr]->process (result[i], resultMask[i],
+					  lines[i], masks[i], positions[i]);
+		} catch (std::exception& x) {
+#ifdef _OPENMP
+#pragma omp critical(LatticeApply_lineApply)
+#endif
+		    errMsg = x.what();
+		}
+	    }
+	    if (! errMsg.empty()) {
+		throw AipsError (errMsg);
+	    }
+	} else {
+	    for (uInt i=0; i<n; i++) {
+		DebugAssert (! inIter.atEnd(), AipsError);
+		const IPosition pos (inIter.position());
+		Vector<Bool> mask;
+		if (useMask) {
+		    // Casting const away is innocent.
+		    // Remove degenerate axes to get a 1D array.
+		    Array<Bool> tmp;
+		    ((MaskedLattice<T>&)latticeIn).getMaskSlice
+                              (tmp, Slicer(pos, inIter.cursorShape()), True);
+		    mask.reference (tmp);
+		}
+		collapser.process (result[i], resultMask[i],
+				   inIter.vectorCursor(), mask, pos);
+		inIter++;
+		if (tellProgress != 0) {
+		    tellProgress->nstepsDone (inIter.nsteps());
+		}
 	    }
-	    collapser.process (result[i], resultMask[i],
-			       inIter.vectorCursor(), mask, pos);
-	    inIter++;
-	    if (tellProgress != 0) tellProgress->nstepsDone (inIter.nsteps());
 	}
 	array.putStorage (result, deleteIt);
 	arrayMask.putStorage (resultMask, deleteMask);
@@ -276,6 +317,21 @@ void LatticeApply<T,U>::lineMultiApply (PtrBlock<MaskedLattice<U>*>& latticeOut,
     collapser.init (nResult);
     if (tellProgress != 0) tellProgress->init (nLine);
 
+// Clone the collapser if the lines can be processed in parallel.
+// Each thread needs its own result vectors.
+
+    Block<CountedPtr<LineCollapser<T,U> > > clones;
+    const uInt nthr = makeClones (clones, collapser);
+    Block<Vector<T> > lines;
+    Block<Vector<Bool> > masks;
+    Block<IPosition> positions;
+    Block<Vector<U> > results(nthr);
+    Block<Vector<Bool> > resultMasks(nthr);
+    for (i=0; i<nthr; i++) {
+	results[i].resize (nOut);
+	resultMasks[i].resize (nOut);
+    }
+
 // Iterate through all the lines.
 // Per tile the lines (in the collapseAxis) direction are
 // assembled into a single array, which is put thereafter.
@@ -311,33 +367,73 @@ void LatticeApply<T,U>::lineMultiApply (PtrBlock<MaskedLattice<U>*>& latticeOut,
 	Block<Bool> blockMask(n*nOut);
 	U* data = block.storage();
 	Bool* dataMask = blockMask.storage();
-	Vector<U> result(nOut);
-	Vector<Bool> resultMask(nOut);
-	for (i=0; i<n; i++) {
-	    DebugAssert (! inIter.atEnd(), AipsError);
-	    const IPosition pos (inIter.position());
-	    Vector<Bool> mask;
-	    if (useMask) {
-		// Casting const away is innocent.
-		// Remove degenerate axes to get a 1D array.
-		Array<Bool> tmp;
-		((MaskedLattice<T>&)latticeIn).getMaskSlice
-                          (tmp, Slicer(pos, inIter.cursorShape()), True);
-		mask.reference (tmp);
+	if (nthr > 1) {
+	    readLines (lines, masks, positions, n, inIter,
+		       latticeIn, useMask, tellProgress);
+	    String errMsg;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+	    for (Int k=0; k<Int(n); k++) {
+		uInt thr = 0;
+#ifdef _OPENMP
+		thr = omp_get_thread_num();
+#endif
+		try {
+		    Vector<U>& result = results[thr];
+		    Vector<Bool>& resultMask = resultMasks[thr];
+		    clones[thr]->multiProcess (result, resultMask,
+					       lines[k], masks[k], positions[k]);
+		    DebugAssert (result.nelements() == nOut, AipsError);
+		    U* datap = data+k;
+		    Bool* dataMaskp = dataMask+k;
+		    for (uInt j=0; j<nOut; j++) {
+			*datap = result(j);
+			datap += n;
+			*dataMaskp = resultMask(j);
+			dataMaskp += n;
+		    }
+		} catch (std::exception& x) {
+#ifdef _OPENMP
+#pragma omp critical(LatticeApply_lineMultiApply)
+#endif
+		    errMsg = x.what();
+		}
 	    }
-	    collapser.multiProcess (result, resultMask,
-				    inIter.vectorCursor(), mask, pos);
-	    DebugAssert (result.nelements() == nOut, AipsError);
-	    U* datap = data+i;
-	    Bool* dataMaskp = dataMask+i;
-	    for (uInt j=0; j<nOut; j++) {
-		*datap = result(j);
-		datap += n;
-		*dataMaskp = resultMask(j);
-		dataMaskp += n;
+	    if (! errMsg.empty()) {
+		throw AipsError (errMsg);
+	    }
+	} else {
+	    Vector<U>& result = results[0];
+	    Vector<Bool>& resultMask = resultMasks[0];
+	    for (i=0; i<n; i++) {
+		DebugAssert (! inIter.atEnd(), AipsError);
+		const IPosition pos (inIter.position());
+		Vector<Bool> mask;
+		if (useMask) {
+		    // Casting const away is innocent.
+		    // Remove degenerate axes to get a 1D array.
+		    Array<Bool> tmp;
+		    ((MaskedLattice<T>&)latticeIn).getMaskSlice
+                              (tmp, Slicer(pos, inIter.cursorShape()), True);
+		    mask.reference (tmp);
+		}
+		collapser.multiProcess (result, resultMask,
+					inIter.vectorCursor(), mask, pos);
+		DebugAssert (result.nelements() == nOut, AipsError);
+		U* datap = data+i;
+		Bool* dataMaskp = dataMask+i;
+		for (uInt j=0; j<nOut; j++) {
+		    *datap = result(j);
+		    datap += n;
+		    *dataMaskp = resultMask(j);
+		    dataMaskp += n;
+		}
+		inIter++;
+		if (tellProgress != 0) {
+		    tellProgress->nstepsDone (inIter.nsteps());
+		}
 	    }
-	    inIter++;
-	    if (tellProgress != 0) tellProgress->nstepsDone (inIter.nsteps());
 	}
 
 // Write the arrays (one in each output lattice).
@@ -455,24 +551,35 @@ void LatticeApply<T,U>::tiledApply (MaskedLattice<U>& latticeOut,
 	}
     }
 
+// Clone the collapser if the tiles can be processed in parallel.
+// In that case the tiles (and masks) are buffered, so they can be read
+// by this thread and processed in parallel thereafter.
+
+    Block<CountedPtr<TiledCollapser<T,U> > > clones;
+    const uInt nthr = makeClones (clones, collapser);
+    const uInt nbuf = (nthr > 1  ?  4*nthr : 0);
+    Block<Array<T> > tiles(nbuf);
+    Block<Array<Bool> > tileMasks(nbuf);
+    Block<IPosition> tilePositions(nbuf);
+    uInt ntile = 0;
+
 // Iterate through all the tiles.
 // TileStepper is set up in such a way that the collapse axes are iterated
 // fastest. When all collapse axes are handled, thus when the iter axes
 // position changes, we have to write that part.
 
     Bool firstTime = True;
+    uInt nOut = 0;
     IPosition outPos(outDim, 0);
     IPosition iterPos(outDim, 0);
     while (! inIter.atEnd()) {
 
 // Calculate the size of each chunk of output data.
 // Each chunk contains the data of a tile in each IterAxis.
-// Determine the index of the first element to take from the cursor.
 
 	const Array<T>& cursor = inIter.cursor();
 	const IPosition& cursorShape = cursor.shape();
 	IPosition pos = inIter.position();
-	IPosition latPos = pos;
 	Array<Bool> mask;
 	if (useMask) {
 	    // Casting const away is innocent.
@@ -487,6 +594,17 @@ void LatticeApply<T,U>::tiledApply (MaskedLattice<U>& latticeOut,
 	}
 	if (firstTime  ||  outPos != iterPos) {
 	    if (!firstTime) {
+		// Process the remaining buffered tiles and merge the
+		// accumulators of the clones.
+		if (nthr > 1) {
+		    processTiles (clones, nthr, ntile, tiles, tileMasks,
+				  tilePositions, useMask, collapseAxes,
+				  collStart, iterAxes, ioMap, resultAxis);
+		    ntile = 0;
+		    for (uInt k=1; k<nthr; k++) {
+			collapser.mergeAccumulator (*clones[k]);
+		    }
+		}
 		Array<U> result;
 		Array<Bool> resultMask;
 		collapser.endAccumulator (result, resultMask, outShape);
@@ -509,54 +627,124 @@ void LatticeApply<T,U>::tiledApply (MaskedLattice<U>& latticeOut,
 		    }
 		}
 	    }
-	    collapser.initAccumulator (n1, n3);
+	    nOut = n1 * n3;
+	    for (uInt k=0; k<nthr; k++) {
+		clones[k]->initAccumulator (n1, n3);
+	    }
 	}
 
-// Put the collapsed lines into an output buffer
+// Process the tile directly or buffer it.
+// A buffer is reused if the tile shape matches.
+
+	if (nthr > 1) {
+	    if (! tiles[ntile].shape().isEqual (cursorShape)) {
+		tiles[ntile].resize (cursorShape);
+	    }
+	    tiles[ntile] = cursor;
+	    if (useMask) {
+		if (! tileMasks[ntile].shape().isEqual (cursorShape)) {
+		    tileMasks[ntile].resize (cursorShape);
+		}
+		tileMasks[ntile] = mask;
+	    }
+	    tilePositions[ntile] = pos;
+	    if (++ntile == nbuf) {
+		processTiles (clones, nthr, ntile, tiles, tileMasks,
+			      tilePositions, useMask, collapseAxes,
+			      collStart, iterAxes, ioMap, resultAxis);
+		ntile = 0;
+	    }
+	} else {
+	    processTile (collapser, cursor, mask, useMask, pos,
+			 collapseAxes, collStart, iterAxes, ioMap, resultAxis,
+			 0, nOut);
+	}
+	inIter++;
+	if (tellProgress != 0) tellProgress->nstepsDone (inIter.nsteps());
+    }
+
+// Write out the last output array.
+    if (nthr > 1) {
+	processTiles (clones, nthr, ntile, tiles, tileMasks,
+		      tilePositions, useMask, collapseAxes,
+		      collStart, iterAxes, ioMap, resultAxis);
+	for (uInt k=1; k<nthr; k++) {
+	    collapser.mergeAccumulator (*clones[k]);
+	}
+    }
+    Array<U> result;
+    Array<Bool> resultMask;
+    collapser.endAccumulator (result, resultMask, outShape);
+    latticeOut.putSlice (result, outPos);
+    if (maskOut != 0) {
+        maskOut->putSlice (resultMask, outPos);
+    }
+    if (tellProgress != 0) tellProgress->done();
+}
+
+
+template <class T, class U>
+void LatticeApply<T,U>::processTile (TiledCollapser<T,U>& collapser,
+				     const Array<T>& cursor,
+				     const Array<Bool>& mask,
+				     Bool useMask,
+				     const IPosition& pos,
+				     const IPosition& collapseAxes,
+				     uInt collStart,
+				     const IPosition& iterAxes,
+				     const IPosition& ioMap,
+				     uInt resultAxis,
+				     uInt outStart, uInt outEnd)
+{
+    uInt j;
+    const IPosition& cursorShape = cursor.shape();
+    const uInt inDim = cursorShape.nelements();
+    const uInt collDim = collapseAxes.nelements();
+    const uInt iterDim = iterAxes.nelements();
+    IPosition latPos = pos;
+
 // Initialize the cursor position needed in the loop.
 
-	IPosition curPos (inDim, 0);
+    IPosition curPos (inDim, 0);
 
 // Determine the increment for the first collapse axes.
 // This is done by taking the difference between the adresses of two pixels
 // in the cursor (if there are 2 pixels).
 
-	IPosition chunkShape (inDim, 1);
-	for (j=0; j<collStart; j++) {
-	    const uInt axis = collapseAxes(j);
-	    chunkShape(axis) = cursorShape(axis);
-	}
-	uInt nval = chunkShape.product();
-	const uInt axis = collapseAxes(0);
-
-	IPosition p0(inDim, 0);
-	IPosition p1(inDim, 0);
-	p1[axis] = 1;
-	// general for Arrays with contiguous or non-contiguous storage.
-	uInt dataIncr = &(cursor(p1)) - &(cursor(p0));
-	uInt maskIncr = useMask ? &(mask(p1)) - &(mask(p0)) : 0;
+    IPosition chunkShape (inDim, 1);
+    for (j=0; j<collStart; j++) {
+	const uInt axis = collapseAxes(j);
+	chunkShape(axis) = cursorShape(axis);
+    }
+    uInt nval = chunkShape.product();
+    const uInt axis = collapseAxes(0);
 
-//	cout << " cursorShape " << cursorShape << endl;
-//	cout << " chunkShape  " << chunkShape << endl;
-//	cout << " incr        " << incr << endl;
-//	cout << " nval        " << nval << endl;
+    IPosition p0(inDim, 0);
+    IPosition p1(inDim, 0);
+    p1[axis] = 1;
+    // general for Arrays with contiguous or non-contiguous storage.
+    uInt dataIncr = &(cursor(p1)) - &(cursor(p0));
+    uInt maskIncr = useMask ? &(mask(p1)) - &(mask(p0)) : 0;
 
 // Iterate in the outer loop through the iterator axes.
 // Iterate in the inner loop through the collapse axes.
+// Output positions outside [outStart,outEnd) are skipped.
 
-	uInt index1 = 0;
-	uInt index3 = 0;
-	for (;;) {
-	    for (;;) {
-//	        cout << curPos << ' ' << collPos << endl;
+    uInt index1 = 0;
+    uInt index3 = 0;
+    for (uInt outIndex=0; outIndex<outEnd; outIndex++) {
+	if (outIndex >= outStart) {
+	    while (True) {
 		if (useMask) {
 		    collapser.process (index1, index3,
 				       &(cursor(curPos)), &(mask(curPos)),
-				       dataIncr, maskIncr, nval, latPos, chunkShape);
+				       dataIncr, maskIncr, nval, latPos,
+				       chunkShape);
 		} else {
 		    collapser.process (index1, index3,
 				       &(cursor(curPos)), 0,
-				       dataIncr, maskIncr, nval, latPos, chunkShape);
+				       dataIncr, maskIncr, nval, latPos,
+				       chunkShape);
 		}
 		// Increment a collapse axis until all axes are handled.
 		for (j=collStart; j<collDim; j++) {
@@ -564,48 +752,200 @@ void LatticeApply<T,U>::tiledApply (MaskedLattice<U>& latticeOut,
 		    if (++curPos(axis) < cursorShape(axis)) {
 			break;
 		    }
-		    curPos(axis) = 0;               // restart this axis
+		    curPos(axis) = 0;           // restart this axis
 		}
 		if (j == collDim) {
-		    break;                          // all axes are handled
+		    break;                      // all axes are handled
 		}
 	    }
+	}
 	
 // Increment an iteration axis until all iteration axes are handled.
 	
-	    for (j=0; j<iterDim; j++) {
-		uInt arraxis = iterAxes(j);
-		uInt axis = ioMap(arraxis);
-		++latPos(axis);
-		if (++curPos(axis) < cursorShape(axis)) {
-		    if (arraxis < resultAxis) {
-		        index1++;
-		    } else {
-		        index3++;
-			index1 = 0;
-		    }
-		    break;
+	for (j=0; j<iterDim; j++) {
+	    uInt arraxis = iterAxes(j);
+	    uInt axis = ioMap(arraxis);
+	    ++latPos(axis);
+	    if (++curPos(axis) < cursorShape(axis)) {
+		if (arraxis < resultAxis) {
+		    index1++;
+		} else {
+		    index3++;
+		    index1 = 0;
 		}
-		curPos(axis) = 0;
-		latPos(axis) = pos(axis);
-	    }
-	    if (j == iterDim) {
 		break;
 	    }
+	    curPos(axis) = 0;
+	    latPos(axis) = pos(axis);
+	}
+	if (j == iterDim) {
+	    break;
 	}
-	inIter++;
-	if (tellProgress != 0) tellProgress->nstepsDone (inIter.nsteps());
     }
+}
 
-// Write out the last output array.
-    Array<U> result;
-    Array<Bool> resultMask;
-    collapser.endAccumulator (result, resultMask, outShape);
-    latticeOut.putSlice (result, outPos);
-    if (maskOut != 0) {
-        maskOut->putSlice (resultMask, outPos);
+
+template <class T, class U>
+void LatticeApply<T,U>::processTiles
+                         (Block<CountedPtr<TiledCollapser<T,U> > >& clones,
+			  uInt nthr, uInt ntile,
+			  const Block<Array<T> >& tiles,
+			  const Block<Array<Bool> >& masks,
+			  const Block<IPosition>& positions,
+			  Bool useMask,
+			  const IPosition& collapseAxes,
+			  uInt collStart,
+			  const IPosition& iterAxes,
+			  const IPosition& ioMap,
+			  uInt resultAxis)
+{
+    if (ntile == 0) {
+	return;
+    }
+    // All tiles of a chunk have the same number of output positions.
+    uInt nOut = 1;
+    for (uInt j=0; j<iterAxes.nelements(); j++) {
+	nOut *= tiles[0].shape()(ioMap(iterAxes(j)));
+    }
+    String errMsg;
+    if (nOut >= nthr) {
+	// Each thread processes all tiles, but only for its own part of
+	// the output positions. So an accumulator is filled by one thread
+	// in the same order as sequentially.
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nthr)
+#endif
+	{
+	    uInt thr = 0;
+	    uInt nt = 1;
+#ifdef _OPENMP
+	    thr = omp_get_thread_num();
+	    nt = omp_get_num_threads();
+#endif
+	    const uInt outStart = uInt(uInt64(thr) * nOut / nt);
+	    const uInt outEnd = uInt(uInt64(thr+1) * nOut / nt);
+	    try {
+		for (uInt i=0; i<ntile; i++) {
+		    processTile (*clones[thr], tiles[i], masks[i], useMask,
+				 positions[i], collapseAxes, collStart,
+				 iterAxes, ioMap, resultAxis, outStart, outEnd);
+		}
+	    } catch (std::exception& x) {
+#ifdef _OPENMP
+#pragma omp critical(LatticeApply_processTiles)
+#endif
+		errMsg = x.what();
+	    }
+	}
+    } else {
+	// Each thread processes a contiguous part of the tiles (which is
+	// the static schedule), so the result does not depend on timing.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) num_threads(nthr)
+#endif
+	for (Int i=0; i<Int(ntile); i++) {
+	    uInt thr = 0;
+#ifdef _OPENMP
+	    thr = omp_get_thread_num();
+#endif
+	    try {
+		processTile (*clones[thr], tiles[i], masks[i], useMask,
+			     positions[i], collapseAxes, collStart,
+			     iterAxes, ioMap, resultAxis, 0, nOut);
+	    } catch (std::exception& x) {
+#ifdef _OPENMP
+#pragma omp critical(LatticeApply_processTiles)
+#endif
+		errMsg = x.what();
+	    }
+	}
+    }
+    if (! errMsg.empty()) {
+	throw AipsError (errMsg);
+    }
+}
+
+
+template <class T, class U>
+uInt LatticeApply<T,U>::makeClones
+                         (Block<CountedPtr<LineCollapser<T,U> > >& clones,
+			  LineCollapser<T,U>& collapser)
+{
+    uInt nthr = 1;
+#ifdef _OPENMP
+    nthr = omp_get_max_threads();
+#endif
+    clones.resize (nthr);
+    // The collapser itself must not be deleted.
+    clones[0] = CountedPtr<LineCollapser<T,U> > (&collapser, False);
+    for (uInt i=1; i<nthr; i++) {
+	LineCollapser<T,U>* clone = collapser.clone();
+	if (clone == 0) {
+	    clones.resize (1, True, True);
+	    return 1;
+	}
+	clones[i] = clone;
+    }
+    return nthr;
+}
+
+template <class T, class U>
+uInt LatticeApply<T,U>::makeClones
+                         (Block<CountedPtr<TiledCollapser<T,U> > >& clones,
+			  TiledCollapser<T,U>& collapser)
+{
+    uInt nthr = 1;
+#ifdef _OPENMP
+    nthr = omp_get_max_threads();
+#endif
+    clones.resize (nthr);
+    // The collapser itself must not be deleted.
+    clones[0] = CountedPtr<TiledCollapser<T,U> > (&collapser, False);
+    for (uInt i=1; i<nthr; i++) {
+	TiledCollapser<T,U>* clone = collapser.clone();
+	if (clone == 0) {
+	    clones.resize (1, True, True);
+	    return 1;
+	}
+	clones[i] = clone;
+    }
+    return nthr;
+}
+
+template <class T, class U>
+void LatticeApply<T,U>::readLines (Block<Vector<T> >& lines,
+				   Block<Vector<Bool> >& masks,
+				   Block<IPosition>& positions, uInt n,
+				   RO_LatticeIterator<T>& inIter,
+				   const MaskedLattice<T>& latticeIn,
+				   Bool useMask,
+				   LatticeProgress* tellProgress)
+{
+    if (lines.nelements() < n) {
+	lines.resize (n, True, False);
+	masks.resize (n, True, False);
+	positions.resize (n, True, False);
+    }
+    for (uInt i=0; i<n; i++) {
+	DebugAssert (! inIter.atEnd(), AipsError);
+	positions[i] = inIter.position();
+	// Copy the line, because the cursor is reused by the iterator.
+	const Vector<T>& line = inIter.vectorCursor();
+	if (lines[i].nelements() != line.nelements()) {
+	    lines[i].resize (line.nelements());
+	}
+	lines[i] = line;
+	if (useMask) {
+	    // Casting const away is innocent.
+	    // Remove degenerate axes to get a 1D array.
+	    Array<Bool> tmp;
+	    ((MaskedLattice<T>&)latticeIn).getMaskSlice
+                        (tmp, Slicer(positions[i], inIter.cursorShape()), True);
+	    masks[i].reference (tmp);
+	}
+	inIter++;
+	if (tellProgress != 0) tellProgress->nstepsDone (inIter.nsteps());
     }
-    if (tellProgress != 0) tellProgress->done();
 }
 
 
@@ -208,6 +208,19 @@ public:
   // of stopPointMode
   Bool queryStopPointMode() const {return itsDidStopPointMode; }
 
+  // Clean using in-memory arrays instead of the scratch lattices.
+  // The residual images, psf convolutions, scales, masks and the model
+  // are then held as contiguous arrays during <src>clean</src> (lattices
+  // already held in memory are used by reference). The peak search and
+  // residual update of each iteration are done directly on the arrays,
+  // in parallel if possible. The results are the same, apart from the
+  // choice between peaks with exactly the same value.
+  // By default the lattices are used.
+  // <group>
+  void setInMemory(Bool inMemory=True) { itsInMemory = inMemory; }
+  Bool inMemory() const { return itsInMemory; }
+  // </group>
+
   // speedup() will speed the clean iteration by raising the
   // threshold.  This may be required if the threshold is
   // accidentally set too low (ie, lower than can be achieved
@@ -255,6 +268,29 @@ protected:
   static void makeBoxesSameSize(IPosition& blc1, IPosition& trc1,                               
      IPosition &blc2, IPosition& trc2);
 
+  // Get the full contiguous array of a lattice when cleaning in memory.
+  // It returns True if the array references the lattice data.
+  static Bool getCleanArray(Lattice<T>& lattice, Array<T>& array);
+
+  // Find the peak in the box [blc,trc] of an array, possibly weighted
+  // with a mask of the same shape. If <src>weightedValue</src> is False,
+  // the unweighted value of the peak is returned.
+  // The peak found is the same as findMaxAbsLattice or
+  // findMaxAbsMaskLattice find when stepping through the box with
+  // the given tile shape.
+  // The position returned is relative to blc.
+  static void findMaxAbsArray(const Array<T>& array, const Array<T>* mask,
+			      Bool weightedValue,
+			      const IPosition& blc, const IPosition& trc,
+			      const IPosition& tileShape,
+			      T& maxAbs, IPosition& posMax);
+
+  // Add factor times the box at blcFrom in the array from to the box at
+  // blcTo in the array to. Both arrays must have the same shape.
+  static void addBoxTo(Array<T>& to, const IPosition& blcTo,
+		       const Array<T>& from, const IPosition& blcFrom,
+		       const IPosition& boxShape, T factor);
+
 
   CleanEnums::CleanType itsCleanType;
   Float itsGain;
@@ -323,6 +359,7 @@ private:
   Int itsStopPointMode;
   Bool itsDidStopPointMode;
   Bool itsJustStarting;
+  Bool itsInMemory;
 
   // threshold for masks. If negative, mask values are used as weights and no pixels are
   // discarded (although effectively they would be discarded if the mask value is 0.)
@@ -100,6 +100,7 @@ LatticeCleaner<T>::LatticeCleaner():
   itsStopPointMode(-1),
   itsDidStopPointMode(False),
   itsJustStarting(True),
+  itsInMemory(False),
   itsMaskThreshold(T(0.9))
 {
   itsMemoryMB=Double(HostInfo::memoryTotal()/1024)/16.0;
@@ -128,7 +129,8 @@ LatticeCleaner<T>::LatticeCleaner(const Lattice<T> & psf,
   itsStopAtLargeScaleNegative(False),
   itsStopPointMode(-1),
   itsDidStopPointMode(False),
-  itsJustStarting(True)
+  itsJustStarting(True),
+  itsInMemory(False)
 {
   AlwaysAssert(validatePsf(psf), AipsError);
   // Check that everything is the same dimension and that none of the
@@ -181,6 +183,7 @@ template <class T> LatticeCleaner<T>::
    itsStopPointMode(other.itsStopPointMode),
    itsDidStopPointMode(other.itsDidStopPointMode),
    itsJustStarting(other.itsJustStarting),
+   itsInMemory(other.itsInMemory),
    itsMaskThreshold(other.itsMaskThreshold)
 {
 }
@@ -205,6 +208,7 @@ operator=(const LatticeCleaner<T> & other) {
     itsStopPointMode = other.itsStopPointMode;
     itsDidStopPointMode = other.itsDidStopPointMode;
     itsJustStarting = other.itsJustStarting;
+    itsInMemory = other.itsInMemory;
     itsStrengthOptimum = other.itsStrengthOptimum;
     itsMaskThreshold = other.itsMaskThreshold;
   }
@@ -452,6 +456,9 @@ Int LatticeCleaner<T>::clean(Lattice<T>& model,
     }
   }
   LCBox centerBox(blcDirty, trcDirty, model.shape());
+  // The box is limited to the lattice; the arrays need the same limits.
+  blcDirty = centerBox.boundingBox().start();
+  trcDirty = centerBox.boundingBox().end();
 
   PtrBlock<Lattice<T>* > scaleMaskSubs;
   if (itsMask)  {
@@ -461,6 +468,43 @@ Int LatticeCleaner<T>::clean(Lattice<T>& model,
     }
   }
 
+  // When cleaning in memory, get the arrays of all lattices needed.
+  // The psf convolutions are only needed for the scales to clean.
+  Block<Array<T> > dirtyArrs, psfArrs, scaleArrs, maskArrs;
+  Block<IPosition> tileShapes;
+  Block<Bool> dirtyIsRef;
+  Array<T> modelArr;
+  Bool modelIsRef = False;
+  if (itsInMemory) {
+    dirtyArrs.resize(nScalesToClean);
+    dirtyIsRef.resize(nScalesToClean);
+    scaleArrs.resize(nScalesToClean);
+    tileShapes.resize(nScalesToClean);
+    psfArrs.resize(itsPsfConvScales.nelements());
+    for (scale=0; scale<nScalesToClean; scale++) {
+      dirtyIsRef[scale] = getCleanArray(*itsDirtyConvScales[scale],
+					dirtyArrs[scale]);
+      // The peak search steps through the box as the lattice path does.
+      tileShapes[scale] = SubLattice<T>(*itsDirtyConvScales[scale],
+					centerBox).niceCursorShape();
+      getCleanArray(*itsScales[scale], scaleArrs[scale]);
+      for (Int otherscale=0; otherscale<nScalesToClean; otherscale++) {
+	Int ind = index(scale, otherscale);
+	AlwaysAssert(itsPsfConvScales[ind], AipsError);
+	if (psfArrs[ind].empty()) {
+	  getCleanArray(*itsPsfConvScales[ind], psfArrs[ind]);
+	}
+      }
+    }
+    if (itsMask) {
+      maskArrs.resize(nScalesToClean);
+      for (scale=0; scale<nScalesToClean; scale++) {
+	getCleanArray(*itsScaleMasks[scale], maskArrs[scale]);
+      }
+    }
+    modelIsRef = getCleanArray(model, modelArr);
+  }
+
   // Start the iteration
   Vector<T> maxima(nScalesToClean);
   Block<IPosition> posMaximum(nScalesToClean);
@@ -481,16 +525,22 @@ Int LatticeCleaner<T>::clean(Lattice<T>& model,
     optimumScale = 0;
     for (scale=0; scale<nScalesToClean; scale++) {
       // Find absolute maximum for the dirty image
-      SubLattice<T> dirtySub(*itsDirtyConvScales[scale], centerBox);
       maxima(scale)=0;
       posMaximum[scale]=IPosition(model.shape().nelements(), 0);
 
-
-      if (itsMask) {
-	findMaxAbsMaskLattice(dirtySub, *(scaleMaskSubs[scale]),
-			      maxima(scale), posMaximum[scale]);
+      if (itsInMemory) {
+	findMaxAbsArray(dirtyArrs[scale],
+			(itsMask ? &(maskArrs[scale]) : 0),
+			itsMaskThreshold >= 0, blcDirty, trcDirty,
+			tileShapes[scale], maxima(scale), posMaximum[scale]);
       } else {
-	findMaxAbsLattice(dirtySub, maxima(scale), posMaximum[scale]);
+	SubLattice<T> dirtySub(*itsDirtyConvScales[scale], centerBox);
+	if (itsMask) {
+	  findMaxAbsMaskLattice(dirtySub, *(scaleMaskSubs[scale]),
+				maxima(scale), posMaximum[scale]);
+	} else {
+	  findMaxAbsLattice(dirtySub, maxima(scale), posMaximum[scale]);
+	}
       }
 
       // Remember to adjust the position for the window and for 
@@ -610,6 +660,20 @@ Int LatticeCleaner<T>::clean(Lattice<T>& model,
     LCBox::verify(blcPsf, trcPsf, inc, model.shape());
 
     makeBoxesSameSize(blc,trc,blcPsf,trcPsf);
+
+    if (itsInMemory) {
+      // Add this scale to the model, and subtract its effects from all
+      // dirty convolutions. The scales are independent of each other.
+      const IPosition boxShape(trc-blc+1);
+      addBoxTo(modelArr, blc, scaleArrs[optimumScale], blcPsf, boxShape,
+	       scaleFactor);
+      for (scale=0;scale<nScalesToClean;scale++) {
+	addBoxTo(dirtyArrs[scale], blc,
+		 psfArrs[index(scale,optimumScale)], blcPsf, boxShape,
+		 -scaleFactor);
+      }
+      continue;
+    }
     
     LCBox subRegion(blc, trc, model.shape());
     LCBox subRegionPsf(blcPsf, trcPsf, model.shape());
@@ -634,6 +698,18 @@ Int LatticeCleaner<T>::clean(Lattice<T>& model,
   }
   // End of iteration
 
+  // Write back the arrays that do not reference the lattices.
+  if (itsInMemory) {
+    for (scale=0;scale<nScalesToClean;scale++) {
+      if (!dirtyIsRef[scale]) {
+	itsDirtyConvScales[scale]->put(dirtyArrs[scale]);
+      }
+    }
+    if (!modelIsRef) {
+      model.put(modelArr);
+    }
+  }
+
   for (scale=0;scale<nScalesToClean;scale++) {
     os << LogIO::NORMAL
        << "  " << scale+1 << "    " << totalFluxScale(scale)
@@ -749,6 +825,205 @@ Bool LatticeCleaner<T>::findMaxAbsMaskLattice(const Lattice<T>& lattice,
 
 
 
+template<class T>
+Bool LatticeCleaner<T>::getCleanArray(Lattice<T>& lattice, Array<T>& array)
+{
+  // Get the lattice data by reference if possible (i.e. in-memory lattice).
+  const IPosition shape = lattice.shape();
+  Bool isRef = lattice.getSlice(array, IPosition(shape.nelements(), 0),
+				shape);
+  if (!array.contiguousStorage()) {
+    array.reference(array.copy());
+    isRef = False;
+  }
+  return isRef;
+}
+
+template<class T>
+void LatticeCleaner<T>::findMaxAbsArray(const Array<T>& array,
+					const Array<T>* mask,
+					Bool weightedValue,
+					const IPosition& blc,
+					const IPosition& trc,
+					const IPosition& tileShape,
+					T& maxAbs, IPosition& posMaxAbs)
+{
+  // Do the same as findMaxAbsLattice and findMaxAbsMaskLattice, which
+  // step line by line through the box in tile order (TiledLineStepper).
+  // In each line the minimum and maximum (of the weighted values) are
+  // found; they are the candidates for the peak. The first candidate
+  // (in stepping order) with the largest absolute value is the peak.
+  // The lines are done in parallel, so each candidate gets a sequence
+  // number telling its order in the lattice path.
+  const IPosition& shape = array.shape();
+  const uInt ndim = shape.nelements();
+  const IPosition boxShape(trc-blc+1);
+  const Int64 nx = boxShape(0);
+  const Int64 nlines = boxShape.product() / nx;
+  Int64 nlinesTile = 1;
+  for (uInt i=1; i<ndim; i++) {
+    nlinesTile *= tileShape(i);
+  }
+  Bool deleteData, deleteMask;
+  const T* data = array.getStorage(deleteData);
+  const T* maskData = (mask ? mask->getStorage(deleteMask) : 0);
+  T peak = 0;
+  T peakAbs = 0;
+  Int64 peakOffset = -1;
+  Int64 peakSeq = -1;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    T myPeak = 0;
+    T myPeakAbs = 0;
+    Int64 myOffset = -1;
+    Int64 mySeq = -1;
+#ifdef _OPENMP
+#pragma omp for
+#endif
+    for (Int64 line=0; line<nlines; line++) {
+      // Get the offset of the start of the line in the array and
+      // the number of the line in tile order.
+      Int64 rest = line;
+      Int64 offset = blc(0);
+      Int64 step = shape(0);
+      Int64 tileNr = 0;
+      Int64 tileStep = 1;
+      Int64 lineInTile = 0;
+      Int64 lineStep = 1;
+      for (uInt i=1; i<ndim; i++) {
+	Int64 pos = rest % boxShape(i);
+	rest /= boxShape(i);
+	offset += (blc(i) + pos) * step;
+	step *= shape(i);
+	tileNr += pos / tileShape(i) * tileStep;
+	tileStep *= (boxShape(i) + tileShape(i) - 1) / tileShape(i);
+	lineInTile += pos % tileShape(i) * lineStep;
+	lineStep *= tileShape(i);
+      }
+      const T* ptr = data + offset;
+      // Find minimum and maximum like minMax and minMaxMasked.
+      Int64 minx = 0;
+      Int64 maxx = 0;
+      T minVal, maxVal;
+      if (maskData) {
+	const T* mptr = maskData + offset;
+	minVal = maxVal = ptr[0] * mptr[0];
+	for (Int64 ix=1; ix<nx; ix++) {
+	  T val = ptr[ix] * mptr[ix];
+	  if (val < minVal) {
+	    minVal = val;
+	    minx = ix;
+	  } else if (val > maxVal) {
+	    maxVal = val;
+	    maxx = ix;
+	  }
+	}
+	if (!weightedValue) {
+	  minVal = ptr[minx];
+	  maxVal = ptr[maxx];
+	}
+      } else {
+	minVal = maxVal = ptr[0];
+	for (Int64 ix=1; ix<nx; ix++) {
+	  if (ptr[ix] < minVal) {
+	    minVal = ptr[ix];
+	    minx = ix;
+	  } else if (ptr[ix] > maxVal) {
+	    maxVal = ptr[ix];
+	    maxx = ix;
+	  }
+	}
+      }
+      // The minimum is tested before the maximum.
+      Int64 seq = 2 * (tileNr * nlinesTile + lineInTile);
+      T vals[2] = {minVal, maxVal};
+      Int64 xs[2] = {minx, maxx};
+      for (uInt j=0; j<2; j++) {
+	T valAbs = abs(vals[j]);
+	if (valAbs > myPeakAbs  ||
+	    (valAbs == myPeakAbs  &&  myOffset >= 0  &&  seq+j < mySeq)) {
+	  myPeak = vals[j];
+	  myPeakAbs = valAbs;
+	  myOffset = offset + xs[j];
+	  mySeq = seq + j;
+	}
+      }
+    }
+#ifdef _OPENMP
+#pragma omp critical(LatticeCleaner_findMaxAbsArray)
+#endif
+    {
+      if (myOffset >= 0  &&  (myPeakAbs > peakAbs  ||
+			      (myPeakAbs == peakAbs  &&
+			       (peakOffset < 0  ||  mySeq < peakSeq)))) {
+	peak = myPeak;
+	peakAbs = myPeakAbs;
+	peakOffset = myOffset;
+	peakSeq = mySeq;
+      }
+    }
+  }
+  array.freeStorage(data, deleteData);
+  if (mask) {
+    mask->freeStorage(maskData, deleteMask);
+  }
+  // Convert the offset to the position relative to the box.
+  maxAbs = peak;
+  posMaxAbs = IPosition(ndim, 0);
+  if (peakOffset >= 0) {
+    for (uInt i=0; i<ndim; i++) {
+      posMaxAbs(i) = peakOffset % shape(i) - blc(i);
+      peakOffset /= shape(i);
+    }
+  }
+}
+
+template<class T>
+void LatticeCleaner<T>::addBoxTo(Array<T>& to, const IPosition& blcTo,
+				 const Array<T>& from,
+				 const IPosition& blcFrom,
+				 const IPosition& boxShape, T factor)
+{
+  // Both arrays have the same shape and contiguous storage, so the
+  // lines along the first axis of the boxes can be added directly.
+  const IPosition& shape = to.shape();
+  const uInt ndim = shape.nelements();
+  const Int64 nx = boxShape(0);
+  const Int64 nlines = boxShape.product() / nx;
+  Bool deleteTo, deleteFrom;
+  T* toData = to.getStorage(deleteTo);
+  const T* fromData = from.getStorage(deleteFrom);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (Int64 line=0; line<nlines; line++) {
+    Int64 rest = line;
+    Int64 offTo = 0;
+    Int64 offFrom = 0;
+    Int64 step = 1;
+    for (uInt i=0; i<ndim; i++) {
+      Int64 pos = 0;
+      if (i > 0) {
+	pos = rest % boxShape(i);
+	rest /= boxShape(i);
+      }
+      offTo   += (blcTo(i) + pos) * step;
+      offFrom += (blcFrom(i) + pos) * step;
+      step *= shape(i);
+    }
+    T* toPtr = toData + offTo;
+    const T* fromPtr = fromData + offFrom;
+    for (Int64 ix=0; ix<nx; ix++) {
+      toPtr[ix] += factor * fromPtr[ix];
+    }
+  }
+  from.freeStorage(fromData, deleteFrom);
+  to.putStorage(toData, deleteTo);
+}
+
+
 template<class T>
 Bool LatticeCleaner<T>::setscales(const Int nscales, const Float scaleInc)
 {
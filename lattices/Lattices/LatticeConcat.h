@@ -32,6 +32,9 @@
 //# Includes
 #include <lattices/Lattices/MaskedLattice.h>
 #include <casa/Containers/Block.h>
+#include <casa/BasicSL/String.h>
+#include <map>
+#include <set>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
@@ -74,6 +77,23 @@ class Slicer;
 //
 // If you use the putSlice function, be aware that it will change the
 // underlying lattices if they are writable.
+//
+// If <src>tempClose</src> is True, the input lattices are not closed
+// immediately after being accessed. Instead a pool of at most
+// <src>maxOpen</src> open lattices is kept; when it is full, the least
+// recently used lattice is closed. It is reopened when accessed again.
+// Thus concatenating many lattices does not reach the open file limit, while
+// repeated access to the same lattices (e.g. when iterating plane by plane)
+// does not need to reopen them each time. A maximum of 0 closes a lattice
+// immediately after each access.
+//
+// The shapes of the input lattices are kept, so the lattices contributing
+// to a section can be found without opening them.
+// If the section to get spans multiple input lattices that are all paged
+// lattices (e.g. PagedArray or PagedImage) stored in different tables,
+// they are read in parallel (using OpenMP) in batches of at most
+// <src>maxOpen</src> lattices. Other lattices (e.g. expressions or
+// sublattices referencing the same table) are read sequentially.
 // </synopsis>
 //
 // <example>
@@ -168,6 +188,14 @@ public:
    Bool isTempClose () const 
      {return tempClose_p;} 
 
+// Get or set the maximum number of input lattices kept open if
+// tempClose is True. The default is 32.
+// <group>
+   uInt maxOpen() const
+     { return maxOpen_p; }
+   void setMaxOpen (uInt maxOpen);
+// </group>
+
 // Returns the number of dimensions of the *input* lattices (may be different 
 // by one from output lattice).  Returns 0 if none yet set.
    uInt latticeDim() const;
@@ -256,29 +284,63 @@ private:
    IPosition shape_p;
    Bool isMasked_p, dimUpOne_p, tempClose_p;
    LatticeConcat<Bool>* pPixelMask_p;
+// The start of each lattice on the concatenation axis; the last element
+// is the length of that axis.
+   Block<Int> start_p;
+// The names of the lattices and whether they are all paged lattices
+// in different tables.
+   std::set<String> names_p;
+   Bool distinctTables_p;
+// The pool of open lattices: the time of last use of each lattice
+// (0 if not in the pool) and the lattice for each time of last use.
+   uInt maxOpen_p;
+   uInt64 clock_p;
+   Block<uInt64> lastUse_p;
+   std::map<uInt64,uInt> openPool_p;
 //
    void checkAxis(uInt axis, uInt ndim) const;
+//
+// Close the given lattice after it has been used (if tempClose is set).
+// It is put in the pool of open lattices; the least recently used lattices
+// are closed if the pool is full.
+   void release (uInt which);
+// Close the least recently used lattices until at most nkeep are
+// in the pool.
+   void shrinkPool (uInt nkeep);
 //
    void setup1 (IPosition& blc, IPosition& trc, IPosition& stride,
                 IPosition& blc2, IPosition& trc2,
                 IPosition& blc3, IPosition& trc3, IPosition& stride3,
-                const Slicer& section);
+                const Slicer& section) const;
    Slicer setup2 (Bool& first, IPosition& blc2, IPosition& trc2,
                   Int shape2, Int axis, const IPosition& blc,
-                  const IPosition& trc, const IPosition& stride, Int start);
-   Bool getSlice1 (Array<T>& buffer, const Slicer& section,
-                   uInt nLattices);
-   Bool getSlice2 (Array<T>& buffer, const Slicer& section,
-                   uInt nLattices);
+                  const IPosition& trc, const IPosition& stride, Int start) const;
+// Find the lattices contributing to the section, the section to get
+// from each of them and the section in the output buffer to put it in.
+   uInt findParts (Block<uInt>& parts, Block<Slicer>& sections,
+                   Block<Slicer>& outSections, const Slicer& section) const;
+// Tell if the given lattices can be read in parallel.
+   Bool canReadParallel (uInt nparts) const;
+// Get the data or mask of the section from the contributing lattices,
+// using the given function to read a part.
+   template<class U>
+   void getParts (Array<U>& buffer, const Slicer& section,
+                  Bool (*getPart) (MaskedLattice<T>&, Array<U>&,
+                                   const Slicer&));
+// Read the data or mask of a part.
+// <group>
+   static Bool getDataPart (MaskedLattice<T>& lattice, Array<T>& buffer,
+                            const Slicer& section)
+     { return lattice.getSlice (buffer, section); }
+   static Bool getMaskPart (MaskedLattice<T>& lattice, Array<Bool>& buffer,
+                            const Slicer& section)
+     { return lattice.getMaskSlice (buffer, section); }
+// </group>
    Bool putSlice1 (const Array<T>& buffer, const IPosition& where,
                    const IPosition& stride, uInt nLattices);
 
    Bool putSlice2 (const Array<T>& buffer, const IPosition& where,
                    const IPosition& stride, uInt nLattices);
-   Bool getMaskSlice1 (Array<Bool>& buffer, const Slicer& section,
-                       uInt nLattices);
-   Bool getMaskSlice2 (Array<Bool>& buffer, const Slicer& section,
-                       uInt nLattices);
 };
 
 
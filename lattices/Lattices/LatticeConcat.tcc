@@ -38,6 +38,10 @@
 #include <casa/BasicMath/Math.h>
 #include <casa/Exceptions/Error.h>
 #include <casa/Utilities/Assert.h>
+#include <algorithm>
+#ifdef _OPENMP
+# include <omp.h>
+#endif
 
 
 namespace casa { //# NAMESPACE CASA - BEGIN
@@ -49,7 +53,11 @@ LatticeConcat<T>::LatticeConcat()
   isMasked_p(False),
   dimUpOne_p(False),
   tempClose_p(True),
-  pPixelMask_p(0)
+  pPixelMask_p(0),
+  start_p(1, 0),
+  distinctTables_p(True),
+  maxOpen_p(32),
+  clock_p(0)
 {
 }
 
@@ -60,7 +68,11 @@ LatticeConcat<T>::LatticeConcat(uInt axis, Bool tempClose)
   isMasked_p(False),
   dimUpOne_p(False),
   tempClose_p(tempClose),
-  pPixelMask_p(0)
+  pPixelMask_p(0),
+  start_p(1, 0),
+  distinctTables_p(True),
+  maxOpen_p(32),
+  clock_p(0)
 {
 }
 
@@ -73,7 +85,13 @@ LatticeConcat<T>::LatticeConcat (const LatticeConcat<T>&other)
   isMasked_p(other.isMasked_p),
   dimUpOne_p(other.dimUpOne_p),
   tempClose_p(other.tempClose_p),
-  pPixelMask_p(0)
+  pPixelMask_p(0),
+  start_p(other.start_p),
+  names_p(other.names_p),
+  distinctTables_p(other.distinctTables_p),
+  maxOpen_p(other.maxOpen_p),
+  clock_p(0),
+  lastUse_p(other.lastUse_p.nelements(), uInt64(0))
 {
    const uInt n = lattices_p.nelements();
    for (uInt i=0; i<n; i++) {
@@ -105,6 +123,11 @@ LatticeConcat<T>& LatticeConcat<T>::operator= (const LatticeConcat<T>& other)
     isMasked_p     = other.isMasked_p;
     dimUpOne_p     = other.dimUpOne_p;
     tempClose_p    = other.tempClose_p;
+    start_p        = other.start_p;
+    names_p        = other.names_p;
+    distinctTables_p = other.distinctTables_p;
+    maxOpen_p      = other.maxOpen_p;
+    openPool_p.clear();
 //
     uInt n = lattices_p.nelements();
     for (uInt j=0; j<n; j++) {
@@ -118,6 +141,8 @@ LatticeConcat<T>& LatticeConcat<T>::operator= (const LatticeConcat<T>& other)
        lattices_p[i] = other.lattices_p[i]->cloneML();
        if (tempClose_p) lattices_p[i]->tempClose();
     }
+    lastUse_p.resize (n, True, False);
+    lastUse_p = uInt64(0);
 //
     delete pPixelMask_p;
     pPixelMask_p = 0;
@@ -185,10 +210,25 @@ void LatticeConcat<T>::setLattice(MaskedLattice<T>& lattice)
       }
    }
 
-// Assign lattice
+// Assign lattice and keep its extent on the concatenation axis
 
    lattices_p.resize(n+1, True);
    lattices_p[n] = lattice.cloneML();
+   lastUse_p.resize(n+1, True);
+   lastUse_p[n] = 0;
+   start_p.resize(n+2, True);
+   start_p[n+1] = start_p[n] + (dimUpOne_p ? 1 : lattice.shape()(axis_p));
+
+// Lattices can only be read in parallel if each of them is a paged lattice
+// in its own table. A sublattice of a paged lattice is only persistent
+// if it covers the entire lattice, in which case it has the same name.
+// Other lattices (e.g. expressions) can access any table.
+
+   const String name = lattice.name(False);
+   if (name.empty()  ||  !lattice.isPaged()  ||  !lattice.isPersistent()
+   ||  !names_p.insert(name).second) {
+      distinctTables_p = False;
+   }
 
 // If any lattice is masked, the whole thing is masked
 
@@ -216,11 +256,18 @@ void LatticeConcat<T>::setLattice(MaskedLattice<T>& lattice)
       }
    }
 
-// Close this lattice
+// Close this lattice (or keep it in the pool of open lattices)
  
-   if (tempClose_p) lattices_p[n]->tempClose();
+   release (n);
 } 
 
+template <class T>
+void LatticeConcat<T>::setMaxOpen (uInt maxOpen)
+{
+   maxOpen_p = maxOpen;
+   shrinkPool (maxOpen_p);
+}
+
 
 template <class T>
 uInt LatticeConcat<T>::latticeDim() const
@@ -328,20 +375,11 @@ Bool LatticeConcat<T>::doGetSlice (Array<T>& buffer,
       throw (AipsError("No lattices set - use function setLattice"));
    }
 //
-   Bool ok = False;
-   if (dimUpOne_p) {
+   getParts (buffer, section, &getDataPart);
 
-// Increase dimensionality by one
-
-     ok = getSlice1 (buffer, section, nLattices);
-   } else {
-
-// No dimensionality increase
+// Result is a copy
 
-     ok = getSlice2(buffer, section, nLattices);
-   }
-//
-   return ok;
+   return False;
 }
  
 
@@ -354,26 +392,16 @@ Bool LatticeConcat<T>::doGetMaskSlice (Array<Bool>& buffer,
       throw (AipsError("No lattices set - use function setLattice"));
    }
 //
-   Bool ok = False;
    if (isMasked_p) {
-      if (dimUpOne_p) {
-
-// Increase dimensionality by one
-
-        ok = getMaskSlice1 (buffer, section, nLattices);
-      } else {
-
-// No dimensionality increase
-
-        ok = getMaskSlice2 (buffer, section, nLattices);
-      }
+      getParts (buffer, section, &getMaskPart);
    } else {
       buffer.resize (section.length());
       buffer = True;
-      ok = True;
    }
-//
-   return ok;   
+
+// Result is a copy
+
+   return False;   
 }
 
 
@@ -427,12 +455,12 @@ Bool LatticeConcat<T>::lock (FileLocker::LockType type, uInt nattempts)
              } else {
                 lattices_p[j]->unlock();
              }
-             if (tempClose_p) lattices_p[j]->tempClose();
+             release (j);
           }
-          if (tempClose_p) lattices_p[i]->tempClose();
+          release (i);
           return False;
        }
-       if (tempClose_p) lattices_p[i]->tempClose();
+       release (i);
     }
     return True;
 }
@@ -480,6 +508,7 @@ void LatticeConcat<T>::flush()
 template <class T>
 void LatticeConcat<T>::tempClose()
 {
+    shrinkPool (0);
     const uInt n = lattices_p.nelements();
     for (uInt i=0; i<n; i++) {
        lattices_p[i]->tempClose();
@@ -500,6 +529,10 @@ void LatticeConcat<T>::tempClose(uInt which)
 {
     AlwaysAssert (which<lattices_p.nelements(), AipsError);
     lattices_p[which]->tempClose();
+    if (lastUse_p[which] != 0) {
+       openPool_p.erase (lastUse_p[which]);
+       lastUse_p[which] = 0;
+    }
 }
 
 template <class T>
@@ -530,7 +563,7 @@ template <class T>
 void LatticeConcat<T>::setup1 (IPosition& blc, IPosition& trc, IPosition& stride,
                                IPosition& blc2, IPosition& trc2, 
                                IPosition& blc3, IPosition& trc3, IPosition& stride3, 
-                               const Slicer& section)
+                               const Slicer& section) const
 {
 // The Slicer section for the whole concatenated lattice
 
@@ -557,7 +590,7 @@ void LatticeConcat<T>::setup1 (IPosition& blc, IPosition& trc, IPosition& stride
 template<class T>
 Slicer LatticeConcat<T>::setup2 (Bool& first, IPosition& blc2, IPosition& trc2, 
                                  Int shape2, Int axis, const IPosition& blc, 
-                                 const IPosition& trc, const IPosition& stride, Int start)
+                                 const IPosition& trc, const IPosition& stride, Int start) const
 {
 
 // This lattice contributes to the slice.  Find section
@@ -577,107 +610,175 @@ Slicer LatticeConcat<T>::setup2 (Bool& first, IPosition& blc2, IPosition& trc2,
 }
 
 template <class T>
-Bool LatticeConcat<T>::getSlice1 (Array<T>& buffer,
-                                  const Slicer& section,
-                                  uInt nLattices)
+void LatticeConcat<T>::release (uInt which)
 {
-   const uInt dimIn = axis_p;
-
-// The concatenated lattice section
-
-   if (section.end()(axis_p)+1 > Int(nLattices)) {
-      throw(AipsError("Number of lattices and requested slice are inconsistent"));      
+   if (tempClose_p) {
+      if (lastUse_p[which] != 0) {
+         openPool_p.erase (lastUse_p[which]);
+      }
+      lastUse_p[which] = ++clock_p;
+      openPool_p[clock_p] = which;
+      shrinkPool (maxOpen_p);
    }
-   IPosition blc3(dimIn+1,0);
-   IPosition trc3(section.length()-1);
-   IPosition stride3(dimIn+1,1);
-
-
-// The underlying lattice section - it never changes
-
-   Slicer section2(section.start().getFirst(dimIn), section.end().getFirst(dimIn), 
-                   section.stride().getFirst(dimIn), Slicer::endIsLast);
-//
-   buffer.resize(section.length());
-
-// We are looping over the last axis of the concatenated lattice
-// Each input lattice contributes just one pixel to that axis
+}
 
-   uInt k = 0;
-   for (Int i=section.start()(axis_p); i<=section.end()(axis_p); i+=section.stride()(axis_p)) {
-       Array<T> buf = lattices_p[i]->getSlice(section2);
-//
-       blc3(axis_p) = k;
-       trc3(axis_p) = k;
-       buffer(blc3, trc3, stride3) = buf.addDegenerate(1);
-       if (tempClose_p) lattices_p[i]->tempClose();
-       k++;
+template <class T>
+void LatticeConcat<T>::shrinkPool (uInt nkeep)
+{
+   while (openPool_p.size() > nkeep) {
+      std::map<uInt64,uInt>::iterator iter = openPool_p.begin();
+      lattices_p[iter->second]->tempClose();
+      lastUse_p[iter->second] = 0;
+      openPool_p.erase (iter);
    }
-
-// Result is a copy
-
-   return False;
 }
 
-
 template <class T>
-Bool LatticeConcat<T>::getSlice2 (Array<T>& buffer,
-                                  const Slicer& section,
-                                  uInt nLattices)
+uInt LatticeConcat<T>::findParts (Block<uInt>& parts, Block<Slicer>& sections,
+                                  Block<Slicer>& outSections,
+                                  const Slicer& section) const
 {
-//cout << "blc, trc, stride=" << section.start() << section.end() << section.stride() << endl;
-
-// Setup positions
-
-   IPosition blc, trc, stride;   
-   IPosition blc2, trc2;
-   IPosition blc3, trc3, stride3;
-   setup1 (blc, trc, stride, blc2, trc2, blc3, trc3, stride3, section);
-//
-   buffer.resize(section.length());
-//cout << "Buffer shape = " << buffer.shape() << endl;
-//
-   Int start = 0;
-   Bool first = True;
-   Slicer section2;
-//
-   for (uInt i=0; i<nLattices; i++) {
-
-//cout << "Lattice shape = " << lattices_p[i]->shape() << endl;
-
-// Find start and end of this lattice inside the concatenated lattice
+   const uInt nLattices = lattices_p.nelements();
+   uInt nparts = 0;
+   if (dimUpOne_p) {
+      const uInt dimIn = axis_p;
 
-      Int shape2 = lattices_p[i]->shape()(axis_p);
-      Int end = start + shape2 - 1;
-//
-      if (! (blc(axis_p)>end || trc(axis_p)<start)) {
+// The concatenated lattice section
 
-// Find section of input Lattice to copy
+      if (section.end()(axis_p)+1 > Int(nLattices)) {
+         throw(AipsError("Number of lattices and requested slice are inconsistent"));      
+      }
+      IPosition blc3(dimIn+1,0);
+      IPosition trc3(section.length()-1);
+      IPosition stride3(dimIn+1,1);
 
-         section2 = setup2(first, blc2, trc2, shape2, axis_p, blc, trc, 
-                           stride, start);
+// The underlying lattice section - it never changes
 
-// Put it in output buffer
+      Slicer section2(section.start().getFirst(dimIn), section.end().getFirst(dimIn), 
+                      section.stride().getFirst(dimIn), Slicer::endIsLast);
 
-//cout << "blc2, trc2, stride2, shape = " 
-//     << section2.start() << section2.end() << section2.stride() << section2.length() << endl;
+// We are looping over the last axis of the concatenated lattice
+// Each input lattice contributes just one pixel to that axis
 
-         trc3(axis_p) = blc3(axis_p) + section2.length()(axis_p) - 1;
+      nparts = section.length()(axis_p);
+      parts.resize (nparts, True, False);
+      sections.resize (nparts, True, False);
+      outSections.resize (nparts, True, False);
+      uInt k = 0;
+      for (Int i=section.start()(axis_p); i<=section.end()(axis_p); i+=section.stride()(axis_p)) {
+         blc3(axis_p) = k;
+         trc3(axis_p) = k;
+         parts[k] = i;
+         sections[k] = section2;
+         outSections[k] = Slicer(blc3, trc3, stride3, Slicer::endIsLast);
+         k++;
+      }
+   } else {
 
-//IPosition sh(Slicer(blc3, trc3, stride3, Slicer::endIsLast).length());
-//cout << "blc3, trc3, stride3, shape = " << blc3 << trc3 << stride3  << sh << endl << endl;
+// Setup positions
 
-         buffer(blc3, trc3, stride3) = lattices_p[i]->getSlice(section2);
-         blc3(axis_p) += section2.length()(axis_p);
+      IPosition blc, trc, stride;   
+      IPosition blc2, trc2;
+      IPosition blc3, trc3, stride3;
+      setup1 (blc, trc, stride, blc2, trc2, blc3, trc3, stride3, section);
+
+// Find the first lattice containing the start of the section on the
+// concatenation axis. The shapes are known, so no lattice needs to be opened.
+
+      uInt first = std::upper_bound (start_p.storage(),
+                                     start_p.storage() + nLattices,
+                                     Int(blc(axis_p))) - start_p.storage() - 1;
+      parts.resize (nLattices-first, True, False);
+      sections.resize (nLattices-first, True, False);
+      outSections.resize (nLattices-first, True, False);
+      Bool firstPart = True;
+      for (uInt i=first; i<nLattices && start_p[i]<=trc(axis_p); i++) {
+         Int start = start_p[i];
+         Int shape2 = start_p[i+1] - start;
+         Int end = start + shape2 - 1;
+         if (blc(axis_p) <= end) {
+
+// Find section of input Lattice to copy and where to put it in the buffer
+
+            sections[nparts] = setup2 (firstPart, blc2, trc2, shape2,
+                                       axis_p, blc, trc, stride, start);
+            trc3(axis_p) = blc3(axis_p) + sections[nparts].length()(axis_p) - 1;
+            outSections[nparts] = Slicer(blc3, trc3, stride3, Slicer::endIsLast);
+            parts[nparts] = i;
+            blc3(axis_p) += sections[nparts].length()(axis_p);
+            nparts++;
+         }
       }
-      start += shape2;
-      if (tempClose_p) lattices_p[i]->tempClose();
    }
+   return nparts;
+}
 
-// Result is a copy
-
+#ifdef _OPENMP
+template <class T>
+Bool LatticeConcat<T>::canReadParallel (uInt nparts) const
+{
+   return nparts > 1  &&  distinctTables_p  &&  omp_get_max_threads() > 1
+      &&  !omp_in_parallel();
+}
+#else
+template <class T>
+Bool LatticeConcat<T>::canReadParallel (uInt) const
+{
    return False;
 }
+#endif
+
+template <class T>
+template <class U>
+void LatticeConcat<T>::getParts (Array<U>& buffer, const Slicer& section,
+                                 Bool (*getPart) (MaskedLattice<T>&,
+                                                  Array<U>&, const Slicer&))
+{
+   Block<uInt> parts;
+   Block<Slicer> sections, outSections;
+   const uInt nparts = findParts (parts, sections, outSections, section);
+   buffer.resize (section.length());
+   const Bool parallel = canReadParallel (nparts);
+
+// Read the lattices in batches, so no more than maxOpen are open at a time.
+// They are opened sequentially.
+
+   const uInt nbatch = (tempClose_p  ?  std::max(maxOpen_p, 1u) : nparts);
+   for (uInt st=0; st<nparts; st+=nbatch) {
+      const uInt nb = std::min (nbatch, nparts-st);
+      if (parallel  &&  tempClose_p) {
+         for (uInt i=st; i<st+nb; i++) {
+            lattices_p[parts[i]]->reopen();
+         }
+      }
+      String errMsg;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if(parallel && nb > 1)
+#endif
+      for (Int i=st; i<Int(st+nb); i++) {
+         try {
+            Array<U> buf;
+            getPart (*lattices_p[parts[i]], buf, sections[i]);
+            if (dimUpOne_p) {
+               buffer(outSections[i]) = buf.addDegenerate(1);
+            } else {
+               buffer(outSections[i]) = buf;
+            }
+         } catch (std::exception& x) {
+#ifdef _OPENMP
+#pragma omp critical(LatticeConcat_getParts)
+#endif
+            errMsg = x.what();
+         }
+      }
+      for (uInt i=st; i<st+nb; i++) {
+         release (parts[i]);
+      }
+      if (!errMsg.empty()) {
+         throw AipsError (errMsg);
+      }
+   }
+}
 
 
 template <class T>
@@ -712,7 +813,7 @@ Bool LatticeConcat<T>::putSlice1 (const Array<T>& buffer, const IPosition& where
       Array<T> buf0(buffer);
       lattices_p[i]->putSlice(buf0(blc3, trc3, stride3).nonDegenerate(axis_p-1), 
                               section2.start(), section2.stride());
-      if (tempClose_p) lattices_p[i]->tempClose();
+      release (i);
       k++;
    }
 //  
@@ -751,7 +852,7 @@ Bool LatticeConcat<T>::putSlice2 (const Array<T>& buffer, const IPosition& where
 
 // Find start and end of this lattice inside the concatenated lattice
 
-      Int shape2 = lattices_p[i]->shape()(axis_p);
+      Int shape2 = start_p[i+1] - start_p[i];
       Int end = start + shape2 - 1;
 //
       if (! (blc(axis_p)>end || trc(axis_p)<start)) {
@@ -775,7 +876,7 @@ Bool LatticeConcat<T>::putSlice2 (const Array<T>& buffer, const IPosition& where
 
          Array<T> buf(buffer);
          lattices_p[i]->putSlice(buf(blc3, trc3, stride3), blc2, stride);
-         if (tempClose_p) lattices_p[i]->tempClose();
+         release (i);
 //
          blc3(axis_p) += section2.length()(axis_p);
       }
@@ -786,96 +887,5 @@ Bool LatticeConcat<T>::putSlice2 (const Array<T>& buffer, const IPosition& where
 }
 
 
-template <class T>
-Bool LatticeConcat<T>::getMaskSlice1 (Array<Bool>& buffer,
-                                      const Slicer& section,
-                                      uInt nLattices)
-{
-   const uInt dimIn = axis_p;
-
-// The concatenated lattice section
-
-   if (section.end()(axis_p)+1 > Int(nLattices)) {
-      throw(AipsError("Number of lattices and requested slice are inconsistent"));
-   }
-   IPosition blc3(dimIn+1,0);
-   IPosition trc3(section.length()-1);
-   IPosition stride3(dimIn+1,1);
-
-
-// The underlying lattice section - it never changes
-   
-   Slicer section2(section.start().getFirst(dimIn), section.end().getFirst(dimIn),
-                   section.stride().getFirst(dimIn), Slicer::endIsLast);
-//
-   buffer.resize(section.length());
-
-// We are looping over the last axis of the concatenated lattice
-// Each input lattice contributes just one pixel to that axis
-                                  
-   uInt k = 0;
-   for (Int i=section.start()(axis_p); i<=section.end()(axis_p); i+=section.stride()(axis_p)) {
-       blc3(axis_p) = k;
-       trc3(axis_p) = k;
-       Array<Bool> buf = lattices_p[i]->getMaskSlice(section2);
-       buffer(blc3, trc3, stride3) = buf.addDegenerate(1);
-       if (tempClose_p) lattices_p[i]->tempClose();
-       k++;
-   }
-
-// Result is a copy
-
-   return False;
-}
- 
-
-
-template <class T>
-Bool LatticeConcat<T>::getMaskSlice2 (Array<Bool>& buffer,
-                                      const Slicer& section,
-                                      uInt nLattices)
-{
-
-// Setup positions
-
-   IPosition blc, trc, stride;   
-   IPosition blc2, trc2;
-   IPosition blc3, trc3, stride3;
-   setup1 (blc, trc, stride, blc2, trc2, blc3, trc3, stride3, section);
-//
-   buffer.resize(section.length());
-//
-   Int start = 0;
-   Bool first = True;
-   Slicer section2;
-//
-   for (uInt i=0; i<nLattices; i++) {
-
-// Find start and end of this lattice inside the concatenated lattice
-
-      Int shape2 = lattices_p[i]->shape()(axis_p);
-      Int end = start + shape2 - 1;
-//
-      if (! (blc(axis_p)>end || trc(axis_p)<start)) {
-
-// Whack slice into the output
-
-         section2 = setup2(first, blc2, trc2, shape2, axis_p, blc, trc, 
-                           stride, start);
-//
-         trc3(axis_p) = blc3(axis_p) + section2.length()(axis_p) - 1;
-         buffer(blc3, trc3, stride3) = lattices_p[i]->getMaskSlice(section2);
-         if (tempClose_p) lattices_p[i]->tempClose();
-//
-         blc3(axis_p) += section2.length()(axis_p);
-      }
-      start += shape2;
-   }
-
-// Result is a copy
-
-   return False;
-}
-
 } //# NAMESPACE CASA - END
 
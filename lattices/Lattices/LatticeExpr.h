@@ -39,7 +39,9 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 //# Forward Declarations
 template <class T> class Array;
+template <class T> class Block;
 template <class T> class LELArray;
+class LatticeNavigator;
 
 
 // <summary> Class to allow C++ expressions involving lattices </summary>
@@ -221,8 +223,22 @@ public:
 			    const IPosition& stride);
 
   // Copy the data from this lattice to the given lattice.
+  // If multiple threads can be used, several chunks are evaluated in
+  // parallel (using <src>evalChunks</src>), while they are written into
+  // the output lattice sequentially in stepper order.
    virtual void copyDataTo (Lattice<T>& to) const;
 
+  // Evaluate the next chunks of the (non-scalar) expression as given by
+  // the stepper. At most <src>values.nelements()</src> chunks are
+  // evaluated; if OpenMP is used, this is done in parallel.
+  // The stepper is advanced past the chunks evaluated.
+  // The chunk values, masks, and start positions are stored in the blocks.
+  // A mask is empty if the expression is not masked.
+  // It returns the number of chunks evaluated (0 if the stepper is at end).
+   uInt evalChunks (Block<Array<T> >& values, Block<Array<Bool> >& masks,
+		    Block<IPosition>& positions,
+		    LatticeNavigator& stepper) const;
+
   // Handle the Math operators (+=, -=, *=, /=).
   // They work similarly to copyData(To).
   // However, they are not defined for Bool types, thus specialized below.
@@ -232,6 +248,9 @@ private:
    // Initialize the object from the expression.
    void init (const LatticeExprNode& expr);
 
+   // Evaluate the expression for the given section into the chunk buffer.
+   // The buffer of the previous chunk is reused if possible.
+   void makeChunk (const Slicer& section);
 
    LatticeExprNode expr_p;     //# its shape can be undefined
    IPosition       shape_p;    //# this shape is always defined
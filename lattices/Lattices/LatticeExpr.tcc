@@ -28,12 +28,18 @@
 #include <lattices/Lattices/LatticeExpr.h>
 #include <lattices/Lattices/LELArray.h>
 #include <lattices/Lattices/LatticeIterator.h>
+#include <lattices/Lattices/LatticeStepper.h>
 #include <casa/Arrays/Array.h>
 #include <casa/Arrays/Slicer.h>
+#include <casa/Containers/Block.h>
 #include <casa/Arrays/ArrayMath.h>
 #include <casa/Utilities/Assert.h>
 #include <casa/Exceptions/Error.h> 
 
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
@@ -203,15 +209,33 @@ Bool LatticeExpr<T>::doGetSlice (Array<T>& buffer,
 {
 // Evaluate the expression if not accessing the same section again.
    if (!(section==lastSlicer_p)) {
-      delete lastChunkPtr_p;
-      lastChunkPtr_p = new LELArray<T> (section.length());
-      lastSlicer_p = section;
-      expr_p.eval (*lastChunkPtr_p, section);
+      makeChunk (section);
    }
    buffer.reference (lastChunkPtr_p->value());
    return True;
 }
 
+template <class T>
+void LatticeExpr<T>::makeChunk (const Slicer& section)
+{
+// Reuse the buffer of the previous chunk if it has the same shape
+// and is not referenced elsewhere anymore (e.g. by an iterator cursor).
+// The mask is removed, because the expression sets it if needed.
+   const IPosition& shp = section.length();
+   if (lastChunkPtr_p != 0  &&  lastChunkPtr_p->shape().isEqual(shp)
+   &&  lastChunkPtr_p->value().nrefs() == 1) {
+      lastChunkPtr_p->removeMask();
+   } else {
+      delete lastChunkPtr_p;
+      lastChunkPtr_p = 0;
+      lastChunkPtr_p = new LELArray<T> (shp);
+   }
+   // Invalidate the chunk while evaluating, in case an exception is thrown.
+   lastSlicer_p = Slicer();
+   expr_p.eval (*lastChunkPtr_p, section);
+   lastSlicer_p = section;
+}
+
 template <class T>
 Bool LatticeExpr<T>::doGetMaskSlice (Array<Bool>& buffer,
 				     const Slicer& section)
@@ -219,10 +243,7 @@ Bool LatticeExpr<T>::doGetMaskSlice (Array<Bool>& buffer,
 // Evaluate if masked and if different section.
    if (expr_p.isMasked()) {
       if (!(section==lastSlicer_p)) {
-	 delete lastChunkPtr_p;
-	 lastChunkPtr_p = new LELArray<T> (section.length());
-	 lastSlicer_p = section;
-	 expr_p.eval (*lastChunkPtr_p, section);
+	 makeChunk (section);
       }
       if (lastChunkPtr_p->isMasked()) {
 	 buffer.reference (lastChunkPtr_p->mask());
@@ -246,16 +267,106 @@ template<class T>
 void LatticeExpr<T>::copyDataTo (Lattice<T>& to) const
 {
   // If a scalar, set lattice to its value.
-  // Otherwise use the Lattice copyDataTo function.
+  // Otherwise evaluate the chunks in parallel if possible.
+  // If not, use the Lattice copyDataTo function.
   if (expr_p.isScalar()) {
     // Check the lattice is writable.
     AlwaysAssert (to.isWritable(), AipsError);
     T value;
     expr_p.eval (value);
     to.set (value);
-  } else {
+    return;
+  }
+  uInt nthr = 1;
+#ifdef _OPENMP
+  nthr = omp_get_max_threads();
+#endif
+  if (nthr <= 1) {
     Lattice<T>::copyDataTo (to);
+    return;
+  }
+  // Check the lattice is writable.
+  // Check the shape conformance.
+  AlwaysAssert (to.isWritable(), AipsError);
+  const IPosition shapeOut = to.shape();
+  AlwaysAssert (shape_p.isEqual (shapeOut), AipsError);
+  IPosition cursorShape = to.niceCursorShape();
+  LatticeStepper stepper (shapeOut, cursorShape, LatticeStepper::RESIZE);
+  // Create an iterator for the output to setup the cache.
+  // It is not used, because using putSlice directly is faster and as easy.
+  LatticeIterator<T> dummyIter(to, stepper);
+  // Evaluate two chunks per thread at a time and write them in order,
+  // so the output lattice is still written sequentially.
+  Block<Array<T> > values(2*nthr);
+  Block<Array<Bool> > masks(2*nthr);
+  Block<IPosition> positions(2*nthr);
+  uInt nchunk;
+  while ((nchunk = evalChunks (values, masks, positions, stepper)) > 0) {
+    for (uInt i=0; i<nchunk; ++i) {
+      to.putSlice (values[i], positions[i]);
+    }
+  }
+}
+
+template<class T>
+uInt LatticeExpr<T>::evalChunks (Block<Array<T> >& values,
+				 Block<Array<Bool> >& masks,
+				 Block<IPosition>& positions,
+				 LatticeNavigator& stepper) const
+{
+  AlwaysAssert (!expr_p.isScalar(), AipsError);
+  AlwaysAssert (masks.nelements() >= values.nelements()  &&
+		positions.nelements() >= values.nelements(), AipsError);
+  // Let the expression optimize itself (which replaces its scalar
+  // subexpressions by their values) before evaluating in parallel.
+  expr_p.isInvalidScalar();
+  // Get the sections of the next chunks.
+  const IPosition last = shape_p - 1;
+  Block<Slicer> sections(values.nelements());
+  uInt nchunk = 0;
+  for (; nchunk<values.nelements() && !stepper.atEnd(); ++nchunk, stepper++) {
+    IPosition end (stepper.endPosition());
+    for (uInt j=0; j<end.nelements(); ++j) {
+      if (end[j] > last[j]) {
+	end[j] = last[j];
+      }
+    }
+    positions[nchunk] = stepper.position();
+    sections[nchunk]  = Slicer (positions[nchunk], end, Slicer::endIsLast);
+  }
+  // Evaluate the chunks. The LEL nodes do not change during evaluation;
+  // the lattices they read are guarded by the global LELLatticeLock.
+  // Exceptions cannot cross the parallel region, so they are rethrown
+  // afterwards.
+  Bool failed = False;
+  String errMsg;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (Int i=0; i<Int(nchunk); ++i) {
+    try {
+      LELArray<T> chunk (sections[i].length());
+      expr_p.eval (chunk, sections[i]);
+      values[i].reference (chunk.value());
+      if (chunk.isMasked()) {
+	masks[i].reference (chunk.mask());
+      } else {
+	masks[i].resize();
+      }
+    } catch (std::exception& x) {
+#ifdef _OPENMP
+#pragma omp critical(LatticeExpr_evalChunks)
+#endif
+      {
+	failed = True;
+	errMsg = x.what();
+      }
+    }
+  }
+  if (failed) {
+    throw AipsError ("LatticeExpr::evalChunks - " + errMsg);
   }
+  return nchunk;
 }
 
 template<class T>
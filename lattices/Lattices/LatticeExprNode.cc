@@ -38,6 +38,7 @@
 #include <lattices/Lattices/LELFunction.h>
 #include <lattices/Lattices/LELSpectralIndex.h>
 #include <lattices/Lattices/LELArray.h>
+#include <lattices/Lattices/LELEvalContext.h>
 #include <lattices/Lattices/LELRegion.h>
 #include <lattices/Lattices/LCRegion.h>
 #include <lattices/Lattices/LCSlicer.h>
@@ -693,12 +694,48 @@ Bool LatticeExprNode::replaceScalarExpr()
    return isInvalid_p;
 }
 
+void LatticeExprNode::replaceSubExpr (LELSubExprMap& map)
+{
+   if (!donePrepare_p) {
+      replaceScalarExpr();
+   }
+   switch (dataType()) {
+   case TpFloat:
+      LELInterface<Float>::replaceSubExpr (pExprFloat_p, map);
+      pAttr_p = &pExprFloat_p->getAttribute();
+      break;
+   case TpDouble:
+      LELInterface<Double>::replaceSubExpr (pExprDouble_p, map);
+      pAttr_p = &pExprDouble_p->getAttribute();
+      break;
+   case TpComplex:
+      LELInterface<Complex>::replaceSubExpr (pExprComplex_p, map);
+      pAttr_p = &pExprComplex_p->getAttribute();
+      break;
+   case TpDComplex:
+      LELInterface<DComplex>::replaceSubExpr (pExprDComplex_p, map);
+      pAttr_p = &pExprDComplex_p->getAttribute();
+      break;
+   case TpBool:
+      LELInterface<Bool>::replaceSubExpr (pExprBool_p, map);
+      pAttr_p = &pExprBool_p->getAttribute();
+      break;
+   default:
+      throw (AipsError ("LatticeExprNode::replaceSubExpr - "
+			"unknown data type"));
+   }
+   donePrepare_p = True;
+}
+
 void LatticeExprNode::doPrepare() const
 {
    if (!donePrepare_p) {
+// Replace scalar subexpressions by their values and share the
+// common subexpressions (also in function arguments).
       LatticeExprNode* This = (LatticeExprNode*)this;
-      This->replaceScalarExpr();
-      This->donePrepare_p = True;
+      LELSubExprMap map;
+      This->replaceSubExpr (map);
+      map.setUsers();
    }
 }
 
@@ -724,6 +761,8 @@ void LatticeExprNode::eval (LELArray<Float>& result,
 	 result.setMask (mask);
       }
    } else {
+// Results of shared subexpressions are kept in the context.
+      LELEvalContext context;
       pExprFloat_p->eval (result, section);
    }
 }
@@ -734,9 +773,7 @@ void LatticeExprNode::eval (LELArray<Double>& result,
 // If first time, try to do optimization.
    DebugAssert (dataType() == TpDouble, AipsError);
    if (!donePrepare_p) {
-      LatticeExprNode* This = (LatticeExprNode*)this;
-      This->replaceScalarExpr();
-      This->donePrepare_p = True;
+      doPrepare();
    }
 // If scalar, remove mask if scalar is valid. Otherwise set False mask.
 // If array, evaluate for this section.
@@ -752,6 +789,8 @@ void LatticeExprNode::eval (LELArray<Double>& result,
 	 result.setMask (mask);
       }
    } else {
+// Results of shared subexpressions are kept in the context.
+      LELEvalContext context;
       pExprDouble_p->eval (result, section);
    }
 }
@@ -762,9 +801,7 @@ void LatticeExprNode::eval (LELArray<Complex>& result,
 // If first time, try to do optimization.
    DebugAssert (dataType() == TpComplex, AipsError);
    if (!donePrepare_p) {
-      LatticeExprNode* This = (LatticeExprNode*)this;
-      This->replaceScalarExpr();
-      This->donePrepare_p = True;
+      doPrepare();
    }
 // If scalar, remove mask if scalar is valid. Otherwise set False mask.
 // If array, evaluate for this section.
@@ -780,6 +817,8 @@ void LatticeExprNode::eval (LELArray<Complex>& result,
 	 result.setMask (mask);
       }
    } else {
+// Results of shared subexpressions are kept in the context.
+      LELEvalContext context;
       pExprComplex_p->eval (result, section);
    }
 }
@@ -790,9 +829,7 @@ void LatticeExprNode::eval (LELArray<DComplex>& result,
 // If first time, try to do optimization.
    DebugAssert (dataType() == TpDComplex, AipsError);
    if (!donePrepare_p) {
-      LatticeExprNode* This = (LatticeExprNode*)this;
-      This->replaceScalarExpr();
-      This->donePrepare_p = True;
+      doPrepare();
    }
 // If scalar, remove mask if scalar is valid. Otherwise set False mask.
 // If array, evaluate for this section.
@@ -808,6 +845,8 @@ void LatticeExprNode::eval (LELArray<DComplex>& result,
 	 result.setMask (mask);
       }
    } else {
+// Results of shared subexpressions are kept in the context.
+      LELEvalContext context;
       pExprDComplex_p->eval (result, section);
    }
 }
@@ -818,9 +857,7 @@ void LatticeExprNode::eval (LELArray<Bool>& result,
 // If first time, try to do optimization.
    DebugAssert (dataType() == TpBool, AipsError);
    if (!donePrepare_p) {
-      LatticeExprNode* This = (LatticeExprNode*)this;
-      This->replaceScalarExpr();
-      This->donePrepare_p = True;
+      doPrepare();
    }
 // If scalar, remove mask if scalar is valid. Otherwise set False mask.
 // If array, evaluate for this section.
@@ -836,6 +873,8 @@ void LatticeExprNode::eval (LELArray<Bool>& result,
 	 result.setMask (mask);
       }
    } else {
+// Results of shared subexpressions are kept in the context.
+      LELEvalContext context;
       pExprBool_p->eval (result, section);
    }
 }
@@ -710,6 +710,10 @@ public:
 
 // Replace a scalar subexpression by its result.
    Bool replaceScalarExpr();
+
+// Replace equal subexpressions by a shared one (see class LELShared).
+// It also marks the node as prepared.
+   void replaceSubExpr (LELSubExprMap& map);
   
 // Make the object from a Counted<LELInterface> pointer.
 // Ideally this function is private, but alas it is needed in LELFunction1D,
@@ -40,12 +40,217 @@
 #include <lattices/Lattices/LatticeExpr.h>
 #include <lattices/Lattices/LatticeStepper.h>
 #include <lattices/Lattices/TempLattice.h>
-#include <lattices/Lattices/TiledLineStepper.h>
 #include <casa/OS/HostInfo.h>
 #include <casa/iostream.h>
+#include <algorithm>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
+// The ways a single line can be transformed.
+enum LatticeFFTLineMode {
+  // fft, i.e. with the origin in the centre of the line
+  LineShift,
+  // fft0, i.e. with the origin at the first element
+  LineNoShift,
+  // flip the input to the first element, followed by fft0
+  LineFlipBefore,
+  // fft0 followed by flipping the output to the centre
+  LineFlipAfter
+};
+
+// Determine the shape of the slabs used to transform the lines along
+// the given axis. A slab contains the full lines and the lattice's tile
+// shape along the other axes, so each tile is read and written only once.
+// If needed, the slab is made smaller to fit in a fraction of the free memory.
+static IPosition fftSlabShape (const IPosition& latticeShape,
+			       const IPosition& tileShape,
+			       uInt dim, uInt pixelSize)
+{
+  IPosition slabShape (latticeShape.nelements());
+  for (uInt i=0; i<slabShape.nelements(); i++) {
+    slabShape(i) = std::min(tileShape(i), latticeShape(i));
+  }
+  slabShape(dim) = latticeShape(dim);
+  // Use at most 1/8 of the free memory for a slab.
+  const Int64 memFree = HostInfo::memoryFree();
+  const Int64 maxPixels = (memFree * 1024) / (8 * pixelSize);
+  while (memFree > 0  &&  slabShape.product() > maxPixels) {
+    uInt axis = dim;
+    for (uInt i=0; i<slabShape.nelements(); i++) {
+      if (i != dim  &&  slabShape(i) > 1  &&
+	  (axis == dim  ||  slabShape(i) > slabShape(axis))) {
+	axis = i;
+      }
+    }
+    if (axis == dim) {
+      break;
+    }
+    slabShape(axis) = (slabShape(axis) + 1) / 2;
+  }
+  return slabShape;
+}
+
+// Transform a line. The direction of a real<->complex transform
+// follows from the types of the lines.
+// <group>
+template<class T, class S>
+static void fftLine (FFTServer<T,S>& ffts, Vector<S>& out, Vector<S>& in,
+		     Bool toFrequency, LatticeFFTLineMode mode)
+{
+  out = in;
+  switch (mode) {
+  case LineShift:
+    ffts.fft (out, toFrequency);
+    break;
+  case LineNoShift:
+    ffts.fft0 (out, toFrequency);
+    break;
+  case LineFlipBefore:
+    ffts.flip (out, True, False);
+    ffts.fft0 (out, toFrequency);
+    break;
+  case LineFlipAfter:
+    ffts.fft0 (out, toFrequency);
+    ffts.flip (out, False, False);
+    break;
+  }
+}
+template<class T, class S>
+static void fftLine (FFTServer<T,S>& ffts, Vector<S>& out, Vector<T>& in,
+		     Bool, LatticeFFTLineMode mode)
+{
+  switch (mode) {
+  case LineShift:
+    ffts.fft (out, in);
+    break;
+  case LineNoShift:
+    ffts.fft0 (out, in);
+    break;
+  case LineFlipBefore:
+    ffts.flip (in, True, False);
+    ffts.fft0 (out, in);
+    break;
+  case LineFlipAfter:
+    ffts.fft0 (out, in);
+    ffts.flip (out, False, False);
+    break;
+  }
+}
+template<class T, class S>
+static void fftLine (FFTServer<T,S>& ffts, Vector<T>& out, Vector<S>& in,
+		     Bool, LatticeFFTLineMode mode)
+{
+  switch (mode) {
+  case LineShift:
+    ffts.fft (out, in);
+    break;
+  case LineNoShift:
+    ffts.fft0 (out, in);
+    break;
+  case LineFlipBefore:
+    ffts.flip (in, True, False);
+    ffts.fft0 (out, in);
+    break;
+  case LineFlipAfter:
+    ffts.fft0 (out, in);
+    ffts.flip (out, False, False);
+    break;
+  }
+}
+// </group>
+
+// Transform all lines along axis <src>dim</src> of a slab.
+// The input and output slab only differ in length along that axis.
+// The lines are independent, so they are transformed in parallel
+// with an FFTServer per thread. Each line is copied into a contiguous
+// vector, because the lines along the higher axes are strided.
+// <src>in</src> and <src>out</src> can be the same complex array.
+template<class T, class S, class U, class V>
+static void fftSlabLines (Array<V>& out, const Array<U>& in, uInt dim,
+			  Bool toFrequency, LatticeFFTLineMode mode)
+{
+  const IPosition& inShape = in.shape();
+  const Int64 inLen  = inShape(dim);
+  const Int64 outLen = out.shape()(dim);
+  Int64 stride = 1;
+  for (uInt i=0; i<dim; i++) {
+    stride *= inShape(i);
+  }
+  const Int64 nlines = (inLen == 0  ?  0 : in.nelements() / inLen);
+  Bool deleteIn, deleteOut;
+  const U* inData = in.getStorage (deleteIn);
+  V* outData = out.getStorage (deleteOut);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    FFTServer<T,S> ffts;
+    Vector<U> inLine (inLen);
+    Vector<V> outLine (outLen);
+    U* inPtr  = inLine.data();
+    V* outPtr = outLine.data();
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,16)
+#endif
+    for (Int64 line=0; line<nlines; line++) {
+      const Int64 offset = (line / stride) * stride;
+      const U* from = inData + offset*inLen + line%stride;
+      V* to = outData + offset*outLen + line%stride;
+      for (Int64 i=0; i<inLen; i++) {
+	inPtr[i] = from[i*stride];
+      }
+      fftLine (ffts, outLine, inLine, toFrequency, mode);
+      for (Int64 i=0; i<outLen; i++) {
+	to[i*stride] = outPtr[i];
+      }
+    }
+  }
+  in.freeStorage (inData, deleteIn);
+  out.putStorage (outData, deleteOut);
+}
+
+// Transform the lines along axis <src>dim</src> of a complex lattice
+// in place. The lattice is traversed in slabs of full lines.
+template<class T, class S>
+static void fftLatticeLines (Lattice<S>& lattice, uInt dim,
+			     Bool toFrequency, LatticeFFTLineMode mode)
+{
+  const IPosition latticeShape = lattice.shape();
+  const IPosition slabShape = fftSlabShape (latticeShape,
+					    lattice.niceCursorShape(),
+					    dim, sizeof(S));
+  LatticeIterator<S> iter(lattice, LatticeStepper(latticeShape, slabShape,
+						  LatticeStepper::RESIZE));
+  for (iter.reset(); !iter.atEnd(); iter++) {
+    Array<S>& slab = iter.rwCursor();
+    fftSlabLines<T,S> (slab, slab, dim, toFrequency, mode);
+  }
+}
+
+// Transform the lines along axis <src>dim</src> of a real lattice into
+// a complex lattice or vice versa. The lattices only differ in length
+// along that axis; the slabs follow the tiling of the complex lattice.
+template<class T, class S, class U, class V>
+static void fftLatticeLinesTo (Lattice<V>& out, const Lattice<U>& in,
+			       const IPosition& tileShape, uInt dim,
+			       LatticeFFTLineMode mode)
+{
+  const IPosition inShape = in.shape();
+  const IPosition outShape = out.shape();
+  const IPosition inSlab = fftSlabShape (inShape, tileShape, dim,
+					 sizeof(T) + sizeof(S));
+  IPosition outSlab (inSlab);
+  outSlab(dim) = outShape(dim);
+  RO_LatticeIterator<U> inIter(in, LatticeStepper(inShape, inSlab,
+						  LatticeStepper::RESIZE));
+  LatticeIterator<V> outIter(out, LatticeStepper(outShape, outSlab,
+						 LatticeStepper::RESIZE));
+  for (inIter.reset(), outIter.reset();
+       !inIter.atEnd() && !outIter.atEnd(); inIter++, outIter++) {
+    fftSlabLines<T,S> (outIter.woCursor(), inIter.cursor(), dim, True, mode);
+  }
+}
+
 void LatticeFFT::cfft2d(Lattice<Complex>& cLattice, const Bool toFrequency) {
   const uInt ndim = cLattice.ndim();
   DebugAssert(ndim > 1, AipsError);
@@ -112,17 +317,9 @@ void LatticeFFT::cfft(Lattice<Complex>& cLattice,
   const uInt ndim = cLattice.ndim();
   DebugAssert(ndim > 0, AipsError);
   DebugAssert(ndim == whichAxes.nelements(), AipsError);
-  FFTServer<Float,Complex> ffts;
-  const IPosition latticeShape = cLattice.shape();
-  const IPosition tileShape = cLattice.niceCursorShape();
-
   for (uInt dim = 0; dim < ndim; dim++) {
     if (whichAxes(dim) == True) {
-      TiledLineStepper ts(latticeShape, tileShape, dim);
-      LatticeIterator<Complex> li(cLattice, ts);
-      for (li.reset(); !li.atEnd(); li++) {
-	ffts.fft(li.rwVectorCursor(), toFrequency);
-      }
+      fftLatticeLines<Float,Complex> (cLattice, dim, toFrequency, LineShift);
     }
   }
 }
@@ -132,17 +329,10 @@ void LatticeFFT::cfft0(Lattice<Complex>& cLattice,
   const uInt ndim = cLattice.ndim();
   DebugAssert(ndim > 0, AipsError);
   DebugAssert(ndim == whichAxes.nelements(), AipsError);
-  FFTServer<Float,Complex> ffts;
-  const IPosition latticeShape = cLattice.shape();
-  const IPosition tileShape = cLattice.niceCursorShape();
-
   for (uInt dim = 0; dim < ndim; dim++) {
     if (whichAxes(dim) == True) {
-      TiledLineStepper ts(latticeShape, tileShape, dim);
-      LatticeIterator<Complex> li(cLattice, ts);
-      for (li.reset(); !li.atEnd(); li++) {
-	ffts.fft0(li.rwVectorCursor(), toFrequency);
-      }
+      fftLatticeLines<Float,Complex> (cLattice, dim, toFrequency,
+				      LineNoShift);
     }
   }
 }
@@ -152,17 +342,10 @@ void LatticeFFT::cfft(Lattice<DComplex>& cLattice,
   const uInt ndim = cLattice.ndim();
   DebugAssert(ndim > 0, AipsError);
   DebugAssert(ndim == whichAxes.nelements(), AipsError);
-  FFTServer<Double,DComplex> ffts;
-  const IPosition latticeShape = cLattice.shape();
-  const IPosition tileShape = cLattice.niceCursorShape();
-
   for (uInt dim = 0; dim < ndim; dim++) {
     if (whichAxes(dim) == True) {
-      TiledLineStepper ts(latticeShape, tileShape, dim);
-      LatticeIterator<DComplex> li(cLattice, ts);
-      for (li.reset(); !li.atEnd(); li++) {
-	ffts.fft(li.rwVectorCursor(), toFrequency);
-      }
+      fftLatticeLines<Double,DComplex> (cLattice, dim, toFrequency,
+					LineShift);
     }
   }
 }
@@ -202,63 +385,24 @@ void LatticeFFT::rcfft(Lattice<Complex>& out, const Lattice<Float>& in,
 //     return;
 //   }
 
+  // The input lines are copied before being transformed,
+  // so the input lattice is not changed.
   const IPosition tileShape = out.niceCursorShape();
-  TempLattice<Float> inlocal(TiledShape(in.shape(), tileShape));
-  inlocal.put(in.get());
-  FFTServer<Float,Complex> ffts;
-
-    {
-      for (uInt dim = 0; dim < ndim; dim++) {
-	if (whichAxes(dim) == True) {
-	  if (dim == firstAxis) { 
-	    if (inShape(dim) != 1) { // Do real->complex Transforms
-	      LatticeIterator<Float> inIter(inlocal, 
-					       TiledLineStepper(inShape,
-								tileShape,dim));
-	      LatticeIterator<Complex> outIter(out,
-					       TiledLineStepper(outShape,
-								tileShape,dim));
-	      for (inIter.reset(), outIter.reset();
-		   !inIter.atEnd() && !outIter.atEnd(); inIter++, outIter++) {
-		if (doShift) {
-		  if(doFast){
-		    // ffts.flip(inIter.rwVectorCursor(), True, False);
-		    ffts.fft0(outIter.woVectorCursor(), inIter.vectorCursor());
-		  }
-		  else{
-		    ffts.fft(outIter.woVectorCursor(), inIter.vectorCursor());
-		  }
-		    
-		} else {
-		  ffts.fft0(outIter.woVectorCursor(), inIter.vectorCursor());
-		}
-	      }
-	    } else { // just copy the data
-	      out.copyData(LatticeExpr<Complex>(in));
-	    }
-	  }
-	  else { // Do complex->complex transforms
-	    if (inShape(dim) != 1) { 
-	      LatticeIterator<Complex> iter(out,
-					    TiledLineStepper(outShape,
-							     tileShape, dim));
-	      for (iter.reset(); !iter.atEnd(); iter++) {
-		if (doShift) {
-		  if(doFast){
-		    ffts.fft0(iter.rwVectorCursor(),True);
-		  }
-		  else{
-		    ffts.fft(iter.rwVectorCursor(),True);
-		  }
-		} else {
-		  ffts.fft0(iter.rwVectorCursor(), True);
-		}
-	      }
-	    }
-	  }
-	}
+  LatticeFFTLineMode mode = LineNoShift;
+  if (doShift  &&  !doFast) {
+    mode = LineShift;
+  }
+  for (uInt dim = 0; dim < ndim; dim++) {
+    if (whichAxes(dim) == True  &&  inShape(dim) != 1) {
+      if (dim == firstAxis) { // Do real->complex Transforms
+	fftLatticeLinesTo<Float,Complex> (out, in, tileShape, dim, mode);
+      } else { // Do complex->complex transforms
+	fftLatticeLines<Float,Complex> (out, dim, True, mode);
       }
+    } else if (dim == firstAxis) { // just copy the data
+      out.copyData(LatticeExpr<Complex>(in));
     }
+  }
 }
 //
 // ----------------MYRCFFT--------------------------------------
@@ -294,49 +438,18 @@ void LatticeFFT::myrcfft(Lattice<Complex>& out, const Lattice<Float>& in,
 //   }
 
   const IPosition tileShape = out.niceCursorShape();
-  FFTServer<Float,Complex> ffts;
-
-    {
-      for (uInt dim = 0; dim < ndim; dim++) {
-	if (whichAxes(dim) == True) {
-	  if (dim == firstAxis) { 
-	    if (inShape(dim) != 1) { // Do real->complex Transforms
-	      RO_LatticeIterator<Float> inIter(in, 
-					       TiledLineStepper(inShape,tileShape,dim));
-	      LatticeIterator<Complex> outIter(out,
-					       TiledLineStepper(outShape,tileShape,dim));
-	      for (inIter.reset(), outIter.reset();
-		   !inIter.atEnd() && !outIter.atEnd(); inIter++, outIter++) {
-		if (doShift) {
-		  //		  ffts.myfft(outIter.woVectorCursor(), inIter.vectorCursor());
-		  ffts.flip((Vector<Float> &)inIter.vectorCursor(),True,False);
-		  ffts.fft0(outIter.woVectorCursor(), inIter.vectorCursor());
-		} else {
-		  ffts.fft0(outIter.woVectorCursor(), inIter.vectorCursor());
-		}
-	      }
-	    } else { // just copy the data
-	      out.copyData(LatticeExpr<Complex>(in));
-	    }
-	  }
-	  else { // Do complex->complex transforms
-	    if (inShape(dim) != 1) { 
-	      LatticeIterator<Complex> iter(out,
-					    TiledLineStepper(outShape, tileShape, dim));
-	      for (iter.reset(); !iter.atEnd(); iter++) {
-		if (doShift) {
-		  //		  ffts.fft(iter.rwVectorCursor(), 1, True);
-		  ffts.flip(iter.rwVectorCursor(),True,False);
-		  ffts.fft0(iter.rwVectorCursor(),True);
-		} else {
-		  ffts.fft0(iter.rwVectorCursor(), True);
-		}
-	      }
-	    }
-	  }
-	}
+  const LatticeFFTLineMode mode = (doShift ? LineFlipBefore : LineNoShift);
+  for (uInt dim = 0; dim < ndim; dim++) {
+    if (whichAxes(dim) == True  &&  inShape(dim) != 1) {
+      if (dim == firstAxis) { // Do real->complex Transforms
+	fftLatticeLinesTo<Float,Complex> (out, in, tileShape, dim, mode);
+      } else { // Do complex->complex transforms
+	fftLatticeLines<Float,Complex> (out, dim, True, mode);
       }
+    } else if (dim == firstAxis) { // just copy the data
+      out.copyData(LatticeExpr<Complex>(in));
     }
+  }
 }
 //
 //-------------------------------------------------------------------------
@@ -379,53 +492,21 @@ void LatticeFFT::crfft(Lattice<Float>& out, Lattice<Complex>& in,
 //   }
 
   const IPosition tileShape = in.niceCursorShape();
-  FFTServer<Float,Complex> ffts;
-
+  LatticeFFTLineMode mode = LineNoShift;
+  if (doShift) {
+    mode = (doFast ? LineFlipAfter : LineShift);
+  }
   uInt dim = ndim;
   while (dim != 0) {
     dim--;
     if (whichAxes(dim) == True) {
       if (dim != firstAxis) { // Do complex->complex Transforms
 	if (inShape(dim) != 1) { // no need to do anything unless len > 1
-	  LatticeIterator<Complex> iter(in, TiledLineStepper(inShape,
-							     tileShape, dim));
-	  for (iter.reset(); !iter.atEnd(); iter++) {
-	    if (doShift) {
-	      if(doFast){
-		ffts.fft0(iter.rwVectorCursor(), False);
-		ffts.flip(iter.rwVectorCursor(), False, False);
-	      }
-	      else{
-	      //	      ffts.fft(iter.rwVectorCursor(), 2, False);
-	      ffts.fft(iter.rwVectorCursor(),False);
-
-	      }
-	    } else {
-	      ffts.fft0(iter.rwVectorCursor(), False);
-	    }
-	  }
+	  fftLatticeLines<Float,Complex> (in, dim, False, mode);
 	}
       } else { // the first axis is treated specially
 	if (inShape(dim) != 1) { // Do complex->real transforms
-	  RO_LatticeIterator<Complex> inIter(in, 
-					     TiledLineStepper(inShape,
-							      tileShape, dim));
-	  LatticeIterator<Float> outIter(out, 
-					 TiledLineStepper(outShape,
-							  tileShape, dim));
-	  for (inIter.reset(), outIter.reset(); 
-	       !inIter.atEnd() && !outIter.atEnd(); inIter++, outIter++) {
-	    if (doShift) {
-	      if(doFast){
-	       ffts.fft0(outIter.woVectorCursor(), inIter.vectorCursor());
-	       ffts.flip(outIter.rwVectorCursor(), False, False);
-	      }else{
-		ffts.fft(outIter.woVectorCursor(), inIter.vectorCursor());
-	      }
-	    } else {
-	      ffts.fft0(outIter.woVectorCursor(), inIter.vectorCursor());
-	    }
-	  }
+	  fftLatticeLinesTo<Float,Complex> (out, in, tileShape, dim, mode);
 	} else { // just copy the data truncating the imaginary parts.
 	  out.copyData(LatticeExpr<Float>(real(in)));
 	}
@@ -134,6 +134,21 @@ public:
 				    uInt smallSize = 4096*4096);
   // </group>
 
+  // Determine the values of the elements at an arbitrary number of
+  // fractiles. It gives the same results as calling
+  // <src>maskedFractile</src> for each fraction, but all fractiles are
+  // determined in the same passes over the data. So getting, for instance,
+  // the median and both quartiles takes about as long as getting
+  // the median only.
+  // <br>The fractions do not need to be in any particular order.
+  // <br>If the lattice is masked, only masked-on elements are taken
+  // into account.
+  // <br>Normally a vector with as many elements as fractions is returned.
+  // If the lattice has no masked-on elements, an empty vector is returned.
+  static Vector<T> maskedFractiles (const MaskedLattice<T>& lattice,
+				    const Vector<Float>& fractions,
+				    uInt smallSize = 4096*4096);
+
 private:
   // Determine the fractile for a small masked lattice.
   static Vector<T> smallMaskedFractile (const MaskedLattice<T>& lattice,
@@ -143,6 +158,10 @@ private:
   static Vector<T> smallMaskedFractiles (const MaskedLattice<T>& lattice,
 					 Float left, Float right);
 
+  // Determine multiple fractiles for a small masked lattice.
+  static Vector<T> smallMaskedFractiles (const MaskedLattice<T>& lattice,
+					 const Vector<Float>& fractions);
+
   // Calculate the first histogram (with 10000 bins).
   // Also calculate the minimum and maximum. It returns the number
   // of masked-on values. Masked-off values are ignored.
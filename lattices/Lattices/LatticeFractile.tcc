@@ -984,5 +984,263 @@ Vector<T> LatticeFractile<T>::smallMaskedFractiles
   return result;
 }
 
+
+template <class T>
+Vector<T> LatticeFractile<T>::maskedFractiles (const MaskedLattice<T>& lattice,
+					       const Vector<Float>& fractions,
+					       uInt smallSize)
+{
+  const uInt nfrac = fractions.nelements();
+  for (uInt k=0; k<nfrac; k++) {
+    AlwaysAssert (fractions(k) >= 0  &&  fractions(k) <= 1, AipsError);
+  }
+  if (nfrac == 0) {
+    return Vector<T>();
+  }
+  // Determine the number of elements in the lattice.
+  // If small enough, we read them all and do it in memory.
+  uInt ntodo = lattice.shape().product();
+  if (ntodo == 0) {
+    return Vector<T>();
+  }
+  if (ntodo <= smallSize) {
+    return smallMaskedFractiles (lattice, fractions);
+  }
+  // Bad luck. We have to do some more work.
+  // Do a first binning while determining min/max at the same time.
+  // Make the block 1 element larger, because possible roundoff errors
+  // could result in a binnr just beyond the end.
+  const Bool isMasked = lattice.isMasked();
+  const uInt nbins = 10000;
+  Block<uInt> hist(nbins+1, 0u);
+  Block<T> boundaries(nbins+1);
+  T stv, endv, minv, maxv;
+  if (isMasked) {
+    ntodo = maskedHistogram (stv, endv, minv, maxv, hist, boundaries,
+			     lattice);
+    if (ntodo == 0) {
+      return Vector<T>();
+    }
+  } else {
+    unmaskedHistogram (stv, endv, minv, maxv, hist, boundaries, lattice);
+  }
+  // Initialize the variables of all fractiles from the first histogram.
+  // Each fractile gets its own histogram, because in general they end up
+  // in different bins.
+  Vector<T> result(nfrac);
+  Block<uInt> fractileInx(nfrac);
+  Block<uInt> nleft(nfrac);
+  Block<Bool> finished(nfrac, False);
+  Block<T> stvs(nfrac, stv);
+  Block<T> endvs(nfrac, endv);
+  Block<T> minvs(nfrac, minv);
+  Block<T> maxvs(nfrac, maxv);
+  Block<T> steps(nfrac);
+  Block<Block<uInt> > hists(nfrac, hist);
+  Block<Block<T> > bounds(nfrac, boundaries);
+  for (uInt k=0; k<nfrac; k++) {
+    fractileInx[k] = uInt (fractions(k) * (ntodo-1));
+  }
+  // Iterate until the bins containing the fractiles do not
+  // contain too many values anymore.
+  // The histograms of all unfinished fractiles are made in the same pass.
+  COWPtr<Array<Bool> > mask;
+  RO_MaskedLatticeIterator<T> iter(lattice);
+  while (True) {
+    uInt ntotal = 0;
+    for (uInt k=0; k<nfrac; k++) {
+      if (!finished[k]) {
+	nleft[k] = findBin (fractileInx[k], stvs[k], endvs[k],
+			    minvs[k], maxvs[k], hists[k], bounds[k]);
+	if (nleft[k] <= smallSize) {
+	  finished[k] = True;
+	  if (nleft[k] == 0) {
+	    result(k) = endvs[k];
+	  }
+	} else {
+	  ntotal += nleft[k];
+	}
+      }
+    }
+    if (ntotal == 0) {
+      break;
+    }
+    // Build new histograms with determined subsets.
+    for (uInt k=0; k<nfrac; k++) {
+      if (!finished[k]) {
+	minvs[k] = endvs[k];
+	maxvs[k] = stvs[k];
+	hists[k] = 0u;
+	steps[k] = (endvs[k] - stvs[k]) / nbins;
+	for (uInt i=0; i<=nbins; i++) {
+	  bounds[k][i] = stvs[k] + i*steps[k];
+	}
+      }
+    }
+    uInt ndone = 0;
+    iter.reset();
+    while (! iter.atEnd()  &&  ndone<ntotal) {
+      Bool delData, delMask;
+      const Array<T>& array = iter.cursor();
+      const Bool* maskPtr = 0;
+      if (isMasked) {
+	iter.getMask (mask);
+	maskPtr = mask->getStorage (delMask);
+      }
+      const T* dataPtr = array.getStorage (delData);
+      uInt n = array.nelements();
+      for (uInt i=0; i<n; i++) {
+	if (maskPtr == 0  ||  maskPtr[i]) {
+	  const T value = dataPtr[i];
+	  for (uInt k=0; k<nfrac; k++) {
+	    if (!finished[k]  &&  value >= stvs[k]  &&  value < endvs[k]) {
+	      Int bin = Int((value - stvs[k]) / steps[k]);
+	      // Due to rounding the bin number might get one too low or high.
+	      if (value < bounds[k][bin]) {
+		bin--;
+	      } else if (value >= bounds[k][bin+1]) {
+		bin++;
+	      }
+	      hists[k][bin]++;
+	      if (value < minvs[k]) {
+		minvs[k] = value;
+	      }
+	      if (value > maxvs[k]) {
+		maxvs[k] = value;
+	      }
+	      ndone++;
+	    }
+	  }
+	}
+      }
+      array.freeStorage (dataPtr, delData);
+      if (isMasked) {
+	mask->freeStorage (maskPtr, delMask);
+      }
+      iter++;
+    }
+    // In principle the last bins should be empty, but roundoff errors
+    // might have put a few in there. So add them to previous one.
+    for (uInt k=0; k<nfrac; k++) {
+      if (!finished[k]) {
+	hists[k][nbins-1] += hists[k][nbins];
+      }
+    }
+  }
+  // There are only a 'few' points left in the histograms.
+  // So read them all in (in a single pass) and determine the Inx'th-largest.
+  // Again, due to rounding we might find a few elements more or less.
+  uInt ntotal = 0;
+  Block<Block<T> > tmp(nfrac);
+  Block<uInt> ndone(nfrac, 0u);
+  for (uInt k=0; k<nfrac; k++) {
+    tmp[k].resize (nleft[k]);
+    ntotal += nleft[k];
+  }
+  if (ntotal == 0) {
+    return result;
+  }
+  uInt nfound = 0;
+  iter.reset();
+  while (! iter.atEnd()  &&  nfound<ntotal) {
+    Bool delData, delMask;
+    const Array<T>& array = iter.cursor();
+    const Bool* maskPtr = 0;
+    if (isMasked) {
+      iter.getMask (mask);
+      maskPtr = mask->getStorage (delMask);
+    }
+    const T* dataPtr = array.getStorage (delData);
+    uInt n = array.nelements();
+    for (uInt i=0; i<n; i++) {
+      if (maskPtr == 0  ||  maskPtr[i]) {
+	const T value = dataPtr[i];
+	for (uInt k=0; k<nfrac; k++) {
+	  if (ndone[k] < nleft[k]  &&  value >= stvs[k]  &&  value < endvs[k]) {
+	    tmp[k][ndone[k]++] = value;
+	    nfound++;
+	  }
+	}
+      }
+    }
+    array.freeStorage (dataPtr, delData);
+    if (isMasked) {
+      mask->freeStorage (maskPtr, delMask);
+    }
+    iter++;
+  }
+  // By rounding it is possible that not enough elements were found.
+  // In that case return the end or middle of the (very small) interval
+  // like maskedFractiles and unmaskedFractile do.
+  for (uInt k=0; k<nfrac; k++) {
+    if (nleft[k] > 0) {
+      if (fractileInx[k] >= ndone[k]) {
+	result(k) = (isMasked  ?  endvs[k] : (stvs[k]+endvs[k])/2);
+      } else {
+	result(k) = GenSort<T>::kthLargest (tmp[k].storage(), ndone[k],
+					    fractileInx[k]);
+      }
+    }
+  }
+  return result;
+}
+
+
+template <class T>
+Vector<T> LatticeFractile<T>::smallMaskedFractiles
+                                       (const MaskedLattice<T>& lattice,
+					const Vector<Float>& fractions)
+{
+  // Make a buffer to hold all masked-on elements.
+  uInt size = lattice.shape().product();
+  Block<T> buffer(size);
+  uInt npts = 0;
+  // Iterate through the lattice and assemble all masked-on elements.
+  const Bool isMasked = lattice.isMasked();
+  COWPtr<Array<Bool> > mask;
+  RO_MaskedLatticeIterator<T> iter(lattice);
+  while (! iter.atEnd()) {
+    Bool delData, delMask;
+    const Array<T>& array = iter.cursor();
+    const T* dataPtr = array.getStorage (delData);
+    uInt n = array.nelements();
+    if (isMasked) {
+      iter.getMask (mask);
+      const Bool* maskPtr = mask->getStorage (delMask);
+      for (uInt i=0; i<n; i++) {
+	if (maskPtr[i]) {
+	  buffer[npts++] = dataPtr[i];
+	}
+      }
+      mask->freeStorage (maskPtr, delMask);
+    } else {
+      objcopy (buffer.storage() + npts, dataPtr, n);
+      npts += n;
+    }
+    array.freeStorage (dataPtr, delData);
+    iter++;
+  }
+  if (npts == 0) {
+    return Vector<T>();
+  }
+  // Determine the values in the same way as smallMaskedFractile and
+  // unmaskedFractile do, so the results are the same.
+  // kthLargest only reorders the buffer, so it can be used repeatedly.
+  Array<T> values (IPosition(1,npts), buffer.storage(), SHARE);
+  Vector<T> result(fractions.nelements());
+  for (uInt k=0; k<fractions.nelements(); k++) {
+    if (fractions(k) == 0.5) {
+      result(k) = median (values);
+    } else if (! isMasked) {
+      result(k) = fractile (values, fractions(k));
+    } else {
+      uInt fractileInx = uInt (fractions(k) * (npts-1));
+      result(k) = GenSort<T>::kthLargest (buffer.storage(), npts,
+					  fractileInx);
+    }
+  }
+  return result;
+}
+
 } //# NAMESPACE CASA - END
 
@@ -488,12 +488,31 @@ public:
 // Can handle null mask
    virtual Bool canHandleNullMask() const {return True;};
 
+// Make a copy of this collapser, so the tiles can be processed in parallel.
+// The copy has its own histograms.
+   virtual TiledCollapser<T,T>* clone() const;
+
+// Add the histograms of another collapser to the histograms of this one.
+   virtual void mergeAccumulator (const TiledCollapser<T,T>& other);
+
 private:
+// Get the data range and bin width for the given accumulator from the
+// statistics object.
+    void getClip (uInt index, const IPosition& startPos);
+
     LatticeStatistics<T>* pStats_p;
     Block<T>* pHist_p;
     uInt nBins_p;
     uInt n1_p;
     uInt n3_p;
+// The data range and bin width of each accumulator. They are fetched
+// from the statistics object when the accumulator is first used.
+// clipState_p tells if unknown yet (0), valid (1) or without points (2).
+    Block<T> clipMin_p;
+    Block<T> clipMax_p;
+    Block<T> binWidth_p;
+    Block<uChar> clipState_p;
+    Vector<T> clip_p;
 };
  
 
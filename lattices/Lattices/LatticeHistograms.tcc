@@ -1241,11 +1241,24 @@ void LatticeHistograms<T>::setStream (ostream& os, Int oPrec)
 template <class T>
 HistTiledCollapser<T>::HistTiledCollapser(LatticeStatistics<T>* pStats, uInt nBins)
 : pStats_p(pStats),
-  nBins_p(nBins)
+  pHist_p(0),
+  nBins_p(nBins),
+  n1_p(0),
+  n3_p(0),
+  clip_p(2)
 {;}
    
 template <class T>
-HistTiledCollapser<T>::~HistTiledCollapser<T>() {}
+HistTiledCollapser<T>::~HistTiledCollapser<T>()
+{
+   delete pHist_p;
+}
+
+template <class T>
+TiledCollapser<T,T>* HistTiledCollapser<T>::clone() const
+{
+   return new HistTiledCollapser<T> (pStats_p, nBins_p);
+}
 
 template <class T>
 void HistTiledCollapser<T>::init (uInt nOutPixelsPerCollapse)
@@ -1259,11 +1272,61 @@ void HistTiledCollapser<T>::initAccumulator (uInt n1, uInt n3)
 // pHist_p contains the histograms for each chunk
 // It is T not uInt so we can handle Complex types
 {
+   delete pHist_p;
    pHist_p = new Block<T>(nBins_p*n1*n3);
    pHist_p->set(0);
 //          
    n1_p = n1;
    n3_p = n3;
+   clipMin_p.resize (n1*n3, False, False);
+   clipMax_p.resize (n1*n3, False, False);
+   binWidth_p.resize (n1*n3, False, False);
+   clipState_p.resize (n1*n3, False, False);
+   clipState_p.set (0);
+}
+
+
+template <class T>
+void HistTiledCollapser<T>::getClip (uInt index, const IPosition& startPos)
+{
+// Fish out the min and max for this chunk of the data 
+// from the statistics object.
+// The statistics object is not thread-safe, so only one thread at a time
+// can access it.
+
+   typedef typename NumericTraits<T>::PrecisionType AccumType; 
+   Vector<AccumType> stats;
+   String errMsg;
+#ifdef _OPENMP
+#pragma omp critical(HistTiledCollapser_getClip)
+#endif
+   {
+      try {
+         pStats_p->getStats(stats, startPos, True);
+      } catch (std::exception& x) {
+         errMsg = x.what();
+      }
+   }
+   if (! errMsg.empty()) {
+      throw AipsError (errMsg);
+   }
+
+// Without points nothing can be added to the histogram.
+
+   if (stats.nelements() == 0) {
+      clipState_p[index] = 2;
+      return;
+   }
+
+// Assignment from AccumType to T ok (e.g. Double to FLoat)
+// Set histogram bin width
+
+   clipMin_p[index] = stats(LatticeStatsBase::MIN);
+   clipMax_p[index] = stats(LatticeStatsBase::MAX);
+   binWidth_p[index] = LatticeHistSpecialize::setBinWidth(clipMin_p[index],
+                                                          clipMax_p[index],
+                                                          nBins_p);
+   clipState_p[index] = 1;
 }
 
 
@@ -1278,35 +1341,47 @@ void HistTiledCollapser<T>::process (
 // chunk belongs in one output location in the accumulation
 // lattices
 //
+// The data range is the same for all chunks of an accumulator, so it
+// is only fetched from the statistics object the first time.
 
-// Fish out the min and max for this chunk of the data 
-// from the statistics object
-
-   typedef typename NumericTraits<T>::PrecisionType AccumType; 
-   Vector<AccumType> stats;
-   pStats_p->getStats(stats, startPos, True);
-
-// Assignment from AccumType to T ok (e.g. Double to FLoat)
-
-   Vector<T> clip(2);
-   clip(0) = stats(LatticeStatsBase::MIN);
-   clip(1) = stats(LatticeStatsBase::MAX);
-
-// Set histogram bin width
-   
-   const T binWidth = LatticeHistSpecialize::setBinWidth(clip(0), clip(1), nBins_p);
+   const uInt index = index1 + index3*n1_p;
+   if (clipState_p[index] == 0) {
+      getClip (index, startPos);
+   }
+   if (clipState_p[index] != 1) {
+      return;
+   }
+   clip_p(0) = clipMin_p[index];
+   clip_p(1) = clipMax_p[index];
 
 // Fill histograms.  
 
    uInt offset = (nBins_p*index1) + (nBins_p*n1_p*index3);
    LatticeHistSpecialize::process(
-		   pInData, pInMask, pHist_p, clip,
-		   binWidth, offset, nrval,
+		   pInData, pInMask, pHist_p, clip_p,
+		   binWidth_p[index], offset, nrval,
 		   nBins_p, dataIncr, maskIncr
    );
 }
 
 
+template <class T>
+void HistTiledCollapser<T>::mergeAccumulator (const TiledCollapser<T,T>& other)
+{
+// The counts are whole numbers, so adding them is exact.
+
+   const HistTiledCollapser<T>& that =
+                          dynamic_cast<const HistTiledCollapser<T>&>(other);
+   AlwaysAssert (that.n1_p == n1_p  &&  that.n3_p == n3_p, AipsError);
+   T* hist = pHist_p->storage();
+   const T* hist2 = that.pHist_p->storage();
+   const uInt n = pHist_p->nelements();
+   for (uInt i=0; i<n; i++) {
+      hist[i] += hist2[i];
+   }
+}
+
+
 
 template <class T>
 void HistTiledCollapser<T>::endAccumulator(Array<T>& result,
@@ -1338,6 +1413,7 @@ void HistTiledCollapser<T>::endAccumulator(Array<T>& result,
     
     result.putStorage (res, deleteRes);
     delete pHist_p;
+    pHist_p = 0;
 }      
 
 } //# NAMESPACE CASA - END
@@ -29,6 +29,7 @@
 #include <lattices/Lattices/LatticeSlice1D.h>
 
 #include <casa/Arrays/Array.h>
+#include <casa/Arrays/ArrayMath.h>
 #include <casa/Arrays/Matrix.h>
 #include <casa/Arrays/Vector.h>
 #include <lattices/Lattices/MaskedLattice.h>
@@ -277,13 +278,10 @@ void LatticeSlice1D<T>::doGetSlice (Vector<T>& data, Vector<Bool>& mask,
 // Interpolate
 
    const uInt nPts = itsX.nelements();
-   data.resize(nPts);
-   mask.resize(nPts);
-   for (uInt i=0; i<nPts; i++) {
-      itsPos[0] = itsX[i];
-      itsPos[1] = itsY[i];
-      mask[i] = itsInterpPtr->interp (data[i], itsPos, dataIn, maskIn);
-   }
+   Vector<Double> x(nPts), y(nPts);
+   convertArray (x, itsX);
+   convertArray (y, itsY);
+   itsInterpPtr->interp (data, mask, x, y, dataIn, maskIn);
 }
 
 
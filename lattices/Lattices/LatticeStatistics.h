@@ -637,6 +637,9 @@ public:
     StatsTiledCollapser(const Vector<T>& pixelRange, Bool noInclude, 
                         Bool noExclude, Bool fixedMinMax);
 
+// Destructor
+    virtual ~StatsTiledCollapser();
+
 // Initialize process, making some checks
     virtual void init (uInt nOutPixelsPerCollapse);
 
@@ -660,12 +663,24 @@ public:
 // Can handle null mask
    virtual Bool canHandleNullMask() const {return True;};
 
+// Make a copy of this collapser, so the tiles can be processed in parallel.
+// The copy has its own accumulator.
+   virtual TiledCollapser<T,U>* clone() const;
+
+// Merge the accumulator of another collapser into this one.
+// The location of the minimum and maximum are updated if they
+// are taken from <src>other</src>.
+   virtual void mergeAccumulator (const TiledCollapser<T,U>& other);
+
 // Find the location of the minimum and maximum data values
 // in the input lattice.
    void minMaxPos(IPosition& minPos, IPosition& maxPos);
 
 
 private:
+// Delete the accumulators.
+    void deleteAccumulator();
+
     Vector<T> range_p;
     Bool noInclude_p, noExclude_p, fixedMinMax_p;
     IPosition minPos_p, maxPos_p;
@@ -892,16 +892,10 @@ void LatticeStatistics<T>::generateRobust ()
          Slicer slicer(stepper.position(), stepper.endPosition(), Slicer::endIsLast);
          SubLattice<T> subLat(*pInLattice_p, slicer);
 
-// Get robust statistics with LEL (which takes masked values into account)
+// Get robust statistics (which takes masked values into account)
 
-         LatticeExprNode node(median(subLat));
-         T dummy = 0;
-
-         T lelMed = LattStatsSpecialize::getNodeScalarValue(node, dummy);
-         LatticeExprNode node2(median(abs((subLat)-lelMed)));
-         T lelMed2 = LattStatsSpecialize::getNodeScalarValue(node2, dummy);
-	 LatticeExprNode nodeIQR(fractileRange(subLat, .25, .75));
-	 T iqr = LattStatsSpecialize::getNodeScalarValue(nodeIQR, dummy);
+         T lelMed, lelMed2, iqr;
+         LattStatsSpecialize::getRobustStats (lelMed, lelMed2, iqr, subLat);
 
 // Whack results into storage lattice
 
@@ -3120,9 +3114,56 @@ StatsTiledCollapser<T,U>::StatsTiledCollapser(const Vector<T>& pixelRange,
   noExclude_p(noExclude),
   fixedMinMax_p(fixedMinMax),
   minPos_p(0),
-  maxPos_p(0)
+  maxPos_p(0),
+  pSum_p(0),
+  pSumSq_p(0),
+  pNPts_p(0),
+  pMean_p(0),
+  pVariance_p(0),
+  pNVariance_p(0),
+  pMin_p(0),
+  pMax_p(0),
+  pInitMinMax_p(0),
+  n1_p(0),
+  n3_p(0)
 {;}
 
+template <class T, class U>
+StatsTiledCollapser<T,U>::~StatsTiledCollapser()
+{
+   deleteAccumulator();
+}
+
+template <class T, class U>
+TiledCollapser<T,U>* StatsTiledCollapser<T,U>::clone() const
+{
+   return new StatsTiledCollapser<T,U> (range_p, noInclude_p, noExclude_p,
+                                        fixedMinMax_p);
+}
+
+template <class T, class U>
+void StatsTiledCollapser<T,U>::deleteAccumulator()
+{
+   delete pSum_p;
+   delete pSumSq_p;
+   delete pNPts_p;
+   delete pMin_p;
+   delete pMax_p;
+   delete pInitMinMax_p;
+   delete pMean_p;
+   delete pVariance_p;
+   delete pNVariance_p;
+   pSum_p = 0;
+   pSumSq_p = 0;
+   pNPts_p = 0;
+   pMin_p = 0;
+   pMax_p = 0;
+   pInitMinMax_p = 0;
+   pMean_p = 0;
+   pVariance_p = 0;
+   pNVariance_p = 0;
+}
+
 
 template <class T, class U>
 void StatsTiledCollapser<T,U>::init (uInt nOutPixelsPerCollapse)
@@ -3133,6 +3174,7 @@ void StatsTiledCollapser<T,U>::init (uInt nOutPixelsPerCollapse)
 template <class T, class U>
 void StatsTiledCollapser<T,U>::initAccumulator (uInt n1, uInt n3)
 {
+   deleteAccumulator();
    pSum_p = new Block<U>(n1*n3);
    pSumSq_p = new Block<U>(n1*n3);
    pNPts_p = new Block<U>(n1*n3);
@@ -3393,20 +3435,44 @@ void StatsTiledCollapser<T,U>::endAccumulator(Array<U>& result,
        resptr_root += n1_p * Int(LatticeStatsBase::NACCUM);
     }
 
-    delete pSum_p;
-    delete pSumSq_p;
-    delete pNPts_p;
-    delete pMin_p;
-    delete pMax_p;
-    delete pInitMinMax_p;
-    delete pMean_p;
-    delete pVariance_p;
-    delete pNVariance_p;
+    deleteAccumulator();
 
     result.putStorage (res, deleteRes);
 }
 
 
+template <class T, class U>
+void StatsTiledCollapser<T,U>::mergeAccumulator
+                                     (const TiledCollapser<T,U>& other)
+{
+    const StatsTiledCollapser<T,U>& that =
+                       dynamic_cast<const StatsTiledCollapser<T,U>&>(other);
+    AlwaysAssert (that.n1_p == n1_p  &&  that.n3_p == n3_p, AipsError);
+    Bool minTaken, maxTaken;
+    const uInt n = n1_p * n3_p;
+    for (uInt i=0; i<n; i++) {
+       LattStatsSpecialize::merge ((*pNPts_p)[i], (*pSum_p)[i],
+                                   (*pMean_p)[i], (*pNVariance_p)[i],
+                                   (*pVariance_p)[i], (*pSumSq_p)[i],
+                                   (*pMin_p)[i], (*pMax_p)[i],
+                                   (*pInitMinMax_p)[i], minTaken, maxTaken,
+                                   (*that.pNPts_p)[i], (*that.pSum_p)[i],
+                                   (*that.pMean_p)[i], (*that.pNVariance_p)[i],
+                                   (*that.pSumSq_p)[i],
+                                   (*that.pMin_p)[i], (*that.pMax_p)[i],
+                                   (*that.pInitMinMax_p)[i]);
+       if (minTaken) {
+          minPos_p.resize (that.minPos_p.nelements());
+          minPos_p = that.minPos_p;
+       }
+       if (maxTaken) {
+          maxPos_p.resize (that.maxPos_p.nelements());
+          maxPos_p = that.maxPos_p;
+       }
+    }
+}
+
+
 template <class T, class U>
 void StatsTiledCollapser<T,U>::minMaxPos(IPosition& minPos, IPosition& maxPos)
 {
@@ -0,0 +1,83 @@
+//# LatticeUtilities.cc: non-templated functions for LatticeUtilities
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <lattices/Lattices/LatticeUtilities.h>
+#include <casa/Arrays/IPosition.h>
+#include <casa/Exceptions/Error.h>
+#include <algorithm>
+
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+IPosition LatticeUtilities::retileBlockShape (const IPosition& shape,
+                                              const IPosition& inTileShape,
+                                              const IPosition& outTileShape,
+                                              uInt64 maxPixels)
+{
+   const uInt ndim = shape.nelements();
+   if (inTileShape.nelements() != ndim  ||  outTileShape.nelements() != ndim) {
+      throw AipsError ("LatticeUtilities::retileBlockShape - "
+                       "tile shapes do not match the lattice shape");
+   }
+// A block is the least common multiple of the input and output tiles,
+// so it contains whole tiles of both.
+   IPosition outTile(ndim);
+   IPosition block(ndim);
+   for (uInt i=0; i<ndim; i++) {
+      Int64 a = std::max<Int64> (1, std::min (inTileShape(i), shape(i)));
+      Int64 b = std::max<Int64> (1, std::min (outTileShape(i), shape(i)));
+      outTile(i) = b;
+      Int64 x = a;
+      Int64 y = b;
+      while (y != 0) {
+         Int64 t = x % y;
+         x = y;
+         y = t;
+      }
+      block(i) = std::min<Int64> (a / x * b, shape(i));
+   }
+// Halve the block (in units of output tiles) along the axis with most
+// output tiles until it fits.
+   while (uInt64(block.product()) > maxPixels) {
+      Int axis = -1;
+      Int64 maxTiles = 1;
+      for (uInt i=0; i<ndim; i++) {
+         Int64 ntiles = (block(i) + outTile(i) - 1) / outTile(i);
+         if (ntiles > maxTiles) {
+            maxTiles = ntiles;
+            axis = i;
+         }
+      }
+      if (axis < 0) {
+         break;
+      }
+      block(axis) = outTile(axis) * ((maxTiles + 1) / 2);
+   }
+   return block;
+}
+
+} //# NAMESPACE CASA - END
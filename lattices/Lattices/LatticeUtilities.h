@@ -101,6 +101,25 @@ class LatticeUtilities
    static void copyDataAndMask (LogIO& os, MaskedLattice<T>& out,
                                 const MaskedLattice<T>& in, Bool zeroMasked=False);
 
+// Copy the pixels of a lattice to a lattice with another tiling, for
+// example to make a spectrum-optimised copy of a plane-optimised cube.
+// The tile shapes are taken from <src>niceCursorShape()</src>.
+// The copy steps through blocks spanning a whole number of input and
+// output tiles, so each tile is read and written once. If such a block
+// does not fit in <src>maxMemoryInMB</src> (default 1/4 of the free
+// memory), it is reduced, but kept a whole number of output tiles.
+// Input tiles may then be read more than once.
+   template <class T>
+   static void copyRetiled (Lattice<T>& out, const Lattice<T>& in,
+                            Int maxMemoryInMB=-1);
+
+// Get the block shape used by <src>copyRetiled</src> for the given
+// lattice shape, tile shapes and maximum number of pixels in a block.
+   static IPosition retileBlockShape (const IPosition& shape,
+                                      const IPosition& inTileShape,
+                                      const IPosition& outTileShape,
+                                      uInt64 maxPixels);
+
 // Replicate array through lattice in the specified region.
 // The shape of <src>pixels</src> has to fit exactly into the shape of
 // the selected region for each axis of <src>pixels</src>. Otherwise
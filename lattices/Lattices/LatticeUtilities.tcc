@@ -43,10 +43,12 @@
 #include <lattices/Lattices/TempLattice.h>
 #include <lattices/Lattices/RebinLattice.h>
 #include <casa/Logging/LogIO.h>
+#include <casa/OS/HostInfo.h>
 #include <casa/BasicMath/Math.h>
 #include <casa/Exceptions/Error.h>
 #include <casa/Utilities/Assert.h>
 #include <casa/iostream.h>
+#include <algorithm>
 
 namespace casa {  //# namespace casa begin
 
@@ -166,6 +168,36 @@ void LatticeUtilities::collapse(
  }
 
 
+template <class T>
+void LatticeUtilities::copyRetiled (Lattice<T>& out, const Lattice<T>& in,
+                                    Int maxMemoryInMB)
+{
+   const IPosition shape = in.shape();
+   if (! out.shape().isEqual (shape)) {
+      throw AipsError ("LatticeUtilities::copyRetiled - input shape " +
+                       shape.toString() + " differs from output shape " +
+                       out.shape().toString());
+   }
+   uInt64 maxBytes;
+   if (maxMemoryInMB > 0) {
+      maxBytes = uInt64(maxMemoryInMB) * 1024 * 1024;
+   } else {
+// memoryFree is in kBytes.
+      maxBytes = uInt64(std::max (ptrdiff_t(1024), HostInfo::memoryFree())) * 1024 / 4;
+   }
+   const IPosition block = retileBlockShape (shape, in.niceCursorShape(),
+                                             out.niceCursorShape(),
+                                             std::max (uInt64(1), maxBytes/sizeof(T)));
+   LatticeStepper stepper (shape, block, LatticeStepper::RESIZE);
+   Array<T> buffer;
+   for (stepper.reset(); !stepper.atEnd(); stepper++) {
+      Slicer section (stepper.position(), stepper.endPosition(),
+                      Slicer::endIsLast);
+      in.getSlice (buffer, section);
+      out.putSlice (buffer, stepper.position());
+   }
+}
+
 template <class T>
 void LatticeUtilities::copyDataAndMask(LogIO& os, MaskedLattice<T>& out,
                                        const MaskedLattice<T>& in, 
@@ -134,6 +134,15 @@ public:
 			       const Vector<T>& line,
 			       const Vector<Bool>& mask,
 			       const IPosition& pos) = 0;
+
+// Make a copy of this collapser (after <src>init</src> has been called).
+// Each line is collapsed independently, so if a derived class implements
+// this function, <src>LatticeApply</src> can give each thread its own
+// copy and collapse the lines of a chunk in parallel.
+// The caller takes over the returned pointer.
+// <br>The default implementation returns a null pointer, which means
+// that the lines are collapsed sequentially.
+    virtual LineCollapser<T,U>* clone() const;
 };
 
 
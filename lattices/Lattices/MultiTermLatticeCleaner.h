@@ -122,7 +122,6 @@ private:
   
   // Image mask
   TempLattice<Float>* dirty_p;
-  TempLattice<Complex>* dirtyFT_p;
   TempLattice<Float>* mask_p;
   TempLattice<Float>* fftmask_p;
   
@@ -136,6 +135,8 @@ private:
   IPosition gip,imshape;
   Int nx,ny,npol_p,nchan;
   Bool donePSF_p,donePSP_p,doneCONV_p;
+  // Which PSF terms have been set. An unchanged PSF keeps doneCONV_p.
+  Vector<Bool> psfValid_p;
  
   // h(s) [nx,ny,nscales]
   PtrBlock<TempLattice<Float>* > vecScales_p; 
@@ -154,15 +155,12 @@ private:
   // A_{smn} = B_{sm} * B{sn} [nx,ny,ntaylor,ntaylor,nscales,nscales]
   // A_{s1s2mn} = B_{s1m} * B{s2n} [nx,ny,ntaylor,ntaylor,nscales,nscales]
   PtrBlock<TempLattice<Float>* > cubeA_p; 
-  PtrBlock<LatticeIterator<Float>* > itercubeA_p;
   
   // R_{sk} = I_D * B_{sk} [nx,ny,ntaylor,nscales]
   PtrBlock<TempLattice<Float>* > matR_p; 
-  PtrBlock<LatticeIterator<Float>* > itermatR_p;
   
   // a_{sk} = Solution vectors. [nx,ny,ntaylor,nscales]
   PtrBlock<TempLattice<Float>* > matCoeffs_p; 
-  PtrBlock<LatticeIterator<Float>* > itermatCoeffs_p;
 
   // Memory to be allocated per TempLattice
   Double memoryMB_p;
@@ -172,12 +170,8 @@ private:
   PtrBlock<Matrix<Double>*> matA_p;    // 2D matrix to be inverted.
   PtrBlock<Matrix<Double>*> invMatA_p; // Inverse of matA_p;
 
-  // Scratch Lattices and iterators.
-  TempLattice<Complex>* cWork_p;
+  // Scratch Lattice.
   TempLattice<Float>* tWork_p;
-  LatticeIterator<Float>* itertWork_p;
-  
-  LatticeExprNode len_p;
 
   Float lambda_p;
   
@@ -193,6 +187,12 @@ private:
   Int computeFluxLimit(Float &fluxlimit, Float threshold);
   Int computeMatrixA();
   Int computeRHS();
+  // Inverse FFT of the planes of an array in memory. Unlike
+  // LatticeFFT::cfft2d it does not look at the free memory, so it can be
+  // used in several threads at once.
+  static void fftPlanes(Array<Complex>& work);
+  // Can the work lattices be accessed from several threads at once?
+  Bool latticesInMemory();
   Int solveMatrixEqn(Int scale);
   Int computePenaltyFunction(Int scale, Float &loopgain, Bool choosespec);
   Int updateSolution(IPosition globalmaxpos, Int maxscaleindex, Float loopgain);
@@ -200,6 +200,9 @@ private:
   
   Int IND2(Int taylor,Int scale);
   Int IND4(Int taylor1, Int taylor2, Int scale1, Int scale2);
+
+  // Number of pixels per thread in the per-pixel solve.
+  enum {solveBlockSize = 4096};
   
   Bool adbg;
 };
@@ -40,11 +40,13 @@
 #include <lattices/Lattices/LatticeNavigator.h> 
 #include <lattices/Lattices/LatticeIterator.h>
 #include <lattices/Lattices/TempLattice.h>
+#include <lattices/Lattices/ArrayLattice.h>
 #include <lattices/Lattices/LatticeFFT.h>
 #include <lattices/Lattices/LatticeExpr.h>
 #include <lattices/Lattices/SubLattice.h>
 #include <lattices/Lattices/LCBox.h>
 #include <casa/Arrays/Slicer.h>
+#include <casa/Containers/Block.h>
 #include <lattices/Lattices/LatticeExpr.h>
 #include <lattices/Lattices/LatticeExprNode.h>
 
@@ -67,6 +69,7 @@
 #include <casa/Arrays/ArrayMath.h>
 #include <casa/Arrays/Matrix.h>
 #include <scimath/Mathematics/MatrixMathLA.h>
+#include <scimath/Mathematics/FFTServer.h>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
@@ -173,9 +176,18 @@ Bool MultiTermLatticeCleaner<T>::setpsf(int order, Lattice<T> & psf)
 	AlwaysAssert((order>=(int)0 && order<(int)vecPsf_p.nelements()), AipsError);
 	if(order==0) AlwaysAssert(validatePsf(psf), AipsError);
 	//AlwaysAssert(psf, AipsError);
+	/* An unchanged PSF (e.g. in the next major cycle) keeps its FT and
+	   the cached Hessians and cross-convolutions of computeMatrixA(). */
+	if(psfValid_p[order] && psf.shape().isEqual(vecPsf_p[order]->shape()))
+	{
+		LatticeExprNode ndiff = ntrue(LatticeExprNode(psf) != LatticeExprNode(*vecPsf_p[order]));
+		if(ndiff.getDouble() == 0) return True;
+	}
 	vecPsf_p[order]->copyData(LatticeExpr<Float>(psf));
 	vecPsfFT_p[order]->copyData(LatticeExpr<Complex>(toComplex((*fftmask_p)*(*vecPsf_p[order]))));
 	LatticeFFT::cfft2d(*vecPsfFT_p[order], True);
+	psfValid_p[order] = True;
+	doneCONV_p = False;
 
   return True;
 }
@@ -420,7 +432,7 @@ template <class T>
 Int MultiTermLatticeCleaner<T>::numberOfTempLattices(Int nscales, Int ntaylor)
 {
   Int ntotal4d = (nscales*(nscales+1)/2) * (ntaylor*(ntaylor+1)/2);
-  return ntotal4d + 6 + 2 + (2+1)*nscales + (1+1)*ntaylor + 2*nscales*ntaylor;
+  return ntotal4d + 4 + 2 + (2+1)*nscales + (1+1)*ntaylor + 2*nscales*ntaylor;
 }
 
 /*************************************
@@ -476,20 +488,16 @@ Int MultiTermLatticeCleaner<T>::manageMemory(Bool direction)
 	if(direction)
 	{
 		dirty_p = new TempLattice<Float>(gip, memoryMB_p);
-		dirtyFT_p = new TempLattice<Complex>(gip, memoryMB_p);
 		mask_p = new TempLattice<Float>(gip, memoryMB_p);
 		fftmask_p = new TempLattice<Float>(gip, memoryMB_p);
 		// Temporary work-holder
-		cWork_p = new TempLattice<Complex>(gip,memoryMB_p);
 		tWork_p = new TempLattice<Float>(gip,memoryMB_p);
 	}
 	else
 	{
 		delete dirty_p;
-		delete dirtyFT_p;
 		delete fftmask_p;
 		delete mask_p;
-		delete cWork_p;
 		delete tWork_p;
 	}
 
@@ -520,6 +528,12 @@ Int MultiTermLatticeCleaner<T>::manageMemory(Bool direction)
 	// Psfs and Models
 	vecPsf_p.resize(psfntaylor_p);
 	vecPsfFT_p.resize(psfntaylor_p);
+	if(direction)
+	{
+		psfValid_p.resize(psfntaylor_p);
+		psfValid_p = False;
+		doneCONV_p = False;
+	}
 	for(Int i=0;i<psfntaylor_p;i++) 
 	{
 		if(direction)
@@ -556,66 +570,30 @@ Int MultiTermLatticeCleaner<T>::manageMemory(Bool direction)
 	//  matPsfConvScales_p.resize(ntaylor_p*nscales_p);
 	//  for(Int i=0;i<nscales_p*ntaylor_p;i++) matPsfConvScales_p = new TempLattice<Float>(gip,memoryMB_p);
 	
-	// Set up the latticeiterators also
-	IPosition shapeOut;
-	IPosition cursorShape;
-	
-	if(direction)
-	{
-		AlwaysAssert (tWork_p->isWritable(), AipsError);
-		shapeOut = IPosition(tWork_p->shape());
-		cursorShape = IPosition(tWork_p->niceCursorShape());
-	}
-	else
-	{
-		shapeOut = gip;
-		cursorShape = gip;
-	}
-	
-	LatticeStepper stepper(shapeOut, cursorShape, LatticeStepper::RESIZE);
-	
-	if(direction)itertWork_p = new LatticeIterator<Float>((*tWork_p), stepper);
-	else delete itertWork_p;
-	
 	// (Psf * Scales) * (Psf * Scales)
 	cubeA_p.resize(ntotal4d);
-	itercubeA_p.resize(ntotal4d);
 	for(Int i=0;i<ntotal4d;i++) 
 	{
-		if(direction) 
-		{
-			cubeA_p[i] = new TempLattice<Float>(gip,memoryMB_p);
-			itercubeA_p[i] = new LatticeIterator<Float>((*cubeA_p[i]),stepper);
-		}
-		else 
-		{
-			delete cubeA_p[i];
-			delete itercubeA_p[i];
-		}
+		if(direction) cubeA_p[i] = new TempLattice<Float>(gip,memoryMB_p);
+		else delete cubeA_p[i];
 	}
 	
 	// I_D * (Psf * Scales)
 	matR_p.resize(ntaylor_p*nscales_p);
-	itermatR_p.resize(ntaylor_p*nscales_p);
 	// Coefficients to be solved for.
 	matCoeffs_p.resize(ntaylor_p*nscales_p);
-	itermatCoeffs_p.resize(ntaylor_p*nscales_p);
 	
 	for(Int i=0;i<ntaylor_p*nscales_p;i++) 
 	{
 		if(direction)
 		{	
 			matR_p[i] = new TempLattice<Float>(gip,memoryMB_p);
-			itermatR_p[i] = new LatticeIterator<Float>((*matR_p[i]),stepper);
 			matCoeffs_p[i] = new TempLattice<Float>(gip,memoryMB_p);
-			itermatCoeffs_p[i] = new LatticeIterator<Float>((*matCoeffs_p[i]),stepper);
 		}
 		else
 		{
 			delete matR_p[i];
-			delete itermatR_p[i];
 			delete matCoeffs_p[i];
-			delete itermatCoeffs_p[i];
 		}
 	}
   
@@ -790,26 +768,59 @@ Int MultiTermLatticeCleaner<T>::computeMatrixA()
 	   
       // (PSF * scale) * (PSF * scale) -> cubeA_p [nx_p,ny_p,ntaylor,ntaylor,nscales]
       os << "Calculating PSF and Scale convolutions " << LogIO::POST;
+      Block<Array<Complex> > psfFT(psfntaylor_p);
+      Block<Array<Complex> > scaleFT(nscales_p);
+      for (Int taylor=0; taylor<psfntaylor_p; taylor++) vecPsfFT_p[taylor]->get(psfFT[taylor]);
+      for (Int scale=0; scale<nscales_p; scale++) vecScalesFT_p[scale]->get(scaleFT[scale]);
+
+      /* The convolutions are independent, so they are spread over the threads.
+         Each one is transformed in its own array; only writing the result
+         into the (possibly paged) lattice is serialized. */
+      Block<Int> todo;
+      Int nconv=0;
       for (Int taylor1=0; taylor1<ntaylor_p;taylor1++) 
       for (Int taylor2=0; taylor2<=taylor1;taylor2++) 
       for (Int scale1=0; scale1<nscales_p;scale1++) 
       for (Int scale2=0; scale2<=scale1;scale2++) 
       {
-	Int ttay1 = taylor1+taylor2;
-        if(adbg)
-	   os << "Calculating (PSF_"<< taylor1 << " * Scale_"<<scale1+1 << ") * (PSF_"<< taylor2<<" * Scale_"<<scale2+1<<")   using taylor "<< ttay1 << LogIO::POST;
-	
-	LatticeExpr<Complex> dpsExpr(((*vecPsfFT_p[ttay1]) *(*vecPsfFT_p[0]))*(*vecScalesFT_p[scale1])*(*vecScalesFT_p[scale2]));
-	cWork_p->copyData(dpsExpr);
-	LatticeFFT::cfft2d(*cWork_p, False);
-	AlwaysAssert(cubeA_p[IND4(taylor1,taylor2,scale1,scale2)], AipsError);
-	LatticeExpr<Float> realWork2(real(*cWork_p));
-	cubeA_p[IND4(taylor1,taylor2,scale1,scale2)]->copyData(realWork2);
-  
-	Float zmaxval=0.0; IPosition zmaxpos;
-	findMaxAbsLattice((*mask_p),(*cubeA_p[IND4(taylor1,taylor2,scale1,scale2)]),zmaxval,zmaxpos);
-	//if(adbg) os << "Max (result) : " << zmaxval << "  at " << zmaxpos << LogIO::POST;
-      }	  
+	todo.resize(4*(nconv+1));
+	todo[4*nconv]=taylor1; todo[4*nconv+1]=taylor2;
+	todo[4*nconv+2]=scale1; todo[4*nconv+3]=scale2;
+	nconv++;
+      }
+      Bool failed=False;
+      String errMsg;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (Int i=0; i<nconv; i++)
+      {
+	try
+	{
+	  Int taylor1=todo[4*i], taylor2=todo[4*i+1];
+	  Int scale1=todo[4*i+2], scale2=todo[4*i+3];
+	  Array<Complex> work(psfFT[taylor1+taylor2] * psfFT[0]);
+	  work *= scaleFT[scale1];
+	  work *= scaleFT[scale2];
+	  fftPlanes(work);
+	  Array<Float> realWork(real(work));
+#ifdef _OPENMP
+#pragma omp critical(MultiTermLatticeCleaner_put)
+#endif
+	  cubeA_p[IND4(taylor1,taylor2,scale1,scale2)]->put(realWork);
+	}
+	catch (std::exception& x)
+	{
+#ifdef _OPENMP
+#pragma omp critical(MultiTermLatticeCleaner_error)
+#endif
+	  {
+	    failed=True;
+	    errMsg=x.what();
+	  }
+	}
+      }
+      if(failed) throw AipsError("MultiTermLatticeCleaner::computeMatrixA - " + errMsg);
 
       // Construct A, invA for each scale.
       
@@ -915,24 +926,58 @@ Int MultiTermLatticeCleaner<T>::computeRHS()
 	
 	/* I_D * (PSF * scale) -> matR_p [nx_p,ny_p,ntaylor,nscales] */
 	os << "Calculating convolutions of dirty image with scales and PSFs " << LogIO::POST;
+	Array<Float> fftmask;
+	fftmask_p->get(fftmask);
+	Array<Complex> psfFT;
+	vecPsfFT_p[0]->get(psfFT);
+	Block<Array<Complex> > scaleFT(nscales_p);
+	for (Int scale=0; scale<nscales_p; scale++) vecScalesFT_p[scale]->get(scaleFT[scale]);
+
+	/* FT of the dirty images, multiplied by the FT of the PSF */
+	Block<Array<Complex> > dirtyFT(ntaylor_p);
 	for (Int taylor=0; taylor<ntaylor_p;taylor++) 
 	{
-	   /* Compute FT of dirty image */
-	   dirtyFT_p->copyData(LatticeExpr<Complex>(toComplex((*fftmask_p)*(*vecDirty_p[taylor]))));
-	   LatticeFFT::cfft2d(*dirtyFT_p, True);
-	   
-	   for (Int scale=0; scale<nscales_p;scale++) 
+	   Array<Float> dirty;
+	   vecDirty_p[taylor]->get(dirty);
+	   dirtyFT[taylor].resize(dirty.shape());
+	   convertArray(dirtyFT[taylor], fftmask*dirty);
+	   ArrayLattice<Complex> dirtyLat(dirtyFT[taylor]);
+	   LatticeFFT::cfft2d(dirtyLat, True);
+	   dirtyFT[taylor] *= psfFT;
+	}
+
+	/* The (taylor,scale) convolutions are spread over the threads. */
+	Bool failed=False;
+	String errMsg;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+	for (Int i=0; i<ntaylor_p*nscales_p; i++)
+	{
+	   try
 	   {
-		if(adbg)os << "Calculating I_D * (PSF_"<< taylor << " * Scale_" << scale+1 << ")"<< LogIO::POST;
-		LatticeExpr<Complex> dpsExpr( (*dirtyFT_p)*(*vecPsfFT_p[0])*(*vecScalesFT_p[scale]));
-		cWork_p->copyData(dpsExpr);
-		LatticeFFT::cfft2d(*cWork_p, False);
-		AlwaysAssert(matR_p[IND2(taylor,scale)], AipsError);
-		LatticeExpr<Float> realWork2(real(*cWork_p));
-		matR_p[IND2(taylor,scale)]->copyData(realWork2);
-		//String lab("_"+String::toString(taylor)+"_"+String::toString(scale));
+		Int taylor = i / nscales_p;
+		Int scale = i % nscales_p;
+		Array<Complex> work(dirtyFT[taylor] * scaleFT[scale]);
+		fftPlanes(work);
+		Array<Float> realWork(real(work));
+#ifdef _OPENMP
+#pragma omp critical(MultiTermLatticeCleaner_put)
+#endif
+		matR_p[IND2(taylor,scale)]->put(realWork);
+	   }
+	   catch (std::exception& x)
+	   {
+#ifdef _OPENMP
+#pragma omp critical(MultiTermLatticeCleaner_error)
+#endif
+		{
+		   failed=True;
+		   errMsg=x.what();
+		}
 	   }
 	}
+	if(failed) throw AipsError("MultiTermLatticeCleaner::computeRHS - " + errMsg);
 	
 	return 0;
 }/* end of computeRHS() */
@@ -1001,19 +1046,62 @@ Int MultiTermLatticeCleaner<T>::computeFluxLimit(Float &fluxlimit, Float thresho
 
 /***************************************
  *  Solve the matrix eqn for each point in the lattice.
+ *  The lattices are processed chunk by chunk, and each chunk in blocks
+ *  of pixels spread over the threads. Within a block the terms are
+ *  accumulated line by line, which the compiler can vectorise.
  ****************************************/
 template <class T>
 Int MultiTermLatticeCleaner<T>::solveMatrixEqn(Int scale)
 {
-	/* Solve for the coefficients */
-	for(Int taylor1=0;taylor1<ntaylor_p;taylor1++)
+	const Int nt = ntaylor_p;
+	Block<Float> invA(nt*nt);
+	for(Int taylor1=0;taylor1<nt;taylor1++)
+	for(Int taylor2=0;taylor2<nt;taylor2++)
+		invA[taylor1*nt+taylor2] = (Float)(*invMatA_p[scale])(taylor1,taylor2);
+
+	const IPosition shape(tWork_p->shape());
+	LatticeStepper stepper(shape, tWork_p->niceCursorShape(), LatticeStepper::RESIZE);
+	Block<Array<Float> > resid(nt), coeffs(nt);
+	Block<const Float*> residPtr(nt);
+	Block<Float*> coeffPtr(nt);
+	Block<Bool> residDel(nt), coeffDel(nt);
+	for(stepper.reset(); !stepper.atEnd(); stepper++)
 	{
-		len_p = LatticeExprNode(0.0);
-		for(Int taylor2=0;taylor2<ntaylor_p;taylor2++)
+		const Slicer section(stepper.position(), stepper.endPosition(), Slicer::endIsLast);
+		for(Int taylor=0;taylor<nt;taylor++)
+		{
+			matR_p[IND2(taylor,scale)]->getSlice(resid[taylor], section);
+			coeffs[taylor].resize(section.length());
+			residPtr[taylor] = resid[taylor].getStorage(residDel[taylor]);
+			coeffPtr[taylor] = coeffs[taylor].getStorage(coeffDel[taylor]);
+		}
+		const Int64 npix = section.length().product();
+		const Int64 nblock = (npix + solveBlockSize - 1) / solveBlockSize;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+		for(Int64 block=0; block<nblock; block++)
 		{
-			len_p = len_p + LatticeExprNode((Float)(*invMatA_p[scale])(taylor1,taylor2)*(*matR_p[IND2(taylor2,scale)]));
+			const Int64 start = block*solveBlockSize;
+			const Int64 end = MIN(npix, start+solveBlockSize);
+			for(Int taylor1=0;taylor1<nt;taylor1++)
+			{
+				Float* coeff = coeffPtr[taylor1];
+				for(Int64 i=start;i<end;i++) coeff[i] = 0;
+				for(Int taylor2=0;taylor2<nt;taylor2++)
+				{
+					const Float fac = invA[taylor1*nt+taylor2];
+					const Float* res = residPtr[taylor2];
+					for(Int64 i=start;i<end;i++) coeff[i] += fac*res[i];
+				}
+			}
+		}
+		for(Int taylor=0;taylor<nt;taylor++)
+		{
+			resid[taylor].freeStorage(residPtr[taylor], residDel[taylor]);
+			coeffs[taylor].putStorage(coeffPtr[taylor], coeffDel[taylor]);
+			matCoeffs_p[IND2(taylor,scale)]->putSlice(coeffs[taylor], stepper.position());
 		}
-		(*matCoeffs_p[IND2(taylor1,scale)]).copyData(LatticeExpr<Float>(len_p));
 	}
 	
 	return 0;
@@ -1025,34 +1113,86 @@ Int MultiTermLatticeCleaner<T>::solveMatrixEqn(Int scale)
 template <class T>
 Int MultiTermLatticeCleaner<T>::computePenaltyFunction(Int scale, Float &loopgain, Bool choosespec)
 {
-	tWork_p->set(0.0);
-	
-	for(Int i=0;i<(Int)itermatCoeffs_p.nelements();i++) itermatCoeffs_p[i]->reset();
-	for(Int i=0;i<(Int)itercubeA_p.nelements();i++) itercubeA_p[i]->reset();
-	for(Int i=0;i<(Int)itermatR_p.nelements();i++) itermatR_p[i]->reset();
-	
-	for(itertWork_p->reset(); !(itertWork_p->atEnd()); (*itertWork_p)++)
+	const Int nt = ntaylor_p;
+	Float norm = 0.0;
+	if(!choosespec)
 	{
-		if(choosespec)
+		if(loopgain > 0.5) loopgain*=0.5;
+		norm = sqrt((1.0/(*matA_p[scale])(0,0)));
+	}
+
+	const IPosition shape(tWork_p->shape());
+	LatticeStepper stepper(shape, tWork_p->niceCursorShape(), LatticeStepper::RESIZE);
+	Block<Array<Float> > resid(nt), coeffs(nt), smooth(nt*nt);
+	Block<const Float*> residPtr(nt), coeffPtr(nt), smoothPtr(nt*nt);
+	Block<Bool> residDel(nt), coeffDel(nt), smoothDel(nt*nt);
+	Array<Float> penalty;
+	const Int nread = choosespec ? nt : 1;
+	for(stepper.reset(); !stepper.atEnd(); stepper++)
+	{
+		const Slicer section(stepper.position(), stepper.endPosition(), Slicer::endIsLast);
+		for(Int taylor1=0;taylor1<nread;taylor1++)
+		{
+			matR_p[IND2(taylor1,scale)]->getSlice(resid[taylor1], section);
+			residPtr[taylor1] = resid[taylor1].getStorage(residDel[taylor1]);
+			if(!choosespec) continue;
+			matCoeffs_p[IND2(taylor1,scale)]->getSlice(coeffs[taylor1], section);
+			coeffPtr[taylor1] = coeffs[taylor1].getStorage(coeffDel[taylor1]);
+			for(Int taylor2=0;taylor2<nt;taylor2++)
+			{
+				Int k = taylor1*nt+taylor2;
+				cubeA_p[IND4(taylor1,taylor2,scale,scale)]->getSlice(smooth[k], section);
+				smoothPtr[k] = smooth[k].getStorage(smoothDel[k]);
+			}
+		}
+		penalty.resize(section.length());
+		Bool penDel;
+		Float* pen = penalty.getStorage(penDel);
+		const Int64 npix = section.length().product();
+		const Int64 nblock = (npix + solveBlockSize - 1) / solveBlockSize;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+		for(Int64 block=0; block<nblock; block++)
 		{
-			for(Int taylor1=0;taylor1<ntaylor_p;taylor1++)
+			const Int64 start = block*solveBlockSize;
+			const Int64 end = MIN(npix, start+solveBlockSize);
+			if(choosespec)
+			{
+				for(Int64 i=start;i<end;i++) pen[i] = 0;
+				for(Int taylor1=0;taylor1<nt;taylor1++)
+				{
+					const Float* coeff1 = coeffPtr[taylor1];
+					const Float* res = residPtr[taylor1];
+					for(Int64 i=start;i<end;i++) pen[i] += (Float)2.0*coeff1[i]*res[i];
+					for(Int taylor2=0;taylor2<nt;taylor2++)
+					{
+						const Float* coeff2 = coeffPtr[taylor2];
+						const Float* sm = smoothPtr[taylor1*nt+taylor2];
+						for(Int64 i=start;i<end;i++) pen[i] -= coeff1[i]*coeff2[i]*sm[i];
+					}
+				}
+				// Constrain location too, based on the I0 flux being > thresh*5 or something..
+			}
+			else
 			{
-				itertWork_p->rwCursor() += (Float)2.0*((itermatCoeffs_p[IND2(taylor1,scale)])->rwCursor())*((itermatR_p[IND2(taylor1,scale)])->rwCursor());
-				
-				for(Int taylor2=0;taylor2<ntaylor_p;taylor2++)
-					itertWork_p->rwCursor() -= ((itermatCoeffs_p[IND2(taylor1,scale)])->rwCursor())*((itermatCoeffs_p[IND2(taylor2,scale)])->rwCursor())*((itercubeA_p[IND4(taylor1,taylor2,scale,scale)])->rwCursor());
+				const Float* res = residPtr[0];
+				for(Int64 i=start;i<end;i++) pen[i] = norm*res[i];
 			}
-			// Constrain location too, based on the I0 flux being > thresh*5 or something..
 		}
-		else 
+		penalty.putStorage(pen, penDel);
+		for(Int taylor1=0;taylor1<nread;taylor1++)
 		{
-			if(loopgain > 0.5) loopgain*=0.5;
-			Float norm = sqrt((1.0/(*matA_p[scale])(0,0)));
-			itertWork_p->rwCursor() += norm*((itermatR_p[IND2(0,scale)])->rwCursor());
+			resid[taylor1].freeStorage(residPtr[taylor1], residDel[taylor1]);
+			if(!choosespec) continue;
+			coeffs[taylor1].freeStorage(coeffPtr[taylor1], coeffDel[taylor1]);
+			for(Int taylor2=0;taylor2<nt;taylor2++)
+			{
+				Int k = taylor1*nt+taylor2;
+				smooth[k].freeStorage(smoothPtr[k], smoothDel[k]);
+			}
 		}
-		for(Int i=0;i<(Int)itermatCoeffs_p.nelements();i++) (*itermatCoeffs_p[i])++;
-		for(Int i=0;i<(Int)itercubeA_p.nelements();i++) (*itercubeA_p[i])++;
-		for(Int i=0;i<(Int)itermatR_p.nelements();i++) (*itermatR_p[i])++;
+		tWork_p->putSlice(penalty, stepper.position());
 	}
 	
 	return 0;
@@ -1088,36 +1228,91 @@ Int MultiTermLatticeCleaner<T>::updateSolution(IPosition globalmaxpos, Int maxsc
    LCBox subRegion(blc,trc,gip);
    LCBox subRegionPsf(blcPsf,trcPsf,gip);
    
+   /* The chosen coefficients */
+   Vector<Float> coeffs(ntaylor_p);
+   for(Int taylor=0;taylor<ntaylor_p;taylor++)
+	   coeffs[taylor] = (*matCoeffs_p[IND2(taylor,maxscaleindex)]).getAt(globalmaxpos);
+   
    /* Update the model image */
    for(Int taylor=0;taylor<ntaylor_p;taylor++)
    {
 	   SubLattice<Float> modelSub(*vecModel_p[taylor],subRegion,True);
 	   SubLattice<Float> scaleSub((*vecScales_p[maxscaleindex]),subRegionPsf,True);
-	   addTo(modelSub,scaleSub,loopgain*(*matCoeffs_p[IND2(taylor,maxscaleindex)]).getAt(globalmaxpos));
+	   addTo(modelSub,scaleSub,loopgain*coeffs[taylor]);
    }
    
-   /* Update the convolved residuals */
-   for(Int scale=0;scale<nscales_p;scale++)
-   for(Int taylor1=0;taylor1<ntaylor_p;taylor1++)
+   /* Update the convolved residuals. Each (scale,taylor) residual is a
+      separate lattice, so they are spread over the threads if all
+      lattices are held in memory. */
+   Bool failed=False;
+   String errMsg;
+#ifdef _OPENMP
+   const Bool parallel = latticesInMemory();
+#pragma omp parallel for schedule(dynamic) if(parallel)
+#endif
+   for(Int i=0;i<nscales_p*ntaylor_p;i++)
    {
-	   SubLattice<Float> residSub((*matR_p[IND2(taylor1,scale)]),subRegion,True);
-	   for(Int taylor2=0;taylor2<ntaylor_p;taylor2++)
+	   try
 	   {
-		   SubLattice<Float> smoothSub((*cubeA_p[IND4(taylor1,taylor2,scale,maxscaleindex)]),subRegionPsf,True);
-		   addTo(residSub,smoothSub,-1*loopgain*(*matCoeffs_p[IND2(taylor2,maxscaleindex)]).getAt(globalmaxpos));
+		   Int scale = i / ntaylor_p;
+		   Int taylor1 = i % ntaylor_p;
+		   SubLattice<Float> residSub((*matR_p[IND2(taylor1,scale)]),subRegion,True);
+		   for(Int taylor2=0;taylor2<ntaylor_p;taylor2++)
+		   {
+			   SubLattice<Float> smoothSub((*cubeA_p[IND4(taylor1,taylor2,scale,maxscaleindex)]),subRegionPsf,True);
+			   addTo(residSub,smoothSub,-1*loopgain*coeffs[taylor2]);
+		   }
+	   }
+	   catch (std::exception& x)
+	   {
+#ifdef _OPENMP
+#pragma omp critical(MultiTermLatticeCleaner_error)
+#endif
+		   {
+			   failed=True;
+			   errMsg=x.what();
+		   }
 	   }
    }
+   if(failed) throw AipsError("MultiTermLatticeCleaner::updateSolution - " + errMsg);
    
    /* Update flux counters */
    for(Int taylor=0;taylor<ntaylor_p;taylor++)
    {
-	   totalTaylorFlux_p[taylor] += loopgain*(*matCoeffs_p[IND2(taylor,maxscaleindex)]).getAt(globalmaxpos);
+	   totalTaylorFlux_p[taylor] += loopgain*coeffs[taylor];
    }
-   totalScaleFlux_p[maxscaleindex] += loopgain*(*matCoeffs_p[IND2(0,maxscaleindex)]).getAt(globalmaxpos);
+   totalScaleFlux_p[maxscaleindex] += loopgain*coeffs[0];
    
    return 0;
 }/* end of updateSolution() */
 
+/* Same as the in-core branch of LatticeFFT::cfft2d, but each call has its
+   own FFTServer and no shared state is used. */
+template <class T>
+void MultiTermLatticeCleaner<T>::fftPlanes(Array<Complex>& work)
+{
+   const IPosition cursorShape(2, work.shape()(0), work.shape()(1));
+   FFTServer<Float,Complex> ffts(cursorShape);
+   ArrayIterator<Complex> iter(work, 2);
+   while(!iter.pastEnd())
+   {
+	   Matrix<Complex> plane(iter.array());
+	   ffts.fft(plane, False);
+	   iter.next();
+   }
+}
+
+/* Paged lattices cannot be accessed by several threads at once. */
+template <class T>
+Bool MultiTermLatticeCleaner<T>::latticesInMemory()
+{
+   for(uInt i=0;i<matR_p.nelements();i++)
+	   if(matR_p[i]->isPaged()) return False;
+   for(uInt i=0;i<cubeA_p.nelements();i++)
+	   if(cubeA_p[i]->isPaged()) return False;
+   return True;
+}
+
 /* ................ */
 template <class T>
 Int MultiTermLatticeCleaner<T>::checkConvergence(Bool choosespec, Float thresh, Float fluxlimit)
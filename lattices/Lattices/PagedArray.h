@@ -39,6 +39,10 @@
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
+//# Forward Declarations
+class TileShapeAdvisor;
+
+
 // <summary>
 // A Lattice that is read from or written to disk.
 // </summary>
@@ -513,6 +517,15 @@ public:
   // unchanged from when <src>setMaximumCacheSize</src> was last called.
   virtual void clearCache();
 
+  // Set the advisor recording the shape of each slice accessed (see
+  // <linkto class=TileShapeAdvisor>TileShapeAdvisor</linkto>).
+  // The advisor is not owned and is shared by copies of this object.
+  // A null pointer stops the tracing.
+  // <group>
+  void setAccessTracer (TileShapeAdvisor* tracer);
+  TileShapeAdvisor* accessTracer() const;
+  // </group>
+
   // Generate a report on how the cache is doing. This is reset every
   // time <src>clearCache</src> is called.
   virtual void showCacheStatistics (ostream& os) const;
@@ -599,6 +612,7 @@ private:
           TableLock itsLockOpt;
   mutable ArrayColumn<T>       itsArray;
   mutable ROTiledStManAccessor itsAccessor;
+          TileShapeAdvisor*    itsTracer;
 };
 
 
@@ -658,6 +672,18 @@ inline uInt PagedArray<T>::defaultRow()
   return 0;
 }
 
+template<class T>
+inline void PagedArray<T>::setAccessTracer (TileShapeAdvisor* tracer)
+{
+  itsTracer = tracer;
+}
+
+template<class T>
+inline TileShapeAdvisor* PagedArray<T>::accessTracer() const
+{
+  return itsTracer;
+}
+
 template<class T>
 void PagedArray<T>::doReopen() const
 {
@@ -30,6 +30,7 @@
 #include <lattices/Lattices/PagedArrIter.h>
 #include <lattices/Lattices/LatticeNavigator.h>
 #include <lattices/Lattices/TiledShape.h>
+#include <lattices/Lattices/TileShapeAdvisor.h>
 #include <casa/Arrays/Array.h>
 #include <casa/Arrays/ArrayLogical.h>
 #include <casa/Arrays/ArrayUtil.h>
@@ -54,7 +55,8 @@ template<class T>
 PagedArray<T>::PagedArray()
 : itsIsClosed   (True),
   itsMarkDelete (False),
-  itsWritable   (False)
+  itsWritable   (False),
+  itsTracer     (0)
 {
   // Initializes all private data using their default consructor
 }
@@ -63,7 +65,8 @@ template<class T>
 PagedArray<T>::PagedArray (const TiledShape& shape, const String& filename) 
 : itsColumnName (defaultColumn()),
   itsRowNumber  (defaultRow()),
-  itsIsClosed   (True)
+  itsIsClosed   (True),
+  itsTracer     (0)
 {
   makeTable(filename, Table::New);
   makeArray (shape);
@@ -75,7 +78,8 @@ template<class T>
 PagedArray<T>::PagedArray (const TiledShape& shape)
 : itsColumnName (defaultColumn()),
   itsRowNumber  (defaultRow()),
-  itsIsClosed   (True)
+  itsIsClosed   (True),
+  itsTracer     (0)
 {
   Path filename=File::newUniqueName(String("./"), String("pagedArray"));
   makeTable (filename.absoluteName(), Table::Scratch);
@@ -91,7 +95,8 @@ PagedArray<T>::PagedArray (const TiledShape& shape, Table& file)
   itsRowNumber  (defaultRow()),
   itsIsClosed   (False),
   itsMarkDelete (False),
-  itsWritable   (file.isWritable())
+  itsWritable   (file.isWritable()),
+  itsTracer     (0)
 {
   makeArray (shape);
   setTableType();
@@ -106,7 +111,8 @@ PagedArray<T>::PagedArray (const TiledShape& shape, Table& file,
   itsRowNumber  (rowNumber),
   itsIsClosed   (False),
   itsMarkDelete (False),
-  itsWritable   (file.isWritable())
+  itsWritable   (file.isWritable()),
+  itsTracer     (0)
 {
   makeArray (shape);
   setTableType();
@@ -122,7 +128,8 @@ PagedArray<T>::PagedArray (const String& filename)
   itsMarkDelete (False),
   itsWritable   (False),
   itsArray      (itsTable, itsColumnName),
-  itsAccessor   (itsTable, itsColumnName)
+  itsAccessor   (itsTable, itsColumnName),
+  itsTracer     (0)
 {
   DebugAssert (ok(), AipsError);
 }
@@ -135,7 +142,8 @@ template<class T> PagedArray<T>::PagedArray (Table& file)
   itsMarkDelete (False),
   itsWritable   (False),
   itsArray      (itsTable, itsColumnName),
-  itsAccessor   (itsTable, itsColumnName)
+  itsAccessor   (itsTable, itsColumnName),
+  itsTracer     (0)
 {
   DebugAssert (ok(), AipsError);
 }
@@ -150,7 +158,8 @@ PagedArray<T>::PagedArray (Table& file, const String& columnName,
   itsMarkDelete (False),
   itsWritable   (False),
   itsArray      (itsTable, itsColumnName),
-  itsAccessor   (itsTable, itsColumnName)
+  itsAccessor   (itsTable, itsColumnName),
+  itsTracer     (0)
 {
   DebugAssert (ok(), AipsError);
 }
@@ -167,7 +176,8 @@ PagedArray<T>::PagedArray (const PagedArray<T>& other)
   itsWritable   (other.itsWritable),
   itsLockOpt    (other.itsLockOpt),
   itsArray      (other.itsArray),
-  itsAccessor   (other.itsAccessor)
+  itsAccessor   (other.itsAccessor),
+  itsTracer     (other.itsTracer)
 {
   DebugAssert (ok(), AipsError);
 }
@@ -204,6 +214,7 @@ PagedArray<T>& PagedArray<T>::operator= (const PagedArray<T>& other)
     itsLockOpt    = other.itsLockOpt;
     itsArray.reference(other.itsArray);
     itsAccessor   = other.itsAccessor;
+    itsTracer     = other.itsTracer;
   }
   DebugAssert (ok(), AipsError);
   return *this;
@@ -276,6 +287,9 @@ void PagedArray<T>::resize (const TiledShape& newShape)
 template<class T>
 Bool PagedArray<T>::doGetSlice (Array<T>& buffer, const Slicer& section)
 {
+  if (itsTracer != 0) {
+    itsTracer->trace (section.length());
+  }
   doReopen();
   itsArray.getSlice (itsRowNumber, section, buffer, True);
   return False;
@@ -291,6 +305,16 @@ void PagedArray<T>::doPutSlice (const Array<T>& sourceArray,
   const uInt arrDim = sourceArray.ndim();
   const uInt latDim = ndim();
   AlwaysAssert(arrDim <= latDim, AipsError);
+  if (itsTracer != 0) {
+    IPosition len(sourceArray.shape());
+    if (arrDim < latDim) {
+      len.resize (latDim);
+      for (uInt i=arrDim; i<latDim; i++) {
+        len(i) = 1;
+      }
+    }
+    itsTracer->trace (len);
+  }
   if (arrDim == latDim) {
     Slicer section(where, sourceArray.shape(), stride, Slicer::endIsLength); 
     itsArray.putSlice (itsRowNumber, section, sourceArray);
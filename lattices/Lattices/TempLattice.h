@@ -75,12 +75,17 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 // memory the operating system has (using an aipsrc variable) and compares
 // it with the size of the requested Array.
 // <p>
-// The algorithm currently used is: create an ArrayLattice if the size of the
-// array is less than a quarter of the total system memory; otherwise a
-// PagedArray is created. The PagedArray is stored in the current
-// working directory and given a unique name that contains the string
-// "pagedArray". This pagedArray will be deleted once the TempLattice goes out
-// of scope. So unlike PagedArrays which can be made to exist longer than the
+// All TempLattices share a memory budget which is managed by
+// <linkto class="TempLatticeManager">TempLatticeManager</linkto>.
+// The budget is defined by the aipsrc variable
+// <src>lattices.templattice.memory</src> (in MB) and defaults to half the
+// memory of the machine. An ArrayLattice is created if the array fits in
+// the budget, possibly after spilling the least recently used TempLattices
+// to disk; otherwise a PagedArray is created. A spilled TempLattice is read
+// back into memory when it is used again and the budget has room for it.
+// The PagedArray is stored in the work directory and given a unique name
+// that contains the string "TempLattice". This PagedArray will be deleted
+// once the TempLattice goes out of scope. So unlike PagedArrays which can be made to exist longer than the
 // time they are used by a process, the PagedArrays created by the
 // TempLattice class are always scratch arrays.
 // <p>
@@ -91,7 +96,9 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 // It can also be reopened explicitly.
 // <p>
 // You can force the TempLattice to be disk based by setting the memory
-// argument in the constructors to 0
+// argument in the constructors to 0. A non-negative memory argument
+// makes the TempLattice decide at construction whether it is held in
+// memory; it is then not part of the shared budget.
 // <p>
 // TempLattice is implemented using TempLatticeImpl for reasons explained
 // in that class.
@@ -138,10 +145,9 @@ public:
 
   // Create a TempLattice of the specified shape. You can specify how much
   // memory the Lattice can consume before it becomes disk based by giving a
-  // non-negative value to the maxMemoryInMB argument. Otherwise it will assume
-  // it can use up to 25% of the memory on your machine as defined in aipsrc
-  // (this algorithm may change). Setting maxMemoryInMB to zero will force
-  // the lattice to disk.
+  // non-negative value to the maxMemoryInMB argument. Otherwise the memory
+  // budget shared by all TempLattices is used (see TempLatticeManager).
+  // Setting maxMemoryInMB to zero will force the lattice to disk.
   // <group>
   explicit TempLattice (const TiledShape& shape, Int maxMemoryInMB=-1)
     : itsImpl (new TempLatticeImpl<T>(shape, maxMemoryInMB)) {}
@@ -33,6 +33,7 @@
 //# Includes
 #include <lattices/Lattices/Lattice.h>
 #include <lattices/Lattices/TiledShape.h>
+#include <lattices/Lattices/TempLatticeManager.h>
 #include <tables/Tables/Table.h>
 #include <casa/Utilities/CountedPtr.h>
 
@@ -62,10 +63,16 @@ class Table;
 // This was needed to have a correct implementation of tempClose. Otherwise
 // when deleting a copy of a TempLattice, that destructor would delete the
 // underlying table and the original TempLattice could not reopen it.
+// <p>
+// A TempLatticeImpl created without an explicit memory limit is managed by
+// <linkto class="TempLatticeManager">TempLatticeManager</linkto>. Such an
+// object can be spilled to disk when memory is needed for another one and
+// can be read back into memory when it is used again and memory is free.
+// Every access through <src>doReopen</src> marks it as used.
 // </synopsis>
 
 
-template<class T> class TempLatticeImpl
+template<class T> class TempLatticeImpl : public TempLatticeImplBase
 {
 public:
   // The default constructor creates a TempLatticeImpl containing a
@@ -74,10 +81,9 @@ public:
 
   // Create a TempLatticeImpl of the specified shape. You can specify how much
   // memory the Lattice can consume before it becomes disk based by giving a
-  // non-negative value to the maxMemoryInMB argument. Otherwise it will assume
-  // it can use up to 25% of the memory on your machine as defined in aipsrc
-  // (this algorithm may change). Setting maxMemoryInMB to zero will force
-  // the lattice to disk.
+  // non-negative value to the maxMemoryInMB argument. Otherwise the memory
+  // budget shared by all TempLattices is used (see TempLatticeManager).
+  // Setting maxMemoryInMB to zero will force the lattice to disk.
   // <group>
   TempLatticeImpl (const TiledShape& shape, Int maxMemoryInMB);
   TempLatticeImpl (const TiledShape& shape, Double maxMemoryInMB);
@@ -212,8 +218,15 @@ public:
     { doReopen(); itsLatticePtr->putSlice (sourceBuffer, where, stride); }
   
   // Do the reopen of the table (if not open already).
+  // A managed lattice is marked as used and, if on disk, read back into
+  // memory if the memory budget allows.
   void doReopen() const
-    { if (itsIsClosed) tempReopen(); }
+    { if (itsIsClosed) tempReopen(); if (itsManaged) use(); }
+
+  // Move the data of a managed lattice in memory to disk.
+  // It returns False if the data are referenced elsewhere.
+  // It is called by TempLatticeManager.
+  virtual Bool spill();
 
 private:
   // The copy constructor cannot be used.
@@ -231,11 +244,26 @@ private:
   // Make sure that the temporary table gets deleted.
   void deleteTable();
 
+  // Create the scratch table holding the lattice.
+  void makeTable();
+
+  // Mark a managed lattice as used and try to move it into memory
+  // if it is on disk.
+  void use() const;
+
+  // Move the data of a managed lattice on disk to memory.
+  // It returns False if the table is referenced elsewhere.
+  Bool unspill();
+
 
   mutable Table*                  itsTablePtr;
   mutable CountedPtr<Lattice<T> > itsLatticePtr;
-          String                  itsTableName;
+  mutable String                  itsTableName;
   mutable Bool                    itsIsClosed;
+          Bool                    itsManaged;
+          TiledShape              itsShape;
+  //# The number of references to the table made by this object.
+          uInt                    itsTableRefs;
 };
 
 
@@ -41,7 +41,9 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 template<class T>
 TempLatticeImpl<T>::TempLatticeImpl() 
 : itsTablePtr (0),
-  itsIsClosed (False)
+  itsIsClosed (False),
+  itsManaged  (False),
+  itsTableRefs (0)
 {
   itsLatticePtr = new ArrayLattice<T>;
 }
@@ -49,7 +51,9 @@ TempLatticeImpl<T>::TempLatticeImpl()
 template<class T>
 TempLatticeImpl<T>::TempLatticeImpl (const TiledShape& shape, Int maxMemoryInMB)
 : itsTablePtr (0),
-  itsIsClosed (False)
+  itsIsClosed (False),
+  itsManaged  (False),
+  itsTableRefs (0)
 {
   init (shape, Double(maxMemoryInMB));
 }
@@ -57,7 +61,9 @@ TempLatticeImpl<T>::TempLatticeImpl (const TiledShape& shape, Int maxMemoryInMB)
 template<class T>
 TempLatticeImpl<T>::TempLatticeImpl (const TiledShape& shape, Double maxMemoryInMB)
 : itsTablePtr (0),
-  itsIsClosed (False)
+  itsIsClosed (False),
+  itsManaged  (False),
+  itsTableRefs (0)
 {
   init(shape, maxMemoryInMB);
 }
@@ -65,6 +71,10 @@ TempLatticeImpl<T>::TempLatticeImpl (const TiledShape& shape, Double maxMemoryIn
 template<class T>
 TempLatticeImpl<T>::~TempLatticeImpl()
 {
+  if (itsManaged) {
+    TempLatticeManager::release (this);
+    itsManaged = False;
+  }
   // Reopen to make sure that temporary table gets deleted.
   doReopen();
   delete itsTablePtr;
@@ -73,26 +83,93 @@ TempLatticeImpl<T>::~TempLatticeImpl()
 template<class T>
 void TempLatticeImpl<T>::init (const TiledShape& shape, Double maxMemoryInMB) 
 {
-  Double memoryReq = Double(shape.shape().product()*sizeof(T))/(1024.0*1024.0);
-  Double memoryAvail;
-  // maxMemoryInMb = 0.0 forces disk.
+  itsShape = shape;
+  Bool inMemory;
   if (maxMemoryInMB < 0.0) {
-    memoryAvail = Double(HostInfo::memoryFree()/1024) / 2.0;
+    // Use the memory budget shared by all TempLattices.
+    itsManaged = True;
+    inMemory = TempLatticeManager::reserve
+                    (this, uInt64(shape.shape().product()) * sizeof(T));
   } else {
-    memoryAvail = maxMemoryInMB;
+    // maxMemoryInMb = 0.0 forces disk.
+    Double memoryReq = Double(shape.shape().product()*sizeof(T))/(1024.0*1024.0);
+    inMemory = (memoryReq <= maxMemoryInMB);
   }
-  if (memoryReq > memoryAvail) {
-    // Create a table with a unique name in a work directory.
-    // We can use exclusive locking, since nobody else should use the table.
-    itsTableName = AppInfo::workFileName (Int(memoryReq), "TempLattice");
-    SetupNewTable newtab (itsTableName, TableDesc(), Table::Scratch);
-    itsTablePtr = new Table (newtab, TableLock::PermanentLockingWait);
-    itsLatticePtr = new PagedArray<T> (shape, *itsTablePtr);
-  } else {
+  if (inMemory) {
     itsLatticePtr = new ArrayLattice<T> (shape.shape());
+  } else {
+    makeTable();
+  }
+}
+
+template<class T>
+void TempLatticeImpl<T>::makeTable()
+{
+  // Create a table with a unique name in a work directory.
+  // We can use exclusive locking, since nobody else should use the table.
+  Double memoryReq = Double(itsShape.shape().product()*sizeof(T))/(1024.0*1024.0);
+  itsTableName = AppInfo::workFileName (Int(memoryReq), "TempLattice");
+  SetupNewTable newtab (itsTableName, TableDesc(), Table::Scratch);
+  itsTablePtr = new Table (newtab, TableLock::PermanentLockingWait);
+  itsLatticePtr = new PagedArray<T> (itsShape, *itsTablePtr);
+  itsTableRefs = itsTablePtr->nrefs();
+}
+
+template<class T>
+void TempLatticeImpl<T>::use() const
+{
+  if (! isPaged()) {
+    TempLatticeManager::touch (const_cast<TempLatticeImpl<T>*>(this));
+  } else if (itsTablePtr->nrefs() == itsTableRefs  &&
+             TempLatticeManager::canMove()) {
+    // Read it back into memory if it fits in the free part of the budget.
+    TempLatticeImpl<T>* self = const_cast<TempLatticeImpl<T>*>(this);
+    if (TempLatticeManager::reserveIfFree
+                  (self, uInt64(itsShape.shape().product()) * sizeof(T))) {
+      if (! self->unspill()) {
+        TempLatticeManager::release (self);
+      }
+    }
   }
 }
 
+template<class T>
+Bool TempLatticeImpl<T>::spill()
+{
+  if (isPaged()  ||  itsLatticePtr.null()) {
+    return False;
+  }
+  // An iterator or a referencing getSlice shares the array.
+  const ArrayLattice<T>* arrLat =
+    dynamic_cast<const ArrayLattice<T>*>(itsLatticePtr.operator->());
+  if (arrLat == 0  ||  arrLat->asArray().nrefs() > 1) {
+    return False;
+  }
+  CountedPtr<Lattice<T> > arrPtr = itsLatticePtr;
+  makeTable();
+  itsLatticePtr->putSlice (arrLat->asArray(),
+                           IPosition(itsShape.shape().nelements(), 0));
+  return True;
+}
+
+template<class T>
+Bool TempLatticeImpl<T>::unspill()
+{
+  // A copy of the table (e.g. in an iterator) could still be written.
+  if (itsTablePtr->nrefs() != itsTableRefs) {
+    return False;
+  }
+  Array<T> data (itsLatticePtr->get());
+  CountedPtr<Lattice<T> > arrPtr = new ArrayLattice<T> (data);
+  // Delete the table; it is marked for delete.
+  itsLatticePtr = arrPtr;
+  delete itsTablePtr;
+  itsTablePtr = 0;
+  itsTableName = String();
+  itsTableRefs = 0;
+  return True;
+}
+
 template<class T>
 void TempLatticeImpl<T>::tempClose()
 {
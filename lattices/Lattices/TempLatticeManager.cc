@@ -0,0 +1,181 @@
+//# TempLatticeManager.cc: Manage the memory used by TempLattice objects
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <lattices/Lattices/TempLatticeManager.h>
+#include <casa/System/AipsrcValue.h>
+#include <casa/OS/HostInfo.h>
+#include <set>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+TempLatticeImplBase::~TempLatticeImplBase()
+{}
+
+
+Mutex  TempLatticeManager::theirMutex;
+Bool   TempLatticeManager::theirInitDone = False;
+uInt64 TempLatticeManager::theirBudget = 0;
+uInt64 TempLatticeManager::theirUsed = 0;
+uInt64 TempLatticeManager::theirClock = 0;
+std::map<TempLatticeImplBase*,uInt64> TempLatticeManager::theirLattices;
+
+
+void TempLatticeManager::initBudget()
+{
+  if (! theirInitDone) {
+    Double budgetInMB;
+    AipsrcValue<Double>::find (budgetInMB, "lattices.templattice.memory", -1.);
+    if (budgetInMB < 0) {
+      // Default is half the memory (which is given in KBytes).
+      budgetInMB = Double(HostInfo::memoryTotal(true)) / (2*1024.);
+    }
+    theirBudget = (budgetInMB <= 0  ?  0 : uInt64(budgetInMB*1024*1024));
+    theirInitDone = True;
+  }
+}
+
+void TempLatticeManager::add (TempLatticeImplBase* lattice, uInt64 nbytes)
+{
+  theirLattices[lattice] = nbytes;
+  theirUsed += nbytes;
+  lattice->itsLastUse = ++theirClock;
+}
+
+uInt64 TempLatticeManager::budget()
+{
+  ScopedMutexLock lock(theirMutex);
+  initBudget();
+  return theirBudget;
+}
+
+void TempLatticeManager::setBudget (Double budgetInMB)
+{
+  ScopedMutexLock lock(theirMutex);
+  if (budgetInMB < 0) {
+    theirInitDone = False;
+    initBudget();
+  } else {
+    theirBudget   = uInt64(budgetInMB*1024*1024);
+    theirInitDone = True;
+  }
+}
+
+uInt64 TempLatticeManager::used()
+{
+  ScopedMutexLock lock(theirMutex);
+  return theirUsed;
+}
+
+uInt TempLatticeManager::nInMemory()
+{
+  ScopedMutexLock lock(theirMutex);
+  return theirLattices.size();
+}
+
+Bool TempLatticeManager::canMove()
+{
+#ifdef _OPENMP
+  return (omp_in_parallel() == 0);
+#else
+  return True;
+#endif
+}
+
+Bool TempLatticeManager::reserve (TempLatticeImplBase* lattice, uInt64 nbytes)
+{
+  ScopedMutexLock lock(theirMutex);
+  initBudget();
+  if (nbytes > theirBudget) {
+    return False;
+  }
+  if (theirUsed + nbytes > theirBudget  &&  canMove()) {
+    // Spill the least recently used lattices until the new one fits.
+    // Lattices that cannot be spilled are skipped.
+    std::set<TempLatticeImplBase*> busy;
+    while (theirUsed + nbytes > theirBudget) {
+      std::map<TempLatticeImplBase*,uInt64>::iterator lru = theirLattices.end();
+      for (std::map<TempLatticeImplBase*,uInt64>::iterator iter =
+             theirLattices.begin(); iter != theirLattices.end(); ++iter) {
+        if (busy.find(iter->first) == busy.end()  &&
+            (lru == theirLattices.end()  ||
+             iter->first->itsLastUse < lru->first->itsLastUse)) {
+          lru = iter;
+        }
+      }
+      if (lru == theirLattices.end()) {
+        break;
+      }
+      if (lru->first->spill()) {
+        theirUsed -= lru->second;
+        theirLattices.erase (lru);
+      } else {
+        busy.insert (lru->first);
+      }
+    }
+  }
+  if (theirUsed + nbytes > theirBudget) {
+    return False;
+  }
+  add (lattice, nbytes);
+  return True;
+}
+
+Bool TempLatticeManager::reserveIfFree (TempLatticeImplBase* lattice,
+                                        uInt64 nbytes)
+{
+  ScopedMutexLock lock(theirMutex);
+  initBudget();
+  if (theirUsed + nbytes > theirBudget) {
+    return False;
+  }
+  add (lattice, nbytes);
+  return True;
+}
+
+void TempLatticeManager::release (TempLatticeImplBase* lattice)
+{
+  ScopedMutexLock lock(theirMutex);
+  std::map<TempLatticeImplBase*,uInt64>::iterator iter =
+    theirLattices.find (lattice);
+  if (iter != theirLattices.end()) {
+    theirUsed -= iter->second;
+    theirLattices.erase (iter);
+  }
+}
+
+void TempLatticeManager::touch (TempLatticeImplBase* lattice)
+{
+  ScopedMutexLock lock(theirMutex);
+  lattice->itsLastUse = ++theirClock;
+}
+
+} //# NAMESPACE CASA - END
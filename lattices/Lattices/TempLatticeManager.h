@@ -0,0 +1,175 @@
+//# TempLatticeManager.h: Manage the memory used by TempLattice objects
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef LATTICES_TEMPLATTICEMANAGER_H
+#define LATTICES_TEMPLATTICEMANAGER_H
+
+
+//# Includes
+#include <casa/aips.h>
+#include <casa/OS/Mutex.h>
+#include <map>
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+
+// <summary>
+// Non-templated base class of TempLatticeImpl used by TempLatticeManager
+// </summary>
+
+// <use visibility=local>
+
+// <synopsis>
+// TempLatticeManager keeps track of the TempLatticeImpl objects by means
+// of this base class, which it uses to ask an object to move its data
+// to disk.
+// </synopsis>
+
+class TempLatticeImplBase
+{
+public:
+  TempLatticeImplBase()
+    : itsLastUse (0)
+  {}
+
+  virtual ~TempLatticeImplBase();
+
+  // Move the lattice data to disk.
+  // It returns False if that cannot be done, because the data are
+  // referenced elsewhere (e.g. by an iterator).
+  virtual Bool spill() = 0;
+
+private:
+  friend class TempLatticeManager;
+  // The time of last use as a sequence number (maintained by the manager).
+  uInt64 itsLastUse;
+};
+
+
+// <summary>
+// Manage the memory used by TempLattice objects
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tTempLattice.cc">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class="TempLattice">TempLattice</linkto>
+// </prerequisite>
+
+// <synopsis>
+// TempLattice objects created without an explicit memory limit share a
+// global memory budget. This class keeps track of how much of the budget
+// is used by the TempLattices held in memory and when each was used last.
+// <p>
+// When a new TempLattice does not fit in the remaining budget, the least
+// recently used TempLattices are spilled to disk until it fits. A
+// TempLattice whose data are referenced elsewhere (e.g. by an active
+// iterator) is not spilled. If sufficient memory cannot be freed, the new
+// TempLattice is created on disk. A TempLattice on disk is read back into
+// memory when it is used and the remaining budget can hold it; this never
+// spills other TempLattices, so two large lattices used in turn cannot
+// cause them to be copied back and forth.
+// <p>
+// The budget (in MB) is taken from the aipsrc variable
+// <src>lattices.templattice.memory</src>. It defaults to half the memory
+// of the machine as given by <src>HostInfo::memoryTotal</src> (which
+// can be limited using the aipsrc variable <src>system.resources.memory</src>).
+// It can also be set explicitly using function <src>setBudget</src>.
+// <p>
+// All functions are thread-safe. However, TempLattices are only moved
+// between memory and disk outside OpenMP parallel regions, because another
+// thread might be accessing them.
+// </synopsis>
+
+// <motivation>
+// Deconvolution jobs use many TempLattices at the same time. Deciding
+// in isolation for each of them whether it is held in memory either
+// exhausted the memory or put all of them needlessly on disk.
+// </motivation>
+
+class TempLatticeManager
+{
+public:
+  // Get the memory budget in bytes.
+  static uInt64 budget();
+
+  // Set the memory budget in MB. A negative value means using the value
+  // defined in aipsrc. Setting a smaller budget does not spill lattices;
+  // it only takes effect for later allocations.
+  static void setBudget (Double budgetInMB);
+
+  // Get the number of bytes in use by the TempLattices held in memory.
+  static uInt64 used();
+
+  // Get the number of TempLattices held in memory.
+  static uInt nInMemory();
+
+  // Reserve memory for a TempLattice that is not held in memory yet.
+  // If needed, least recently used TempLattices are spilled to disk.
+  // It returns False if the memory could not be obtained.
+  static Bool reserve (TempLatticeImplBase* lattice, uInt64 nbytes);
+
+  // Reserve memory for a TempLattice on disk, but only if the budget
+  // has enough space left (thus without spilling others).
+  static Bool reserveIfFree (TempLatticeImplBase* lattice, uInt64 nbytes);
+
+  // Release the memory of a TempLattice that is moved to disk or deleted.
+  // Nothing is done if it does not hold memory.
+  static void release (TempLatticeImplBase* lattice);
+
+  // Mark the TempLattice as most recently used.
+  static void touch (TempLatticeImplBase* lattice);
+
+  // Can TempLattices be moved between memory and disk?
+  // It is False inside an OpenMP parallel region.
+  static Bool canMove();
+
+private:
+  // Initialize the budget from aipsrc if not done yet.
+  // The mutex must be locked.
+  static void initBudget();
+
+  // Add a lattice held in memory.
+  // The mutex must be locked.
+  static void add (TempLatticeImplBase* lattice, uInt64 nbytes);
+
+  static Mutex  theirMutex;
+  static Bool   theirInitDone;
+  static uInt64 theirBudget;
+  static uInt64 theirUsed;
+  static uInt64 theirClock;
+  // The TempLattices in memory with their sizes in bytes.
+  static std::map<TempLatticeImplBase*,uInt64> theirLattices;
+};
+
+
+} //# NAMESPACE CASA - END
+
+#endif
@@ -0,0 +1,370 @@
+//# TileShapeAdvisor.cc: Advise a tile shape and cache size for access patterns
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+#include <lattices/Lattices/TileShapeAdvisor.h>
+#include <lattices/Lattices/TiledShape.h>
+#include <tables/Tables/TSMCube.h>
+#include <casa/OS/HostInfo.h>
+#include <casa/Utilities/Assert.h>
+#include <casa/Exceptions/Error.h>
+#include <algorithm>
+#include <limits>
+
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+TileShapeAdvisor::TileShapeAdvisor (const IPosition& latticeShape,
+				    uInt pixelSize, uInt64 maxCacheSize)
+: itsShape        (latticeShape),
+  itsPixelSize    (pixelSize),
+  itsMaxCacheSize (maxCacheSize),
+  itsSeekCost     (32768),
+  itsNPatterns    (0)
+{
+  for (uInt i=0; i<itsShape.nelements(); i++) {
+    if (itsShape(i) <= 0) {
+      throw AipsError ("TileShapeAdvisor: lattice shape " +
+		       itsShape.toString() + " is invalid");
+    }
+  }
+  if (itsMaxCacheSize == 0) {
+    // memoryFree is in kBytes.
+    ptrdiff_t free = HostInfo::memoryFree();
+    if (free > 0) {
+      itsMaxCacheSize = uInt64(free) * 1024 / 8;
+    }
+  }
+}
+
+TileShapeAdvisor::TileShapeAdvisor (const TileShapeAdvisor& that)
+: itsShape        (that.itsShape),
+  itsPixelSize    (that.itsPixelSize),
+  itsMaxCacheSize (that.itsMaxCacheSize),
+  itsSeekCost     (that.itsSeekCost),
+  itsNPatterns    (0)
+{
+  ScopedMutexLock lock(that.itsMutex);
+  itsNPatterns = that.itsNPatterns;
+  itsSlices    = that.itsSlices;
+  itsPaths     = that.itsPaths;
+  itsWeights   = that.itsWeights;
+}
+
+TileShapeAdvisor::~TileShapeAdvisor()
+{}
+
+TileShapeAdvisor& TileShapeAdvisor::operator= (const TileShapeAdvisor& that)
+{
+  if (this != &that) {
+    ScopedMutexLock lock(that.itsMutex);
+    // IPosition assignment requires equal lengths, so empty the old ones.
+    itsShape.resize (0);
+    itsSlices.resize (0, True, False);
+    itsPaths.resize (0, True, False);
+    itsShape        = that.itsShape;
+    itsPixelSize    = that.itsPixelSize;
+    itsMaxCacheSize = that.itsMaxCacheSize;
+    itsSeekCost     = that.itsSeekCost;
+    itsNPatterns    = that.itsNPatterns;
+    itsSlices       = that.itsSlices;
+    itsPaths        = that.itsPaths;
+    itsWeights      = that.itsWeights;
+  }
+  return *this;
+}
+
+void TileShapeAdvisor::setSeekCost (Double nbytes)
+{
+  itsSeekCost = nbytes;
+}
+
+void TileShapeAdvisor::addSlices (const IPosition& sliceShape, Double weight,
+				  const IPosition& axisPath)
+{
+  uInt ndim = itsShape.nelements();
+  if (sliceShape.nelements() > ndim) {
+    throw AipsError ("TileShapeAdvisor::addSlices - slice shape " +
+		     sliceShape.toString() + " has too many axes");
+  }
+  IPosition slice(ndim, 1);
+  for (uInt i=0; i<sliceShape.nelements(); i++) {
+    if (sliceShape(i) > 0) {
+      slice(i) = std::min (sliceShape(i), itsShape(i));
+    }
+  }
+  // makeAxisPath checks the path and completes it.
+  IPosition path = IPosition::makeAxisPath (ndim, axisPath);
+  ScopedMutexLock lock(itsMutex);
+  add (slice, path, weight);
+}
+
+void TileShapeAdvisor::addLines (uInt axis, Double weight)
+{
+  if (axis >= itsShape.nelements()) {
+    throw AipsError ("TileShapeAdvisor::addLines - invalid axis");
+  }
+  IPosition slice(itsShape.nelements(), 1);
+  slice(axis) = itsShape(axis);
+  addSlices (slice, weight, IPosition(1, axis));
+}
+
+void TileShapeAdvisor::addPlanes (uInt axis0, uInt axis1, Double weight)
+{
+  if (axis0 >= itsShape.nelements()  ||  axis1 >= itsShape.nelements()
+  ||  axis0 == axis1) {
+    throw AipsError ("TileShapeAdvisor::addPlanes - invalid axes");
+  }
+  IPosition slice(itsShape.nelements(), 1);
+  slice(axis0) = itsShape(axis0);
+  slice(axis1) = itsShape(axis1);
+  addSlices (slice, weight, IPosition(2, axis0, axis1));
+}
+
+void TileShapeAdvisor::addSweep (Double weight)
+{
+  ScopedMutexLock lock(itsMutex);
+  add (IPosition(), IPosition(), weight);
+}
+
+void TileShapeAdvisor::trace (const IPosition& sliceShape)
+{
+  uInt ndim = itsShape.nelements();
+  if (sliceShape.nelements() != ndim) {
+    return;
+  }
+  // A slice adds the fraction of a traversal it represents.
+  Double weight = Double(sliceShape.product()) / itsShape.product();
+  IPosition path = IPosition::makeAxisPath (ndim);
+  ScopedMutexLock lock(itsMutex);
+  for (uInt i=0; i<itsNPatterns; i++) {
+    if (itsSlices[i].isEqual (sliceShape)  &&  itsPaths[i].isEqual (path)) {
+      itsWeights[i] += weight;
+      return;
+    }
+  }
+  add (sliceShape, path, weight);
+}
+
+void TileShapeAdvisor::add (const IPosition& slice, const IPosition& path,
+			    Double weight)
+{
+  if (itsNPatterns >= itsSlices.nelements()) {
+    uInt n = 2*itsNPatterns + 4;
+    itsSlices.resize (n, False, True);
+    itsPaths.resize (n, False, True);
+    itsWeights.resize (n, False, True);
+  }
+  // An entry can be reused after clear(), so its length may differ.
+  itsSlices[itsNPatterns].resize (slice.nelements(), False);
+  itsSlices[itsNPatterns]  = slice;
+  itsPaths[itsNPatterns].resize (path.nelements(), False);
+  itsPaths[itsNPatterns]   = path;
+  itsWeights[itsNPatterns] = weight;
+  itsNPatterns++;
+}
+
+uInt TileShapeAdvisor::nPatterns() const
+{
+  ScopedMutexLock lock(itsMutex);
+  return itsNPatterns;
+}
+
+IPosition TileShapeAdvisor::sliceShape (uInt i) const
+{
+  ScopedMutexLock lock(itsMutex);
+  AlwaysAssert (i < itsNPatterns, AipsError);
+  return itsSlices[i];
+}
+
+Double TileShapeAdvisor::weight (uInt i) const
+{
+  ScopedMutexLock lock(itsMutex);
+  AlwaysAssert (i < itsNPatterns, AipsError);
+  return itsWeights[i];
+}
+
+void TileShapeAdvisor::clear()
+{
+  ScopedMutexLock lock(itsMutex);
+  itsNPatterns = 0;
+}
+
+Double TileShapeAdvisor::axisTileHits (Int64 length, Int64 slice, Int64 tile)
+{
+  Double hits = 0;
+  for (Int64 st=0; st<length; st+=slice) {
+    Int64 end = std::min (st+slice, length) - 1;
+    hits += 1 + end/tile - st/tile;
+  }
+  return hits;
+}
+
+Double TileShapeAdvisor::calcCost (const IPosition& tileShape,
+				   const Block<Double>& hits) const
+{
+  uInt ndim = itsShape.nelements();
+  Double allTiles = 1;
+  for (uInt i=0; i<ndim; i++) {
+    allTiles *= (itsShape(i) + tileShape(i) - 1) / tileShape(i);
+  }
+  Double tileBytes = Double(tileShape.product()) * itsPixelSize;
+  Double maxTiles = std::numeric_limits<Double>::max();
+  if (itsMaxCacheSize > 0) {
+    maxTiles = Double(itsMaxCacheSize) / tileBytes;
+  }
+  Double cost = 0;
+  for (uInt i=0; i<itsNPatterns; i++) {
+    Double reads = allTiles;
+    // Without sufficient cache a tile is read for each slice using it.
+    if (! itsSlices[i].empty()
+    &&  patternCacheSize (i, tileShape, 0) > maxTiles) {
+      reads = 1;
+      for (uInt j=0; j<ndim; j++) {
+	reads *= hits[i*ndim + j];
+      }
+    }
+    cost += itsWeights[i] * reads * (tileBytes + itsSeekCost);
+  }
+  return cost;
+}
+
+uInt TileShapeAdvisor::patternCacheSize (uInt i, const IPosition& tileShape,
+					 uInt64 maxCacheSize) const
+{
+  if (itsSlices[i].empty()) {
+    return 1;
+  }
+  uInt maxSize = uInt(std::min (maxCacheSize,
+				uInt64(std::numeric_limits<uInt>::max())));
+  uInt tileBytes = tileShape.product() * itsPixelSize;
+  return TSMCube::calcCacheSize (itsShape, tileShape, False, itsSlices[i],
+				 IPosition(), IPosition(), itsPaths[i],
+				 maxSize, tileBytes);
+}
+
+Double TileShapeAdvisor::cost (const IPosition& tileShape) const
+{
+  uInt ndim = itsShape.nelements();
+  if (tileShape.nelements() != ndim) {
+    throw AipsError ("TileShapeAdvisor::cost - tile shape " +
+		     tileShape.toString() + " does not match lattice shape");
+  }
+  ScopedMutexLock lock(itsMutex);
+  Block<Double> hits(itsNPatterns*ndim, 1.);
+  for (uInt i=0; i<itsNPatterns; i++) {
+    if (! itsSlices[i].empty()) {
+      for (uInt j=0; j<ndim; j++) {
+	hits[i*ndim + j] = axisTileHits (itsShape(j), itsSlices[i](j),
+					 tileShape(j));
+      }
+    }
+  }
+  return calcCost (tileShape, hits);
+}
+
+uInt TileShapeAdvisor::cacheSize (const IPosition& tileShape) const
+{
+  ScopedMutexLock lock(itsMutex);
+  uInt size = 1;
+  for (uInt i=0; i<itsNPatterns; i++) {
+    size = std::max (size, patternCacheSize (i, tileShape, itsMaxCacheSize));
+  }
+  return size;
+}
+
+IPosition TileShapeAdvisor::tileShape (uInt minPixels, uInt maxPixels) const
+{
+  uInt ndim = itsShape.nelements();
+  if (ndim == 0  ||  itsShape.product() <= Int64(minPixels)) {
+    return itsShape;
+  }
+  ScopedMutexLock lock(itsMutex);
+  // The candidate lengths per axis are the axis length divided by powers
+  // of 2. The tile hits of the patterns only depend on the axis length,
+  // so they are calculated once per axis.
+  Block<IPosition> cands(ndim);
+  Block<Block<Double> > candHits(ndim);
+  for (uInt j=0; j<ndim; j++) {
+    uInt n = 0;
+    for (Int64 div=1; ; div*=2) {
+      Int64 len = (itsShape(j) + div - 1) / div;
+      if (n == 0  ||  len != cands[j](n-1)) {
+	cands[j].resize (n+1, True);
+	cands[j](n++) = len;
+      }
+      if (len == 1) break;
+    }
+    candHits[j].resize (n*itsNPatterns);
+    for (uInt k=0; k<n; k++) {
+      for (uInt i=0; i<itsNPatterns; i++) {
+	candHits[j][k*itsNPatterns + i] = itsSlices[i].empty()  ?  1 :
+	  axisTileHits (itsShape(j), itsSlices[i](j), cands[j](k));
+      }
+    }
+  }
+  // Step through all combinations of candidate lengths.
+  IPosition inx(ndim, 0);
+  IPosition tile(ndim);
+  IPosition best;
+  Double bestCost = 0;
+  Block<Double> hits(itsNPatterns*ndim);
+  while (True) {
+    Int64 npix = 1;
+    for (uInt j=0; j<ndim; j++) {
+      tile(j) = cands[j](inx(j));
+      npix *= tile(j);
+    }
+    if (npix >= Int64(minPixels)  &&  npix <= Int64(maxPixels)) {
+      for (uInt i=0; i<itsNPatterns; i++) {
+	for (uInt j=0; j<ndim; j++) {
+	  hits[i*ndim + j] = candHits[j][inx(j)*itsNPatterns + i];
+	}
+      }
+      Double cost = calcCost (tile, hits);
+      if (best.empty()  ||  cost < bestCost) {
+	best.resize (ndim);
+	best = tile;
+	bestCost = cost;
+      }
+    }
+    uInt j=0;
+    for (; j<ndim; j++) {
+      if (++inx(j) < Int(cands[j].nelements())) break;
+      inx(j) = 0;
+    }
+    if (j == ndim) break;
+  }
+  // Use the default tile shape if no candidate fits the size limits.
+  if (best.empty()) {
+    best = TiledShape(itsShape).tileShape (maxPixels);
+  }
+  return best;
+}
+
+
+} //# NAMESPACE CASA - END
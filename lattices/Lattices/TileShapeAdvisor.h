@@ -0,0 +1,204 @@
+//# TileShapeAdvisor.h: Advise a tile shape and cache size for access patterns
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef LATTICES_TILESHAPEADVISOR_H
+#define LATTICES_TILESHAPEADVISOR_H
+
+//# Includes
+#include <casa/Arrays/IPosition.h>
+#include <casa/Containers/Block.h>
+#include <casa/OS/Mutex.h>
+
+namespace casa { //# NAMESPACE CASA - BEGIN
+
+
+// <summary>
+// Advise a tile shape and cache size for the access patterns of a lattice
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tTileShapeAdvisor.cc">
+// </reviewed>
+
+// <prerequisite>
+//  <li> <linkto class=TiledShape>TiledShape</linkto>
+//  <li> <linkto class=PagedArray>PagedArray</linkto>
+// </prerequisite>
+
+// <synopsis>
+// The default tile shape of a <linkto class=TiledShape>TiledShape</linkto>
+// is about cubic and does not know how the lattice will be accessed.
+// TileShapeAdvisor recommends a tile shape (and the matching cache size)
+// for a description of the accesses to be done, for example spectra,
+// planes or full sweeps through the lattice. Each access pattern has a
+// weight giving the number of times the entire lattice is traversed
+// in that way.
+// <p>
+// The I/O of a tile shape is modelled per access pattern. When the cache
+// needed for the pattern (as determined by the tiled storage manager,
+// see <src>TSMCube::calcCacheSize</src>) fits in the maximum cache size,
+// each tile is read once per traversal. Otherwise a tile is read for
+// every slice intersecting it. Each tile read costs the number of bytes
+// in the tile plus a fixed seek cost. The advised tile shape is the
+// candidate with the lowest total cost; the candidate tile axes are the
+// lattice axes divided by powers of two (rounded up), which keeps the
+// padding in the last tiles small.
+// <p>
+// The actual access pattern of a lattice can be recorded by function
+// <src>trace</src>. A <linkto class=PagedArray>PagedArray</linkto>
+// calls it for each getSlice and putSlice if an advisor is set using
+// <src>PagedArray::setAccessTracer</src>. Each traced slice adds the
+// fraction of a traversal it represents to the weight of its pattern,
+// so traced and planned patterns can be mixed. The advice can then be
+// used to re-tile the lattice.
+// Function <src>trace</src> is thread-safe.
+// </synopsis>
+
+// <example>
+// <srcblock>
+// // A cube mainly accessed by spectra, sometimes by planes.
+// TileShapeAdvisor advisor (IPosition(3,512,512,1024));
+// advisor.addLines (2, 10);
+// advisor.addPlanes (0, 1, 1);
+// IPosition tileShape = advisor.tileShape();
+// PagedArray<Float> arr (TiledShape(advisor.shape(), tileShape), "cube");
+// arr.setCacheSizeInTiles (advisor.cacheSize(tileShape));
+// </srcblock>
+// </example>
+
+// <motivation>
+// Badly tiled images are a large, avoidable slowdown.
+// </motivation>
+
+
+class TileShapeAdvisor
+{
+public:
+    // Create the advisor for a lattice with the given shape and pixel size
+    // in bytes. The maximum cache size is given in bytes; 0 means 1/8 of
+    // the free memory.
+    explicit TileShapeAdvisor (const IPosition& latticeShape,
+			       uInt pixelSize = sizeof(Float),
+			       uInt64 maxCacheSize = 0);
+
+    // Copy constructor (copy semantics).
+    TileShapeAdvisor (const TileShapeAdvisor& that);
+
+    ~TileShapeAdvisor();
+
+    // Assignment (copy semantics).
+    TileShapeAdvisor& operator= (const TileShapeAdvisor& that);
+
+    // Get the lattice shape.
+    const IPosition& shape() const
+      { return itsShape; }
+
+    // Get the maximum cache size in bytes (0 is unlimited).
+    uInt64 maxCacheSize() const
+      { return itsMaxCacheSize; }
+
+    // Set the cost of reading a tile in addition to its size (in bytes).
+    // The default is 32768.
+    void setSeekCost (Double nbytes);
+
+    // Add an access pattern stepping with the given slice shape along the
+    // given axis path (see <linkto class=LatticeStepper>LatticeStepper</linkto>).
+    // Missing or zero slice axes are taken as 1.
+    void addSlices (const IPosition& sliceShape, Double weight = 1,
+		    const IPosition& axisPath = IPosition());
+
+    // Add an access pattern of lines (e.g. spectra) along the given axis.
+    void addLines (uInt axis, Double weight = 1);
+
+    // Add an access pattern of planes through the given axes.
+    void addPlanes (uInt axis0, uInt axis1, Double weight = 1);
+
+    // Add a full sweep in the optimal order (e.g. using a TileStepper).
+    void addSweep (Double weight = 1);
+
+    // Record an actual access of a slice with the given shape.
+    void trace (const IPosition& sliceShape);
+
+    // Get the number of access patterns.
+    uInt nPatterns() const;
+
+    // Get the slice shape and weight of the i-th access pattern.
+    // The slice shape of a sweep is empty.
+    // <group>
+    IPosition sliceShape (uInt i) const;
+    Double weight (uInt i) const;
+    // </group>
+
+    // Remove all access patterns.
+    void clear();
+
+    // Get the modelled I/O (in bytes) for the given tile shape.
+    Double cost (const IPosition& tileShape) const;
+
+    // Get the cache size (in tiles) needed by the access patterns
+    // for the given tile shape, limited by the maximum cache size.
+    uInt cacheSize (const IPosition& tileShape) const;
+
+    // Get the tile shape with the lowest modelled I/O and a size
+    // between the given numbers of pixels.
+    // A lattice smaller than <src>minPixels</src> is a single tile.
+    IPosition tileShape (uInt minPixels = 4096,
+			 uInt maxPixels = 131072) const;
+
+private:
+    // Add a pattern without locking.
+    void add (const IPosition& slice, const IPosition& path, Double weight);
+
+    // Get the number of tiles accessed along an axis with the given
+    // length, when stepping through it in slices.
+    static Double axisTileHits (Int64 length, Int64 slice, Int64 tile);
+
+    // Get the modelled cost. The number of tile hits along each axis
+    // for pattern i is given in hits[i*ndim + axis].
+    Double calcCost (const IPosition& tileShape,
+		     const Block<Double>& hits) const;
+
+    // Get the cache size (in tiles) needed for pattern i.
+    uInt patternCacheSize (uInt i, const IPosition& tileShape,
+			   uInt64 maxCacheSize) const;
+
+    IPosition        itsShape;
+    uInt             itsPixelSize;
+    uInt64           itsMaxCacheSize;
+    Double           itsSeekCost;
+    uInt             itsNPatterns;
+    Block<IPosition> itsSlices;
+    Block<IPosition> itsPaths;
+    Block<Double>    itsWeights;
+    mutable Mutex    itsMutex;
+};
+
+
+} //# NAMESPACE CASA - END
+
+#endif
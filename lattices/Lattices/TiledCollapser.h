@@ -155,6 +155,24 @@ public:
     virtual void endAccumulator (Array<U>& result, 
                                  Array<Bool>& resultMask,
 				 const IPosition& shape) = 0;
+
+// Make a copy of this collapser (after <src>init</src> has been called).
+// If a derived class implements this function and
+// <src>mergeAccumulator</src>, <src>LatticeApply::tiledApply</src> can
+// process the tiles of a chunk in parallel. Each thread then uses its
+// own copy with its own accumulator (initialized with the same
+// <src>n1</src> and <src>n3</src>), which are merged before
+// <src>endAccumulator</src> is called.
+// The caller takes over the returned pointer.
+// <br>The default implementation returns a null pointer, which means
+// that the tiles are processed sequentially.
+    virtual TiledCollapser<T,U>* clone() const;
+
+// Merge the accumulator of the given collapser (a clone of this one)
+// into the accumulator of this collapser, as if the data processed by
+// <src>other</src> had been processed by this one.
+// <br>The default implementation throws an exception.
+    virtual void mergeAccumulator (const TiledCollapser<T,U>& other);
 };
 
 
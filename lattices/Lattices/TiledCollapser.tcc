@@ -27,6 +27,7 @@
 
 
 #include <lattices/Lattices/TiledCollapser.h>
+#include <casa/Exceptions/Error.h>
 
 
 namespace casa { //# NAMESPACE CASA - BEGIN
@@ -41,5 +42,17 @@ Bool TiledCollapser<T,U>::canHandleNullMask() const
     return False;
 }
 
+template<class T, class U>
+TiledCollapser<T,U>* TiledCollapser<T,U>::clone() const
+{
+    return 0;
+}
+
+template<class T, class U>
+void TiledCollapser<T,U>::mergeAccumulator (const TiledCollapser<T,U>&)
+{
+    throw AipsError ("TiledCollapser::mergeAccumulator not implemented");
+}
+
 } //# NAMESPACE CASA - END
 
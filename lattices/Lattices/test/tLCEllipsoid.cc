@@ -170,6 +170,38 @@ int main()
     		AlwaysAssert(ellipse3 == ellipse4, AipsError);
     		near(ellipse3.theta(), ellipse4.theta());
     	}
+    	{
+    		// The mask of a rotated ellipse must contain exactly the
+    		// pixels inside it, also if it is clipped by the lattice edge.
+    		IPosition latticeShape(2, 300, 200);
+    		Float thetas[] = {0.1, 0.7, 1.3, 2.2, 2.9};
+    		Float xcenters[] = {150, 12.5, 290.3};
+    		for (uInt i=0; i<5; i++) {
+    			for (uInt j=0; j<3; j++) {
+    				LCEllipsoid ellipse(
+    					xcenters[j], 100.7, 60, 18.3, thetas[i], latticeShape
+    				);
+    				Array<Bool> mask = ellipse.maskArray();
+    				IPosition blc = ellipse.boundingBox().start();
+    				Float theta = ellipse.theta();
+    				Float rad0 = ellipse.radii()[0] * ellipse.radii()[0];
+    				Float rad1 = ellipse.radii()[1] * ellipse.radii()[1];
+    				Float cx = ellipse.center()[0] - Float(blc[0]);
+    				Float cy = ellipse.center()[1] - Float(blc[1]);
+    				IPosition pos(2);
+    				for (pos[1]=0; pos[1]<mask.shape()[1]; pos[1]++) {
+    					Float ydiff = Float(pos[1]-cy);
+    					for (pos[0]=0; pos[0]<mask.shape()[0]; pos[0]++) {
+    						Float xdiff = Float(pos[0]-cx);
+    						Float xp = xdiff*cos(-theta) - ydiff*sin(-theta);
+    						Float yp = xdiff*sin(-theta) + ydiff*cos(-theta);
+    						Bool inside = (xp*xp/rad0 + yp*yp/rad1 <= 1);
+    						AlwaysAssert(mask(pos) == inside, AipsError);
+    					}
+    				}
+    			}
+    		}
+    	}
     	/*
     	{
 
@@ -75,6 +75,24 @@ int main()
       Vector<Float> yv(IPosition(1,sizeof(y)/sizeof(Float)), y, SHARE);
       doIt (shape, xv, yv);
     }
+    {
+      // A square with many points on each side.
+      const uInt n = 1000;
+      Vector<Float> xv(4*n), yv(4*n);
+      for (uInt i=0; i<n; i++) {
+        Float d = 90. * i / n;
+        xv[i] = 10 + d;       yv[i] = 10;
+        xv[n+i] = 100;        yv[n+i] = 10 + d;
+        xv[2*n+i] = 100 - d;  yv[2*n+i] = 100;
+        xv[3*n+i] = 10;       yv[3*n+i] = 100 - d;
+      }
+      LCPolygon polygon (xv, yv, IPosition(2, 1024, 1024));
+      AlwaysAssert (polygon.boundingBox().start() == IPosition(2,10,10),
+                    AipsError);
+      AlwaysAssert (polygon.maskArray().shape() == IPosition(2,91,91),
+                    AipsError);
+      AlwaysAssert (allEQ (polygon.maskArray(), True), AipsError);
+    }
   } catch (AipsError x) {
     cout << "Caught exception: " << x.getMesg() << endl;
     return 1;
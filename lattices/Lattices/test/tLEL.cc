@@ -754,7 +754,9 @@ int main (int argc, const char* argv[])
     {
     cout << "   Function cosh" << endl;     
     LELFunction1D<Float> expr(LELFunctionEnums::COSH, pExpr);
-    FResult = cosh(bFVal);
+    // Use the lattice value, so the compiler cannot fold cosh into a
+    // constant which can differ in the last bit from the library result.
+    FResult = cosh(bF.getAt(IPosition(2,0,0)));
     if (!checkFloat (expr, FResult, String("LELFunction1D"), shape, False, suppress)) ok = False;
     }
 
@@ -71,6 +71,55 @@ int main() {
 			AlwaysAssert(minPos == 0, AipsError);
 			AlwaysAssert(maxPos == 9, AipsError);
 		}
+		{
+			// Accumulate the samples 2*i in two halves and merge them.
+			Double nPts[2] = {0, 0};
+			Double sum[2] = {0, 0};
+			Double mean[2] = {0, 0};
+			Double nvariance[2] = {0, 0};
+			Double variance[2] = {0, 0};
+			Double sumSq[2] = {0, 0};
+			Float dataMin[2], dataMax[2];
+			Int minPos, maxPos;
+			Bool minMaxInit[2] = {True, True};
+			for (uInt i=0; i<10; i++) {
+				uInt k = (i%3 == 0  ?  1 : 0);
+				LattStatsSpecialize::accumulate (
+						nPts[k], sum[k], mean[k], nvariance[k], variance[k],
+						sumSq[k], dataMin[k], dataMax[k], minPos,
+						maxPos, minMaxInit[k], False, 2*Float(i),
+						i, Float(1)
+				);
+			}
+			Bool minTaken, maxTaken;
+			LattStatsSpecialize::merge (
+					nPts[0], sum[0], mean[0], nvariance[0], variance[0],
+					sumSq[0], dataMin[0], dataMax[0], minMaxInit[0],
+					minTaken, maxTaken,
+					nPts[1], sum[1], mean[1], nvariance[1],
+					sumSq[1], dataMin[1], dataMax[1], minMaxInit[1]
+			);
+			AlwaysAssert(nPts[0] == 10, AipsError);
+			AlwaysAssert(sum[0] == 90, AipsError);
+			AlwaysAssert(near(mean[0], 9.0, 1e-13), AipsError);
+			AlwaysAssert(near(variance[0], 36.6666666666, 1e-11), AipsError);
+			AlwaysAssert(sumSq[0] == 1140, AipsError);
+			AlwaysAssert(dataMin[0] == 0, AipsError);
+			AlwaysAssert(dataMax[0] == 18, AipsError);
+			AlwaysAssert(minTaken && maxTaken, AipsError);
+			// Merging an empty accumulator changes nothing.
+			Double zero = 0;
+			LattStatsSpecialize::merge (
+					nPts[0], sum[0], mean[0], nvariance[0], variance[0],
+					sumSq[0], dataMin[0], dataMax[0], minMaxInit[0],
+					minTaken, maxTaken,
+					zero, zero, zero, zero, zero, 0, 0, True
+			);
+			AlwaysAssert(nPts[0] == 10, AipsError);
+			AlwaysAssert(near(variance[0], 36.6666666666, 1e-11), AipsError);
+			AlwaysAssert(dataMin[0] == 0, AipsError);
+			AlwaysAssert(!minTaken && !maxTaken, AipsError);
+		}
 		{
 			Vector<Complex> mySamples(10);
 			DComplex nPts = 0;
@@ -66,6 +66,7 @@ public:
 			  const Vector<Int>& vector,
 			  const Vector<Bool>& arrayMask,
 			  const IPosition& pos);
+    virtual LineCollapser<Int>* clone() const;
 };
 void MyLineCollapser::init (uInt nOutPixelsPerCollapse)
 {
@@ -75,6 +76,10 @@ Bool MyLineCollapser::canHandleNullMask() const
 {
     return False;
 }
+LineCollapser<Int>* MyLineCollapser::clone() const
+{
+    return new MyLineCollapser();
+}
 void MyLineCollapser::process (Int& result, Bool& resultMask,
 			       const Vector<Int>& vector,
 			       const Vector<Bool>& mask,
@@ -132,6 +137,8 @@ public:
     virtual void endAccumulator (Array<Int>& result,
 				 Array<Bool>& resultMask,
 				 const IPosition& shape);
+    virtual TiledCollapser<Int>* clone() const;
+    virtual void mergeAccumulator (const TiledCollapser<Int>& other);
 private:
     Matrix<uInt>* itsSum1;
     Block<Int>*   itsSum2;
@@ -151,6 +158,9 @@ void MyTiledCollapser::init (uInt nOutPixelsPerCollapse)
 }
 void MyTiledCollapser::initAccumulator (uInt n1, uInt n3)
 {
+    delete itsSum1;
+    delete itsSum2;
+    delete itsNpts;
     itsSum1 = new Matrix<uInt> (n1, n3);
     itsSum2 = new Block<Int> (n1*n3);
     itsNpts = new Matrix<uInt> (n1, n3);
@@ -164,6 +174,19 @@ Bool MyTiledCollapser::canHandleNullMask() const
 {
     return False;
 }
+TiledCollapser<Int>* MyTiledCollapser::clone() const
+{
+    return new MyTiledCollapser();
+}
+void MyTiledCollapser::mergeAccumulator (const TiledCollapser<Int>& other)
+{
+    const MyTiledCollapser& that = dynamic_cast<const MyTiledCollapser&>(other);
+    *itsSum1 += *that.itsSum1;
+    *itsNpts += *that.itsNpts;
+    for (uInt i=0; i<itsSum2->nelements(); i++) {
+	(*itsSum2)[i] += (*that.itsSum2)[i];
+    }
+}
 void MyTiledCollapser::process (uInt index1, uInt index3,
 				const Int* inData, const Bool* inMask,
 				uInt inDataIncr, uInt inMaskIncr, uInt nrval,
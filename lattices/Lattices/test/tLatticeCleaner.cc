@@ -0,0 +1,178 @@
+//# tLatticeCleaner.cc: Test program for class LatticeCleaner
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <lattices/Lattices/LatticeCleaner.h>
+#include <lattices/Lattices/ArrayLattice.h>
+#include <casa/Arrays/Array.h>
+#include <casa/Arrays/ArrayMath.h>
+#include <casa/Arrays/ArrayLogical.h>
+#include <casa/Arrays/IPosition.h>
+#include <casa/Arrays/Vector.h>
+#include <casa/BasicMath/Math.h>
+#include <casa/Quanta/Quantum.h>
+#include <casa/Utilities/Assert.h>
+#include <casa/Exceptions/Error.h>
+#include <casa/iostream.h>
+
+#include <casa/namespace.h>
+
+// Make an image with gaussians at the given positions.
+Array<Float> makeImage (const IPosition& shape, const Vector<Float>& xs,
+                        const Vector<Float>& ys, const Vector<Float>& fluxes,
+                        const Vector<Float>& widths)
+{
+  Array<Float> image(shape);
+  image = 0;
+  for (Int y=0; y<shape(1); y++) {
+    for (Int x=0; x<shape(0); x++) {
+      Float val = 0;
+      for (uInt i=0; i<xs.nelements(); i++) {
+        Float dx = x - xs(i);
+        Float dy = y - ys(i);
+        val += fluxes(i) * exp(-(dx*dx + dy*dy) / (2*widths(i)*widths(i)));
+      }
+      image(IPosition(4,x,y,0,0)) = val;
+    }
+  }
+  return image;
+}
+
+// Clean the dirty image and return the model and residual.
+Int doClean (CleanEnums::CleanType type, const Array<Float>& psf,
+             const Array<Float>& dirty, const Array<Float>* mask,
+             Float maskThreshold, Bool inMemory,
+             Array<Float>& model, Array<Float>& residual)
+{
+  ArrayLattice<Float> psfLat(psf);
+  ArrayLattice<Float> dirtyLat(dirty);
+  LatticeCleaner<Float> cleaner(psfLat, dirtyLat);
+  Vector<Float> scales(type == CleanEnums::MULTISCALE ? 2 : 1, 0.);
+  if (type == CleanEnums::MULTISCALE) {
+    scales(1) = 4;
+  }
+  cleaner.setscales (scales);
+  if (mask) {
+    ArrayLattice<Float> maskLat(*mask);
+    cleaner.setMask (maskLat, maskThreshold);
+  }
+  cleaner.setcontrol (type, 200, 0.1, Quantity(0.001, "Jy"), False);
+  cleaner.setInMemory (inMemory);
+  ArrayLattice<Float> modelLat(dirty.shape());
+  modelLat.set (0);
+  cleaner.clean (modelLat);
+  model.reference (modelLat.get().copy());
+  residual.reference (cleaner.residual()->get());
+  return cleaner.iteration();
+}
+
+// Check that cleaning in memory gives the same results.
+Bool check (const String& name, CleanEnums::CleanType type,
+            const Array<Float>& psf, const Array<Float>& dirty,
+            const Array<Float>* mask, Float maskThreshold)
+{
+  Array<Float> model1, residual1, model2, residual2;
+  Int niter1 = doClean (type, psf, dirty, mask, maskThreshold, False,
+                        model1, residual1);
+  Int niter2 = doClean (type, psf, dirty, mask, maskThreshold, True,
+                        model2, residual2);
+  Bool ok = True;
+  if (niter1 != niter2) {
+    cout << name << ": " << niter1 << " and " << niter2
+         << " iterations" << endl;
+    ok = False;
+  }
+  if (!allNearAbs (model1, model2, 1e-5)) {
+    cout << name << ": models differ by "
+         << max(abs(model1-model2)) << endl;
+    ok = False;
+  }
+  if (!allNearAbs (residual1, residual2, 1e-5)) {
+    cout << name << ": residuals differ by "
+         << max(abs(residual1-residual2)) << endl;
+    ok = False;
+  }
+  if (allEQ (model1, Float(0))) {
+    cout << name << ": nothing has been cleaned" << endl;
+    ok = False;
+  }
+  return ok;
+}
+
+int main()
+{
+  try {
+    IPosition shape(4,64,64,1,1);
+    Vector<Float> xs(1, 32.), ys(1, 32.), fluxes(1, 1.), widths(1, 2.);
+    Array<Float> psf = makeImage (shape, xs, ys, fluxes, widths);
+    // Some point sources and an extended one; two have equal peaks.
+    xs.resize(4);
+    ys.resize(4);
+    fluxes.resize(4);
+    widths.resize(4);
+    xs(0) = 24; ys(0) = 30; fluxes(0) =  1.0; widths(0) = 2;
+    xs(1) = 40; ys(1) = 38; fluxes(1) =  1.0; widths(1) = 2;
+    xs(2) = 30; ys(2) = 42; fluxes(2) = -0.4; widths(2) = 2;
+    xs(3) = 35; ys(3) = 27; fluxes(3) =  0.3; widths(3) = 6;
+    Array<Float> dirty = makeImage (shape, xs, ys, fluxes, widths);
+    // A mask with a box and one with weights in the same box.
+    Array<Float> mask(shape);
+    mask = 0;
+    Array<Float> weights(shape);
+    weights = 0;
+    for (Int y=18; y<48; y++) {
+      for (Int x=18; x<48; x++) {
+        mask(IPosition(4,x,y,0,0)) = 1;
+        weights(IPosition(4,x,y,0,0)) = 0.5 + 0.5*x/63.;
+      }
+    }
+    Bool ok = True;
+    CleanEnums::CleanType types[2] = {CleanEnums::HOGBOM,
+                                      CleanEnums::MULTISCALE};
+    String names[2] = {"hogbom", "multiscale"};
+    for (uInt i=0; i<2; i++) {
+      if (! check (names[i], types[i], psf, dirty, 0, 0.9)) {
+        ok = False;
+      }
+      if (! check (names[i] + " mask", types[i], psf, dirty, &mask, 0.9)) {
+        ok = False;
+      }
+      if (! check (names[i] + " weights", types[i], psf, dirty,
+                   &weights, -1)) {
+        ok = False;
+      }
+    }
+    if (!ok) {
+      cout << "not ok" << endl;
+      return 1;
+    }
+  } catch (AipsError x) {
+    cout << "Caught exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -38,7 +38,10 @@
 #include <lattices/Lattices/ArrayLattice.h>
 #include <lattices/Lattices/LCBox.h>
 #include <lattices/Lattices/LatticeConcat.h>
+#include <lattices/Lattices/PagedArray.h>
 #include <lattices/Lattices/SubLattice.h>
+#include <tables/Tables/Table.h>
+#include <casa/BasicSL/String.h>
 #include <casa/iostream.h>
 
 
@@ -746,6 +749,47 @@ int main() {
          }
       }
 
+
+// Concatenate lattices on disk, keeping at most 3 of them open.
+
+      const uInt nlat = 10;
+      {
+         IPosition pshape(3,8,6,2);
+         Array<Float> expected(IPosition(3,8,6,2*nlat));
+         LatticeConcat<Float> lc (2);
+         lc.setMaxOpen (3);
+         AlwaysAssert(lc.maxOpen()==3, AipsError);
+         for (uInt k=0; k<nlat; k++) {
+            PagedArray<Float> pa(pshape, "tLatticeConcat_tmp" +
+                                 String::toString(k) + ".pa");
+            Array<Float> arr(pshape);
+            indgen (arr, Float(100*k));
+            pa.put (arr);
+            expected(IPosition(3,0,0,2*k), IPosition(3,7,5,2*k+1)) = arr;
+            SubLattice<Float> ml(pa);
+            lc.setLattice (ml);
+         }
+         AlwaysAssert(lc.shape()==expected.shape(), AipsError);
+         AlwaysAssert(allEQ(lc.get(), expected), AipsError);
+         Slicer sl(IPosition(3,1,0,3), IPosition(3,7,5,16),
+                   IPosition(3,2,3,1), Slicer::endIsLast);
+         AlwaysAssert(allEQ(lc.getSlice(sl), expected(sl)), AipsError);
+         for (uInt k=0; k<2*nlat; k++) {
+            Slicer plane(IPosition(3,0,0,k), IPosition(3,8,6,1));
+            AlwaysAssert(allEQ(lc.getSlice(plane), expected(plane)),
+                         AipsError);
+         }
+         AlwaysAssert(allEQ(lc.getMask(), True), AipsError);
+         LatticeConcat<Float> lc2(lc);
+         lc2.setMaxOpen (0);
+         AlwaysAssert(allEQ(lc2.get(), expected), AipsError);
+         lc.tempClose();
+         AlwaysAssert(allEQ(lc.get(), expected), AipsError);
+      }
+      for (uInt k=0; k<nlat; k++) {
+         Table::deleteTable ("tLatticeConcat_tmp" + String::toString(k) + ".pa");
+      }
+
   } catch(AipsError x) {
     cerr << x.getMesg() << endl;
     return 1;
@@ -27,10 +27,14 @@
 
 #include <lattices/Lattices/LatticeExpr.h>
 #include <lattices/Lattices/ArrayLattice.h>
+#include <lattices/Lattices/LatticeStepper.h>
 #include <casa/Arrays/Slicer.h>
 #include <casa/Arrays/Array.h>
 #include <casa/Arrays/ArrayLogical.h>
+#include <casa/Arrays/ArrayMath.h>
 #include <casa/Arrays/IPosition.h>
+#include <casa/Arrays/MaskedArray.h>
+#include <casa/Containers/Block.h>
 #include <casa/BasicSL/Constants.h>
 #include <casa/Inputs/Input.h>
 #include <casa/Exceptions/Error.h>
@@ -38,8 +42,29 @@
 
 #include <casa/iostream.h>
 
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
 
 #include <casa/namespace.h>
+
+// An ArrayLattice counting the number of slices read from it.
+class CountingLattice : public ArrayLattice<Float>
+{
+public:
+  CountingLattice (const Array<Float>& array)
+    : ArrayLattice<Float> (array) {}
+  CountingLattice (const CountingLattice& other)
+    : ArrayLattice<Float> (other) {}
+  virtual Lattice<Float>* clone() const
+    { return new CountingLattice (*this); }
+  virtual Bool doGetSlice (Array<Float>& buffer, const Slicer& section)
+    { theirNGet++; return ArrayLattice<Float>::doGetSlice (buffer, section); }
+  static uInt theirNGet;
+};
+uInt CountingLattice::theirNGet = 0;
+
 Bool checkFloat(Lattice<Float>& expr, 
                 const Float result,
                 const IPosition shape,
@@ -223,6 +248,186 @@ int main (int argc, const char* argv[])
 
      }
 
+//
+// Same operand on both sides of a binary operator.
+//
+     {
+       cout << "Shared operand" << endl;
+       LatticeExprNode node(aF);
+       LatticeExpr<Float> exprAdd(node+node);
+       if (!checkFloat(exprAdd, aFVal+aFVal, shape, supress)) ok = False;
+       LatticeExpr<Float> exprSub(node-node);
+       if (!checkFloat(exprSub, 0, shape, supress)) ok = False;
+       LatticeExpr<Float> exprMul(node*node);
+       if (!checkFloat(exprMul, aFVal*aFVal, shape, supress)) ok = False;
+       LatticeExpr<Float> exprDiv(node/node);
+       if (!checkFloat(exprDiv, 1, shape, supress)) ok = False;
+     }
+
+//
+// A chunk buffer must not be reused while still referenced.
+//
+     {
+       cout << "Chunk reuse" << endl;
+       IPosition shp(2,4,4);
+       Array<Double> arr(shp);
+       indgen (arr);
+       ArrayLattice<Double> aI(arr);
+       LatticeExpr<Float> expr(LatticeExprNode(aI) * 2.);
+       IPosition chunkShape(2,2,4);
+       Array<Float> chunk1, chunk2;
+       expr.getSlice (chunk1, Slicer(IPosition(2,0,0), chunkShape));
+       expr.getSlice (chunk2, Slicer(IPosition(2,2,0), chunkShape));
+       for (uInt j=0; j<4; j++) {
+         for (uInt i=0; i<2; i++) {
+           if (chunk1(IPosition(2,i,j)) != 2*arr(IPosition(2,i,j))  ||
+               chunk2(IPosition(2,i,j)) != 2*arr(IPosition(2,i+2,j))) {
+             cout << "   Chunk values are incorrect" << endl;
+             ok = False;
+           }
+         }
+       }
+       chunk1.resize();
+       chunk2.resize();
+       expr.getSlice (chunk1, Slicer(IPosition(2,0,0), chunkShape));
+       if (chunk1(IPosition(2,1,3)) != 2*arr(IPosition(2,1,3))) {
+         cout << "   Reused chunk values are incorrect" << endl;
+         ok = False;
+       }
+     }
+
+     {
+       cout << "Parallel chunks" << endl;
+#ifdef _OPENMP
+       omp_set_num_threads (4);
+#endif
+       IPosition shp(2,16,12);
+       Array<Float> arr(shp);
+       indgen (arr);
+       ArrayLattice<Float> aF(arr);
+       LatticeExprNode node(aF);
+       LatticeExpr<Float> expr(sin(node) + 2*node);
+       Array<Float> expect (sin(arr) + Float(2)*arr);
+       // Evaluate in chunks of 5x4, so the last chunks get resized.
+       LatticeStepper stepper(shp, IPosition(2,5,4), LatticeStepper::RESIZE);
+       Block<Array<Float> > values(3);
+       Block<Array<Bool> > masks(3);
+       Block<IPosition> positions(3);
+       Array<Float> result(shp);
+       uInt nchunk;
+       uInt ntotal = 0;
+       while ((nchunk = expr.evalChunks (values, masks, positions,
+                                         stepper)) > 0) {
+         for (uInt i=0; i<nchunk; i++) {
+           if (! masks[i].empty()) {
+             cout << "   Unmasked chunk has a mask" << endl;
+             ok = False;
+           }
+           result(Slicer(positions[i], values[i].shape())) = values[i];
+         }
+         ntotal += nchunk;
+       }
+       if (ntotal != 12  ||  !allNear (result, expect, 1e-5)) {
+         cout << "   evalChunks gives incorrect results" << endl;
+         ok = False;
+       }
+       ArrayLattice<Float> out(shp);
+       out.copyData (expr);
+       if (!allNear (out.get(), expect, 1e-5)) {
+         cout << "   copyData gives incorrect results" << endl;
+         ok = False;
+       }
+       // Reductions on unmasked and masked expressions.
+       if (sum(node).getFloat() != sum(arr)  ||
+           mean(node).getFloat() != mean(arr)  ||
+           min(expr).getFloat() != min(expect)  ||
+           max(expr).getFloat() != max(expect)) {
+         cout << "   Unmasked reductions are incorrect" << endl;
+         ok = False;
+       }
+       LatticeExprNode masked (node[node > Float(100)]);
+       if (sum(masked).getFloat() != 91*146  ||
+           mean(masked).getFloat() != 146  ||
+           min(masked).getFloat() != 101  ||
+           max(masked).getFloat() != 191) {
+         cout << "   Masked reductions are incorrect" << endl;
+         ok = False;
+       }
+     }
+
+//
+// Common subexpressions are evaluated once per chunk.
+//
+     {
+       cout << "Common subexpressions" << endl;
+       IPosition shp(2,16,12);
+       Array<Float> arrA(shp), arrB(shp);
+       indgen (arrA);
+       indgen (arrB, Float(1), Float(0.5));
+       CountingLattice latA(arrA);
+       ArrayLattice<Float> latB(arrB);
+       LatticeExprNode a(latA);
+       LatticeExprNode b(latB);
+       // Equal subtrees built separately, used by different parents.
+       LatticeExpr<Float> expr (sin(a+b) * (a+b) + sin(a+b) / Float(2) +
+                                (a+b));
+       Array<Float> sum1 (arrA + arrB);
+       Array<Float> expect (sin(sum1) * sum1 + sin(sum1) / Float(2) + sum1);
+       LatticeStepper stepper(shp, IPosition(2,5,4), LatticeStepper::RESIZE);
+       ArrayLattice<Float> out(shp);
+       out.copyData (expr);
+       if (!allNear (out.get(), expect, 1e-5)) {
+         cout << "   Shared subexpressions give incorrect results" << endl;
+         ok = False;
+       }
+       // The lattice is read once per chunk.
+       CountingLattice::theirNGet = 0;
+       Block<Array<Float> > values(3);
+       Block<Array<Bool> > masks(3);
+       Block<IPosition> positions(3);
+       Array<Float> result(shp);
+       uInt nchunk;
+       uInt ntotal = 0;
+       while ((nchunk = expr.evalChunks (values, masks, positions,
+                                         stepper)) > 0) {
+         for (uInt i=0; i<nchunk; i++) {
+           result(Slicer(positions[i], values[i].shape())) = values[i];
+         }
+         ntotal += nchunk;
+       }
+       if (CountingLattice::theirNGet != ntotal) {
+         cout << "   Shared subexpression evaluated "
+              << CountingLattice::theirNGet << " times for "
+              << ntotal << " chunks" << endl;
+         ok = False;
+       }
+       if (!allNear (result, expect, 1e-5)) {
+         cout << "   Shared subexpressions in chunks are incorrect" << endl;
+         ok = False;
+       }
+       // Masked subexpressions and scalar operands.
+       LatticeExprNode ma (a[a > Float(20)]);
+       LatticeExpr<Float> exprm ((ma*2 + 1) * (ma*2 + 1) - (ma*2 + 1));
+       Array<Float> tmp (arrA*Float(2) + Float(1));
+       Array<Float> expectm (tmp*tmp - tmp);
+       Array<Float> valm;
+       exprm.getSlice (valm, IPosition(2,0), shp);
+       Array<Bool> maskm = exprm.getMask();
+       if (!allEQ (maskm, arrA > Float(20))  ||
+           !allNear (valm(arrA > Float(20)).getCompressedArray(),
+                     expectm(arrA > Float(20)).getCompressedArray(),
+                     1e-5)) {
+         cout << "   Masked shared subexpressions are incorrect" << endl;
+         ok = False;
+       }
+       // Different scalars must not be shared.
+       LatticeExpr<Float> exprs ((a+2) * (a+3));
+       if (!allNear (exprs.get(), (arrA+Float(2)) * (arrA+Float(3)), 1e-5)) {
+         cout << "   Subexpressions with different scalars are shared"
+              << endl;
+         ok = False;
+       }
+     }
 
 
   cout << endl;
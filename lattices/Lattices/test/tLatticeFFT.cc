@@ -27,6 +27,8 @@
 
 #include <casa/aips.h>
 #include <casa/Arrays/MaskArrLogi.h>
+#include <casa/Arrays/ArrayMath.h>
+#include <casa/Arrays/ArrayLogical.h>
 #include <casa/Arrays/Vector.h>
 #include <casa/Exceptions/Error.h>
 #include <casa/Arrays/IPosition.h>
@@ -36,6 +38,8 @@
 #include <lattices/Lattices/LatticeFFT.h>
 #include <lattices/Lattices/LatticeIterator.h>
 #include <lattices/Lattices/PagedArray.h>
+#include <lattices/Lattices/TiledShape.h>
+#include <scimath/Mathematics/FFTServer.h>
 #include <casa/iostream.h>
 
 #include <casa/namespace.h>
@@ -176,6 +180,41 @@ int main() {
  	}
       }
     }
+    { // test asymmetric data on small tiles against FFTServer
+      const IPosition shape(3,6,5,4);
+      const IPosition hShape(3,4,5,4);
+      const IPosition tileShape(3,2,2,3);
+      Array<Float> rArr(shape);
+      indgen (rArr);
+      rArr = sin(rArr);
+      Array<Complex> cArr(shape);
+      convertArray (cArr, rArr);
+      cArr += Complex(0,1) * cArr * cArr;
+      FFTServer<Float,Complex> ffts;
+      { // complex->complex
+	PagedArray<Complex> cLat(TiledShape(shape, tileShape));
+	cLat.put (cArr);
+	LatticeFFT::cfft (cLat);
+	Array<Complex> expect (cArr.copy());
+	ffts.fft (expect, True);
+	AlwaysAssert(allNearAbs(cLat.get(), expect, 1E-4), AipsError);
+	LatticeFFT::cfft (cLat, False);
+	AlwaysAssert(allNearAbs(cLat.get(), cArr, 1E-5), AipsError);
+      }
+      { // real->complex and back
+	PagedArray<Float> rLat(TiledShape(shape, tileShape));
+	rLat.put (rArr);
+	PagedArray<Complex> hLat(TiledShape(hShape, tileShape));
+	LatticeFFT::rcfft (hLat, rLat);
+	AlwaysAssert(allEQ(rLat.get(), rArr), AipsError);
+	Array<Complex> expect;
+	ffts.fft (expect, rArr);
+	AlwaysAssert(allNearAbs(hLat.get(), expect, 1E-4), AipsError);
+	PagedArray<Float> rOut(TiledShape(shape, tileShape));
+	LatticeFFT::crfft (rOut, hLat);
+	AlwaysAssert(allNearAbs(rOut.get(), rArr, 1E-5), AipsError);
+      }
+    }
     cout<< "OK"<< endl;
     return 0;
   } catch (AipsError x) {
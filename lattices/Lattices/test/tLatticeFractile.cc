@@ -28,6 +28,7 @@
 
 #include <lattices/Lattices/ArrayLattice.h>
 #include <lattices/Lattices/TempLattice.h>
+#include <lattices/Lattices/SubLattice.h>
 #include <lattices/Lattices/LatticeIterator.h>
 #include <lattices/Lattices/LatticeFractile.h>
 #include <lattices/Lattices/LatticeExpr.h>
@@ -37,6 +38,7 @@
 #include <casa/Inputs/Input.h>
 #include <casa/OS/Timer.h>
 #include <casa/Exceptions/Error.h>
+#include <casa/Utilities/Assert.h>
 #include <casa/iostream.h>
 
 
@@ -156,6 +158,39 @@ int main (int argc, const char* argv[])
 	   << endl;
     }
 
+    {
+      // Multiple fractiles at once must match the single ones.
+      IPosition shape(2, 32*nx, 32*ny);
+      Array<Float> arr(shape);
+      indgen (arr);
+      ArrayLattice<Float> aF(arr);
+      SubLattice<Float> subF(aF);
+      LatticeExprNode afExpr(aF);
+      LatticeExpr<Float> expr(afExpr[aF>4]);
+      Vector<Float> fractions(4);
+      fractions(0) = 0.5;
+      fractions(1) = 0.25;
+      fractions(2) = 0.75;
+      fractions(3) = 0.1;
+      uInt smallSizes[] = {4096*4096, 1000, 16, 2};
+      for (uInt j=0; j<4; j++) {
+	Vector<Float> res1 = LatticeFractile<Float>::maskedFractiles
+	                                   (subF, fractions, smallSizes[j]);
+	Vector<Float> res2 = LatticeFractile<Float>::maskedFractiles
+	                                   (expr, fractions, smallSizes[j]);
+	AlwaysAssertExit (res1.nelements() == 4  &&  res2.nelements() == 4);
+	for (uInt i=0; i<fractions.nelements(); i++) {
+	  AlwaysAssertExit (res1(i) == LatticeFractile<Float>::maskedFractile
+			    (subF, fractions(i), smallSizes[j])(0));
+	  AlwaysAssertExit (res2(i) == LatticeFractile<Float>::maskedFractile
+			    (expr, fractions(i), smallSizes[j])(0));
+	}
+      }
+      LatticeExpr<Float> emptyExpr(afExpr[aF<0]);
+      AlwaysAssertExit (LatticeFractile<Float>::maskedFractiles
+			(emptyExpr, fractions, 2).nelements() == 0);
+    }
+
     // Hereafter numbers can be different on different machines.
     // So 'outcomment' it for assay (and also outcomment the timings).
     cout << ">>>" << endl;
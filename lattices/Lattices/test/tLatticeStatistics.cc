@@ -28,6 +28,7 @@
 #include <casa/aips.h>
 #include <casa/Arrays/Array.h>
 #include <casa/Arrays/ArrayMath.h>
+#include <casa/Arrays/ArrayLogical.h>
 #include <casa/Exceptions/Error.h>
 #include <casa/Inputs/Input.h>
 #include <casa/Logging.h>
@@ -43,6 +44,9 @@
 #include <casa/System/PGPlotter.h>
 
 #include <casa/iostream.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 #include <casa/namespace.h>
@@ -59,6 +63,7 @@ void test1DFloat (LatticeStatistics<Float>& stats, const Vector<Float>& results,
                   const Vector<Bool>& hasResult, const IPosition& shape);
 void test2DFloat (LatticeStatistics<Float>& stats, const Vector<Float>& results,
                   const Vector<Bool>& hasResult, const IPosition& shape);
+void doPlanesFloat (LogIO& os);
 
 
 int main()
@@ -68,6 +73,7 @@ int main()
       LogIO os(lor);
 //
       doitFloat(os);
+      doPlanesFloat(os);
    } catch (AipsError x) {
      cerr << "aipserror: error " << x.getMesg() << endl;
      return 1;
@@ -334,3 +340,57 @@ void test2DFloat (LatticeStatistics<Float>& stats, const Vector<Float>& results,
    }
 }
 
+
+
+void doPlanesFloat (LogIO& os)
+{
+// Per-plane statistics of a cube must be the same whether the planes
+// are accumulated by one or by multiple threads.
+
+   IPosition shape(3,40,30,24);
+   Array<Float> arr(shape);
+   indgen(arr);
+   arr = sin(arr) * Float(10);
+   ArrayLattice<Float> lat(arr);
+   SubLattice<Float> subLat(lat);
+   Vector<Int> axes(2);
+   axes(0) = 0;
+   axes(1) = 1;
+   Array<Double> parSum, parSumsq, parVar, parMin, parMax;
+   {
+      LatticeStatistics<Float> stats(subLat, os, False, False);
+      AlwaysAssert(stats.setAxes(axes), AipsError);
+      AlwaysAssert(stats.getStatistic (parSum, LatticeStatsBase::SUM), AipsError);
+      AlwaysAssert(stats.getStatistic (parSumsq, LatticeStatsBase::SUMSQ),
+                   AipsError);
+      AlwaysAssert(stats.getStatistic (parVar, LatticeStatsBase::VARIANCE),
+                   AipsError);
+      AlwaysAssert(stats.getStatistic (parMin, LatticeStatsBase::MIN), AipsError);
+      AlwaysAssert(stats.getStatistic (parMax, LatticeStatsBase::MAX), AipsError);
+   }
+#ifdef _OPENMP
+   Int nthr = omp_get_max_threads();
+   omp_set_num_threads (1);
+#endif
+   Array<Double> sum, sumsq, var, mn, mx;
+   {
+      LatticeStatistics<Float> stats(subLat, os, False, False);
+      AlwaysAssert(stats.setAxes(axes), AipsError);
+      AlwaysAssert(stats.getStatistic (sum, LatticeStatsBase::SUM), AipsError);
+      AlwaysAssert(stats.getStatistic (sumsq, LatticeStatsBase::SUMSQ),
+                   AipsError);
+      AlwaysAssert(stats.getStatistic (var, LatticeStatsBase::VARIANCE),
+                   AipsError);
+      AlwaysAssert(stats.getStatistic (mn, LatticeStatsBase::MIN), AipsError);
+      AlwaysAssert(stats.getStatistic (mx, LatticeStatsBase::MAX), AipsError);
+   }
+#ifdef _OPENMP
+   omp_set_num_threads (nthr);
+#endif
+   AlwaysAssert(sum.shape() == IPosition(1,shape(2)), AipsError);
+   AlwaysAssert(allEQ(parSum, sum), AipsError);
+   AlwaysAssert(allEQ(parSumsq, sumsq), AipsError);
+   AlwaysAssert(allEQ(parVar, var), AipsError);
+   AlwaysAssert(allEQ(parMin, mn), AipsError);
+   AlwaysAssert(allEQ(parMax, mx), AipsError);
+}
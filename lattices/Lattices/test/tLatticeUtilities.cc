@@ -44,6 +44,8 @@
 #include <lattices/Lattices/LatticeExprNode.h>
 #include <lattices/Lattices/LatticeExpr.h>
 #include <lattices/Lattices/ArrayLattice.h>
+#include <lattices/Lattices/PagedArray.h>
+#include <lattices/Lattices/TiledShape.h>
 
 #include <casa/iostream.h>
 
@@ -53,6 +55,7 @@ void doCollapse();
 void doCopy();
 void doReplicate();
 void doBin();
+void doRetile();
 
 int main()
 {
@@ -78,6 +81,10 @@ int main()
 
      doBin();
 
+// Retile
+
+     doRetile();
+
   } catch (AipsError x) {
     cout<< "FAIL"<< endl;
     cerr << x.getMesg() << endl;
@@ -305,3 +312,53 @@ void doBin ()
    AlwaysAssert(allEQ(mArrOut.getMask(),True), AipsError);
 }
 
+
+void doRetile ()
+{
+    cerr << "copyRetiled" << endl;
+// Blocks contain whole input and output tiles.
+    {
+       IPosition shape(3, 64, 64, 32);
+       IPosition inTile(3, 64, 64, 1);
+       IPosition outTile(3, 8, 8, 32);
+       AlwaysAssert(LatticeUtilities::retileBlockShape
+                    (shape, inTile, outTile, 1000000) == shape, AipsError);
+       AlwaysAssert(LatticeUtilities::retileBlockShape
+                    (shape, IPosition(3,6,64,3), outTile, 1000000) ==
+                    IPosition(3,24,64,32), AipsError);
+// Too large blocks are reduced in whole output tiles.
+       AlwaysAssert(LatticeUtilities::retileBlockShape
+                    (shape, inTile, outTile, 32768) ==
+                    IPosition(3,32,32,32), AipsError);
+       AlwaysAssert(LatticeUtilities::retileBlockShape
+                    (shape, inTile, outTile, 10) == outTile, AipsError);
+    }
+// Copy a plane-tiled array to a spectrum-tiled one.
+    {
+       IPosition shape(3, 16, 12, 20);
+       PagedArray<Float> latIn (TiledShape(shape, IPosition(3,16,12,1)));
+       Array<Float> arr(shape);
+       indgen(arr);
+       latIn.put (arr);
+       PagedArray<Float> latOut (TiledShape(shape, IPosition(3,2,3,20)));
+       LatticeUtilities::copyRetiled (latOut, latIn);
+       AlwaysAssert(latOut.tileShape() == IPosition(3,2,3,20), AipsError);
+       AlwaysAssert(allEQ(latOut.get(), arr), AipsError);
+// And back to tiles not fitting the shape integrally.
+       PagedArray<Float> latOut2 (TiledShape(shape, IPosition(3,5,5,3)));
+       LatticeUtilities::copyRetiled (latOut2, latOut, 1);
+       AlwaysAssert(allEQ(latOut2.get(), arr), AipsError);
+// Non-paged lattices can be used too.
+       ArrayLattice<Float> latOut3 (shape);
+       LatticeUtilities::copyRetiled (latOut3, latOut2);
+       AlwaysAssert(allEQ(latOut3.get(), arr), AipsError);
+       ArrayLattice<Float> latBad (IPosition(3,16,12,19));
+       Bool failed = False;
+       try {
+          LatticeUtilities::copyRetiled (latBad, latIn);
+       } catch (AipsError& x) {
+          failed = True;
+       }
+       AlwaysAssert(failed, AipsError);
+    }
+}
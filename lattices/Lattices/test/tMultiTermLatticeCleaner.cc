@@ -0,0 +1,161 @@
+//# tMultiTermLatticeCleaner.cc: Test program for class MultiTermLatticeCleaner
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <lattices/Lattices/MultiTermLatticeCleaner.h>
+#include <lattices/Lattices/ArrayLattice.h>
+#include <casa/Arrays/Array.h>
+#include <casa/Arrays/ArrayMath.h>
+#include <casa/Arrays/IPosition.h>
+#include <casa/Arrays/Vector.h>
+#include <casa/BasicMath/Math.h>
+#include <casa/Quanta/Quantum.h>
+#include <casa/Exceptions/Error.h>
+#include <casa/iostream.h>
+#include <casa/iomanip.h>
+
+#include <casa/namespace.h>
+
+// Fill the image with a gaussian times a factor linear in x.
+void addGaussian (Array<Float>& image, Float xc, Float yc, Float flux,
+                  Float width, Float slope)
+{
+  const IPosition& shape = image.shape();
+  for (Int y=0; y<shape(1); y++) {
+    for (Int x=0; x<shape(0); x++) {
+      Float dx = x - xc;
+      Float dy = y - yc;
+      image(IPosition(4,x,y,0,0)) += flux * (1 + slope*dx) *
+        exp(-(dx*dx + dy*dy) / (2*width*width));
+    }
+  }
+}
+
+// Compare the value with the result of the original implementation.
+Bool check (const String& name, Double value, Double expected)
+{
+  if (!near (value, expected, 1e-4)  &&  !nearAbs (value, expected, 1e-6)) {
+    cout << name << " is " << setprecision(8) << value
+         << ", expected " << expected << endl;
+    return False;
+  }
+  return True;
+}
+
+// Clean a spectral index source and a flat extended source, optionally
+// in a mask, and check the model and residual of both Taylor terms.
+Bool doClean (Bool useMask, const Double* expected)
+{
+  const IPosition shape(4,64,64,1,1);
+  // The PSFs of the Taylor terms 0, 1 and 2.
+  Array<Float> psf[3];
+  Float slopes[3] = {0., 0.2, 0.};
+  Float fluxes[3] = {1., 0.1, 0.05};
+  Float widths[3] = {2., 2., 3.};
+  for (uInt i=0; i<3; i++) {
+    psf[i].resize (shape);
+    psf[i] = 0;
+    addGaussian (psf[i], 32, 32, fluxes[i], widths[i], slopes[i]);
+  }
+  // The residuals of both Taylor terms.
+  Array<Float> dirty0(shape), dirty1(shape);
+  dirty0 = 0;
+  dirty1 = 0;
+  addGaussian (dirty0, 24, 30, 1.0, 2, 0.);
+  addGaussian (dirty1, 24, 30, -0.3, 2, 0.);
+  addGaussian (dirty0, 40, 38, 0.5, 5, 0.);
+  addGaussian (dirty1, 40, 38, 0.1, 5, 0.);
+  Array<Float> mask(shape);
+  mask = 0;
+  mask(IPosition(4,16,16,0,0), IPosition(4,47,47,0,0)) = 1;
+
+  MultiTermLatticeCleaner<Float> cleaner;
+  cleaner.setntaylorterms (2);
+  Vector<Float> scales(2);
+  scales(0) = 0;
+  scales(1) = 4;
+  cleaner.setscales (scales);
+  cleaner.initialise (shape(0), shape(1));
+  cleaner.setcontrol (CleanEnums::MULTISCALE, 50, 0.1,
+                      Quantity(0.001, "Jy"), False);
+  for (uInt i=0; i<3; i++) {
+    ArrayLattice<Float> psfLat(psf[i]);
+    cleaner.setpsf (i, psfLat);
+  }
+  ArrayLattice<Float> dirtyLat0(dirty0), dirtyLat1(dirty1);
+  cleaner.setresidual (0, dirtyLat0);
+  cleaner.setresidual (1, dirtyLat1);
+  ArrayLattice<Float> modelLat0(shape), modelLat1(shape);
+  modelLat0.set (0);
+  modelLat1.set (0);
+  cleaner.setmodel (0, modelLat0);
+  cleaner.setmodel (1, modelLat1);
+  if (useMask) {
+    ArrayLattice<Float> maskLat(mask);
+    cleaner.setmask (maskLat);
+  }
+  cleaner.mtclean();
+
+  Bool ok = True;
+  for (Int taylor=0; taylor<2; taylor++) {
+    String name = (useMask ? "masked " : "") + String::toString(taylor);
+    ArrayLattice<Float> model(shape), residual(shape);
+    cleaner.getmodel (taylor, model);
+    cleaner.getresidual (taylor, residual);
+    Array<Float> modelArr = model.get();
+    Array<Float> residArr = residual.get();
+    const Double* ref = expected + 4*taylor;
+    ok = check ("model sum " + name, sum(modelArr), ref[0]) && ok;
+    ok = check ("model max " + name, max(abs(modelArr)), ref[1]) && ok;
+    ok = check ("residual sum " + name, sum(residArr), ref[2]) && ok;
+    ok = check ("residual max " + name, max(abs(residArr)), ref[3]) && ok;
+  }
+  return ok;
+}
+
+int main()
+{
+  try {
+    // Results of the original serial implementation (the sum and maximum
+    // absolute value of the model and residual of each Taylor term).
+    const Double expected[8] = {2.6729207, 1.1515653, 103.67244, 1.0008308,
+                                -3.8467317, 4.6299973, 8.1681175, 0.29983386};
+    const Double expectedMask[8] = {2.7427816, 1.1515653, 103.67244, 1.0008308,
+                                    -3.8110404, 4.6299973, 8.1681175,
+                                    0.29983386};
+    Bool ok = doClean (False, expected);
+    ok = doClean (True, expectedMask) && ok;
+    if (!ok) {
+      cout << "not ok" << endl;
+      return 1;
+    }
+  } catch (AipsError x) {
+    cout << "Caught exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
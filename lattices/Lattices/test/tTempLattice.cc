@@ -27,6 +27,7 @@
 
 
 #include <lattices/Lattices/TempLattice.h>
+#include <lattices/Lattices/TempLatticeManager.h>
 #include <lattices/Lattices/LatticeIterator.h>
 #include <casa/Arrays/Array.h>
 #include <casa/Arrays/ArrayMath.h>
@@ -73,6 +74,70 @@ void doIt (TempLattice<Int>& scratch)
     AlwaysAssert(scratch.getAt(IPosition(3,7)) == 7, AipsError);
 }
 
+void testManager()
+{
+    // Use a budget of 1 MB shared by lattices of 256 KB.
+    TempLatticeManager::setBudget (1);
+    AlwaysAssertExit (TempLatticeManager::budget() == 1024*1024);
+    IPosition shape(3,64,64,16);
+    IPosition pos(3,1,2,3);
+    {
+      TempLattice<Int> lat1(shape), lat2(shape), lat3(shape), lat4(shape);
+      AlwaysAssertExit (TempLatticeManager::nInMemory() == 4);
+      AlwaysAssertExit (TempLatticeManager::used() == 1024*1024);
+      lat1.set(1);
+      lat2.set(2);
+      lat3.set(3);
+      lat4.set(4);
+      // A too large lattice is put on disk.
+      {
+        TempLattice<Int> large(IPosition(3,64,64,128));
+        AlwaysAssertExit (large.isPaged());
+        AlwaysAssertExit (TempLatticeManager::nInMemory() == 4);
+      }
+      RO_LatticeIterator<Int>* iter2;
+      {
+        // lat2 is least recently used, so it is spilled.
+        lat1.set(1);
+        TempLattice<Int> lat5(shape);
+        AlwaysAssertExit (! lat5.isPaged());
+        AlwaysAssertExit (lat2.isPaged());
+        AlwaysAssertExit (! lat1.isPaged());
+        AlwaysAssertExit (TempLatticeManager::nInMemory() == 4);
+        // No memory is free, so lat2 stays on disk.
+        AlwaysAssertExit (lat2.getAt(pos) == 2);
+        AlwaysAssertExit (lat2.isPaged());
+        iter2 = new RO_LatticeIterator<Int> (lat2);
+        // lat3 is least recently used, but referenced by an iterator.
+        RO_LatticeIterator<Int> iter3(lat3);
+        lat4.set(4);
+        lat1.set(1);
+        lat5.set(5);
+        TempLattice<Int> lat6(shape);
+        AlwaysAssertExit (! lat3.isPaged());
+        AlwaysAssertExit (lat4.isPaged());
+        AlwaysAssertExit (allEQ (iter3.cursor(), 3));
+        AlwaysAssertExit (lat4.getAt(pos) == 4);
+      }
+      // Memory is free again, but lat2 is still used by an iterator.
+      AlwaysAssertExit (TempLatticeManager::nInMemory() == 2);
+      AlwaysAssertExit (lat2.getAt(pos) == 2);
+      AlwaysAssertExit (lat2.isPaged());
+      AlwaysAssertExit (allEQ (iter2->cursor(), 2));
+      delete iter2;
+      // Now the lattices on disk are read back into memory.
+      AlwaysAssertExit (lat2.getAt(pos) == 2);
+      AlwaysAssertExit (! lat2.isPaged());
+      lat4.tempClose();
+      AlwaysAssertExit (allEQ (lat4.get(), 4));
+      AlwaysAssertExit (! lat4.isPaged());
+      AlwaysAssertExit (TempLatticeManager::nInMemory() == 4);
+    }
+    AlwaysAssertExit (TempLatticeManager::nInMemory() == 0);
+    AlwaysAssertExit (TempLatticeManager::used() == 0);
+    TempLatticeManager::setBudget (-1);
+}
+
 int main() {
   try {
     {
@@ -86,6 +151,7 @@ int main() {
       AlwaysAssertExit (! small.isPaged());
       doIt (small);
     }
+    testManager();
   } catch (AipsError x) {
     cerr << x.getMesg() << endl;
     cout << "FAIL" << endl;
@@ -0,0 +1,152 @@
+//# tTileShapeAdvisor.cc: Test program for class TileShapeAdvisor
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <lattices/Lattices/TileShapeAdvisor.h>
+#include <lattices/Lattices/TiledShape.h>
+#include <lattices/Lattices/PagedArray.h>
+#include <lattices/Lattices/LatticeIterator.h>
+#include <lattices/Lattices/LatticeStepper.h>
+#include <casa/BasicMath/Math.h>
+#include <casa/Utilities/Assert.h>
+#include <casa/Exceptions/Error.h>
+#include <casa/iostream.h>
+
+
+#include <casa/namespace.h>
+// <summary>
+// Test program for TileShapeAdvisor class.
+// </summary>
+
+void testSmall()
+{
+  // A lattice smaller than the minimum tile size is a single tile.
+  TileShapeAdvisor adv (IPosition(2,16,8));
+  adv.addLines (1);
+  AlwaysAssertExit (adv.tileShape() == IPosition(2,16,8));
+  AlwaysAssertExit (adv.cacheSize (IPosition(2,16,8)) == 1);
+}
+
+void testPatterns()
+{
+  // A cube with a cache of 256 kBytes.
+  IPosition shape(3,128,128,512);
+  TileShapeAdvisor adv (shape, sizeof(Float), 256*1024);
+  AlwaysAssertExit (adv.shape() == shape);
+  AlwaysAssertExit (adv.maxCacheSize() == 256*1024);
+  IPosition defTile = TiledShape(shape).tileShape();
+  // Spectra only: long tiles along the spectral axis.
+  adv.addLines (2);
+  AlwaysAssertExit (adv.nPatterns() == 1);
+  AlwaysAssertExit (adv.sliceShape(0) == IPosition(3,1,1,512));
+  IPosition specTile = adv.tileShape();
+  cout << "spectra: " << specTile << ' ' << adv.cost(specTile)
+       << "  default: " << defTile << ' ' << adv.cost(defTile) << endl;
+  AlwaysAssertExit (specTile.product() >= 4096  &&
+		    specTile.product() <= 131072);
+  AlwaysAssertExit (specTile(2) > specTile(0)  &&  specTile(2) > specTile(1));
+  AlwaysAssertExit (adv.cost(specTile) <= adv.cost(defTile));
+  uInt ncache = adv.cacheSize (specTile);
+  AlwaysAssertExit (ncache >= 1);
+  AlwaysAssertExit (ncache * specTile.product() * sizeof(Float)
+		    <= 1.1 * 256*1024);
+  // Planes only: tiles covering large parts of the planes.
+  adv.clear();
+  AlwaysAssertExit (adv.nPatterns() == 0);
+  adv.addPlanes (0, 1);
+  IPosition planeTile = adv.tileShape();
+  cout << "planes: " << planeTile << ' ' << adv.cost(planeTile) << endl;
+  AlwaysAssertExit (planeTile(0) > planeTile(2)  &&
+		    planeTile(1) > planeTile(2));
+  AlwaysAssertExit (adv.cost(planeTile) <= adv.cost(defTile));
+  AlwaysAssertExit (adv.cost(planeTile) < adv.cost(specTile));
+  // A full sweep reads each tile once, so favours big tiles.
+  adv.clear();
+  adv.addSweep (2);
+  IPosition sweepTile = adv.tileShape();
+  AlwaysAssertExit (sweepTile.product() > 65536);
+  // Mixed access patterns give a cost in between.
+  adv.clear();
+  adv.addLines (2, 10);
+  adv.addPlanes (0, 1, 1);
+  IPosition mixTile = adv.tileShape();
+  cout << "mixed: " << mixTile << ' ' << adv.cost(mixTile) << endl;
+  AlwaysAssertExit (adv.cost(mixTile) <= adv.cost(specTile));
+  AlwaysAssertExit (adv.cost(mixTile) <= adv.cost(planeTile));
+  // Copying keeps the patterns.
+  TileShapeAdvisor adv2(adv);
+  AlwaysAssertExit (adv2.nPatterns() == 2);
+  AlwaysAssertExit (adv2.tileShape() == mixTile);
+  TileShapeAdvisor adv3 (IPosition(1,10));
+  adv3 = adv;
+  AlwaysAssertExit (adv3.shape() == shape);
+  AlwaysAssertExit (adv3.weight(0) == 10);
+}
+
+void testTrace()
+{
+  IPosition shape(3,16,12,20);
+  PagedArray<Float> arr (TiledShape(shape, IPosition(3,8,6,5)));
+  arr.set (1.);
+  TileShapeAdvisor adv (shape);
+  arr.setAccessTracer (&adv);
+  AlwaysAssertExit (arr.accessTracer() == &adv);
+  // Read all spectra; each adds 1/(16*12) of a traversal.
+  LatticeStepper stepper (shape, IPosition(3,1,1,20), IPosition(3,2,0,1));
+  RO_LatticeIterator<Float> iter (arr, stepper);
+  Float sum = 0;
+  for (iter.reset(); !iter.atEnd(); iter++) {
+    sum += iter.cursor()(IPosition(3,0,0,0));
+  }
+  AlwaysAssertExit (sum == 16*12);
+  AlwaysAssertExit (adv.nPatterns() == 1);
+  AlwaysAssertExit (adv.sliceShape(0) == IPosition(3,1,1,20));
+  AlwaysAssertExit (near (adv.weight(0), 1.));
+  // A put of a plane is traced too (the lattice is a copy).
+  PagedArray<Float> arr2(arr);
+  arr2.putSlice (Array<Float>(IPosition(2,16,12), 2.), IPosition(3,0,0,3));
+  AlwaysAssertExit (adv.nPatterns() == 2);
+  AlwaysAssertExit (adv.sliceShape(1) == IPosition(3,16,12,1));
+  AlwaysAssertExit (near (adv.weight(1), 1./20));
+  // No tracing anymore.
+  arr.setAccessTracer (0);
+  arr.getAt (IPosition(3,0,0,0));
+  AlwaysAssertExit (adv.nPatterns() == 2);
+}
+
+int main()
+{
+  try {
+    testSmall();
+    testPatterns();
+    testTrace();
+  } catch (AipsError& x) {
+    cout << "Caught exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
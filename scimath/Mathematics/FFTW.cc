@@ -125,6 +125,7 @@ namespace casa {
 
   FFTW::~FFTW()
   {
+    ScopedMutexLock lock(theirMutex);
     delete itsPlanR2Cf;
     delete itsPlanR2C;
     delete itsPlanC2Rf;
@@ -147,6 +148,7 @@ namespace casa {
 
   void FFTW::plan_r2c(const IPosition &size, Float *in, Complex *out) 
   {
+    ScopedMutexLock lock(theirMutex);
     delete itsPlanR2Cf;
     itsPlanR2Cf = new FFTWPlanf
       (fftwf_plan_dft_r2c(size.nelements(),
@@ -158,6 +160,7 @@ namespace casa {
 
   void FFTW::plan_r2c(const IPosition &size, Double *in, DComplex *out) 
   {
+    ScopedMutexLock lock(theirMutex);
     delete itsPlanR2C;
     itsPlanR2C = new FFTWPlan
       (fftw_plan_dft_r2c(size.nelements(),
@@ -168,6 +171,7 @@ namespace casa {
   }
 
   void FFTW::plan_c2r(const IPosition &size, Complex *in, Float *out) {
+    ScopedMutexLock lock(theirMutex);
     delete itsPlanC2Rf;
     itsPlanC2Rf = new FFTWPlanf
       (fftwf_plan_dft_c2r(size.nelements(),
@@ -179,6 +183,7 @@ namespace casa {
   }
 
   void FFTW::plan_c2r(const IPosition &size, DComplex *in, Double *out) {
+    ScopedMutexLock lock(theirMutex);
     delete itsPlanC2R;
     itsPlanC2R = new FFTWPlan
       (fftw_plan_dft_c2r(size.nelements(),
@@ -189,6 +194,7 @@ namespace casa {
   }
 
   void FFTW::plan_c2c_forward(const IPosition &size, DComplex *in) {
+    ScopedMutexLock lock(theirMutex);
     delete itsPlanC2CF;
     itsPlanC2CF = new FFTWPlan
       (fftw_plan_dft(size.nelements(),
@@ -200,6 +206,7 @@ namespace casa {
   }
     
   void FFTW::plan_c2c_forward(const IPosition &size, Complex *in) {
+    ScopedMutexLock lock(theirMutex);
     delete itsPlanC2CFf;
     itsPlanC2CFf = new FFTWPlanf
       (fftwf_plan_dft(size.nelements(),
@@ -210,6 +217,7 @@ namespace casa {
   }
 
   void FFTW::plan_c2c_backward(const IPosition &size, DComplex *in) {
+    ScopedMutexLock lock(theirMutex);
     delete itsPlanC2CB;
     itsPlanC2CB = new FFTWPlan
       (fftw_plan_dft(size.nelements(),
@@ -221,6 +229,7 @@ namespace casa {
   }
     
   void FFTW::plan_c2c_backward(const IPosition &size, Complex *in) {
+    ScopedMutexLock lock(theirMutex);
     delete itsPlanC2CBf;
     itsPlanC2CBf = new FFTWPlanf
       (fftwf_plan_dft(size.nelements(),
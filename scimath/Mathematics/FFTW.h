@@ -96,7 +96,8 @@ private:
   static volatile Bool is_initialized_fftw;  // FFTW needs initialization
                                              // only once per process,
                                              // not once per object
-  static Mutex theirMutex;          // Initialization mutex
+  static Mutex theirMutex;          // Mutex for initialization and
+                                    // planning (not thread-safe in FFTW)
 };    
     
 } //# NAMESPACE CASA - END
@@ -35,7 +35,9 @@
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
-Interpolate2D::Interpolate2D(Interpolate2D::Method method) {
+Interpolate2D::Interpolate2D(Interpolate2D::Method method)
+: itsMethod (method)
+{
 
 // Set up function pointers to correct method
 
@@ -59,7 +61,8 @@ Interpolate2D::Interpolate2D(Interpolate2D::Method method) {
 }
 
 Interpolate2D::Interpolate2D(const Interpolate2D &other)
-: itsFuncPtrFloat (other.itsFuncPtrFloat),
+: itsMethod       (other.itsMethod),
+  itsFuncPtrFloat (other.itsFuncPtrFloat),
   itsFuncPtrDouble(other.itsFuncPtrDouble),
   itsFuncPtrBool  (other.itsFuncPtrBool)
 {}
@@ -69,6 +72,7 @@ Interpolate2D::~Interpolate2D()
 
 Interpolate2D &Interpolate2D::operator=(const Interpolate2D &other)
 {
+   itsMethod        = other.itsMethod;
    itsFuncPtrFloat  = other.itsFuncPtrFloat;
    itsFuncPtrDouble = other.itsFuncPtrDouble;
    itsFuncPtrBool   = other.itsFuncPtrBool;
@@ -141,6 +145,70 @@ Bool Interpolate2D::interp(Bool &result,
 
 
 
+// Batch versions
+
+void Interpolate2D::interp (Vector<Float>& result, Vector<Bool>& ok,
+                            const Vector<Double>& x, const Vector<Double>& y,
+                            const Matrix<Float>& data) const
+{
+  interpMany (result, ok, x, y, data, 0);
+}
+
+void Interpolate2D::interp (Vector<Float>& result, Vector<Bool>& ok,
+                            const Vector<Double>& x, const Vector<Double>& y,
+                            const Matrix<Float>& data,
+                            const Matrix<Bool>& mask) const
+{
+  interpMany (result, ok, x, y, data, &mask);
+}
+
+void Interpolate2D::interp (Vector<Double>& result, Vector<Bool>& ok,
+                            const Vector<Double>& x, const Vector<Double>& y,
+                            const Matrix<Double>& data) const
+{
+  interpMany (result, ok, x, y, data, 0);
+}
+
+void Interpolate2D::interp (Vector<Double>& result, Vector<Bool>& ok,
+                            const Vector<Double>& x, const Vector<Double>& y,
+                            const Matrix<Double>& data,
+                            const Matrix<Bool>& mask) const
+{
+  interpMany (result, ok, x, y, data, &mask);
+}
+
+void Interpolate2D::interp (Vector<Complex>& result, Vector<Bool>& ok,
+                            const Vector<Double>& x, const Vector<Double>& y,
+                            const Matrix<Complex>& data) const
+{
+  interpManyComplex<Complex,Float> (result, ok, x, y, data, 0);
+}
+
+void Interpolate2D::interp (Vector<Complex>& result, Vector<Bool>& ok,
+                            const Vector<Double>& x, const Vector<Double>& y,
+                            const Matrix<Complex>& data,
+                            const Matrix<Bool>& mask) const
+{
+  interpManyComplex<Complex,Float> (result, ok, x, y, data, &mask);
+}
+
+void Interpolate2D::interp (Vector<DComplex>& result, Vector<Bool>& ok,
+                            const Vector<Double>& x, const Vector<Double>& y,
+                            const Matrix<DComplex>& data) const
+{
+  interpManyComplex<DComplex,Double> (result, ok, x, y, data, 0);
+}
+
+void Interpolate2D::interp (Vector<DComplex>& result, Vector<Bool>& ok,
+                            const Vector<Double>& x, const Vector<Double>& y,
+                            const Matrix<DComplex>& data,
+                            const Matrix<Bool>& mask) const
+{
+  interpManyComplex<DComplex,Double> (result, ok, x, y, data, &mask);
+}
+
+
+
 // Private functions
 
 Bool Interpolate2D::interpNearestBool(Bool &result, 
@@ -245,7 +313,29 @@ void Interpolate2D::bcucof (Double c[4][4], const Double y[4],
     {0,0,0,0,0,0,0,0,2,-2,0,0,1,1,0,0},
     {-6,6,-6,6,-3,-3,3,3,-4,4,2,-2,-2,-2,-1,-1},
     {4,-4,4,-4,2,2,-2,-2,2,-2,-2,2,1,1,1,1} };
-  static Double X[16], CL[16];
+  // The column indices of the non-zero weights per row (to skip the
+  // multiplications by zero).
+  static const uInt wtStart[17] =
+  {0,1,2,6,10,11,12,16,20,24,28,44,60,64,68,84,100};
+  static const uInt wtIndex[100] =
+  { 0,
+    8,
+    0,3,8,11,
+    0,3,8,11,
+    4,
+    12,
+    4,7,12,15,
+    4,7,12,15,
+    0,1,4,5,
+    8,9,12,13,
+    0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+    0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+    0,1,4,5,
+    8,9,12,13,
+    0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+    0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15 };
+  // Local scratch arrays, so interpolation is thread-safe.
+  Double X[16], CL[16];
   
   // Pack temporary
   for (uInt i=0; i<4; ++i) {
@@ -259,7 +349,9 @@ void Interpolate2D::bcucof (Double c[4][4], const Double y[4],
   
   for (uInt i=0; i<16; ++i) {
     CL[i] = 0.0;
-    for (uInt k=0; k<16; ++k) CL[i] += wt[i][k] * X[k];
+    for (uInt k=wtStart[i]; k<wtStart[i+1]; ++k) {
+      CL[i] += wt[i][wtIndex[k]] * X[wtIndex[k]];
+    }
   }
   
   // Unpack the result into the output table
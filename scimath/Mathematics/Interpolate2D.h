@@ -30,6 +30,7 @@
 
 //# Includes
 #include <casa/aips.h>
+#include <casa/BasicSL/Complexfwd.h>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
@@ -66,6 +67,15 @@ class String;
 // you supply data and mask, those arrays *must* be the same shape.
 // Failure to follow these rules will result in your program 
 // crashing.
+// <p>
+// Many positions can be interpolated in a single call by giving vectors
+// of x and y pixel coordinates. This avoids the per-position call overhead
+// and is much faster when interpolating entire planes (e.g. in ImageRegrid).
+// The nearest and linear interpolations are done by dedicated loops over
+// the data storage without branching on the mask; a position outside the
+// data does not cause an out-of-bounds access, but gives a False result.
+// The batch functions also handle Complex and DComplex data, for which the
+// real and imaginary parts are interpolated separately.
 // </synopsis>
 //
 // <example>
@@ -91,8 +101,6 @@ class String;
 //   <li> Now that there are float/double/bool versions, the class should
 //        be templated and specialized versions made as needed. The
 //        code duplucation in the Float/Double versions is pretty awful presently.
-//   <li> Alternative approach: instantiate with an Array, take a block of
-//        vector locations, return a block of interpolation results
 // </todo>
 
 
@@ -177,6 +185,41 @@ class Interpolate2D {
                 const Matrix<Bool> &data) const;
   // </group>
   
+  // Do the interpolation for many positions given by the pixel
+  // coordinates in <src>x</src> and <src>y</src> (which must have the same
+  // length). The result and the success flags are resized as needed.
+  // A flag is False if the interpolation failed (coordinate out of range or
+  // data masked); the result is then 0. The mask (True is good) must have
+  // the same shape as the data.
+  // As in the single position version, LANCZOS gives 0 (and True) for
+  // positions whose kernel support is not entirely inside the data.
+  // <group>
+  void interp (Vector<Float>& result, Vector<Bool>& ok,
+               const Vector<Double>& x, const Vector<Double>& y,
+               const Matrix<Float>& data) const;
+  void interp (Vector<Float>& result, Vector<Bool>& ok,
+               const Vector<Double>& x, const Vector<Double>& y,
+               const Matrix<Float>& data, const Matrix<Bool>& mask) const;
+  void interp (Vector<Double>& result, Vector<Bool>& ok,
+               const Vector<Double>& x, const Vector<Double>& y,
+               const Matrix<Double>& data) const;
+  void interp (Vector<Double>& result, Vector<Bool>& ok,
+               const Vector<Double>& x, const Vector<Double>& y,
+               const Matrix<Double>& data, const Matrix<Bool>& mask) const;
+  void interp (Vector<Complex>& result, Vector<Bool>& ok,
+               const Vector<Double>& x, const Vector<Double>& y,
+               const Matrix<Complex>& data) const;
+  void interp (Vector<Complex>& result, Vector<Bool>& ok,
+               const Vector<Double>& x, const Vector<Double>& y,
+               const Matrix<Complex>& data, const Matrix<Bool>& mask) const;
+  void interp (Vector<DComplex>& result, Vector<Bool>& ok,
+               const Vector<Double>& x, const Vector<Double>& y,
+               const Matrix<DComplex>& data) const;
+  void interp (Vector<DComplex>& result, Vector<Bool>& ok,
+               const Vector<Double>& x, const Vector<Double>& y,
+               const Matrix<DComplex>& data, const Matrix<Bool>& mask) const;
+  // </group>
+
   // Recover interpolation method
   Method interpolationMethod() const {return itsMethod;}
   
@@ -186,6 +229,32 @@ class Interpolate2D {
   
  private:
   
+  // Do the batch interpolation of real data.
+  template <typename T>
+  void interpMany (Vector<T>& result, Vector<Bool>& ok,
+                   const Vector<Double>& x, const Vector<Double>& y,
+                   const Matrix<T>& data, const Matrix<Bool>* maskPtr) const;
+
+  // Do the batch interpolation of complex data using the real type R.
+  template <typename T, typename R>
+  void interpManyComplex (Vector<T>& result, Vector<Bool>& ok,
+                          const Vector<Double>& x, const Vector<Double>& y,
+                          const Matrix<T>& data,
+                          const Matrix<Bool>* maskPtr) const;
+
+  // The batch nearest neighbour and bi-linear interpolation loops on
+  // contiguous data and mask (which can be a null pointer).
+  // <group>
+  template <typename T>
+  void batchNearest (T* result, Bool* ok, const Double* x, const Double* y,
+                     uInt npos, const T* data, const Bool* mask,
+                     Int nx, Int ny) const;
+  template <typename T>
+  void batchLinear (T* result, Bool* ok, const Double* x, const Double* y,
+                    uInt npos, const T* data, const Bool* mask,
+                    Int nx, Int ny) const;
+  // </group>
+
   // Are any of the mask pixels bad ? Returns False if no mask.
   Bool anyBadMaskPixels (const Matrix<Bool>* &mask, Int i1, Int i2,
 			 Int j1, Int j2) const;
@@ -28,7 +28,10 @@
 #include <scimath/Mathematics/Interpolate2D.h>
 #include <casa/Arrays/Matrix.h>
 #include <casa/Arrays/Vector.h>
+#include <casa/Arrays/ArrayMath.h>
 #include <casa/BasicSL/Constants.h>
+#include <casa/Exceptions/Error.h>
+#include <casa/Utilities/Assert.h>
 
 namespace casa { //# NAMESPACE CASA - BEGIN
 
@@ -289,6 +292,192 @@ Bool Interpolate2D::interpLanczos(T &result,
     return True;
 }
 
+template <typename T>
+void Interpolate2D::interpMany (Vector<T>& result, Vector<Bool>& ok,
+                                const Vector<Double>& x,
+                                const Vector<Double>& y,
+                                const Matrix<T>& data,
+                                const Matrix<Bool>* maskPtr) const
+{
+  AlwaysAssert (x.nelements() == y.nelements(), AipsError);
+  AlwaysAssert (!maskPtr  ||  maskPtr->shape().isEqual(data.shape()),
+                AipsError);
+  const uInt npos = x.nelements();
+  result.resize (npos);
+  ok.resize (npos);
+  Bool delX, delY, delRes, delOk;
+  const Double* xp = x.getStorage (delX);
+  const Double* yp = y.getStorage (delY);
+  T* resp = result.getStorage (delRes);
+  Bool* okp = ok.getStorage (delOk);
+  if (itsMethod == NEAREST  ||  itsMethod == LINEAR) {
+    Bool delData, delMask;
+    const T* datap = data.getStorage (delData);
+    const Bool* maskp = 0;
+    if (maskPtr) {
+      maskp = maskPtr->getStorage (delMask);
+    }
+    if (itsMethod == NEAREST) {
+      batchNearest (resp, okp, xp, yp, npos, datap, maskp,
+                    data.shape()[0], data.shape()[1]);
+    } else {
+      batchLinear (resp, okp, xp, yp, npos, datap, maskp,
+                   data.shape()[0], data.shape()[1]);
+    }
+    data.freeStorage (datap, delData);
+    if (maskPtr) {
+      maskPtr->freeStorage (maskp, delMask);
+    }
+  } else {
+    // Use the single position functions directly.
+    const Double nx = data.shape()[0];
+    const Double ny = data.shape()[1];
+    Vector<Double> where(2);
+    T value;
+    if (itsMethod == CUBIC) {
+      // Positions far outside the data are rejected first, because they
+      // could overflow the integer indices.
+      for (uInt k=0; k<npos; ++k) {
+        Bool good = False;
+        if (xp[k] > -2.  &&  xp[k] < nx+1.  &&  yp[k] > -2.  &&  yp[k] < ny+1.) {
+          where[0] = xp[k];
+          where[1] = yp[k];
+          good = interpCubic (value, where, data, maskPtr);
+        }
+        resp[k] = (good  ?  value : T(0));
+        okp[k]  = good;
+      }
+    } else {
+      // As in interpLanczos, a position whose kernel support is not
+      // entirely inside the data gives 0 (without testing the mask).
+      // A NaN position fails.
+      const Double a = 3;
+      for (uInt k=0; k<npos; ++k) {
+        const Double fx = floor(xp[k]);
+        const Double fy = floor(yp[k]);
+        Bool good;
+        if (fx >= a  &&  fx < nx-a  &&  fy >= a  &&  fy < ny-a) {
+          where[0] = xp[k];
+          where[1] = yp[k];
+          good = interpLanczos (value, where, data, maskPtr);
+        } else {
+          value = 0;
+          good = !(isNaN(xp[k])  ||  isNaN(yp[k]));
+        }
+        resp[k] = (good  ?  value : T(0));
+        okp[k]  = good;
+      }
+    }
+  }
+  x.freeStorage (xp, delX);
+  y.freeStorage (yp, delY);
+  result.putStorage (resp, delRes);
+  ok.putStorage (okp, delOk);
+}
+
+template <typename T, typename R>
+void Interpolate2D::interpManyComplex (Vector<T>& result, Vector<Bool>& ok,
+                                       const Vector<Double>& x,
+                                       const Vector<Double>& y,
+                                       const Matrix<T>& data,
+                                       const Matrix<Bool>* maskPtr) const
+{
+  // The real and imaginary parts fail at the same positions.
+  Matrix<R> part(real(data));
+  Vector<R> resRe, resIm;
+  interpMany (resRe, ok, x, y, part, maskPtr);
+  part = imag(data);
+  Vector<Bool> okIm;
+  interpMany (resIm, okIm, x, y, part, maskPtr);
+  const uInt npos = x.nelements();
+  result.resize (npos);
+  for (uInt k=0; k<npos; ++k) {
+    result[k] = T(resRe[k], resIm[k]);
+  }
+}
+
+template <typename T>
+void Interpolate2D::batchNearest (T* result, Bool* ok,
+                                  const Double* x, const Double* y, uInt npos,
+                                  const T* data, const Bool* mask,
+                                  Int nx, Int ny) const
+{
+  // Same 'neighborhood' of outer edge data elements as interpNearest.
+  static const Double half= .5001;
+  const Double imax = nx - 1.;
+  const Double jmax = ny - 1.;
+  const Bool hasData = (nx > 0  &&  ny > 0);
+  for (uInt k=0; k<npos; ++k) {
+    const Double wi = x[k];
+    const Double wj = y[k];
+    // A NaN fails all comparisons, so is outside.
+    const Bool inside = hasData & (wi >= -half) & (wi <= imax + half) &
+                        (wj >= -half) & (wj <= jmax + half);
+    // Use a valid position for the data access if outside.
+    const Double ci = (inside  ?  wi : 0.);
+    const Double cj = (inside  ?  wj : 0.);
+    const Int i = (ci <= 0.  ?  0 : (ci >= imax  ?  Int(imax) : Int(ci + .5)));
+    const Int j = (cj <= 0.  ?  0 : (cj >= jmax  ?  Int(jmax) : Int(cj + .5)));
+    const Int off = (inside  ?  i + j*nx : 0);
+    const Bool good = inside  &&  (mask == 0  ||  mask[off]);
+    result[k] = (good  ?  data[off] : T(0));
+    ok[k] = good;
+  }
+}
+
+template <typename T>
+void Interpolate2D::batchLinear (T* result, Bool* ok,
+                                 const Double* x, const Double* y, uInt npos,
+                                 const T* data, const Bool* mask,
+                                 Int nx, Int ny) const
+{
+  // The 2x2 grid starts at the pixel given by truncating the position
+  // (thus in the same way as interpLinear). It is moved left/down by one
+  // at the upper edges.
+  if (nx < 2  ||  ny < 2) {
+    for (uInt k=0; k<npos; ++k) {
+      result[k] = T(0);
+      ok[k] = False;
+    }
+    return;
+  }
+  const uInt si = nx-1;
+  const uInt sj = ny-1;
+  for (uInt k=0; k<npos; ++k) {
+    // Positions far outside (or NaN) are replaced by -1, so they cannot
+    // overflow the integer index and fail below.
+    const Bool nearby = (x[k] > -2.) & (x[k] < nx + 1.) &
+                      (y[k] > -2.) & (y[k] < ny + 1.);
+    const Double wi = (nearby  ?  x[k] : -1.);
+    const Double wj = (nearby  ?  y[k] : -1.);
+    uInt i = Int(wi);
+    uInt j = Int(wj);
+    i -= (i == si);
+    j -= (j == sj);
+    const Bool inside = (i < si) & (j < sj);
+    if (! inside) {
+      i = 0;
+      j = 0;
+    }
+    const uInt off = i + j*nx;
+    Bool good = inside;
+    if (mask) {
+      // Use a non-short-circuit and to avoid branches.
+      const Bool* m = mask + off;
+      good = good & m[0] & m[1] & m[nx] & m[nx+1];
+    }
+    const Double TT = wi - i;
+    const Double UU = wj - j;
+    const T* d = data + off;
+    const T value = (1.0-TT)*(1.0-UU)*d[0] +
+                    TT*(1.0-UU)*d[1] +
+                    TT*UU*d[nx+1] +
+                    (1.0-TT)*UU*d[nx];
+    result[k] = (good  ?  value : T(0));
+    ok[k] = good;
+  }
+}
+
 // Lanczos interpolation: helper function
 template <typename T>
 T Interpolate2D::sinc(const T x) const {
@@ -0,0 +1,226 @@
+//# tInterpolate2D.cc: Test program for the batch functions of Interpolate2D
+//# Copyright (C) 2014
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <scimath/Mathematics/Interpolate2D.h>
+#include <casa/Arrays/Matrix.h>
+#include <casa/Arrays/Vector.h>
+#include <casa/Arrays/ArrayMath.h>
+#include <casa/BasicSL/Complex.h>
+#include <casa/BasicSL/String.h>
+#include <casa/BasicMath/Math.h>
+#include <casa/Utilities/Assert.h>
+#include <casa/Exceptions/Error.h>
+#include <casa/iostream.h>
+
+#include <casa/namespace.h>
+
+// Check the batch interpolation of real data against the interpolation
+// of the positions one by one.
+template<class T>
+void checkReal (const Interpolate2D& interp, const String& name,
+                const Vector<Double>& x, const Vector<Double>& y,
+                const Matrix<T>& data, const Matrix<Bool>* mask, Double tol)
+{
+  Vector<T> result;
+  Vector<Bool> ok;
+  if (mask) {
+    interp.interp (result, ok, x, y, data, *mask);
+  } else {
+    interp.interp (result, ok, x, y, data);
+  }
+  AlwaysAssertExit (result.nelements() == x.nelements());
+  AlwaysAssertExit (ok.nelements() == x.nelements());
+  const Bool lanczos = interp.interpolationMethod() == Interpolate2D::LANCZOS;
+  const Double nx = data.shape()[0];
+  const Double ny = data.shape()[1];
+  Vector<Double> where(2);
+  uInt nok = 0;
+  for (uInt k=0; k<x.nelements(); ++k) {
+    Bool good;
+    T value = 0;
+    if (isNaN(x[k])  ||  isNaN(y[k])) {
+      // The single position functions cannot handle a NaN.
+      good = False;
+    } else if (lanczos  &&  (floor(x[k]) < 3  ||  floor(x[k]) >= nx-3  ||
+                             floor(y[k]) < 3  ||  floor(y[k]) >= ny-3)) {
+      // Outside the kernel support the result is 0 (the single
+      // position function would test the mask outside the data).
+      good = True;
+    } else {
+      where[0] = x[k];
+      where[1] = y[k];
+      if (mask) {
+        good = interp.interp (value, where, data, *mask);
+      } else {
+        good = interp.interp (value, where, data);
+      }
+      if (!good) {
+        value = 0;
+      }
+    }
+    if (ok[k] != good  ||  !nearAbs (Double(result[k]), Double(value), tol)) {
+      cout << name << ": position " << x[k] << ',' << y[k]
+           << " gives " << result[k] << ' ' << ok[k]
+           << " instead of " << value << ' ' << good << endl;
+      AlwaysAssertExit (False);
+    }
+    if (good) nok++;
+  }
+  // Make sure that not all positions are outside or masked.
+  AlwaysAssertExit (nok > x.nelements()/4);
+}
+
+// Check the batch interpolation of complex data against the interpolation
+// of the real and imaginary parts.
+template<class T, class R>
+void checkComplex (const Interpolate2D& interp, const String& name,
+                   const Vector<Double>& x, const Vector<Double>& y,
+                   const Matrix<T>& data, const Matrix<Bool>* mask, Double tol)
+{
+  Vector<T> result;
+  Vector<Bool> ok;
+  if (mask) {
+    interp.interp (result, ok, x, y, data, *mask);
+  } else {
+    interp.interp (result, ok, x, y, data);
+  }
+  Matrix<R> part(real(data));
+  checkReal (interp, name + " real", x, y, part, mask, tol);
+  Vector<R> resRe, resIm;
+  Vector<Bool> okRe, okIm;
+  if (mask) {
+    interp.interp (resRe, okRe, x, y, part, *mask);
+    part = imag(data);
+    interp.interp (resIm, okIm, x, y, part, *mask);
+  } else {
+    interp.interp (resRe, okRe, x, y, part);
+    part = imag(data);
+    interp.interp (resIm, okIm, x, y, part);
+  }
+  checkReal (interp, name + " imag", x, y, part, mask, tol);
+  AlwaysAssertExit (allEQ (ok, okRe));
+  AlwaysAssertExit (allEQ (ok, okIm));
+  for (uInt k=0; k<x.nelements(); ++k) {
+    AlwaysAssertExit (nearAbs (Double(real(result[k])), Double(resRe[k]), tol));
+    AlwaysAssertExit (nearAbs (Double(imag(result[k])), Double(resIm[k]), tol));
+  }
+}
+
+int main()
+{
+  try {
+    // Smooth data with masked pixels in the interior and at an edge.
+    const Int nx = 12;
+    const Int ny = 10;
+    Matrix<Double> dataD(nx, ny), imagD(nx, ny);
+    for (Int j=0; j<ny; ++j) {
+      for (Int i=0; i<nx; ++i) {
+        dataD(i,j) = sin(0.7*i) + cos(0.3*j) + 0.05*i*j;
+        imagD(i,j) = cos(0.4*i) - 0.1*j;
+      }
+    }
+    Matrix<Float> dataF(nx, ny);
+    convertArray (dataF, dataD);
+    Matrix<DComplex> dataDC(nx, ny);
+    Matrix<Complex> dataC(nx, ny);
+    for (Int j=0; j<ny; ++j) {
+      for (Int i=0; i<nx; ++i) {
+        dataDC(i,j) = DComplex(dataD(i,j), imagD(i,j));
+        dataC(i,j) = Complex(dataD(i,j), imagD(i,j));
+      }
+    }
+    Matrix<Bool> mask(nx, ny, True);
+    mask(5,4) = False;
+    mask(9,2) = False;
+    mask(0,7) = False;
+    mask(11,9) = False;
+
+    // Positions inside, at the edges, outside and NaN.
+    uInt npos = 0;
+    Vector<Double> x(2000), y(2000);
+    for (Double yv=-2.3; yv<ny+2; yv+=0.55) {
+      for (Double xv=-2.6; xv<nx+2; xv+=0.45) {
+        x[npos] = xv;
+        y[npos] = yv;
+        npos++;
+      }
+    }
+    for (Int j=0; j<ny; ++j) {
+      for (Int i=0; i<nx; ++i) {
+        x[npos] = i;
+        y[npos] = j;
+        npos++;
+      }
+    }
+    Double edges[][2] = {{nx-1, ny-1}, {nx-1, 4.5}, {3.5, ny-1},
+                         {-0.5, 0}, {nx-0.5, ny-0.5}, {nx-1+0.6, 2},
+                         {1e10, 3}, {3, -1e10}};
+    for (uInt i=0; i<8; ++i) {
+      x[npos] = edges[i][0];
+      y[npos] = edges[i][1];
+      npos++;
+    }
+    Double nan;
+    setNaN (nan);
+    x[npos] = nan;  y[npos] = 3;    npos++;
+    x[npos] = 4;    y[npos] = nan;  npos++;
+    x[npos] = nan;  y[npos] = nan;  npos++;
+    x.resize (npos, True);
+    y.resize (npos, True);
+
+    Interpolate2D::Method methods[4] = {Interpolate2D::NEAREST,
+                                        Interpolate2D::LINEAR,
+                                        Interpolate2D::CUBIC,
+                                        Interpolate2D::LANCZOS};
+    String names[4] = {"nearest", "linear", "cubic", "lanczos"};
+    for (uInt m=0; m<4; ++m) {
+      Interpolate2D interp(methods[m]);
+      for (uInt useMask=0; useMask<2; ++useMask) {
+        const Matrix<Bool>* maskPtr = (useMask  ?  &mask : 0);
+        String name = names[m] + (useMask ? " masked" : "");
+        checkReal (interp, name + " Float", x, y, dataF, maskPtr, 1e-5);
+        checkReal (interp, name + " Double", x, y, dataD, maskPtr, 1e-12);
+        checkComplex<Complex,Float> (interp, name + " Complex", x, y,
+                                     dataC, maskPtr, 1e-5);
+        checkComplex<DComplex,Double> (interp, name + " DComplex", x, y,
+                                       dataDC, maskPtr, 1e-12);
+      }
+    }
+    // A NaN position always fails.
+    Interpolate2D interp(Interpolate2D::LINEAR);
+    Vector<Double> result;
+    Vector<Bool> ok;
+    interp.interp (result, ok, x, y, dataD);
+    AlwaysAssertExit (!ok[npos-3]  &&  !ok[npos-2]  &&  !ok[npos-1]);
+    AlwaysAssertExit (result[npos-1] == 0);
+  } catch (AipsError x) {
+    cout << "Caught exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -111,6 +111,10 @@ public:
     // Delete it if no more references.
     static void unlink (BaseTable*);
 
+    // Get the number of references to this BaseTable object.
+    uInt nrefs() const
+      { return nrlink_p; }
+
     // Is the table a null table?
     // By default it is not.
     virtual Bool isNull() const;
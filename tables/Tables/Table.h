@@ -424,6 +424,10 @@ public:
     // a subtable is used in another process.
     Bool isMultiUsed (Bool checkSubTables=False) const;
 
+    // Get the number of Table objects in this process referencing
+    // the underlying table.
+    uInt nrefs() const;
+
     // Get the locking options.
     const TableLock& lockOptions() const;
 
@@ -1089,6 +1093,8 @@ inline void Table::resync()
 
 inline Bool Table::isMultiUsed(Bool checkSubTables) const
     { return baseTabPtr_p->isMultiUsed(checkSubTables); }
+inline uInt Table::nrefs() const
+    { return baseTabPtr_p->nrefs(); }
 inline const TableLock& Table::lockOptions() const
     { return baseTabPtr_p->lockOptions(); }
 inline Bool Table::lock (FileLocker::LockType type, uInt nattempts)
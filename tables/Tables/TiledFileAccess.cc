@@ -35,6 +35,11 @@
 #include <casa/Utilities/ValType.h>
 #include <casa/Utilities/Assert.h>
 #include <casa/OS/HostInfo.h>
+#include <casa/OS/RegularFile.h>
+#include <casa/OS/CanonicalConversion.h>
+#include <casa/OS/LECanonicalConversion.h>
+#include <casa/IO/MMapIO.h>
+#include <algorithm>
 
 
 namespace casa { //# NAMESPACE CASA - BEGIN
@@ -49,13 +54,17 @@ TiledFileAccess::TiledFileAccess (const String& fileName,
 : itsCube     (0),
   itsTSM      (0),
   itsWritable (writable),
-  itsDataType (dataType)
+  itsDataType (dataType),
+  itsMapped   (0),
+  itsFileOffset (fileOffset),
+  itsBigEndian  (True)
 {
   itsLocalPixelSize = ValType::getTypeSize (dataType);
   itsTSM  = new TiledFileHelper (fileName, shape, dataType, tsmOpt,
 				 writable, HostInfo::bigEndian());
   itsCube = itsTSM->makeTSMCube (itsTSM->file(), shape, tileShape,
                                  Record(), fileOffset);
+  initMapped (fileName, fileOffset, tsmOpt, HostInfo::bigEndian());
 }
 
 TiledFileAccess::TiledFileAccess (const String& fileName,
@@ -69,21 +78,125 @@ TiledFileAccess::TiledFileAccess (const String& fileName,
 : itsCube     (0),
   itsTSM      (0),
   itsWritable (writable),
-  itsDataType (dataType)
+  itsDataType (dataType),
+  itsMapped   (0),
+  itsFileOffset (fileOffset),
+  itsBigEndian  (True)
 {
   itsLocalPixelSize = ValType::getTypeSize (dataType);
   itsTSM  = new TiledFileHelper (fileName, shape, dataType, tsmOpt,
 				 writable, bigEndian);
   itsCube = itsTSM->makeTSMCube (itsTSM->file(), shape, tileShape,
                                  Record(), fileOffset);
+  initMapped (fileName, fileOffset, tsmOpt, bigEndian);
 }
 
 TiledFileAccess::~TiledFileAccess()
 {
+  delete itsMapped;
   delete itsCube;
   delete itsTSM;
 }
 
+void TiledFileAccess::initMapped (const String& fileName, Int64 fileOffset,
+                                  const TSMOption& tsmOpt, Bool bigEndian)
+{
+  TSMOption opt(tsmOpt);
+  opt.fillOption (False);
+  if (opt.option() != TSMOption::MMap  ||  itsWritable  ||
+      !isContiguous (shape(), tileShape())) {
+    return;
+  }
+  if (itsDataType != TpUChar  &&  itsDataType != TpShort  &&
+      itsDataType != TpInt  &&  itsDataType != TpFloat  &&
+      itsDataType != TpDouble) {
+    return;
+  }
+  MMapIO* mapped = new MMapIO (RegularFile(fileName));
+  // Use the cache if the file does not contain the entire array,
+  // because it handles missing data.
+  if (mapped->getFileSize() <
+      fileOffset + Int64(shape().product()) * itsLocalPixelSize) {
+    delete mapped;
+    return;
+  }
+  itsMapped     = mapped;
+  itsFileOffset = fileOffset;
+  itsBigEndian  = bigEndian;
+}
+
+// Convert the data of a section of the array in the mapped file
+// to local format. Leading axes that are fully accessed are converted
+// as a single chunk.
+template<typename T, typename CONV>
+void tiledFileAccessGetMapped (T* buffer, const char* data,
+                               const IPosition& shape,
+                               const IPosition& start,
+                               const IPosition& length,
+                               const IPosition& stride)
+{
+  const uInt ndim = shape.nelements();
+  // Determine the chunk that can be converted at once.
+  uInt nax = 0;
+  size_t chunk = 1;
+  while (nax < ndim  &&  stride(nax) == 1) {
+    chunk *= length(nax);
+    nax++;
+    if (length(nax-1) != shape(nax-1)) {
+      break;
+    }
+  }
+  const size_t nchunk = (chunk == 0  ?  0 : length.product() / chunk);
+  IPosition steps(ndim);
+  Int64 step = 1;
+  for (uInt i=0; i<ndim; i++) {
+    steps(i) = step;
+    step *= shape(i);
+  }
+  Int64 startOffset = 0;
+  for (uInt i=0; i<ndim; i++) {
+    startOffset += start(i) * steps(i);
+  }
+  IPosition pos(ndim, 0);
+  for (size_t n=0; n<nchunk; n++) {
+    Int64 offset = startOffset;
+    for (uInt i=nax; i<ndim; i++) {
+      offset += pos(i) * stride(i) * steps(i);
+    }
+    const char* from = data + offset * sizeof(T);
+    // The conversion functions take the nr of elements as an uInt.
+    for (size_t done=0; done<chunk; ) {
+      uInt nr = std::min (chunk-done, size_t(1073741824));
+      CONV::toLocal (buffer, from, nr);
+      buffer += nr;
+      from   += nr * sizeof(T);
+      done   += nr;
+    }
+    for (uInt i=nax; i<ndim; i++) {
+      if (++pos(i) < length(i)) {
+        break;
+      }
+      pos(i) = 0;
+    }
+  }
+}
+
+template<typename T>
+void TiledFileAccess::getMapped (T* buffer, const IPosition& start,
+                                 const IPosition& length,
+                                 const IPosition& stride) const
+{
+  const char* data = static_cast<const char*>
+    (itsMapped->getReadPointer (itsFileOffset));
+  if (itsBigEndian) {
+    tiledFileAccessGetMapped<T,CanonicalConversion>
+      (buffer, data, shape(), start, length, stride);
+  } else {
+    tiledFileAccessGetMapped<T,LECanonicalConversion>
+      (buffer, data, shape(), start, length, stride);
+  }
+}
+
 Array<Bool> TiledFileAccess::getBool (const Slicer& section)
 {
   Array<Bool> arr;
@@ -156,8 +269,12 @@ void TiledFileAccess::get (Array<uChar>& buffer, const Slicer& section)
   buffer.resize (shp);
   Bool deleteIt;
   uChar* dataPtr = buffer.getStorage (deleteIt);
-  itsCube->accessStrided (start, end, stride, (char*)dataPtr, 0,
-  			  itsLocalPixelSize, itsLocalPixelSize, False);
+  if (itsMapped) {
+    getMapped (dataPtr, start, shp, stride);
+  } else {
+    itsCube->accessStrided (start, end, stride, (char*)dataPtr, 0,
+                            itsLocalPixelSize, itsLocalPixelSize, False);
+  }
   buffer.putStorage (dataPtr, deleteIt);
 }
 
@@ -170,8 +287,12 @@ void TiledFileAccess::get (Array<Short>& buffer, const Slicer& section)
   buffer.resize (shp);
   Bool deleteIt;
   Short* dataPtr = buffer.getStorage (deleteIt);
-  itsCube->accessStrided (start, end, stride, (char*)dataPtr, 0,
-  			  itsLocalPixelSize, itsLocalPixelSize, False);
+  if (itsMapped) {
+    getMapped (dataPtr, start, shp, stride);
+  } else {
+    itsCube->accessStrided (start, end, stride, (char*)dataPtr, 0,
+                            itsLocalPixelSize, itsLocalPixelSize, False);
+  }
   buffer.putStorage (dataPtr, deleteIt);
 }
 
@@ -184,8 +305,12 @@ void TiledFileAccess::get (Array<Int>& buffer, const Slicer& section)
   buffer.resize (shp);
   Bool deleteIt;
   Int* dataPtr = buffer.getStorage (deleteIt);
-  itsCube->accessStrided (start, end, stride, (char*)dataPtr, 0,
-  			  itsLocalPixelSize, itsLocalPixelSize, False);
+  if (itsMapped) {
+    getMapped (dataPtr, start, shp, stride);
+  } else {
+    itsCube->accessStrided (start, end, stride, (char*)dataPtr, 0,
+                            itsLocalPixelSize, itsLocalPixelSize, False);
+  }
   buffer.putStorage (dataPtr, deleteIt);
 }
 
@@ -198,8 +323,12 @@ void TiledFileAccess::get (Array<Float>& buffer, const Slicer& section)
   buffer.resize (shp);
   Bool deleteIt;
   Float* dataPtr = buffer.getStorage (deleteIt);
-  itsCube->accessStrided (start, end, stride, (char*)dataPtr, 0,
-  			  itsLocalPixelSize, itsLocalPixelSize, False);
+  if (itsMapped) {
+    getMapped (dataPtr, start, shp, stride);
+  } else {
+    itsCube->accessStrided (start, end, stride, (char*)dataPtr, 0,
+                            itsLocalPixelSize, itsLocalPixelSize, False);
+  }
   buffer.putStorage (dataPtr, deleteIt);
 }
 
@@ -212,8 +341,12 @@ void TiledFileAccess::get (Array<Double>& buffer, const Slicer& section)
   buffer.resize (shp);
   Bool deleteIt;
   Double* dataPtr = buffer.getStorage (deleteIt);
-  itsCube->accessStrided (start, end, stride, (char*)dataPtr, 0,
-  			  itsLocalPixelSize, itsLocalPixelSize, False);
+  if (itsMapped) {
+    getMapped (dataPtr, start, shp, stride);
+  } else {
+    itsCube->accessStrided (start, end, stride, (char*)dataPtr, 0,
+                            itsLocalPixelSize, itsLocalPixelSize, False);
+  }
   buffer.putStorage (dataPtr, deleteIt);
 }
 
@@ -246,6 +379,31 @@ void TiledFileAccess::get (Array<DComplex>& buffer, const Slicer& section)
 }
 
 
+// Scale the data and set the deleted values to NaN.
+// The loops are written without branches, so the compiler can vectorise them.
+template<typename T>
+void tiledFileAccessScale (Float* out, const T* in, size_t n,
+                           Float scale, Float offset, T deleteValue,
+                           Bool examineForDeleteValues)
+{
+  if (scale == 1  &&  offset == 0) {
+    for (size_t i=0; i<n; i++) {
+      out[i] = in[i];
+    }
+  } else {
+    for (size_t i=0; i<n; i++) {
+      out[i] = in[i] * scale + offset;
+    }
+  }
+  if (examineForDeleteValues) {
+    Float nan;
+    setNaN (nan);
+    for (size_t i=0; i<n; i++) {
+      out[i] = (in[i] == deleteValue  ?  nan : out[i]);
+    }
+  }
+}
+
 Array<Float> TiledFileAccess::getFloat (const Slicer& section,
 					Float scale, Float offset,
 					uChar deleteValue, 
@@ -284,20 +442,8 @@ void TiledFileAccess::get (Array<Float>& buffer, const Slicer& section,
   Bool deleteArr, deleteBuf;
   const uChar* arrPtr = arr.getStorage (deleteArr);
   Float* bufPtr = buffer.getStorage (deleteBuf);
-  uInt n = arr.nelements();
-  if (examineForDeleteValues) {
-    for (uInt i=0; i<n; i++) {
-      if (arrPtr[i] == deleteValue) {
-        setNaN (bufPtr[i]);
-      } else {
-        bufPtr[i] = arrPtr[i] * scale + offset;
-      }
-    }
-  } else {
-    for (uInt i=0; i<n; i++) {
-      bufPtr[i] = arrPtr[i] * scale + offset;
-    }
-  }
+  tiledFileAccessScale (bufPtr, arrPtr, arr.nelements(), scale, offset,
+                        deleteValue, examineForDeleteValues);
   arr.freeStorage (arrPtr, deleteArr);
   buffer.putStorage (bufPtr, deleteBuf);
 }
@@ -311,20 +457,8 @@ void TiledFileAccess::get (Array<Float>& buffer, const Slicer& section,
   Bool deleteArr, deleteBuf;
   const Short* arrPtr = arr.getStorage (deleteArr);
   Float* bufPtr = buffer.getStorage (deleteBuf);
-  uInt n = arr.nelements();
-  if (examineForDeleteValues) {
-    for (uInt i=0; i<n; i++) {
-      if (arrPtr[i] == deleteValue) {
-        setNaN (bufPtr[i]);
-      } else {
-        bufPtr[i] = arrPtr[i] * scale + offset;
-      }
-    }
-  } else {
-    for (uInt i=0; i<n; i++) {
-      bufPtr[i] = arrPtr[i] * scale + offset;
-    }
-  }
+  tiledFileAccessScale (bufPtr, arrPtr, arr.nelements(), scale, offset,
+                        deleteValue, examineForDeleteValues);
   arr.freeStorage (arrPtr, deleteArr);
   buffer.putStorage (bufPtr, deleteBuf);
 }
@@ -338,20 +472,8 @@ void TiledFileAccess::get (Array<Float>& buffer, const Slicer& section,
   Bool deleteArr, deleteBuf;
   const Int* arrPtr = arr.getStorage (deleteArr);
   Float* bufPtr = buffer.getStorage (deleteBuf);
-  uInt n = arr.nelements();
-  if (examineForDeleteValues) {
-    for (uInt i=0; i<n; i++) {
-      if (arrPtr[i] == deleteValue) {
-        setNaN (bufPtr[i]);
-      } else {
-        bufPtr[i] = arrPtr[i] * scale + offset;
-      }
-    }
-  } else {
-    for (uInt i=0; i<n; i++) {
-      bufPtr[i] = arrPtr[i] * scale + offset;
-    }
-  }
+  tiledFileAccessScale (bufPtr, arrPtr, arr.nelements(), scale, offset,
+                        deleteValue, examineForDeleteValues);
   arr.freeStorage (arrPtr, deleteArr);
   buffer.putStorage (bufPtr, deleteBuf);
 }
@@ -528,5 +650,27 @@ IPosition TiledFileAccess::makeTileShape (const IPosition& arrayShape,
   return tileShape;
 }
 
+Bool TiledFileAccess::isContiguous (const IPosition& arrayShape,
+                                    const IPosition& tileShape)
+{
+  uInt ndim = arrayShape.nelements();
+  uInt i=0;
+  // Skip the full axes.
+  while (i < ndim  &&  tileShape(i) == arrayShape(i)) {
+    i++;
+  }
+  // The partial axis must be divisible by its tile length (otherwise the
+  // tiles are padded) and the remaining axes must have tile length 1.
+  if (i < ndim  &&  arrayShape(i) % tileShape(i) != 0) {
+    return False;
+  }
+  for (i++; i<ndim; i++) {
+    if (tileShape(i) != 1) {
+      return False;
+    }
+  }
+  return True;
+}
+
 } //# NAMESPACE CASA - END
 
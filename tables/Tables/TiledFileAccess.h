@@ -38,6 +38,7 @@ namespace casa { //# NAMESPACE CASA - BEGIN
 
 //# Forward Declarations
 class TiledFileHelper;
+class MMapIO;
 class Slicer;
 
 
@@ -66,6 +67,15 @@ class Slicer;
 // <p>
 // See <linkto class=ROTiledStManAccessor>ROTiledStManAccessor</linkto>
 // for a more detailed discussion.
+// <p>
+// If the option <src>TSMOption::MMap</src> is given for a readonly file
+// and if the tile shape does not really tile the array (i.e., the tiles
+// consist of full axes followed by a part of an axis and length 1 for the
+// remaining axes, as made by <src>makeTileShape</src>), the array is
+// stored contiguously in the file. In that case the data are read directly
+// from the memory-mapped file without using the tile cache. It is
+// the fastest way to access arrays in large files (e.g. FITS images).
+// The data types Bool, Complex and DComplex are always read using the cache.
 // </synopsis> 
 
 // <motivation>
@@ -118,6 +128,10 @@ public:
   DataType dataType() const
     { return itsDataType; }
 
+  // Are the data read directly from the memory-mapped file?
+  Bool isMapped() const
+    { return itsMapped != 0; }
+
   // Get part of the array.
   // The Array object is resized if needed.
   // <group>
@@ -236,6 +250,12 @@ public:
   static IPosition makeTileShape (const IPosition& arrayShape,
 				  uInt nrPixelsPerTile = 32768);
 
+  // Is an array with the given tile shape stored contiguously in the file?
+  // It is if the tiles consist of full axes, optionally followed by a part
+  // of an axis (dividing its length) and length 1 for the remaining axes.
+  static Bool isContiguous (const IPosition& arrayShape,
+                            const IPosition& tileShape);
+
 
 private:
   // Forbid copy constructor and assignment.
@@ -244,12 +264,25 @@ private:
   TiledFileAccess& operator= (const TiledFileAccess&);
   // </group>
 
+  // Map the file if the TSMOption tells so and if the array is stored
+  // contiguously.
+  void initMapped (const String& fileName, Int64 fileOffset,
+                   const TSMOption& tsmOpt, Bool bigEndian);
+
+  // Get a section of the array from the memory-mapped file.
+  template<typename T>
+  void getMapped (T* buffer, const IPosition& start,
+                  const IPosition& length, const IPosition& stride) const;
+
 
   TSMCube*         itsCube;
   TiledFileHelper* itsTSM;
   uInt             itsLocalPixelSize;
   Bool             itsWritable;
   DataType         itsDataType;
+  MMapIO*          itsMapped;
+  Int64            itsFileOffset;
+  Bool             itsBigEndian;
 };
 
 
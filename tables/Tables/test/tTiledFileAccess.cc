@@ -36,6 +36,7 @@
 #include <casa/Arrays/ArrayIO.h>
 #include <casa/Arrays/Slicer.h>
 #include <casa/IO/CanonicalIO.h>
+#include <casa/IO/LECanonicalIO.h>
 #include <casa/IO/RawIO.h>
 #include <casa/IO/RegularFileIO.h>
 #include <casa/OS/RegularFile.h>
@@ -108,6 +109,9 @@ int main()
                            TSMOption(TSMOption::MMap, 0, 1));
       AlwaysAssertExit (tfa.shape() == shape);
       AlwaysAssertExit (tfa.tileShape() == IPosition(2,16,1));
+      // The data are contiguous, so read from the mapped file (thus
+      // without using the cache).
+      AlwaysAssertExit (tfa.isMapped());
       AlwaysAssertExit (! tfa.isWritable());
       AlwaysAssertExit (tfa.maximumCacheSize() == 1024*1024);
       cout << tfa.cacheSize() << endl;
@@ -255,6 +259,80 @@ int main()
     }
   }
 
+  // Test reading a Short array from a memory-mapped file in canonical
+  // and little endian format. Compare it with reading using the cache.
+  {
+    IPosition shape(3,6,5,4);
+    Array<Short> arrs(shape);
+    indgen(arrs);
+    arrs(IPosition(3,1,2,3)) = -32768;
+    uInt off2;
+    {
+      Bool deleteIt;
+      const Short* dataPtr = arrs.getStorage (deleteIt);
+      RegularFileIO fios(RegularFile("tTiledFileAccess_tmp.dat"), ByteIO::New);
+      CanonicalIO ios (&fios);
+      off2 = ios.write (shape.product(), dataPtr);
+      LECanonicalIO lios (&fios);
+      lios.write (shape.product(), dataPtr);
+      arrs.freeStorage (dataPtr, deleteIt);
+    }
+    try {
+      TiledFileAccess tfac ("tTiledFileAccess_tmp.dat", 0, shape,
+			    IPosition(3,6,5,1), TpShort,
+                            TSMOption::Cache, False, True);
+      TiledFileAccess tfam ("tTiledFileAccess_tmp.dat", 0, shape,
+			    IPosition(3,6,5,1), TpShort,
+                            TSMOption::MMap, False, True);
+      TiledFileAccess tfal ("tTiledFileAccess_tmp.dat", off2, shape,
+			    IPosition(3,6,5,1), TpShort,
+                            TSMOption::MMap, False, False);
+      // A real tiling or a writable file cannot be mapped.
+      TiledFileAccess tfat ("tTiledFileAccess_tmp.dat", 0, shape,
+			    IPosition(3,3,5,1), TpShort,
+                            TSMOption::MMap, False, True);
+      TiledFileAccess tfaw ("tTiledFileAccess_tmp.dat", 0, shape,
+			    IPosition(3,6,5,1), TpShort,
+                            TSMOption::MMap, True, True);
+      AlwaysAssertExit (!tfac.isMapped());
+      AlwaysAssertExit (tfam.isMapped());
+      AlwaysAssertExit (tfal.isMapped());
+      AlwaysAssertExit (!tfat.isMapped());
+      AlwaysAssertExit (!tfaw.isMapped());
+      AlwaysAssertExit (TiledFileAccess::isContiguous (shape,
+                                                       IPosition(3,6,1,1)));
+      AlwaysAssertExit (!TiledFileAccess::isContiguous (shape,
+                                                        IPosition(3,6,2,1)));
+      AlwaysAssertExit (!TiledFileAccess::isContiguous (shape,
+                                                        IPosition(3,6,1,2)));
+      Slicer slicers[4];
+      slicers[0] = Slicer(IPosition(3,0,0,0), shape);
+      slicers[1] = Slicer(IPosition(3,0,1,1), IPosition(3,6,3,2));
+      slicers[2] = Slicer(IPosition(3,1,0,0), IPosition(3,4,5,4));
+      slicers[3] = Slicer(IPosition(3,1,0,1), IPosition(3,3,3,2),
+                          IPosition(3,2,2,2));
+      for (uInt i=0; i<4; i++) {
+        Array<Short> exp = arrs(slicers[i]);
+        AlwaysAssertExit (allEQ (exp, tfac.getShort (slicers[i])));
+        AlwaysAssertExit (allEQ (exp, tfam.getShort (slicers[i])));
+        AlwaysAssertExit (allEQ (exp, tfal.getShort (slicers[i])));
+        Array<Float> expf = tfac.getFloat (slicers[i], 0.5, 2, short(-32768));
+        Array<Float> arrf = tfam.getFloat (slicers[i], 0.5, 2, short(-32768));
+        AlwaysAssertExit (allEQ (isNaN(expf), isNaN(arrf)));
+        AlwaysAssertExit (allEQ (isNaN(expf), exp == short(-32768)));
+        expf(isNaN(expf)) = 0;
+        arrf(isNaN(arrf)) = 0;
+        AlwaysAssertExit (allEQ (expf, arrf));
+      }
+      AlwaysAssertExit (isNaN (tfam.getFloat (slicers[0], 0.5, 2,
+                                              short(-32768))
+                               (IPosition(3,1,2,3))));
+    } catch (AipsError x) {
+      cout << "Exception: " << x.getMesg() << endl;
+      return 1;
+    }
+  }
+
   // Test the tileShape function in various ways.
   {
     try {